@@ -37,4 +37,9 @@ SET (CGNS_INCLUDE ${EXTERNAL_LIB}/cgnslib/include)
 
 SET (SYMDIFF_ARCHIVE ${EXTERNAL_LIB}/symdiff/lib/libsymdiff_static.a)
 SET (SYMDIFF_INCLUDE ${EXTERNAL_LIB}/symdiff/include)
+
+# threaded direct solver, configure with -DMKL_PARDISO=ON
+SET (MKLLOCATE /opt/intel/mkl)
+SET (MKL_INCLUDE ${MKLLOCATE}/include)
+SET (MKL_PARDISO_ARCHIVE -Wl,--start-group ${MKLLOCATE}/lib/intel64/libmkl_intel_lp64.a ${MKLLOCATE}/lib/intel64/libmkl_gnu_thread.a ${MKLLOCATE}/lib/intel64/libmkl_core.a -Wl,--end-group -fopenmp)
 #ENDIF (${DEVSIM_CONFIG} STREQUAL "ubuntu_12.04")
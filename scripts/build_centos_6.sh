@@ -54,6 +54,8 @@ cd devsim
 
 bash scripts/setup_centos_6.sh
 (cd linux_x86_64_release && make -j2)
+# compare the vectorized special functions with the scalar versions
+(cd linux_x86_64_vector_math && make -j2 && ctest3 -R testing/vector_math --output-on-failure)
 (cd dist && bash package_linux.sh ${1})
 
 
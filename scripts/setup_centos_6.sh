@@ -18,3 +18,16 @@ ARCH=`uname -m`
       ..)
 #  done
 done
+
+# the vectorized special functions are off by default, and this build only runs their test
+NAME=linux_${ARCH}_vector_math
+mkdir ${NAME}
+(cd $NAME; ${CMAKE} \
+  -DCMAKE_BUILD_TYPE=release \
+  -DCMAKE_CXX_COMPILER=${CXX} \
+  -DCMAKE_C_COMPILER=${CC} \
+  -DDEVSIM_CONFIG=${DEVSIM_CONFIG} \
+  -DCMAKE_CXX_FLAGS:STRING="${CMAKE_CXX_FLAGS}" \
+  -DDEVSIM_EXTENDED_PRECISION=ON \
+  -DDEVSIM_VECTOR_MATH=ON \
+  ..)
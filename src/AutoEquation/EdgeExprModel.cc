@@ -20,6 +20,7 @@ limitations under the License.
 #include "Edge.hh"
 #include "Vector.hh"
 #include "ModelExprEval.hh"
+#include "ModelExprProgram.hh"
 #include "GeometryStream.hh"
 #include "dsAssert.hh"
 
@@ -31,7 +32,7 @@ limitations under the License.
 
 // Must be valid equation object which is passed
 template <typename DoubleType>
-EdgeExprModel<DoubleType>::EdgeExprModel(const std::string &nm, const Eqo::EqObjPtr eq, RegionPtr rp, EdgeModel::DisplayType dt, ContactPtr cp) : EdgeModel(nm, rp, dt, cp), equation(eq)
+EdgeExprModel<DoubleType>::EdgeExprModel(const std::string &nm, const Eqo::EqObjPtr eq, RegionPtr rp, EdgeModel::DisplayType dt, ContactPtr cp) : EdgeModel(nm, rp, dt, cp), equation(eq), program(new MEE::ModelExprProgram<DoubleType>(eq, cp ? NULL : rp))
 {
 #if 0
     os << "creating EdgeExprModel " << nm << " with equation " << eq << "\n";
@@ -89,7 +90,7 @@ void EdgeExprModel<DoubleType>::calcEdgeScalarValues() const
     typename MEE::ModelExprEval<DoubleType>::error_t errors;
     const Region *rp = &(this->GetRegion());
     MEE::ModelExprEval<DoubleType> mexp(rp, GetName(), errors);
-    MEE::ModelExprData<DoubleType> out = mexp.eval_function(equation);
+    MEE::ModelExprData<DoubleType> out = mexp.eval_program(*program);
 
     if (!errors.empty())
     {
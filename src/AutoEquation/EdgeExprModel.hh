@@ -26,6 +26,10 @@ namespace Eqo {
 
 }
 
+namespace MEE {
+template <typename DoubleType> class ModelExprProgram;
+}
+
 EdgeModelPtr CreateEdgeExprModel(const std::string &, Eqo::EqObjPtr, RegionPtr, EdgeModel::DisplayType, ContactPtr);
 
 template <typename DoubleType>
@@ -44,6 +48,8 @@ class EdgeExprModel : public EdgeModel
         void calcEdgeScalarValues() const;
 
         const Eqo::EqObjPtr      equation;
+        /// compiled once from the equation
+        std::shared_ptr<MEE::ModelExprProgram<DoubleType> > program;
 };
 
 #endif
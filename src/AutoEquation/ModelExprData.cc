@@ -38,6 +38,8 @@ limitations under the License.
 #include "Edge.hh"
 #include "Tetrahedron.hh"
 
+#include <utility>
+
 namespace MEE {
 const char * const datatypename[] = {
   "nodedata",
@@ -138,6 +140,32 @@ ModelExprData<DoubleType>::ModelExprData(const TetrahedronEdgeScalarData<DoubleT
   tetrahedronEdgeScalarData = std::shared_ptr<TetrahedronEdgeScalarData<DoubleType>>(foo);
 };
 
+template <typename DoubleType>
+ModelExprData<DoubleType>::ModelExprData(datatype t, std::vector<DoubleType> &&x, const Region *r) : val(0.0), type(t), reg(r)
+{
+  if (type == datatype::NODEDATA)
+  {
+    nodeScalarData = nodeScalarData_ptr<DoubleType>(new NodeScalarData<DoubleType>(std::move(x)));
+  }
+  else if (type == datatype::EDGEDATA)
+  {
+    edgeScalarData = edgeScalarData_ptr<DoubleType>(new EdgeScalarData<DoubleType>(std::move(x)));
+  }
+  else if (type == datatype::TRIANGLEEDGEDATA)
+  {
+    triangleEdgeScalarData = triangleEdgeScalarData_ptr<DoubleType>(new TriangleEdgeScalarData<DoubleType>(std::move(x)));
+  }
+  else if (type == datatype::TETRAHEDRONEDGEDATA)
+  {
+    tetrahedronEdgeScalarData = tetrahedronEdgeScalarData_ptr<DoubleType>(new TetrahedronEdgeScalarData<DoubleType>(std::move(x)));
+  }
+  else
+  {
+    dsAssert(false, "UNEXPECTED");
+    type = datatype::INVALID;
+  }
+}
+
 template <typename DoubleType>
 ModelExprData<DoubleType> &ModelExprData<DoubleType>::operator=(const ModelExprData<DoubleType> &x)
 {
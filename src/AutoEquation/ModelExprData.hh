@@ -126,6 +126,8 @@ class ModelExprData {
         ModelExprData(const EdgeScalarData<DoubleType> &, const Region *);
         ModelExprData(const TriangleEdgeScalarData<DoubleType> &, const Region *);
         ModelExprData(const TetrahedronEdgeScalarData<DoubleType> &, const Region *);
+        /// takes ownership of the values for the given type of data
+        ModelExprData(datatype, std::vector<DoubleType> &&, const Region *);
 
         ModelExprData(const ModelExprData &);
         ModelExprData &operator=(const ModelExprData &);
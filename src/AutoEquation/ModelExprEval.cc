@@ -17,6 +17,7 @@ limitations under the License.
 
 #include "ModelExprEval.hh"
 #include "ModelExprData.hh"
+#include "ModelExprProgram.hh"
 #include "NodeScalarData.hh"
 #include "EdgeScalarData.hh"
 #include "NodeModel.hh"
@@ -216,9 +217,39 @@ ModelExprData<DoubleType> ModelExprEval<DoubleType>::EvaluateModelType(Eqo::EqOb
 template <typename DoubleType>
 ModelExprData<DoubleType> ModelExprEval<DoubleType>::EvaluateVariableType(Eqo::EqObjPtr arg)
 {
-  ModelExprData<DoubleType> out;
+  VariableBinding binding;
+  return EvaluateVariable(arg, binding);
+}
 
+template <typename DoubleType>
+ModelExprData<DoubleType> ModelExprEval<DoubleType>::EvaluateVariable(Eqo::EqObjPtr arg, VariableBinding &binding)
+{
   GlobalData &gd  = GlobalData::GetInstance();
+
+  const size_t version = gd.GetDBVersion();
+
+  if ((binding.kind != VariableBinding::Kind::UNBOUND) && (binding.region == data_ref) && (binding.version == version))
+  {
+    if (binding.kind == VariableBinding::Kind::VALUE)
+    {
+      return ModelExprData<DoubleType>(binding.value, data_ref);
+    }
+
+    double val = 0.0;
+    const size_t index = binding.node->GetNumber();
+    if (binding.solution && (index != size_t(-1)))
+    {
+      dsAssert(index < binding.solution->size(), "CIRCUIT_UNEXPECTED");
+      val = (*binding.solution)[index];
+    }
+    return ModelExprData<DoubleType>(static_cast<DoubleType>(val), data_ref);
+  }
+
+  binding.kind = VariableBinding::Kind::UNBOUND;
+  binding.node.reset();
+
+  ModelExprData<DoubleType> out;
+
   MaterialDB &mdb = MaterialDB::GetInstance();
   NodeKeeper &nk = NodeKeeper::instance();
 
@@ -226,26 +257,41 @@ ModelExprData<DoubleType> ModelExprEval<DoubleType>::EvaluateVariableType(Eqo::E
   /**
    * Get the DB entry here
    */
+  const std::string &material = data_ref->GetMaterialName();
   const GlobalData::DoubleDBEntry_t &gdbent  = gd.GetDoubleDBEntryOnRegion(data_ref, nm);
-  const MaterialDB::DoubleDBEntry_t &mdbentr = mdb.GetDoubleDBEntry(data_ref->GetMaterialName(), nm);
+  const MaterialDB::DoubleDBEntry_t &mdbentr = mdb.GetDoubleDBEntry(material, nm);
   const MaterialDB::DoubleDBEntry_t &mdbentg = mdb.GetDoubleDBEntry("global", nm);
 
+  //// entries which are not numbers are reported every time they are looked up
+  const bool can_bind = (gdbent.first || !gd.GetDBEntryOnRegion(data_ref, nm).first)
+                     && (mdbentr.first || !mdb.GetDBEntry(material, nm).first)
+                     && (mdbentg.first || !mdb.GetDBEntry("global", nm).first);
+
   if (gdbent.first)
   {
     out = ModelExprData<DoubleType>(gdbent.second, data_ref);
+    binding.kind  = VariableBinding::Kind::VALUE;
+    binding.value = gdbent.second;
   }
   else if (mdbentr.first)
   {
     out = ModelExprData<DoubleType>(mdbentr.second, data_ref);
+    binding.kind  = VariableBinding::Kind::VALUE;
+    binding.value = mdbentr.second;
   }
   else if (mdbentg.first)
   {
     out = ModelExprData<DoubleType>(mdbentg.second, data_ref);
+    binding.kind  = VariableBinding::Kind::VALUE;
+    binding.value = mdbentg.second;
   }
   else if (nk.IsCircuitNode(nm))
   {
     const DoubleType val = nk.GetNodeValue("dcop", nm);
     out = ModelExprData<DoubleType>(val, data_ref);
+    binding.kind     = VariableBinding::Kind::CIRCUIT;
+    binding.solution = nk.GetSolution("dcop");
+    binding.node     = nk.FindNode(nm);
 #if 0
     std::ostringstream os; 
     os << "circuit using : " << nm << " " << val << "\n";
@@ -259,6 +305,17 @@ ModelExprData<DoubleType> ModelExprEval<DoubleType>::EvaluateVariableType(Eqo::E
     errors.push_back(os.str());
   }
 
+  if (can_bind && (binding.kind != VariableBinding::Kind::UNBOUND))
+  {
+    binding.region  = data_ref;
+    binding.version = version;
+  }
+  else
+  {
+    binding.kind = VariableBinding::Kind::UNBOUND;
+    binding.node.reset();
+  }
+
   return out;
 }
 
@@ -509,6 +566,47 @@ ModelExprData<DoubleType> ModelExprEval<DoubleType>::eval_function(Eqo::EqObjPtr
   return out;
 }
 
+template <typename DoubleType>
+ModelExprData<DoubleType> ModelExprEval<DoubleType>::eval_program(ModelExprProgram<DoubleType> &program)
+{
+  //// contacts only evaluate some of the entries
+  if (!program.IsCompiled() || !indexes.empty())
+  {
+    return eval_function(program.GetEquation());
+  }
+
+  ModelExprData<DoubleType> out(data_ref);
+
+  ModelExprDataCachePtr<DoubleType> cache = const_cast<Region *>(data_ref)->GetModelExprDataCache<DoubleType>();
+  if (!cache)
+  {
+    cache = ModelExprDataCachePtr<DoubleType>(new ModelExprDataCache<DoubleType>()); 
+    const_cast<Region *>(data_ref)->SetModelExprDataCache(cache);
+  }
+
+  if (cache->GetEntry(program.GetKey(), out))
+  {
+    return out;
+  }
+
+  const size_t nerrors = errors.size();
+  if (program.Run(*this, data_ref, *cache, out) && (errors.size() == nerrors))
+  {
+    cache->SetEntry(program.GetKey(), out);
+  }
+  else
+  {
+    //// the interpreter reports what went wrong
+    while (errors.size() > nerrors)
+    {
+      errors.pop_back();
+    }
+    out = eval_function(program.GetEquation());
+  }
+
+  return out;
+}
+
 namespace {
 /// need to do a bunch of checks to find out what we are dealing with data-wise
 template <typename DoubleType>
@@ -23,16 +23,38 @@ limitations under the License.
 #include <string>
 #include <list>
 #include <vector>
+#include <memory>
 class Region;
 typedef Region *RegionPtr;
+class CircuitNode;
 
 
 #include "ModelExprData.hh"
 
 namespace MEE {
 
+template <typename DoubleType> class ModelExprProgram;
+
 enum class ExpectedType {UNKNOWN = 0, NODE, EDGE, TRIANGLEEDGE, TETRAHEDRONEDGE};
 
+//// Where the value of a parameter or circuit node variable comes from.
+//// It is resolved once for a region and reused until GlobalData reports a
+//// change in the parameters, material db or circuit nodes.
+struct VariableBinding {
+  enum class Kind {UNBOUND, VALUE, CIRCUIT};
+
+  VariableBinding() : kind(Kind::UNBOUND), region(NULL), version(0), value(0.0), solution(NULL) {}
+
+  Kind                          kind;
+  const Region                 *region;
+  size_t                        version;
+  /// parameter value
+  double                        value;
+  /// circuit solution and node, the value is read on every use
+  const std::vector<double>    *solution;
+  std::shared_ptr<CircuitNode>  node;
+};
+
 template <typename DoubleType>
 class ModelExprEval {
     public:
@@ -46,6 +68,10 @@ class ModelExprEval {
         ~ModelExprEval();
 
         ModelExprData<DoubleType> eval_function(Eqo::EqObjPtr);
+        /// Runs the compiled program, falling back to eval_function when it cannot be used
+        ModelExprData<DoubleType> eval_program(ModelExprProgram<DoubleType> &);
+        /// Evaluates a variable, resolving it again when the binding is out of date
+        ModelExprData<DoubleType> EvaluateVariable(Eqo::EqObjPtr, VariableBinding &);
     private:
         ModelExprData<DoubleType> EvaluateAddType(Eqo::EqObjPtr);
         ModelExprData<DoubleType> EvaluateProductType(Eqo::EqObjPtr);
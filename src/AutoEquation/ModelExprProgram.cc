@@ -0,0 +1,773 @@
+/***
+DEVSIM
+Copyright 2013 Devsim LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+***/
+
+#include "ModelExprProgram.hh"
+#include "ModelExprEval.hh"
+#include "SharedExprCache.hh"
+#include "Region.hh"
+#include "NodeScalarData.hh"
+#include "EdgeScalarData.hh"
+#include "TriangleEdgeScalarData.hh"
+#include "TetrahedronEdgeScalarData.hh"
+#include "ObjectCache.hh"
+#include "ParallelOpEqual.hh"
+#include "MathEval.hh"
+#include "MathWrapper.hh"
+#include "FPECheck.hh"
+#include "dsAssert.hh"
+
+#include "EngineAPI.hh"
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <utility>
+
+namespace MEE {
+
+template <typename DoubleType>
+const size_t ModelExprProgram<DoubleType>::chunk_size;
+
+template <typename DoubleType>
+const size_t ModelExprProgram<DoubleType>::invalid_index = std::numeric_limits<size_t>::max();
+
+namespace {
+template <typename DoubleType>
+class ProgramRange : public OpEqualRangeTask {
+  public:
+    explicit ProgramRange(const ModelExprProgram<DoubleType> &p) : program_(p) {}
+
+    void operator()(const size_t b, const size_t e) const
+    {
+      program_.EvaluateRange(b, e);
+    }
+
+  private:
+    const ModelExprProgram<DoubleType> &program_;
+};
+
+//// Same order of operations as repeated += or *= in the interpreter
+template <typename DoubleType, typename U>
+void ChainOp(DoubleType *r, const std::vector<DoubleType> &dvals, const std::vector<const DoubleType *> &vptrs, const size_t n, const U &op)
+{
+  if (vptrs[0])
+  {
+    std::copy(vptrs[0], vptrs[0] + n, r);
+  }
+  else
+  {
+    std::fill(r, r + n, dvals[0]);
+  }
+
+  for (size_t j = 1; j < vptrs.size(); ++j)
+  {
+    const DoubleType *v = vptrs[j];
+    if (v)
+    {
+      for (size_t i = 0; i < n; ++i)
+      {
+        op(r[i], v[i]);
+      }
+    }
+    else
+    {
+      const DoubleType d = dvals[j];
+      for (size_t i = 0; i < n; ++i)
+      {
+        op(r[i], d);
+      }
+    }
+  }
+}
+
+template <typename DoubleType>
+ModelExprData<DoubleType> CreateUniformData(datatype t, DoubleType v, size_t len, const Region *rp)
+{
+  ModelExprData<DoubleType> out(rp);
+  if (t == datatype::NODEDATA)
+  {
+    out = ModelExprData<DoubleType>(NodeScalarData<DoubleType>(v, len), rp);
+  }
+  else if (t == datatype::EDGEDATA)
+  {
+    out = ModelExprData<DoubleType>(EdgeScalarData<DoubleType>(v, len), rp);
+  }
+  else if (t == datatype::TRIANGLEEDGEDATA)
+  {
+    out = ModelExprData<DoubleType>(TriangleEdgeScalarData<DoubleType>(v, len), rp);
+  }
+  else if (t == datatype::TETRAHEDRONEDGEDATA)
+  {
+    out = ModelExprData<DoubleType>(TetrahedronEdgeScalarData<DoubleType>(v, len), rp);
+  }
+  else
+  {
+    dsAssert(false, "UNEXPECTED");
+  }
+  return out;
+}
+
+//// An element edge model is substituted by the edge model with the same name
+void AddDependency(const std::string &name, std::vector<std::string> &dependencies)
+{
+  dependencies.push_back(name);
+
+  if (name.size() > 4)
+  {
+    const std::string::size_type rpos = name.size() - 4;
+    if ((name.rfind("@en0") == rpos) || (name.rfind("@en1") == rpos))
+    {
+      std::string alias(name);
+      alias.erase(rpos + 1, 1);
+      dependencies.push_back(alias);
+    }
+  }
+
+  std::sort(dependencies.begin(), dependencies.end());
+}
+}
+
+template <typename DoubleType>
+ModelExprProgram<DoubleType>::ModelExprProgram(Eqo::EqObjPtr eq, RegionPtr rp) : equation_(eq), compiled_(true), eval_(NULL), cache_(NULL), region_(NULL), num_buffers_(0), vtype_(datatype::DOUBLE), vlen_(0)
+{
+  std::map<std::string, size_t> seen;
+  Compile(equation_, seen);
+
+  //// nothing to gain over looking up a single model or value
+  if (instructions_.back().args.empty())
+  {
+    compiled_ = false;
+  }
+
+  if ((!compiled_) || (!rp))
+  {
+    return;
+  }
+
+  shared_ = rp->GetSharedExprCache<DoubleType>();
+  if (!shared_)
+  {
+    shared_ = std::shared_ptr<SharedExprCache<DoubleType> >(new SharedExprCache<DoubleType>());
+    rp->SetSharedExprCache(shared_);
+  }
+
+  for (size_t i = 0; i < instructions_.size(); ++i)
+  {
+    if (!instructions_[i].args.empty())
+    {
+      shared_keys_.push_back(instructions_[i].key);
+    }
+  }
+  shared_->Register(shared_keys_);
+}
+
+template <typename DoubleType>
+ModelExprProgram<DoubleType>::~ModelExprProgram()
+{
+  if (shared_)
+  {
+    shared_->Unregister(shared_keys_);
+  }
+}
+
+template <typename DoubleType>
+size_t ModelExprProgram<DoubleType>::Compile(Eqo::EqObjPtr arg, std::map<std::string, size_t> &seen)
+{
+  const std::string &key = EngineAPI::getStringValue(arg);
+
+  //// identical subexpressions are only evaluated once
+  std::map<std::string, size_t>::const_iterator it = seen.find(key);
+  if (it != seen.end())
+  {
+    return it->second;
+  }
+
+  Instruction ins;
+  ins.op   = OpCode::LEAF;
+  ins.key  = key;
+  ins.expr = arg;
+  ins.val  = 0.0;
+
+  size_t nargs = 0;
+
+  switch (EngineAPI::getEnumeratedType(arg))
+  {
+    case EngineAPI::MODEL_OBJ:
+      break;
+    case EngineAPI::VARIABLE_OBJ:
+      ins.binding = std::shared_ptr<VariableBinding>(new VariableBinding());
+      break;
+    case EngineAPI::CONST_OBJ:
+      ins.op  = OpCode::CONSTANT;
+      ins.val = EngineAPI::getDoubleValue(arg);
+      break;
+    case EngineAPI::ADD_OBJ:
+      ins.op = OpCode::ADD;
+      break;
+    case EngineAPI::PRODUCT_OBJ:
+      ins.op = OpCode::PRODUCT;
+      break;
+    case EngineAPI::IF_OBJ:
+      ins.op = OpCode::IF;
+      nargs = 2;
+      break;
+    case EngineAPI::IFELSE_OBJ:
+      ins.op = OpCode::IFELSE;
+      nargs = 3;
+      break;
+    case EngineAPI::USERFUNC_OBJ:
+    case EngineAPI::EXPONENT_OBJ:
+    case EngineAPI::POW_OBJ:
+    case EngineAPI::LOG_OBJ:
+    case EngineAPI::ULOGICAL_OBJ:
+    case EngineAPI::BLOGICAL_OBJ:
+      ins.op   = OpCode::FUNCTION;
+      ins.name = EngineAPI::getName(arg);
+      //// reductions need every entry of their argument before they can be used
+      if ((ins.name == "vec_sum") || (ins.name == "vec_max") || (ins.name == "vec_min"))
+      {
+        compiled_ = false;
+      }
+      break;
+    default:
+      compiled_ = false;
+      break;
+  }
+
+  if (ins.op == OpCode::LEAF)
+  {
+    AddDependency(ins.key, ins.dependencies);
+  }
+  else if (ins.op != OpCode::CONSTANT)
+  {
+    std::vector<Eqo::EqObjPtr> args = EngineAPI::getArgs(arg);
+    if (args.empty() || (nargs && (nargs != args.size())))
+    {
+      compiled_ = false;
+    }
+
+    ins.args.reserve(args.size());
+    for (size_t i = 0; i < args.size(); ++i)
+    {
+      const size_t index = Compile(args[i], seen);
+      ins.args.push_back(index);
+
+      const std::vector<std::string> &adeps = instructions_[index].dependencies;
+      std::vector<std::string> deps;
+      std::set_union(ins.dependencies.begin(), ins.dependencies.end(), adeps.begin(), adeps.end(), std::back_inserter(deps));
+      ins.dependencies.swap(deps);
+    }
+  }
+
+  const size_t index = instructions_.size();
+  instructions_.push_back(ins);
+  seen[key] = index;
+  return index;
+}
+
+template <typename DoubleType>
+bool ModelExprProgram<DoubleType>::Run(ModelExprEval<DoubleType> &eval, const Region *rp, ObjectCache<ModelExprData<DoubleType> > &cache, ModelExprData<DoubleType> &out)
+{
+  dsAssert(compiled_, "UNEXPECTED");
+
+  eval_   = &eval;
+  cache_  = &cache;
+  region_ = rp;
+  vtype_  = datatype::DOUBLE;
+  vlen_   = 0;
+  num_buffers_ = 0;
+
+  const size_t len = instructions_.size();
+  leaves_.clear();
+  leaves_.resize(len, ModelExprData<DoubleType>(rp));
+  values_.resize(len);
+  linked_.assign(len, 0);
+  steps_.clear();
+  outputs_.clear();
+  stores_.clear();
+
+  FPECheck::ClearFPE();
+
+  const size_t root = len - 1;
+  bool ok = Link(root) && !FPECheck::CheckFPE();
+
+  if (ok)
+  {
+    const Value &result = values_[root];
+    if (result.kind == ValueKind::SCALAR)
+    {
+      out = ModelExprData<DoubleType>(result.val, rp);
+    }
+    else if (result.kind == ValueKind::UNIFORM)
+    {
+      out = CreateUniformData(vtype_, result.val, vlen_, rp);
+    }
+    else if (result.data)
+    {
+      out = leaves_[result.leaf];
+    }
+    else
+    {
+      outputs_[result.reg].resize(vlen_);
+      for (size_t j = 0; j < stores_.size(); ++j)
+      {
+        outputs_[values_[stores_[j]].reg].resize(vlen_);
+      }
+
+      AssignBuffers();
+
+      ProgramRange<DoubleType> range(*this);
+      ForwardOpEqual task(range);
+      OpEqualRun(task, vlen_);
+
+      if (FPECheck::CheckFPE())
+      {
+        ok = false;
+      }
+      else
+      {
+        std::map<size_t, ModelExprData<DoubleType> > results;
+        for (typename std::map<size_t, std::vector<DoubleType> >::iterator it = outputs_.begin(); it != outputs_.end(); ++it)
+        {
+          results.insert(std::make_pair(it->first, ModelExprData<DoubleType>(vtype_, std::move(it->second), rp)));
+        }
+
+        out = results.find(result.reg)->second;
+
+        for (size_t j = 0; j < stores_.size(); ++j)
+        {
+          const Instruction &ins = instructions_[stores_[j]];
+          shared_->SetEntry(*rp, ins.key, results.find(values_[stores_[j]].reg)->second, ins.dependencies);
+        }
+      }
+    }
+  }
+
+  //// do not hold on to model data between runs
+  leaves_.clear();
+  outputs_.clear();
+  eval_   = NULL;
+  cache_  = NULL;
+  region_ = NULL;
+
+  return ok;
+}
+
+template <typename DoubleType>
+bool ModelExprProgram<DoubleType>::Link(size_t i)
+{
+  if (linked_[i])
+  {
+    return true;
+  }
+  linked_[i] = 1;
+
+  const Instruction &ins = instructions_[i];
+
+  Value &value = values_[i];
+  value.kind = ValueKind::SCALAR;
+  value.val  = 0.0;
+  value.data = NULL;
+  value.leaf = invalid_index;
+  value.reg  = invalid_index;
+
+  if (ins.op == OpCode::CONSTANT)
+  {
+    value.val = ins.val;
+    return true;
+  }
+  else if (ins.binding)
+  {
+    return LinkData(i, eval_->EvaluateVariable(ins.expr, *ins.binding));
+  }
+  else if (ins.op == OpCode::LEAF)
+  {
+    return LinkData(i, eval_->eval_function(ins.expr));
+  }
+
+  //// reuse what other models have already evaluated
+  ModelExprData<DoubleType> cached(region_);
+  if (cache_->GetEntry(ins.key, cached))
+  {
+    return LinkData(i, cached);
+  }
+
+  const bool is_shared = shared_ && shared_->IsShared(ins.key);
+  if (is_shared && shared_->GetEntry(*region_, ins.key, cached))
+  {
+    return LinkData(i, cached);
+  }
+
+  const std::vector<size_t> &args = ins.args;
+  const MathEval<DoubleType> &emath = MathEval<DoubleType>::GetInstance();
+
+  bool ok = true;
+
+  if (ins.op == OpCode::ADD)
+  {
+    for (size_t j = 0; ok && (j < args.size()); ++j)
+    {
+      ok = Link(args[j]);
+    }
+    ok = ok && LinkOperation(i, OpCode::ADD, NULL, args);
+  }
+  else if (ins.op == OpCode::PRODUCT)
+  {
+    //// short circuit multiplication, as in the interpreter
+    std::vector<size_t> factors;
+    factors.reserve(args.size());
+    for (size_t j = 0; ok && (j < args.size()); ++j)
+    {
+      ok = Link(args[j]);
+      factors.push_back(args[j]);
+      if (ok && (values_[args[j]].kind == ValueKind::SCALAR) && (values_[args[j]].val == 0.0))
+      {
+        return true;
+      }
+    }
+    ok = ok && LinkOperation(i, OpCode::PRODUCT, NULL, factors);
+  }
+  else if (ins.op == OpCode::IF)
+  {
+    ok = Link(args[0]);
+    if (!ok)
+    {
+    }
+    else if (values_[args[0]].kind == ValueKind::SCALAR)
+    {
+      if (values_[args[0]].val != 0.0)
+      {
+        ok = Link(args[1]);
+        values_[i] = values_[args[1]];
+      }
+    }
+    else
+    {
+      //// Assume we are getting an array of 1's and zeros
+      ok = Link(args[1]) && LinkOperation(i, OpCode::PRODUCT, NULL, args);
+    }
+  }
+  else if (ins.op == OpCode::IFELSE)
+  {
+    ok = Link(args[0]);
+    if (!ok)
+    {
+    }
+    else if (values_[args[0]].kind == ValueKind::SCALAR)
+    {
+      const size_t branch = (values_[args[0]].val != 0.0) ? args[1] : args[2];
+      ok = Link(branch);
+      values_[i] = values_[branch];
+    }
+    else
+    {
+      const Eqomfp::MathWrapper<DoubleType> *func = emath.GetMathWrapper("ifelse");
+      ok = func && Link(args[1]) && Link(args[2]) && LinkOperation(i, OpCode::FUNCTION, func, args);
+    }
+  }
+  else if (ins.op == OpCode::FUNCTION)
+  {
+    const Eqomfp::MathWrapper<DoubleType> *func = emath.GetMathWrapper(ins.name);
+    ok = func && (func->GetNumberArguments() == args.size());
+    for (size_t j = 0; ok && (j < args.size()); ++j)
+    {
+      ok = Link(args[j]);
+    }
+    ok = ok && LinkOperation(i, OpCode::FUNCTION, func, args);
+  }
+  else
+  {
+    ok = false;
+  }
+
+  //// written out in full, so the other models can use it
+  if (ok && is_shared && (values_[i].kind == ValueKind::VECTOR) && (!values_[i].data))
+  {
+    stores_.push_back(i);
+  }
+
+  return ok;
+}
+
+template <typename DoubleType>
+bool ModelExprProgram<DoubleType>::LinkData(size_t i, const ModelExprData<DoubleType> &data)
+{
+  Value &value = values_[i];
+
+  const datatype t = data.GetType();
+  if (t == datatype::DOUBLE)
+  {
+    value.val = data.GetDoubleValue();
+    return true;
+  }
+  else if (t == datatype::INVALID)
+  {
+    return false;
+  }
+
+  const ScalarValuesType<DoubleType> &svals = data.GetScalarValues();
+
+  //// converting edge data to element edge data is left to the interpreter
+  if (vtype_ == datatype::DOUBLE)
+  {
+    vtype_ = t;
+    vlen_  = svals.GetLength();
+  }
+  else if ((vtype_ != t) || (vlen_ != svals.GetLength()))
+  {
+    return false;
+  }
+
+  //// keeps data which is not owned by a model alive
+  leaves_[i] = data;
+  value.leaf = i;
+
+  if (svals.IsUniform())
+  {
+    value.kind = ValueKind::UNIFORM;
+    value.val  = svals.GetScalar();
+  }
+  else
+  {
+    value.kind = ValueKind::VECTOR;
+    value.data = svals.GetVector().data();
+  }
+
+  return true;
+}
+
+template <typename DoubleType>
+bool ModelExprProgram<DoubleType>::LinkOperation(size_t i, OpCode op, const Eqomfp::MathWrapper<DoubleType> *func, const std::vector<size_t> &args)
+{
+  bool has_vector = false;
+  bool all_scalar = true;
+  for (size_t j = 0; j < args.size(); ++j)
+  {
+    const ValueKind kind = values_[args[j]].kind;
+    if (kind == ValueKind::VECTOR)
+    {
+      has_vector = true;
+    }
+    if (kind != ValueKind::SCALAR)
+    {
+      all_scalar = false;
+    }
+  }
+
+  Value &value = values_[i];
+
+  if (has_vector)
+  {
+    Step step;
+    step.op     = op;
+    step.func   = func;
+    step.reg    = i;
+    step.buffer = invalid_index;
+    step.output = NULL;
+    step.regs   = args;
+    steps_.push_back(step);
+
+    value.kind = ValueKind::VECTOR;
+    value.reg  = i;
+    return true;
+  }
+
+  value.kind = all_scalar ? ValueKind::SCALAR : ValueKind::UNIFORM;
+
+  if (op == OpCode::ADD)
+  {
+    DoubleType v = values_[args[0]].val;
+    for (size_t j = 1; j < args.size(); ++j)
+    {
+      v += values_[args[j]].val;
+    }
+    value.val = v;
+  }
+  else if (op == OpCode::PRODUCT)
+  {
+    DoubleType v = 1.0;
+    for (size_t j = 0; j < args.size(); ++j)
+    {
+      v *= values_[args[j]].val;
+    }
+    value.val = v;
+  }
+  else
+  {
+    std::vector<DoubleType> vals(args.size());
+    for (size_t j = 0; j < args.size(); ++j)
+    {
+      vals[j] = values_[args[j]].val;
+    }
+    std::string error;
+    value.val = func->Evaluate(vals, error);
+    if (!error.empty())
+    {
+      return false;
+    }
+  }
+
+  //// later model lookups clear the floating point status
+  return !FPECheck::CheckFPE();
+}
+
+template <typename DoubleType>
+void ModelExprProgram<DoubleType>::AssignBuffers()
+{
+  const size_t len = instructions_.size();
+
+  //// later steps read full length results like any other data
+  for (size_t i = 0; i < len; ++i)
+  {
+    Value &v = values_[i];
+    if (linked_[i] && (v.kind == ValueKind::VECTOR) && (!v.data) && outputs_.count(v.reg))
+    {
+      v.data = outputs_[v.reg].data();
+    }
+  }
+
+  std::vector<size_t> lastuse(len, invalid_index);
+  for (size_t p = 0; p < steps_.size(); ++p)
+  {
+    const std::vector<size_t> &regs = steps_[p].regs;
+    for (size_t j = 0; j < regs.size(); ++j)
+    {
+      const Value &v = values_[regs[j]];
+      if ((v.kind == ValueKind::VECTOR) && (!v.data))
+      {
+        lastuse[v.reg] = p;
+      }
+    }
+  }
+
+  std::vector<size_t> buffers(len, invalid_index);
+  std::vector<size_t> available;
+  num_buffers_ = 0;
+
+  for (size_t p = 0; p < steps_.size(); ++p)
+  {
+    Step &step = steps_[p];
+
+    step.buffer = invalid_index;
+    step.output = NULL;
+
+    typename std::map<size_t, std::vector<DoubleType> >::iterator oit = outputs_.find(step.reg);
+    if (oit != outputs_.end())
+    {
+      step.output = oit->second.data();
+    }
+    else if (!available.empty())
+    {
+      step.buffer = available.back();
+      available.pop_back();
+    }
+    else
+    {
+      step.buffer = num_buffers_++;
+    }
+    buffers[step.reg] = step.buffer;
+
+    step.args.resize(step.regs.size());
+    for (size_t j = 0; j < step.regs.size(); ++j)
+    {
+      const Value &v = values_[step.regs[j]];
+      Operand &o = step.args[j];
+      o.val    = v.val;
+      o.data   = v.data;
+      o.buffer = invalid_index;
+      if ((v.kind == ValueKind::VECTOR) && (!v.data))
+      {
+        o.buffer = buffers[v.reg];
+      }
+    }
+
+    //// released only after the result buffer is chosen, since add and
+    //// multiply read their arguments after writing to the result
+    for (size_t j = 0; j < step.regs.size(); ++j)
+    {
+      const Value &v = values_[step.regs[j]];
+      if ((v.kind == ValueKind::VECTOR) && (!v.data) && (lastuse[v.reg] == p))
+      {
+        available.push_back(buffers[v.reg]);
+        lastuse[v.reg] = invalid_index;
+      }
+    }
+  }
+}
+
+template <typename DoubleType>
+void ModelExprProgram<DoubleType>::EvaluateRange(size_t b, size_t e) const
+{
+  std::vector<DoubleType>         scratch(num_buffers_ * chunk_size);
+  std::vector<DoubleType>         dvals;
+  std::vector<const DoubleType *> vptrs;
+  std::string                     error;
+
+  for (size_t cb = b; cb < e; cb += chunk_size)
+  {
+    const size_t n = std::min(chunk_size, e - cb);
+
+    for (size_t p = 0; p < steps_.size(); ++p)
+    {
+      const Step &step = steps_[p];
+
+      DoubleType *r = (step.output) ? (step.output + cb) : (scratch.data() + step.buffer * chunk_size);
+
+      const size_t nargs = step.args.size();
+      dvals.resize(nargs);
+      vptrs.resize(nargs);
+      for (size_t j = 0; j < nargs; ++j)
+      {
+        const Operand &o = step.args[j];
+        dvals[j] = o.val;
+        if (o.buffer != invalid_index)
+        {
+          vptrs[j] = scratch.data() + o.buffer * chunk_size;
+        }
+        else if (o.data)
+        {
+          vptrs[j] = o.data + cb;
+        }
+        else
+        {
+          vptrs[j] = NULL;
+        }
+      }
+
+      if (step.op == OpCode::ADD)
+      {
+        ChainOp(r, dvals, vptrs, n, ScalarDataHelper::plus_equal<DoubleType>());
+      }
+      else if (step.op == OpCode::PRODUCT)
+      {
+        ChainOp(r, dvals, vptrs, n, ScalarDataHelper::times_equal<DoubleType>());
+      }
+      else
+      {
+        step.func->Evaluate(dvals, vptrs, error, r, n);
+      }
+    }
+  }
+}
+
+template class ModelExprProgram<double>;
+#ifdef DEVSIM_EXTENDED_PRECISION
+#include "Float128.hh"
+template class ModelExprProgram<float128>;
+#endif
+}
+
@@ -0,0 +1,175 @@
+/***
+DEVSIM
+Copyright 2013 Devsim LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+***/
+
+#ifndef MODEL_EXPR_PROGRAM_HH
+#define MODEL_EXPR_PROGRAM_HH
+#include "ModelExprData.hh"
+
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <cstddef>
+
+class Region;
+typedef Region *RegionPtr;
+
+namespace Eqomfp {
+template <typename DoubleType> class MathWrapper;
+}
+
+template <typename T> class ObjectCache;
+
+namespace MEE {
+template <typename DoubleType> class ModelExprEval;
+template <typename DoubleType> class SharedExprCache;
+struct VariableBinding;
+
+//// A model expression lowered once into a flat list of instructions, where
+//// the arguments of an instruction always come before it.
+////
+//// Every time the program is run, the leaves (models, parameters and
+//// constants) are looked up and everything which only depends on uniform
+//// values is folded.  Parameters and circuit nodes keep where their value
+//// was found, so they are only looked up by name again after a change.
+//// The remaining vector operations are applied in chunks of entries, so
+//// intermediate results live in small scratch buffers instead of full
+//// length ModelExprData temporaries.
+////
+//// Interior subexpressions are registered with the SharedExprCache of the
+//// region.  The ones also used by other models are written out in full and
+//// kept there, so they are only evaluated once per update.  Without a
+//// region, e.g. for contact models, nothing is registered.
+////
+//// Run returns false whenever the interpreter in ModelExprEval has to take
+//// over, e.g. when the leaves mix different kinds of data, a function is
+//// only available from the scripting language, or an error occurs.
+template <typename DoubleType>
+class ModelExprProgram {
+  public:
+    /// the region may be NULL
+    ModelExprProgram(Eqo::EqObjPtr, RegionPtr);
+
+    ~ModelExprProgram();
+
+    /// false if the expression can only be interpreted
+    bool IsCompiled() const
+    {
+      return compiled_;
+    }
+
+    Eqo::EqObjPtr GetEquation() const
+    {
+      return equation_;
+    }
+
+    /// The string value of the equation, for cache lookups
+    const std::string &GetKey() const
+    {
+      return instructions_.back().key;
+    }
+
+    bool Run(ModelExprEval<DoubleType> &, const Region *, ObjectCache<ModelExprData<DoubleType> > &, ModelExprData<DoubleType> &);
+
+    /// Called on different ranges from several threads
+    void EvaluateRange(size_t, size_t) const;
+
+    static const size_t chunk_size = 1024;
+
+  private:
+    ModelExprProgram();
+    ModelExprProgram(const ModelExprProgram &);
+    ModelExprProgram &operator=(const ModelExprProgram &);
+
+    enum class OpCode {LEAF, CONSTANT, ADD, PRODUCT, IF, IFELSE, FUNCTION};
+
+    struct Instruction {
+      OpCode              op;
+      std::string         key;
+      std::string         name;
+      Eqo::EqObjPtr       expr;
+      DoubleType          val;
+      std::vector<size_t> args;
+      /// models and parameters the result depends on
+      std::vector<std::string> dependencies;
+      /// set for parameter and circuit node leaves
+      std::shared_ptr<VariableBinding> binding;
+    };
+
+    enum class ValueKind {SCALAR, UNIFORM, VECTOR};
+
+    /// VECTOR values either come from a leaf, or are computed by a step into a buffer.
+    /// Results written out in full are treated as data by later steps.
+    struct Value {
+      ValueKind         kind;
+      DoubleType        val;
+      const DoubleType *data;
+      size_t            leaf;
+      size_t            reg;
+    };
+
+    /// A vector argument is taken from a buffer, from data, or is the scalar val
+    struct Operand {
+      DoubleType        val;
+      const DoubleType *data;
+      size_t            buffer;
+    };
+
+    struct Step {
+      OpCode                                 op;
+      const Eqomfp::MathWrapper<DoubleType> *func;
+      size_t                                 reg;
+      size_t                                 buffer;
+      DoubleType                            *output;
+      std::vector<size_t>                    regs;
+      std::vector<Operand>                   args;
+    };
+
+    size_t Compile(Eqo::EqObjPtr, std::map<std::string, size_t> &);
+
+    bool Link(size_t);
+    bool LinkData(size_t, const ModelExprData<DoubleType> &);
+    bool LinkOperation(size_t, OpCode, const Eqomfp::MathWrapper<DoubleType> *, const std::vector<size_t> &);
+    void AssignBuffers();
+
+    static const size_t invalid_index;
+
+    Eqo::EqObjPtr                                 equation_;
+    std::vector<Instruction>                      instructions_;
+    bool                                          compiled_;
+    std::shared_ptr<SharedExprCache<DoubleType> > shared_;
+    std::vector<std::string>                      shared_keys_;
+
+    //// state of the current run
+    ModelExprEval<DoubleType>                   *eval_;
+    ObjectCache<ModelExprData<DoubleType> >     *cache_;
+    const Region                                *region_;
+    std::vector<ModelExprData<DoubleType> >      leaves_;
+    std::vector<Value>                           values_;
+    std::vector<char>                            linked_;
+    std::vector<Step>                            steps_;
+    /// full length results, indexed by the instruction computing them
+    std::map<size_t, std::vector<DoubleType> >   outputs_;
+    /// shared subexpressions to store once the steps are run
+    std::vector<size_t>                          stores_;
+    size_t                                       num_buffers_;
+    datatype                                     vtype_;
+    size_t                                       vlen_;
+};
+}
+#endif
+
@@ -20,6 +20,7 @@ limitations under the License.
 #include "Node.hh"
 #include "Vector.hh"
 #include "ModelExprEval.hh"
+#include "ModelExprProgram.hh"
 #include "GeometryStream.hh"
 #include "dsAssert.hh"
 
@@ -35,7 +36,7 @@ limitations under the License.
 
 // Must be valid equation object which is passed
 template <typename DoubleType>
-NodeExprModel<DoubleType>::NodeExprModel(const std::string &nm, const Eqo::EqObjPtr eq, RegionPtr rp, NodeModel::DisplayType dt, ContactPtr cp) : NodeModel(nm, rp, dt, cp), equation(eq)
+NodeExprModel<DoubleType>::NodeExprModel(const std::string &nm, const Eqo::EqObjPtr eq, RegionPtr rp, NodeModel::DisplayType dt, ContactPtr cp) : NodeModel(nm, rp, dt, cp), equation(eq), program(new MEE::ModelExprProgram<DoubleType>(eq, cp ? NULL : rp))
 {
 #if 0
     os << "creating NodeExprModel " << nm << " with equation " << eq << "\n";
@@ -93,7 +94,7 @@ void NodeExprModel<DoubleType>::calcNodeScalarValues() const
     typename MEE::ModelExprEval<DoubleType>::error_t errors;
     const Region *rp = &(this->GetRegion());
     MEE::ModelExprEval<DoubleType> mexp(rp, GetName(), errors);
-    MEE::ModelExprData<DoubleType> out = mexp.eval_function(equation);
+    MEE::ModelExprData<DoubleType> out = mexp.eval_program(*program);
 
     if (!errors.empty())
     {
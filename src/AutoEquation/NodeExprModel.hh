@@ -26,6 +26,10 @@ namespace Eqo {
 
 }
 
+namespace MEE {
+template <typename DoubleType> class ModelExprProgram;
+}
+
 NodeModelPtr CreateNodeExprModel(const std::string &, Eqo::EqObjPtr, RegionPtr, NodeModel::DisplayType, ContactPtr cp);
 
 template <typename DoubleType>
@@ -46,6 +50,8 @@ class NodeExprModel : public NodeModel
         void calcNodeScalarValues() const;
         void setInitialValues();
         const Eqo::EqObjPtr      equation;
+        /// compiled once from the equation
+        std::shared_ptr<MEE::ModelExprProgram<DoubleType> > program;
 };
 
 #endif
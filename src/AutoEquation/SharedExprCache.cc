@@ -0,0 +1,106 @@
+/***
+DEVSIM
+Copyright 2013 Devsim LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+***/
+
+#include "SharedExprCache.hh"
+#include "Region.hh"
+
+namespace MEE {
+template <typename DoubleType>
+void SharedExprCache<DoubleType>::Register(const std::vector<std::string> &keys)
+{
+  for (std::vector<std::string>::const_iterator it = keys.begin(); it != keys.end(); ++it)
+  {
+    ++users_[*it];
+  }
+}
+
+template <typename DoubleType>
+void SharedExprCache<DoubleType>::Unregister(const std::vector<std::string> &keys)
+{
+  for (std::vector<std::string>::const_iterator it = keys.begin(); it != keys.end(); ++it)
+  {
+    std::map<std::string, size_t>::iterator uit = users_.find(*it);
+    if (uit == users_.end())
+    {
+      continue;
+    }
+
+    size_t &count = uit->second;
+    --count;
+
+    if (count < 2)
+    {
+      entries_.erase(*it);
+    }
+
+    if (count == 0)
+    {
+      users_.erase(uit);
+    }
+  }
+}
+
+template <typename DoubleType>
+bool SharedExprCache<DoubleType>::IsShared(const std::string &key) const
+{
+  std::map<std::string, size_t>::const_iterator it = users_.find(key);
+  return (it != users_.end()) && (it->second > 1);
+}
+
+template <typename DoubleType>
+bool SharedExprCache<DoubleType>::GetEntry(const Region &region, const std::string &key, ModelExprData<DoubleType> &out)
+{
+  typename std::map<std::string, Entry>::iterator it = entries_.find(key);
+  if (it == entries_.end())
+  {
+    return false;
+  }
+
+  const std::vector<std::pair<std::string, size_t> > &signals = it->second.signals;
+  for (size_t i = 0; i < signals.size(); ++i)
+  {
+    if (region.GetSignalCount(signals[i].first) != signals[i].second)
+    {
+      //// do not hold on to stale data
+      entries_.erase(it);
+      return false;
+    }
+  }
+
+  out = it->second.data;
+  return true;
+}
+
+template <typename DoubleType>
+void SharedExprCache<DoubleType>::SetEntry(const Region &region, const std::string &key, const ModelExprData<DoubleType> &data, const std::vector<std::string> &dependencies)
+{
+  Entry &entry = entries_[key];
+  entry.data = data;
+  entry.signals.resize(dependencies.size());
+  for (size_t i = 0; i < dependencies.size(); ++i)
+  {
+    entry.signals[i] = std::make_pair(dependencies[i], region.GetSignalCount(dependencies[i]));
+  }
+}
+
+template class SharedExprCache<double>;
+#ifdef DEVSIM_EXTENDED_PRECISION
+#include "Float128.hh"
+template class SharedExprCache<float128>;
+#endif
+}
+
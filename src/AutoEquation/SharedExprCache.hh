@@ -0,0 +1,69 @@
+/***
+DEVSIM
+Copyright 2013 Devsim LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+***/
+
+#ifndef SHARED_EXPR_CACHE_HH
+#define SHARED_EXPR_CACHE_HH
+#include "ModelExprData.hh"
+
+#include <string>
+#include <vector>
+#include <map>
+#include <utility>
+#include <cstddef>
+
+class Region;
+
+namespace MEE {
+//// Subexpressions appearing in more than one expression model of a region.
+////
+//// Every compiled model expression registers its interior subexpressions,
+//// keyed by their string value.  Results of the keys used by at least two
+//// models are kept between evaluations, so that terms like B(vdiff) are
+//// calculated once for the currents and all of their derivatives.
+////
+//// An entry remembers how many times callbacks were signaled on the region
+//// for each model and parameter it depends on, and it is discarded as soon
+//// as one of them changes.
+template <typename DoubleType>
+class SharedExprCache {
+  public:
+    SharedExprCache() {}
+
+    void Register(const std::vector<std::string> &);
+    void Unregister(const std::vector<std::string> &);
+
+    /// true if more than one model uses the subexpression
+    bool IsShared(const std::string &) const;
+
+    bool GetEntry(const Region &, const std::string &, ModelExprData<DoubleType> &);
+    void SetEntry(const Region &, const std::string &, const ModelExprData<DoubleType> &, const std::vector<std::string> &);
+
+  private:
+    SharedExprCache(const SharedExprCache &);
+    SharedExprCache &operator=(const SharedExprCache &);
+
+    struct Entry {
+      ModelExprData<DoubleType>                  data;
+      std::vector<std::pair<std::string, size_t> > signals;
+    };
+
+    std::map<std::string, size_t> users_;
+    std::map<std::string, Entry>  entries_;
+};
+}
+#endif
+
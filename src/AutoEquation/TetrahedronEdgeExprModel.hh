@@ -26,6 +26,10 @@ namespace Eqo {
 
 }
 
+namespace MEE {
+template <typename DoubleType> class ModelExprProgram;
+}
+
 TetrahedronEdgeModelPtr CreateTetrahedronEdgeExprModel(const std::string &, Eqo::EqObjPtr, RegionPtr, TetrahedronEdgeModel::DisplayType);
 
 template <typename DoubleType>
@@ -44,6 +48,8 @@ class TetrahedronEdgeExprModel : public TetrahedronEdgeModel
         void calcTetrahedronEdgeScalarValues() const;
 
         const Eqo::EqObjPtr      equation;
+        /// compiled once from the equation
+        std::shared_ptr<MEE::ModelExprProgram<DoubleType> > program;
 };
 
 #endif
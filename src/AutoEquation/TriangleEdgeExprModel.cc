@@ -20,6 +20,7 @@ limitations under the License.
 #include "Edge.hh"
 #include "Vector.hh"
 #include "ModelExprEval.hh"
+#include "ModelExprProgram.hh"
 #include "GeometryStream.hh"
 #include "dsAssert.hh"
 #include "EngineAPI.hh"
@@ -30,7 +31,7 @@ limitations under the License.
 
 // Must be valid equation object which is passed
 template <typename DoubleType>
-TriangleEdgeExprModel<DoubleType>::TriangleEdgeExprModel(const std::string &nm, const Eqo::EqObjPtr eq, RegionPtr rp, TriangleEdgeModel::DisplayType dt) : TriangleEdgeModel(nm, rp, dt), equation(eq)
+TriangleEdgeExprModel<DoubleType>::TriangleEdgeExprModel(const std::string &nm, const Eqo::EqObjPtr eq, RegionPtr rp, TriangleEdgeModel::DisplayType dt) : TriangleEdgeModel(nm, rp, dt), equation(eq), program(new MEE::ModelExprProgram<DoubleType>(eq, rp))
 {
 #if 0
   os << "creating TriangleEdgeExprModel " << nm << " with equation " << eq << "\n";
@@ -87,7 +88,7 @@ void TriangleEdgeExprModel<DoubleType>::calcTriangleEdgeScalarValues() const
     typename MEE::ModelExprEval<DoubleType>::error_t errors;
     const Region *rp = &(this->GetRegion());
     MEE::ModelExprEval<DoubleType> mexp(rp, GetName(), errors);
-    MEE::ModelExprData<DoubleType> out = mexp.eval_function(equation);
+    MEE::ModelExprData<DoubleType> out = mexp.eval_program(*program);
 
     if (!errors.empty())
     {
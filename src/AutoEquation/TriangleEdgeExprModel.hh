@@ -26,6 +26,10 @@ namespace Eqo {
 
 }
 
+namespace MEE {
+template <typename DoubleType> class ModelExprProgram;
+}
+
 TriangleEdgeModelPtr CreateTriangleEdgeExprModel(const std::string &, Eqo::EqObjPtr, RegionPtr, TriangleEdgeModel::DisplayType);
 
 template <typename DoubleType>
@@ -46,6 +50,8 @@ class TriangleEdgeExprModel : public TriangleEdgeModel
         void calcTriangleEdgeScalarValues() const;
 
         const Eqo::EqObjPtr      equation;
+        /// compiled once from the equation
+        std::shared_ptr<MEE::ModelExprProgram<DoubleType> > program;
 };
 
 #endif
@@ -87,6 +87,7 @@ CircuitNodePtr NodeKeeper::AddNode(const std::string & name, CircuitNodeType nt,
 */
         CircuitNodePtr node=CircuitNodePtr(new CircuitNode(nt, ut));
         NodeTable_[name]=node;
+        GlobalData::GetInstance().SignalDBChange();
     }
     return NodeTable_[name];
 }
@@ -110,6 +111,7 @@ CircuitNodePtr NodeKeeper::AddNodeAlias(const std::string &alias, const std::str
     }
 
     NodeAliasTable_[alias] = name;
+    GlobalData::GetInstance().SignalDBChange();
     return nname->second;
 }
 
@@ -135,6 +137,7 @@ void NodeKeeper::DeleteNode(const std::string & name)
         os << name << " is being deleted\n";
         OutputStream::WriteOut(OutputStream::OutputType::INFO, os.str());
         NodeTable_.erase(name);
+        GlobalData::GetInstance().SignalDBChange();
     }
     else
     {
@@ -203,7 +206,7 @@ size_t NodeKeeper::GetMinEquationNumber()
     return minEquationNumber;
 }
 
-size_t NodeKeeper::GetIndexNumber(const std::string &name)
+CircuitNodePtr NodeKeeper::FindNode(const std::string &name)
 {
     std::string node = name;
     if (NodeAliasTable_.count(name))
@@ -211,12 +214,25 @@ size_t NodeKeeper::GetIndexNumber(const std::string &name)
         node = NodeAliasTable_[name];
     }
 
+    CircuitNodePtr ret;
+
     NodeTable_t::iterator it = NodeTable_.find(node);
+    if (it != NodeTable_.end())
+    {
+        ret = it->second;
+    }
+
+    return ret;
+}
+
+size_t NodeKeeper::GetIndexNumber(const std::string &name)
+{
+    CircuitNodePtr cnp = FindNode(name);
     size_t index = size_t(-1);
 
-    if (it != NodeTable_.end())
+    if (cnp)
     {
-        CircuitNode &cn = *(it->second);
+        CircuitNode &cn = *cnp;
         index = cn.GetNumber();
     }
 
@@ -268,6 +284,7 @@ void NodeKeeper::CreateSolution(const std::string &key)
     // migrate to smart pointer
     // Should call initializer for each node (dc case only)
     Sol_[key] = new Solution(numberOfNodes_,0.0);
+    GlobalData::GetInstance().SignalDBChange();
     std::ostringstream os;
     os << "creating solution " << key << " with " << numberOfNodes_ << " nodes" << "\n";
     OutputStream::WriteOut(OutputStream::OutputType::INFO, os.str());
@@ -291,6 +308,7 @@ void NodeKeeper::DestroySolution(const std::string &key)
 
     delete Sol_[key];
     Sol_.erase(key);
+    GlobalData::GetInstance().SignalDBChange();
 }
 
 // For now assume update can be of any value,  In the future
@@ -93,6 +93,9 @@ class NodeKeeper {
 
         size_t getNumberNodes() {return numberOfNodes_;}
 
+        //// The node, or its alias, NULL if it does not exist
+        CircuitNodePtr FindNode(const std::string &);
+
         //// 0 based
         size_t GetIndexNumber(const std::string &);
         //// 0 based on min equation number
@@ -29,7 +29,7 @@ limitations under the License.
 
 GlobalData *GlobalData::instance = 0;
 
-GlobalData::GlobalData()
+GlobalData::GlobalData() : dbVersion(0)
 {
   InitializeParameters();
 }
@@ -67,6 +67,7 @@ void GlobalData::AddDevice(DevicePtr dp)
     const std::string &nm = dp->GetName();
     dsAssert(deviceList.count(nm) == 0, "UNEXPECTED");
     deviceList[nm]=dp;
+    SignalDBChange();
 }
 
 DevicePtr GlobalData::GetDevice(const std::string &nm)
@@ -83,6 +84,7 @@ DevicePtr GlobalData::GetDevice(const std::string &nm)
 void GlobalData::AddDBEntryOnDevice(const std::string &device, const std::string &name, ObjectHolder value)
 {
     deviceData[device][name] = value;
+    SignalDBChange();
 
     SignalCallbacksOnDevice(device, name);
 }
@@ -90,6 +92,7 @@ void GlobalData::AddDBEntryOnDevice(const std::string &device, const std::string
 void GlobalData::AddDBEntryOnRegion(const std::string &device, const std::string &region, const std::string &name, ObjectHolder value)
 {
     regionData[device][region][name] = value;
+    SignalDBChange();
     SignalCallbacksOnRegion(device, region, name);
 }
 
@@ -104,6 +107,7 @@ void GlobalData::AddDBEntryOnRegion(const Region *rp, const std::string &name, O
 void GlobalData::AddDBEntryOnGlobal(const std::string &name, ObjectHolder value)
 {
     globalData[name] = value;
+    SignalDBChange();
     SignalCallbacksOnGlobal(name);
 }
 
@@ -92,6 +92,19 @@ class GlobalData
         typedef std::map<std::string, std::string> TclEquationList_t;
 
         const TclEquationList_t &GetTclEquationList();
+
+        //// Changes whenever a parameter, material db entry, region material
+        //// or circuit node is added or changed, so that model evaluation can
+        //// reuse the variables it has resolved until then
+        size_t GetDBVersion() const
+        {
+            return dbVersion;
+        }
+
+        void SignalDBChange()
+        {
+            ++dbVersion;
+        }
         
 
     private:
@@ -112,6 +125,8 @@ class GlobalData
         TclEquationList_t tclEquationList;
 
         void             *tclInterp;
+
+        size_t            dbVersion;
 };
 #endif
 
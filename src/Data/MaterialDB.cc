@@ -44,6 +44,7 @@ void MaterialDB::ClearEntries()
     }
   }
   materialData.clear();
+  ginst.SignalDBChange();
 }
 
 bool MaterialDB::OpenDB(const std::string &nm, OpenType_t ot, std::string &errorString)
@@ -222,6 +223,8 @@ MaterialDB::DoubleDBEntry_t MaterialDB::GetDoubleDBEntry(const std::string &mate
 
 void MaterialDB::AddDBEntry(const std::string &material_name, const std::string &parameter_name, const MaterialDBEntry &dbentry)
 {
+  GlobalData::GetInstance().SignalDBChange();
+
   //// if this has never been a material parameter, then we don't need to signal a callback on it
   if (materialData.count(material_name) && materialData[material_name].count(parameter_name))
   {
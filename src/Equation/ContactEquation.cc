@@ -37,28 +37,12 @@ limitations under the License.
 #include "dsAssert.hh"
 #include "EdgeData.hh"
 #include "EquationErrors.hh"
+#include "ParallelAssemble.hh"
 
 #include <algorithm>
 #include <sstream>
 #include <string>
 
-namespace {
-//// TODO: inefficient since linear search of same list over and over again
-bool bothNodesOnContact(const ConstNodeList_t &cnodes, const Edge &edge)
-{
-  bool ret = false;
-  if (
-    (std::find(cnodes.begin(), cnodes.end(), edge.GetHead()) != cnodes.end())
-      &&
-    (std::find(cnodes.begin(), cnodes.end(), edge.GetTail()) != cnodes.end())
-  )
-  {
-    ret = true;
-  }
-  return ret;
-}
-}
-
 template <typename DoubleType>
 const std::string &ContactEquation<DoubleType>::GetContactName() const
 {
@@ -81,7 +65,7 @@ void ContactEquation<DoubleType>::UpdateContact()
 template <typename DoubleType>
 ContactEquation<DoubleType>::ContactEquation(const std::string &nm, const std::string &var,
         ContactPtr cp, RegionPtr rp)
-    : myname(nm), variable(var), mycontact(cp), myregion(rp), charge(0.0), current(0.0)
+    : myname(nm), variable(var), mycontact(cp), myregion(rp), charge(0.0), current(0.0), activeNodesVersion(size_t(-1))
 {
     ContactEquationHolder tmp(this);
     cp->AddEquation(tmp);
@@ -92,7 +76,7 @@ ContactEquation<DoubleType>::ContactEquation(const std::string &nm, const std::s
 /////
 ///// TODO: regress this case for two equations of the same name from two different contacts in the same region
 template <typename DoubleType>
-ConstNodeList_t ContactEquation<DoubleType>::GetActiveNodes() const
+void ContactEquation<DoubleType>::FindActiveNodes() const
 {
   ConstNodeList_t ret;
 
@@ -168,7 +152,41 @@ ConstNodeList_t ContactEquation<DoubleType>::GetActiveNodes() const
       ret.push_back(*it);
     }
   }
-  return ret;
+
+  activeNodes.swap(ret);
+  activeNodeIndexes.resize(activeNodes.size());
+  activeNodeFlags.assign(region.GetNumberNodes(), 0);
+  for (size_t i = 0; i < activeNodes.size(); ++i)
+  {
+    const size_t nindex = activeNodes[i]->GetIndex();
+    activeNodeIndexes[i] = nindex;
+    activeNodeFlags[nindex] = 1;
+  }
+  activeNodesVersion = device.GetBoundaryVersion();
+}
+
+template <typename DoubleType>
+const ConstNodeList_t &ContactEquation<DoubleType>::GetActiveNodes() const
+{
+  if (activeNodesVersion != GetRegion().GetDevice()->GetBoundaryVersion())
+  {
+    FindActiveNodes();
+  }
+  return activeNodes;
+}
+
+template <typename DoubleType>
+const std::vector<size_t> &ContactEquation<DoubleType>::GetActiveNodeIndexes() const
+{
+  GetActiveNodes();
+  return activeNodeIndexes;
+}
+
+//// Only valid after GetActiveNodes
+template <typename DoubleType>
+bool ContactEquation<DoubleType>::BothNodesActive(const Edge &edge) const
+{
+  return activeNodeFlags[edge.GetHead()->GetIndex()] && activeNodeFlags[edge.GetTail()->GetIndex()];
 }
 
 template <typename DoubleType>
@@ -271,7 +289,7 @@ DoubleType ContactEquation<DoubleType>::integrateEdgeModelOverNodes(const std::s
       const ConstEdgeList::const_iterator itend = el.end();
       for ( ; it != itend; ++it)
       {
-        if (bothNodesOnContact(cnodes, **it))
+        if (BothNodesActive(**it))
         {
           continue;
         }
@@ -330,7 +348,7 @@ DoubleType ContactEquation<DoubleType>::integrateTriangleEdgeModelOverNodes(cons
           const Edge &edge = *edgeList[eindex];
           if ((edge.GetHead() == (*cit)) || (edge.GetTail() == (*cit)))
           {
-            if (bothNodesOnContact(cnodes, edge))
+            if (BothNodesActive(edge))
             {
               continue;
             }
@@ -399,7 +417,7 @@ DoubleType ContactEquation<DoubleType>::integrateTetrahedronEdgeModelOverNodes(c
           const Edge &edge = *(edgeDataList[eindex]->edge);
           if ((edge.GetHead() == (*cit)) || (edge.GetTail() == (*cit)))
           {
-            if (bothNodesOnContact(cnodes, edge))
+            if (BothNodesActive(edge))
             {
               continue;
             }
@@ -443,12 +461,34 @@ DoubleType ContactEquation<DoubleType>::integrateElementEdgeModelOverNodes(const
   return ret;
 }
 
+//// The node scalar lists must be evaluated before the entries are filled in
+//// across threads.
+template <typename DoubleType>
+void ContactEquation<DoubleType>::AssembleNodeListRHS(dsMath::RHSEntryVec<DoubleType> &v, size_t eqindex, size_t row, const std::vector<DoubleType> &vals)
+{
+  const std::vector<size_t> &nodes = GetActiveNodeIndexes();
+  const size_t offset = v.size();
+  v.resize(offset + nodes.size());
+  NodeListAssembleRHSTask<DoubleType> task(GetRegion(), eqindex, row, nodes, vals, v.data() + offset);
+  AssembleRun(task, nodes.size());
+}
+
+template <typename DoubleType>
+void ContactEquation<DoubleType>::AssembleNodeListJacobian(dsMath::RealRowColValueVec<DoubleType> &m, size_t eqindex0, size_t row, size_t eqindex1, size_t col, const std::vector<DoubleType> &vals)
+{
+  const std::vector<size_t> &nodes = GetActiveNodeIndexes();
+  const size_t offset = m.size();
+  m.resize(offset + nodes.size());
+  NodeListAssembleJacobianTask<DoubleType> task(GetRegion(), eqindex0, row, eqindex1, col, nodes, vals, m.data() + offset);
+  AssembleRun(task, nodes.size());
+}
+
 template <typename DoubleType>
 void ContactEquation<DoubleType>::AssembleNodeEquation(const std::string &nmodel, dsMath::RealRowColValueVec<DoubleType> &m, dsMath::RHSEntryVec<DoubleType> &v, PermutationMap &p, dsMathEnum::WhatToLoad w, const std::string &node_volume)
 {
   dsAssert(!nmodel.empty(), "UNEXPECTED");
 
-  const ConstNodeList_t cnodes = GetActiveNodes();
+  const ConstNodeList_t &cnodes = GetActiveNodes();
 
   const Region &region = GetRegion();
 
@@ -504,14 +544,7 @@ void ContactEquation<DoubleType>::AssembleNodeEquation(const std::string &nmodel
     NodeScalarData<DoubleType> nsd(*nv);
     nsd.times_equal_model(*nm);
 
-    for (ConstNodeList_t::const_iterator cit = cnodes.begin(); cit != cnodes.end(); ++cit)
-    {
-      const size_t row = region.GetEquationNumber(eqindex, *cit);
-
-      DoubleType rhsval = nsd.GetScalarList()[(*cit)->GetIndex()];
-
-      v.push_back(std::make_pair(row,  rhsval));
-    }
+    AssembleNodeListRHS(v, eqindex, size_t(-1), nsd.GetScalarList());
   }
 
   if ((w == dsMathEnum::WhatToLoad::MATRIXONLY) || (w == dsMathEnum::WhatToLoad::MATRIXANDRHS))
@@ -543,14 +576,7 @@ void ContactEquation<DoubleType>::AssembleNodeEquation(const std::string &nmodel
           dsErrors::MissingEquationIndex(region, myname, var, OutputStream::OutputType::FATAL) ;
         }
 
-        for (ConstNodeList_t::const_iterator cit = cnodes.begin(); cit != cnodes.end(); ++cit)
-        {
-          const size_t row = region.GetEquationNumber(eqindex, *cit);
-          const size_t col = region.GetEquationNumber(eqindex2, (*cit));
-          const DoubleType val = ndd.GetScalarList()[(*cit)->GetIndex()];
-
-          m.push_back(dsMath::RealRowColVal<DoubleType>(row, col, val));
-        }
+        AssembleNodeListJacobian(m, eqindex, size_t(-1), eqindex2, size_t(-1), ndd.GetScalarList());
       }
     }
 
@@ -570,13 +596,7 @@ void ContactEquation<DoubleType>::AssembleNodeEquation(const std::string &nmodel
         NodeScalarData<DoubleType> ndd(*nv);
         ndd.times_equal_model(*ndm);
 
-        for (ConstNodeList_t::const_iterator cit = cnodes.begin(); cit != cnodes.end(); ++cit)
-        {
-          const size_t row = region.GetEquationNumber(eqindex, *cit);
-          const DoubleType val = ndd.GetScalarList()[(*cit)->GetIndex()];
-
-          m.push_back(dsMath::RealRowColVal<DoubleType>(row, ccol, val));
-        }
+        AssembleNodeListJacobian(m, eqindex, size_t(-1), size_t(-1), ccol, ndd.GetScalarList());
       }
     }
   }
@@ -589,7 +609,7 @@ void ContactEquation<DoubleType>::AssembleNodeEquationOnCircuit(const std::strin
   dsAssert(!nmodel.empty(), "UNEXPECTED");
   dsAssert(!circuitnode.empty(), "UNEXPECTED");
 
-  const ConstNodeList_t cnodes = GetActiveNodes();
+  const ConstNodeList_t &cnodes = GetActiveNodes();
   const Region &region = GetRegion();
 
   size_t crow = size_t(-1);
@@ -632,11 +652,7 @@ void ContactEquation<DoubleType>::AssembleNodeEquationOnCircuit(const std::strin
     NodeScalarData<DoubleType> nsd(*nv);
     nsd.times_equal_model(*nm);
 
-    for (ConstNodeList_t::const_iterator cit = cnodes.begin(); cit != cnodes.end(); ++cit)
-    {
-      const DoubleType rhsval = nsd.GetScalarList()[(*cit)->GetIndex()];
-      v.push_back(std::make_pair(crow,  rhsval));
-    }
+    AssembleNodeListRHS(v, size_t(-1), crow, nsd.GetScalarList());
   }
 
   if ((w == dsMathEnum::WhatToLoad::MATRIXONLY) || (w == dsMathEnum::WhatToLoad::MATRIXANDRHS))
@@ -659,21 +675,15 @@ void ContactEquation<DoubleType>::AssembleNodeEquationOnCircuit(const std::strin
       {
         NodeScalarData<DoubleType> ndd(*nv);
         ndd.times_equal_model(*ndm);
-        for (ConstNodeList_t::const_iterator cit = cnodes.begin(); cit != cnodes.end(); ++cit)
-        {
-          const size_t eqindex2 = region.GetEquationIndex(region.GetEquationNameFromVariable(var));
-//          dsAssert(eqindex2 != size_t(-1), "UNEXPECTED");
-          if (eqindex2 == size_t(-1))
-          {
-            dsErrors::MissingEquationIndex(region, myname, var, OutputStream::OutputType::FATAL) ;
-          }
-
-          const size_t col = region.GetEquationNumber(eqindex2, (*cit));
 
-          const DoubleType val = ndd.GetScalarList()[(*cit)->GetIndex()];
-
-          m.push_back(dsMath::RealRowColVal<DoubleType>(crow, col, val));
+        const size_t eqindex2 = region.GetEquationIndex(region.GetEquationNameFromVariable(var));
+//        dsAssert(eqindex2 != size_t(-1), "UNEXPECTED");
+        if ((eqindex2 == size_t(-1)) && (!cnodes.empty()))
+        {
+          dsErrors::MissingEquationIndex(region, myname, var, OutputStream::OutputType::FATAL) ;
         }
+
+        AssembleNodeListJacobian(m, size_t(-1), crow, eqindex2, size_t(-1), ndd.GetScalarList());
       }
     }
 
@@ -690,11 +700,7 @@ void ContactEquation<DoubleType>::AssembleNodeEquationOnCircuit(const std::strin
         NodeScalarData<DoubleType> ndd(*nv);
         ndd.times_equal_model(*ndm);
 
-        for (ConstNodeList_t::const_iterator cit = cnodes.begin(); cit != cnodes.end(); ++cit)
-        {
-          const DoubleType val = ndd.GetScalarList()[(*cit)->GetIndex()];
-          m.push_back(dsMath::RealRowColVal<DoubleType>(crow, crow, val));
-        }
+        AssembleNodeListJacobian(m, size_t(-1), crow, size_t(-1), crow, ndd.GetScalarList());
       }
     }
   }
@@ -705,7 +711,7 @@ void ContactEquation<DoubleType>::AssembleEdgeEquation(const std::string &emodel
 {
   typedef std::vector<std::string> VariableList_t;
 
-  const ConstNodeList_t cnodes = GetActiveNodes();
+  const ConstNodeList_t &cnodes = GetActiveNodes();
   const Region &region = GetRegion();
 
   const size_t eqindex = region.GetEquationIndex(GetName());
@@ -880,7 +886,7 @@ void ContactEquation<DoubleType>::AssembleTriangleEdgeEquation(const std::string
 {
   typedef std::vector<std::string> VariableList_t;
 
-  const ConstNodeList_t cnodes = GetActiveNodes();
+  const ConstNodeList_t &cnodes = GetActiveNodes();
   const Region &region = GetRegion();
 
   const size_t eqindex = region.GetEquationIndex(GetName());
@@ -1103,7 +1109,7 @@ void ContactEquation<DoubleType>::AssembleTetrahedronEdgeEquation(const std::str
 {
   typedef std::vector<std::string> VariableList_t;
 
-  const ConstNodeList_t cnodes = GetActiveNodes();
+  const ConstNodeList_t &cnodes = GetActiveNodes();
   const Region &region = GetRegion();
 
   const size_t eqindex = region.GetEquationIndex(GetName());
@@ -1350,7 +1356,7 @@ void ContactEquation<DoubleType>::AssembleEdgeEquationOnCircuit(const std::strin
   dsAssert(!emodel.empty(), "UNEXPECTED");
   dsAssert(!circuitnode.empty(), "UNEXPECTED");
 
-  const ConstNodeList_t cnodes = GetActiveNodes();
+  const ConstNodeList_t &cnodes = GetActiveNodes();
   const Region &region = GetRegion();
 
   size_t crow = size_t(-1);
@@ -1400,7 +1406,7 @@ void ContactEquation<DoubleType>::AssembleEdgeEquationOnCircuit(const std::strin
       const ConstEdgeList &el = ntelist[(*cit)->GetIndex()];
       for (ConstEdgeList::const_iterator it = el.begin() ; it != el.end(); ++it)
       {
-        if (bothNodesOnContact(cnodes, **it))
+        if (BothNodesActive(**it))
         {
           continue;
         }
@@ -1461,7 +1467,7 @@ void ContactEquation<DoubleType>::AssembleEdgeEquationOnCircuit(const std::strin
           DoubleType val = 0.0;
           for (ConstEdgeList::const_iterator it = el.begin() ; it != el.end(); ++it)
           {
-            if (bothNodesOnContact(cnodes, **it))
+            if (BothNodesActive(**it))
             {
               continue;
             }
@@ -1529,7 +1535,7 @@ void ContactEquation<DoubleType>::AssembleEdgeEquationOnCircuit(const std::strin
 
             for (ConstEdgeList::const_iterator it = el.begin() ; it != el.end(); ++it)
             {
-              if (bothNodesOnContact(cnodes, **it))
+              if (BothNodesActive(**it))
               {
                 continue;
               }
@@ -1565,7 +1571,7 @@ void ContactEquation<DoubleType>::AssembleTriangleEdgeEquationOnCircuit(const st
   dsAssert(!emodel.empty(), "UNEXPECTED");
   dsAssert(!circuitnode.empty(), "UNEXPECTED");
 
-  const ConstNodeList_t cnodes = GetActiveNodes();
+  const ConstNodeList_t &cnodes = GetActiveNodes();
   const Region &region = GetRegion();
 
   size_t crow = size_t(-1);
@@ -1627,7 +1633,7 @@ void ContactEquation<DoubleType>::AssembleTriangleEdgeEquationOnCircuit(const st
           const Edge &edge = *edgeList[eindex];
           if ((edge.GetHead() == (*cit)) || (edge.GetTail() == (*cit)))
           {
-            if (bothNodesOnContact(cnodes, edge))
+            if (BothNodesActive(edge))
             {
               continue;
             }
@@ -1714,7 +1720,7 @@ void ContactEquation<DoubleType>::AssembleTriangleEdgeEquationOnCircuit(const st
                 const Edge &edge = *edgeList[eindex];
                 if ((edge.GetHead() == (*cit)) || (edge.GetTail() == (*cit)))
                 {
-                  if (bothNodesOnContact(cnodes, edge))
+                  if (BothNodesActive(edge))
                   {
                     continue;
                   }
@@ -1796,7 +1802,7 @@ void ContactEquation<DoubleType>::AssembleTriangleEdgeEquationOnCircuit(const st
                 const Edge &edge = *edgeList[eindex];
                 if ((edge.GetHead() == (*cit)) || (edge.GetTail() == (*cit)))
                 {
-                  if (bothNodesOnContact(cnodes, edge))
+                  if (BothNodesActive(edge))
                   {
                     continue;
                   }
@@ -1840,7 +1846,7 @@ void ContactEquation<DoubleType>::AssembleTetrahedronEdgeEquationOnCircuit(const
 
   dsAssert(!circuitnode.empty(), "UNEXPECTED");
 
-  const ConstNodeList_t cnodes = GetActiveNodes();
+  const ConstNodeList_t &cnodes = GetActiveNodes();
   const Region &region = GetRegion();
 
   size_t crow = size_t(-1);
@@ -1901,7 +1907,7 @@ void ContactEquation<DoubleType>::AssembleTetrahedronEdgeEquationOnCircuit(const
           const Edge &edge = *(edgeDataList[eindex]->edge);
           if ((edge.GetHead() == (*cit)) || (edge.GetTail() == (*cit)))
           {
-            if (bothNodesOnContact(cnodes, edge))
+            if (BothNodesActive(edge))
             {
               continue;
             }
@@ -1993,7 +1999,7 @@ void ContactEquation<DoubleType>::AssembleTetrahedronEdgeEquationOnCircuit(const
 
                 if ((edge.GetHead() == (*cit)) || (edge.GetTail() == (*cit)))
                 {
-                  if (bothNodesOnContact(cnodes, edge))
+                  if (BothNodesActive(edge))
                   {
                     continue;
                   }
@@ -2088,7 +2094,7 @@ void ContactEquation<DoubleType>::AssembleTetrahedronEdgeEquationOnCircuit(const
                 const Edge &edge = *(edgeDataList[eindex]->edge);
                 if ((edge.GetHead() == (*cit)) || (edge.GetTail() == (*cit)))
                 {
-                  if (bothNodesOnContact(cnodes, edge))
+                  if (BothNodesActive(edge))
                   {
                     continue;
                   }
@@ -36,6 +36,8 @@ typedef Region *RegionPtr;
 class Node;
 typedef std::vector<const Node *> ConstNodeList_t;
 
+class Edge;
+
 namespace dsMath {
 template <typename T> class RowColVal;
 
@@ -80,7 +82,7 @@ class ContactEquation {
 
         const std::string &GetDeviceName() const;
 
-        ConstNodeList_t GetActiveNodes() const;
+        const ConstNodeList_t &GetActiveNodes() const;
 
         //// This is how we will get our equation index and stuff for flux
         void SetCircuitNode(const std::string &);
@@ -107,6 +109,9 @@ class ContactEquation {
         virtual void Serialize(std::ostream &) const = 0;
         virtual void GetCommandOptions_Impl(std::map<std::string, ObjectHolder> &) const = 0;
 
+        /// node indexes of GetActiveNodes, in the same order
+        const std::vector<size_t> &GetActiveNodeIndexes() const;
+
         void SetCurrent(DoubleType x) {
             current = x;
         }
@@ -126,6 +131,9 @@ class ContactEquation {
         void AssembleTriangleEdgeEquation(const std::string &, dsMath::RealRowColValueVec<DoubleType> &, dsMath::RHSEntryVec<DoubleType> &, dsMathEnum::WhatToLoad, const std::string &, const DoubleType /*n0_sign*/, const DoubleType /*n1_sign*/);
         void AssembleTetrahedronEdgeEquation(const std::string &, dsMath::RealRowColValueVec<DoubleType> &, dsMath::RHSEntryVec<DoubleType> &, dsMathEnum::WhatToLoad, const std::string &, const DoubleType /*n0_sign*/, const DoubleType /*n1_sign*/);
 
+        void AssembleNodeListRHS(dsMath::RHSEntryVec<DoubleType> &, size_t /*eqindex*/, size_t /*row*/, const std::vector<DoubleType> &);
+        void AssembleNodeListJacobian(dsMath::RealRowColValueVec<DoubleType> &, size_t /*eqindex0*/, size_t /*row*/, size_t /*eqindex1*/, size_t /*col*/, const std::vector<DoubleType> &);
+
         void AssembleNodeEquationOnCircuit(const std::string &, dsMath::RealRowColValueVec<DoubleType> &, dsMath::RHSEntryVec<DoubleType> &, dsMathEnum::WhatToLoad, const std::string &);
         void AssembleEdgeEquationOnCircuit(const std::string &, dsMath::RealRowColValueVec<DoubleType> &, dsMath::RHSEntryVec<DoubleType> &, dsMathEnum::WhatToLoad, const std::string &);
         void AssembleElementEdgeEquationOnCircuit(const std::string &, dsMath::RealRowColValueVec<DoubleType> &, dsMath::RHSEntryVec<DoubleType> &, dsMathEnum::WhatToLoad, const std::string &, const DoubleType /*n0_sign*/, const DoubleType /*n1_sign*/);
@@ -143,6 +151,9 @@ class ContactEquation {
         ContactEquation(const ContactEquation &);
         ContactEquation &operator=(const ContactEquation &);
 
+        void FindActiveNodes() const;
+        bool BothNodesActive(const Edge &) const;
+
         std::string myname;
         std::string variable;
         std::string circuitnode;
@@ -150,6 +161,13 @@ class ContactEquation {
         RegionPtr  myregion;
         DoubleType charge;
         DoubleType current;
+
+        //// Only searched again when contacts, interfaces, or their equations change
+        mutable size_t              activeNodesVersion;
+        mutable ConstNodeList_t     activeNodes;
+        mutable std::vector<size_t> activeNodeIndexes;
+        /// indexed by the node index in the region
+        mutable std::vector<char>   activeNodeFlags;
 };
 #endif
 
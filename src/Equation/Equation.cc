@@ -32,6 +32,7 @@ limitations under the License.
 #include "Triangle.hh"
 
 #include "MatrixEntries.hh"
+#include "ParallelAssemble.hh"
 
 #include "GeometryStream.hh"
 
@@ -412,18 +413,12 @@ void Equation<DoubleType>::EdgeAssembleRHS(dsMath::RHSEntryVec<DoubleType> &v, c
       dsErrors::MissingEquationIndex(r, myname, "", OutputStream::OutputType::FATAL) ;
     }
 
-    const ConstEdgeList &el = r.GetEdgeList();
-    for (size_t i = 0 ; i < el.size(); ++i)
-    {
-        const ConstNodeList &nl = el[i]->GetNodeList();
-        const size_t row0 = r.GetEquationNumber(eqindex0, nl[0]);
-        const size_t row1 = r.GetEquationNumber(eqindex0, nl[1]);
+    const size_t numedges = r.GetNumberEdges();
+    const size_t offset   = v.size();
+    v.resize(offset + EdgeAssembleRHSTask<DoubleType>::entries_per_item * numedges);
 
-        const DoubleType rhsval = eflux[i];
-
-        v.push_back(std::make_pair(row0,  n0_sign*rhsval));
-        v.push_back(std::make_pair(row1,  n1_sign*rhsval));
-    }
+    EdgeAssembleRHSTask<DoubleType> task(r, eqindex0, eflux.GetScalarList(), n0_sign, n1_sign, v.data() + offset);
+    AssembleRun(task, numedges);
 }
 
 /// should have one assembly routine per shape
@@ -439,23 +434,12 @@ void Equation<DoubleType>::TriangleEdgeAssembleRHS(dsMath::RHSEntryVec<DoubleTyp
     dsErrors::MissingEquationIndex(r, myname, "", OutputStream::OutputType::FATAL) ;
   }
 
-  const Region::TriangleToConstEdgeList_t &ttelist = r.GetTriangleToEdgeList();
-  for (size_t i = 0 ; i < ttelist.size(); ++i)
-  {
-    const ConstEdgeList &el = ttelist[i];
-    for (size_t j = 0; j < el.size(); ++j)
-    {
-      const ConstNodeList &nl = el[j]->GetNodeList();
-
-      const size_t row0 = r.GetEquationNumber(eqindex0, nl[0]);
-      const size_t row1 = r.GetEquationNumber(eqindex0, nl[1]);
-
-      const DoubleType rhsval = teflux[3*i + j];
+  const size_t numtriangles = r.GetNumberTriangles();
+  const size_t offset       = v.size();
+  v.resize(offset + TriangleEdgeAssembleRHSTask<DoubleType>::entries_per_item * numtriangles);
 
-      v.push_back(std::make_pair(row0,  n0_sign * rhsval));
-      v.push_back(std::make_pair(row1,  n1_sign * rhsval));
-    }
-  }
+  TriangleEdgeAssembleRHSTask<DoubleType> task(r, eqindex0, teflux.GetScalarList(), n0_sign, n1_sign, v.data() + offset);
+  AssembleRun(task, numtriangles);
 }
 
 template <typename DoubleType>
@@ -469,25 +453,12 @@ void Equation<DoubleType>::TetrahedronEdgeAssembleRHS(dsMath::RHSEntryVec<Double
     dsErrors::MissingEquationIndex(r, myname, "", OutputStream::OutputType::FATAL) ;
   }
 
-  const Region::TetrahedronToConstEdgeDataList_t &ttelist = r.GetTetrahedronToEdgeDataList();
-  for (size_t i = 0 ; i < ttelist.size(); ++i)
-  {
-    const ConstEdgeDataList &edgeDataList = ttelist[i];
-    for (size_t j = 0; j < edgeDataList.size(); ++j)
-    {
-      const EdgeData &edgeData = *edgeDataList[j];
-      const Edge     &edge     = *edgeData.edge;
-      const ConstNodeList &nl = edge.GetNodeList();
-
-      const size_t row0 = r.GetEquationNumber(eqindex0, nl[0]);
-      const size_t row1 = r.GetEquationNumber(eqindex0, nl[1]);
+  const size_t numtetrahedrons = r.GetNumberTetrahedrons();
+  const size_t offset          = v.size();
+  v.resize(offset + TetrahedronEdgeAssembleRHSTask<DoubleType>::entries_per_item * numtetrahedrons);
 
-      const DoubleType rhsval = teflux[6*i + j];
-
-      v.push_back(std::make_pair(row0,  n0_sign * rhsval));
-      v.push_back(std::make_pair(row1,  n1_sign * rhsval));
-    }
-  }
+  TetrahedronEdgeAssembleRHSTask<DoubleType> task(r, eqindex0, teflux.GetScalarList(), n0_sign, n1_sign, v.data() + offset);
+  AssembleRun(task, numtetrahedrons);
 }
 
 template <typename DoubleType>
@@ -564,25 +535,12 @@ void Equation<DoubleType>::UnSymmetricEdgeAssembleJacobian(dsMath::RealRowColVal
       dsErrors::MissingEquationIndex(r, myname, var, OutputStream::OutputType::FATAL) ;
     }
 
-    // assemble the edge components to rhs first
-    const ConstEdgeList &el = r.GetEdgeList();
-    for (size_t i = 0 ; i < el.size(); ++i)
-    {
-        const ConstNodeList &nl = el[i]->GetNodeList();
-        const size_t row0 = r.GetEquationNumber(eqindex0, nl[0]);
-        const size_t col0 = r.GetEquationNumber(eqindex1, nl[0]);
-        const size_t row1 = r.GetEquationNumber(eqindex0, nl[1]);
-        const size_t col1 = r.GetEquationNumber(eqindex1, nl[1]);
-
-        const DoubleType ederval0 = eder0[i];
-        const DoubleType ederval1 = eder1[i];
+    const size_t numedges = r.GetNumberEdges();
+    const size_t offset   = m.size();
+    m.resize(offset + EdgeAssembleJacobianTask<DoubleType>::entries_per_item * numedges);
 
-        /// Here we account for the fact stuff moving toward row1 has opposite sign
-        m.push_back(dsMath::RealRowColVal<DoubleType>(row0, col0, n0_sign * ederval0));
-        m.push_back(dsMath::RealRowColVal<DoubleType>(row1, col1, n1_sign * ederval1));
-        m.push_back(dsMath::RealRowColVal<DoubleType>(row0, col1, n0_sign * ederval1));
-        m.push_back(dsMath::RealRowColVal<DoubleType>(row1, col0, n1_sign * ederval0));
-    }
+    EdgeAssembleJacobianTask<DoubleType> task(r, eqindex0, eqindex1, eder0.GetScalarList(), eder1.GetScalarList(), n0_sign, n1_sign, m.data() + offset);
+    AssembleRun(task, numedges);
 }
 
 /// Inserts the entries into the matrix for the case when the sensitivity is different with respect to the same variable at the nodes opposite of the edge
@@ -607,52 +565,12 @@ void Equation<DoubleType>::UnSymmetricTriangleEdgeAssembleJacobian(dsMath::RealR
     dsErrors::MissingEquationIndex(r, myname, var, OutputStream::OutputType::FATAL) ;
   }
 
-  const Region::TriangleToConstEdgeList_t &ttelist = r.GetTriangleToEdgeList();
-  const ConstTriangleList &triangleList = r.GetTriangleList();
-  dsAssert(triangleList.size() == ttelist.size(), "UNEXPECTED");
-
-  for (size_t i = 0 ; i < ttelist.size(); ++i)
-  {
-    // assemble the edge components to rhs first
-    const ConstEdgeList &el = ttelist[i];
-
-    const Triangle &triangle = *triangleList[i];
-
-    const ConstNodeList &tnl = triangle.GetNodeList();
-
-    for (size_t j = 0 ; j < el.size(); ++j)
-    {
-      const ConstNodeList &nl = el[j]->GetNodeList();
-
-      const Node * const node0 = nl[0];
-      const Node * const node1 = nl[1];
-
-      //// we are guaranteed that the node is across from the edge
-      const Node * const node2 = tnl[j];
-
-      const size_t row0 = r.GetEquationNumber(eqindex0, node0);
-      const size_t col0 = r.GetEquationNumber(eqindex1, node0);
-      const size_t row1 = r.GetEquationNumber(eqindex0, node1);
-      const size_t col1 = r.GetEquationNumber(eqindex1, node1);
-
-      const size_t col2 = r.GetEquationNumber(eqindex1, node2);
-
-      const size_t eindex = 3 * i + j;
-      const DoubleType ederval0 = eder0[eindex];
-      const DoubleType ederval1 = eder1[eindex];
-      const DoubleType ederval2 = eder2[eindex];
-
-      /// Here we account for the fact stuff moving toward row1 has opposite sign
-      m.push_back(dsMath::RealRowColVal<DoubleType>(row0, col0,  n0_sign * ederval0));
-      m.push_back(dsMath::RealRowColVal<DoubleType>(row1, col1,  n1_sign * ederval1));
-      m.push_back(dsMath::RealRowColVal<DoubleType>(row0, col1,  n0_sign * ederval1));
-      m.push_back(dsMath::RealRowColVal<DoubleType>(row1, col0,  n1_sign * ederval0));
+  const size_t numtriangles = r.GetNumberTriangles();
+  const size_t offset       = m.size();
+  m.resize(offset + TriangleEdgeAssembleJacobianTask<DoubleType>::entries_per_item * numtriangles);
 
-      /// This is true as long as we are projected along the unit vector
-      m.push_back(dsMath::RealRowColVal<DoubleType>(row0, col2,  n0_sign * ederval2));
-      m.push_back(dsMath::RealRowColVal<DoubleType>(row1, col2,  n1_sign * ederval2));
-    }
-  }
+  TriangleEdgeAssembleJacobianTask<DoubleType> task(r, eqindex0, eqindex1, eder0.GetScalarList(), eder1.GetScalarList(), eder2.GetScalarList(), n0_sign, n1_sign, m.data() + offset);
+  AssembleRun(task, numtriangles);
 }
 
 template <typename DoubleType>
@@ -673,57 +591,12 @@ void Equation<DoubleType>::UnSymmetricTetrahedronEdgeAssembleJacobian(dsMath::Re
     dsErrors::MissingEquationIndex(r, myname, var, OutputStream::OutputType::FATAL) ;
   }
 
-  const Region::TetrahedronToConstEdgeDataList_t &ttelist = r.GetTetrahedronToEdgeDataList();
-  const ConstTetrahedronList &tetrahedronList = r.GetTetrahedronList();
-  dsAssert(tetrahedronList.size() == ttelist.size(), "UNEXPECTED");
+  const size_t numtetrahedrons = r.GetNumberTetrahedrons();
+  const size_t offset          = m.size();
+  m.resize(offset + TetrahedronEdgeAssembleJacobianTask<DoubleType>::entries_per_item * numtetrahedrons);
 
-
-  for (size_t i = 0 ; i < ttelist.size(); ++i)
-  {
-    // assemble the edge components to rhs first
-    const ConstEdgeDataList &edgeDataList = ttelist[i];
-
-    for (size_t j = 0 ; j < edgeDataList.size(); ++j)
-    {
-      const EdgeData &edgeData = *edgeDataList[j];
-      const Edge &edge = *(edgeData.edge);
-
-      const ConstNodeList &nl = edge.GetNodeList();
-
-      const Node * const node0 = nl[0];
-      const Node * const node1 = nl[1];
-
-      //// we are guaranteed that the node is across from the edge
-      const Node * const node2 = edgeData.nodeopp[0];
-      const Node * const node3 = edgeData.nodeopp[1];
-
-      const size_t row0 = r.GetEquationNumber(eqindex0, node0);
-      const size_t col0 = r.GetEquationNumber(eqindex1, node0);
-      const size_t row1 = r.GetEquationNumber(eqindex0, node1);
-      const size_t col1 = r.GetEquationNumber(eqindex1, node1);
-
-      const size_t col2 = r.GetEquationNumber(eqindex1, node2);
-      const size_t col3 = r.GetEquationNumber(eqindex1, node3);
-
-      const size_t eindex = 6 * i + j;
-      const DoubleType ederval0 = eder0[eindex];
-      const DoubleType ederval1 = eder1[eindex];
-      const DoubleType ederval2 = eder2[eindex];
-      const DoubleType ederval3 = eder3[eindex];
-
-      /// Here we account for the fact stuff moving toward row1 has opposite sign
-      m.push_back(dsMath::RealRowColVal<DoubleType>(row0, col0,  n0_sign * ederval0));
-      m.push_back(dsMath::RealRowColVal<DoubleType>(row1, col1,  n1_sign * ederval1));
-      m.push_back(dsMath::RealRowColVal<DoubleType>(row0, col1,  n0_sign * ederval1));
-      m.push_back(dsMath::RealRowColVal<DoubleType>(row1, col0,  n1_sign * ederval0));
-
-      /// This is true as long as we are projected along the unit vector
-      m.push_back(dsMath::RealRowColVal<DoubleType>(row0, col2,  n0_sign * ederval2));
-      m.push_back(dsMath::RealRowColVal<DoubleType>(row1, col2,  n1_sign * ederval2));
-      m.push_back(dsMath::RealRowColVal<DoubleType>(row0, col3,  n0_sign * ederval3));
-      m.push_back(dsMath::RealRowColVal<DoubleType>(row1, col3,  n1_sign * ederval3));
-    }
-  }
+  TetrahedronEdgeAssembleJacobianTask<DoubleType> task(r, eqindex0, eqindex1, eder0.GetScalarList(), eder1.GetScalarList(), eder2.GetScalarList(), eder3.GetScalarList(), n0_sign, n1_sign, m.data() + offset);
+  AssembleRun(task, numtetrahedrons);
 }
 
 /// Not scaled by node volume
@@ -741,14 +614,12 @@ void Equation<DoubleType>::NodeAssembleRHS(dsMath::RHSEntryVec<DoubleType> &v, c
       dsErrors::MissingEquationIndex(r, myname, "", OutputStream::OutputType::FATAL) ;
     }
 
-    const ConstNodeList &nl = r.GetNodeList();
-    for (size_t i = 0; i < nl.size(); ++i)
-    {
-        const size_t row1 = r.GetEquationNumber(eqindex0, nl[i]);
-        const DoubleType rhsval = nrhs.GetScalarList()[i];
-        // Note that the sign is reversed
-        v.push_back(std::make_pair(row1, rhsval));
-    }
+    const size_t numnodes = r.GetNumberNodes();
+    const size_t offset   = v.size();
+    v.resize(offset + numnodes);
+
+    NodeAssembleRHSTask<DoubleType> task(r, eqindex0, nrhs.GetScalarList(), v.data() + offset);
+    AssembleRun(task, numnodes);
 }
 
 template <typename DoubleType>
@@ -773,15 +644,12 @@ void Equation<DoubleType>::NodeAssembleJacobian(dsMath::RealRowColValueVec<Doubl
       dsErrors::MissingEquationIndex(r, myname, var, OutputStream::OutputType::FATAL) ;
     }
 
-    const ConstNodeList &nl = r.GetNodeList();
-    for (size_t i = 0; i < nl.size(); ++i)
-    {
-        const size_t row1 = r.GetEquationNumber(eqindex0, nl[i]);
-        const size_t row2 = r.GetEquationNumber(eqindex1, nl[i]);
+    const size_t numnodes = r.GetNumberNodes();
+    const size_t offset   = m.size();
+    m.resize(offset + numnodes);
 
-        const DoubleType derval = nder.GetScalarList()[i];
-        m.push_back(dsMath::RealRowColVal<DoubleType>(row1, row2, derval));
-    }
+    NodeAssembleJacobianTask<DoubleType> task(r, eqindex0, eqindex1, nder.GetScalarList(), m.data() + offset);
+    AssembleRun(task, numnodes);
 }
 
 template <typename DoubleType>
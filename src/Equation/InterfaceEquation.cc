@@ -36,7 +36,7 @@ limitations under the License.
 
 template <typename DoubleType>
 InterfaceEquation<DoubleType>::InterfaceEquation(const std::string &nm, const std::string &var, InterfacePtr ip)
-    : myname(nm), variable(var), myinterface(ip)
+    : myname(nm), variable(var), myinterface(ip), activeNodesVersion(size_t(-1))
 {
     InterfaceEquationHolder tmp(this);
     ip->AddInterfaceEquation(tmp);
@@ -175,6 +175,30 @@ std::set<ConstNodePtr> InterfaceEquation<DoubleType>::GetActiveNodes() const
   return ret;
 }
 
+template <typename DoubleType>
+void InterfaceEquation<DoubleType>::UpdateActiveNodes() const
+{
+  const Interface &in = GetInterface();
+  const size_t version = in.GetRegion0()->GetDevice()->GetBoundaryVersion();
+  if (version == activeNodesVersion)
+  {
+    return;
+  }
+
+  const std::set<ConstNodePtr> &activeNodes = GetActiveNodes();
+  const ConstNodeList_t &nodes0 = in.GetNodes0();
+  const ConstNodeList_t &nodes1 = in.GetNodes1();
+  dsAssert(nodes0.size() == nodes1.size(), "UNEXPECTED");
+
+  activeNodes0.resize(nodes0.size());
+  activeNodes1.resize(nodes1.size());
+  for (size_t i = 0; i < nodes0.size(); ++i)
+  {
+    activeNodes0[i] = activeNodes.count(nodes0[i]);
+    activeNodes1[i] = activeNodes.count(nodes1[i]);
+  }
+  activeNodesVersion = version;
+}
 
 // Should make permutation collection a separate step
 template <typename DoubleType>
@@ -268,7 +292,7 @@ void InterfaceEquation<DoubleType>::NodeVolumeType1Assemble(const std::string &i
 
     }
 
-    const std::set<ConstNodePtr> &activeNodes = GetActiveNodes();
+    UpdateActiveNodes();
     const ConstNodeList_t &nodes0 = in.GetNodes0();
     const ConstNodeList_t &nodes1 = in.GetNodes1();
 
@@ -285,7 +309,7 @@ void InterfaceEquation<DoubleType>::NodeVolumeType1Assemble(const std::string &i
         const Node *node0 = nodes0[i];
         const Node *node1 = nodes1[i];
 
-        if (!(activeNodes.count(node0) && activeNodes.count(node1)))
+        if (!(activeNodes0[i] && activeNodes1[i]))
         {
           continue;
         }
@@ -435,7 +459,7 @@ void InterfaceEquation<DoubleType>::NodeVolumeType2Assemble(const std::string &i
     ConstNodeModelPtr sa1 = r1.GetNodeModel(surface_area);
     dsAssert(sa1.get(), "UNEXPECTED");
 
-    const std::set<ConstNodePtr> &activeNodes = GetActiveNodes();
+    UpdateActiveNodes();
     const ConstNodeList_t &nodes0 = in.GetNodes0();
     const ConstNodeList_t &nodes1 = in.GetNodes1();
 
@@ -458,7 +482,7 @@ void InterfaceEquation<DoubleType>::NodeVolumeType2Assemble(const std::string &i
             const Node *node0 = nodes0[i];
             const Node *node1 = nodes1[i];
 
-            if (!(activeNodes.count(node0)) && (activeNodes.count(node1)))
+            if (!(activeNodes0[i]) && (activeNodes1[i]))
             {
               continue;
             }
@@ -544,7 +568,7 @@ void InterfaceEquation<DoubleType>::NodeVolumeType2Assemble(const std::string &i
 
             for (size_t i = 0; i < nlist.size(); ++i)
             {
-                if (!(activeNodes.count(nodes0[i]) && activeNodes.count(nodes1[i])))
+                if (!(activeNodes0[i] && activeNodes1[i]))
                 {
                   continue;
                 }
@@ -106,8 +106,16 @@ class InterfaceEquation {
         InterfaceEquation(const InterfaceEquation &);
         InterfaceEquation &operator=(const InterfaceEquation &);
 
+        void UpdateActiveNodes() const;
+
         std::string myname;
         std::string variable;
         InterfacePtr myinterface;
+
+        //// Only searched again when contacts, interfaces, or their equations change
+        mutable size_t            activeNodesVersion;
+        /// for each pair of interface nodes, whether the node in region 0, or region 1, is active
+        mutable std::vector<char> activeNodes0;
+        mutable std::vector<char> activeNodes1;
 };
 #endif
@@ -0,0 +1,289 @@
+/***
+DEVSIM
+Copyright 2013 Devsim LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+***/
+
+#include "ParallelAssemble.hh"
+#include "Region.hh"
+#include "MeshTopology.hh"
+#include "MatrixEntries.hh"
+
+#include "parallel_for.hh"
+
+template <typename DoubleType>
+void EdgeAssembleRHSTask<DoubleType>::operator()(const size_t b, const size_t e)
+{
+  const MeshTopology &topology = region_.GetTopology();
+  std::pair<int, DoubleType> *out = out_ + entries_per_item * b;
+  for (size_t i = b; i < e; ++i)
+  {
+    const MeshTopology::index_t *nl = topology.GetEdgeNodes(i);
+    const size_t row0 = region_.GetNodeEquationNumber(eqindex0_, nl[0]);
+    const size_t row1 = region_.GetNodeEquationNumber(eqindex0_, nl[1]);
+
+    const DoubleType rhsval = flux_[i];
+
+    *(out++) = std::make_pair(row0, n0_sign_ * rhsval);
+    *(out++) = std::make_pair(row1, n1_sign_ * rhsval);
+  }
+}
+
+template <typename DoubleType>
+void EdgeAssembleJacobianTask<DoubleType>::operator()(const size_t b, const size_t e)
+{
+  const MeshTopology &topology = region_.GetTopology();
+  dsMath::RowColVal<DoubleType> *out = out_ + entries_per_item * b;
+  for (size_t i = b; i < e; ++i)
+  {
+    const MeshTopology::index_t *nl = topology.GetEdgeNodes(i);
+    const size_t row0 = region_.GetNodeEquationNumber(eqindex0_, nl[0]);
+    const size_t col0 = region_.GetNodeEquationNumber(eqindex1_, nl[0]);
+    const size_t row1 = region_.GetNodeEquationNumber(eqindex0_, nl[1]);
+    const size_t col1 = region_.GetNodeEquationNumber(eqindex1_, nl[1]);
+
+    const DoubleType ederval0 = der0_[i];
+    const DoubleType ederval1 = der1_[i];
+
+    /// Here we account for the fact stuff moving toward row1 has opposite sign
+    *(out++) = dsMath::RowColVal<DoubleType>(row0, col0, n0_sign_ * ederval0);
+    *(out++) = dsMath::RowColVal<DoubleType>(row1, col1, n1_sign_ * ederval1);
+    *(out++) = dsMath::RowColVal<DoubleType>(row0, col1, n0_sign_ * ederval1);
+    *(out++) = dsMath::RowColVal<DoubleType>(row1, col0, n1_sign_ * ederval0);
+  }
+}
+
+template <typename DoubleType>
+void TriangleEdgeAssembleRHSTask<DoubleType>::operator()(const size_t b, const size_t e)
+{
+  const MeshTopology &topology = region_.GetTopology();
+  std::pair<int, DoubleType> *out = out_ + entries_per_item * b;
+  for (size_t i = b; i < e; ++i)
+  {
+    const MeshTopology::index_t *el = topology.GetTriangleEdges(i);
+    for (size_t j = 0; j < 3; ++j)
+    {
+      const MeshTopology::index_t *nl = topology.GetEdgeNodes(el[j]);
+
+      const size_t row0 = region_.GetNodeEquationNumber(eqindex0_, nl[0]);
+      const size_t row1 = region_.GetNodeEquationNumber(eqindex0_, nl[1]);
+
+      const DoubleType rhsval = flux_[3*i + j];
+
+      *(out++) = std::make_pair(row0, n0_sign_ * rhsval);
+      *(out++) = std::make_pair(row1, n1_sign_ * rhsval);
+    }
+  }
+}
+
+template <typename DoubleType>
+void TriangleEdgeAssembleJacobianTask<DoubleType>::operator()(const size_t b, const size_t e)
+{
+  const MeshTopology &topology = region_.GetTopology();
+  dsMath::RowColVal<DoubleType> *out = out_ + entries_per_item * b;
+  for (size_t i = b; i < e; ++i)
+  {
+    const MeshTopology::index_t *el  = topology.GetTriangleEdges(i);
+    const MeshTopology::index_t *tnl = topology.GetTriangleNodes(i);
+
+    for (size_t j = 0; j < 3; ++j)
+    {
+      const MeshTopology::index_t *nl = topology.GetEdgeNodes(el[j]);
+
+      const size_t node0 = nl[0];
+      const size_t node1 = nl[1];
+
+      //// we are guaranteed that the node is across from the edge
+      const size_t node2 = tnl[j];
+
+      const size_t row0 = region_.GetNodeEquationNumber(eqindex0_, node0);
+      const size_t col0 = region_.GetNodeEquationNumber(eqindex1_, node0);
+      const size_t row1 = region_.GetNodeEquationNumber(eqindex0_, node1);
+      const size_t col1 = region_.GetNodeEquationNumber(eqindex1_, node1);
+
+      const size_t col2 = region_.GetNodeEquationNumber(eqindex1_, node2);
+
+      const size_t eindex = 3 * i + j;
+      const DoubleType ederval0 = der0_[eindex];
+      const DoubleType ederval1 = der1_[eindex];
+      const DoubleType ederval2 = der2_[eindex];
+
+      /// Here we account for the fact stuff moving toward row1 has opposite sign
+      *(out++) = dsMath::RowColVal<DoubleType>(row0, col0,  n0_sign_ * ederval0);
+      *(out++) = dsMath::RowColVal<DoubleType>(row1, col1,  n1_sign_ * ederval1);
+      *(out++) = dsMath::RowColVal<DoubleType>(row0, col1,  n0_sign_ * ederval1);
+      *(out++) = dsMath::RowColVal<DoubleType>(row1, col0,  n1_sign_ * ederval0);
+
+      /// This is true as long as we are projected along the unit vector
+      *(out++) = dsMath::RowColVal<DoubleType>(row0, col2,  n0_sign_ * ederval2);
+      *(out++) = dsMath::RowColVal<DoubleType>(row1, col2,  n1_sign_ * ederval2);
+    }
+  }
+}
+
+template <typename DoubleType>
+void TetrahedronEdgeAssembleRHSTask<DoubleType>::operator()(const size_t b, const size_t e)
+{
+  const MeshTopology &topology = region_.GetTopology();
+  std::pair<int, DoubleType> *out = out_ + entries_per_item * b;
+  for (size_t i = b; i < e; ++i)
+  {
+    const MeshTopology::index_t *el = topology.GetTetrahedronEdges(i);
+    for (size_t j = 0; j < 6; ++j)
+    {
+      const MeshTopology::index_t *nl = topology.GetEdgeNodes(el[j]);
+
+      const size_t row0 = region_.GetNodeEquationNumber(eqindex0_, nl[0]);
+      const size_t row1 = region_.GetNodeEquationNumber(eqindex0_, nl[1]);
+
+      const DoubleType rhsval = flux_[6*i + j];
+
+      *(out++) = std::make_pair(row0, n0_sign_ * rhsval);
+      *(out++) = std::make_pair(row1, n1_sign_ * rhsval);
+    }
+  }
+}
+
+template <typename DoubleType>
+void TetrahedronEdgeAssembleJacobianTask<DoubleType>::operator()(const size_t b, const size_t e)
+{
+  const MeshTopology &topology = region_.GetTopology();
+  dsMath::RowColVal<DoubleType> *out = out_ + entries_per_item * b;
+  for (size_t i = b; i < e; ++i)
+  {
+    const MeshTopology::index_t *el = topology.GetTetrahedronEdges(i);
+
+    for (size_t j = 0; j < 6; ++j)
+    {
+      const MeshTopology::index_t *nl  = topology.GetEdgeNodes(el[j]);
+      const MeshTopology::index_t *onl = topology.GetTetrahedronEdgeOppositeNodes(i, j);
+
+      const size_t node0 = nl[0];
+      const size_t node1 = nl[1];
+
+      //// we are guaranteed that the node is across from the edge
+      const size_t node2 = onl[0];
+      const size_t node3 = onl[1];
+
+      const size_t row0 = region_.GetNodeEquationNumber(eqindex0_, node0);
+      const size_t col0 = region_.GetNodeEquationNumber(eqindex1_, node0);
+      const size_t row1 = region_.GetNodeEquationNumber(eqindex0_, node1);
+      const size_t col1 = region_.GetNodeEquationNumber(eqindex1_, node1);
+
+      const size_t col2 = region_.GetNodeEquationNumber(eqindex1_, node2);
+      const size_t col3 = region_.GetNodeEquationNumber(eqindex1_, node3);
+
+      const size_t eindex = 6 * i + j;
+      const DoubleType ederval0 = der0_[eindex];
+      const DoubleType ederval1 = der1_[eindex];
+      const DoubleType ederval2 = der2_[eindex];
+      const DoubleType ederval3 = der3_[eindex];
+
+      /// Here we account for the fact stuff moving toward row1 has opposite sign
+      *(out++) = dsMath::RowColVal<DoubleType>(row0, col0,  n0_sign_ * ederval0);
+      *(out++) = dsMath::RowColVal<DoubleType>(row1, col1,  n1_sign_ * ederval1);
+      *(out++) = dsMath::RowColVal<DoubleType>(row0, col1,  n0_sign_ * ederval1);
+      *(out++) = dsMath::RowColVal<DoubleType>(row1, col0,  n1_sign_ * ederval0);
+
+      /// This is true as long as we are projected along the unit vector
+      *(out++) = dsMath::RowColVal<DoubleType>(row0, col2,  n0_sign_ * ederval2);
+      *(out++) = dsMath::RowColVal<DoubleType>(row1, col2,  n1_sign_ * ederval2);
+      *(out++) = dsMath::RowColVal<DoubleType>(row0, col3,  n0_sign_ * ederval3);
+      *(out++) = dsMath::RowColVal<DoubleType>(row1, col3,  n1_sign_ * ederval3);
+    }
+  }
+}
+
+template <typename DoubleType>
+void NodeAssembleRHSTask<DoubleType>::operator()(const size_t b, const size_t e)
+{
+  std::pair<int, DoubleType> *out = out_ + b;
+  for (size_t i = b; i < e; ++i)
+  {
+    const size_t row1 = region_.GetNodeEquationNumber(eqindex0_, i);
+    *(out++) = std::make_pair(row1, rhs_[i]);
+  }
+}
+
+template <typename DoubleType>
+void NodeAssembleJacobianTask<DoubleType>::operator()(const size_t b, const size_t e)
+{
+  dsMath::RowColVal<DoubleType> *out = out_ + b;
+  for (size_t i = b; i < e; ++i)
+  {
+    const size_t row1 = region_.GetNodeEquationNumber(eqindex0_, i);
+    const size_t row2 = region_.GetNodeEquationNumber(eqindex1_, i);
+    *(out++) = dsMath::RowColVal<DoubleType>(row1, row2, der_[i]);
+  }
+}
+
+template <typename DoubleType>
+void NodeListAssembleRHSTask<DoubleType>::operator()(const size_t b, const size_t e)
+{
+  std::pair<int, DoubleType> *out = out_ + b;
+  for (size_t i = b; i < e; ++i)
+  {
+    const size_t nindex = nodes_[i];
+    const size_t row = (eqindex0_ != size_t(-1)) ? region_.GetNodeEquationNumber(eqindex0_, nindex) : row_;
+    *(out++) = std::make_pair(row, rhs_[nindex]);
+  }
+}
+
+template <typename DoubleType>
+void NodeListAssembleJacobianTask<DoubleType>::operator()(const size_t b, const size_t e)
+{
+  dsMath::RowColVal<DoubleType> *out = out_ + b;
+  for (size_t i = b; i < e; ++i)
+  {
+    const size_t nindex = nodes_[i];
+    const size_t row = (eqindex0_ != size_t(-1)) ? region_.GetNodeEquationNumber(eqindex0_, nindex) : row_;
+    const size_t col = (eqindex1_ != size_t(-1)) ? region_.GetNodeEquationNumber(eqindex1_, nindex) : col_;
+    *(out++) = dsMath::RowColVal<DoubleType>(row, col, der_[nindex]);
+  }
+}
+
+namespace {
+template <typename U>
+class AssembleBody : public myrangetask {
+  public:
+    explicit AssembleBody(const U &t) : task_(t) {}
+
+    void operator()(const size_t b, const size_t e) const
+    {
+      U task(task_);
+      task(b, e);
+    }
+
+  private:
+    const U &task_;
+};
+}
+
+template <typename U>
+void AssembleRun(U &task, size_t vlen)
+{
+  AssembleBody<U> body(task);
+  parallel_for(body, vlen);
+}
+
+#define DBLTYPE double
+#include "ParallelAssembleInstantiate.cc"
+
+#ifdef DEVSIM_EXTENDED_PRECISION
+#undef  DBLTYPE
+#define DBLTYPE float128
+#include "Float128.hh"
+#include "ParallelAssembleInstantiate.cc"
+#endif
+
@@ -0,0 +1,225 @@
+/***
+DEVSIM
+Copyright 2013 Devsim LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+***/
+
+#ifndef PARALLEL_ASSEMBLE_HH
+#define PARALLEL_ASSEMBLE_HH
+
+#include <vector>
+#include <cstddef>
+#include <utility>
+
+class Region;
+
+namespace dsMath {
+template <typename T> class RowColVal;
+}
+
+//// Each task writes a fixed number of entries per mesh element into slots
+//// reserved ahead of time by the caller.  The output order is therefore the
+//// same as the serial assembly, no matter how the range is split across threads.
+template <typename DoubleType>
+struct EdgeAssembleRHSTask {
+  static const size_t entries_per_item = 2;
+
+  EdgeAssembleRHSTask(const Region &r, size_t eq0, const std::vector<DoubleType> &flux, DoubleType s0, DoubleType s1, std::pair<int, DoubleType> *out) :
+    region_(r), eqindex0_(eq0), flux_(flux), n0_sign_(s0), n1_sign_(s1), out_(out) {}
+
+  void operator()(const size_t b, const size_t e);
+
+  const Region                  &region_;
+  const size_t                   eqindex0_;
+  const std::vector<DoubleType> &flux_;
+  const DoubleType               n0_sign_;
+  const DoubleType               n1_sign_;
+  std::pair<int, DoubleType>    *out_;
+};
+
+template <typename DoubleType>
+struct EdgeAssembleJacobianTask {
+  static const size_t entries_per_item = 4;
+
+  EdgeAssembleJacobianTask(const Region &r, size_t eq0, size_t eq1, const std::vector<DoubleType> &d0, const std::vector<DoubleType> &d1, DoubleType s0, DoubleType s1, dsMath::RowColVal<DoubleType> *out) :
+    region_(r), eqindex0_(eq0), eqindex1_(eq1), der0_(d0), der1_(d1), n0_sign_(s0), n1_sign_(s1), out_(out) {}
+
+  void operator()(const size_t b, const size_t e);
+
+  const Region                   &region_;
+  const size_t                    eqindex0_;
+  const size_t                    eqindex1_;
+  const std::vector<DoubleType>  &der0_;
+  const std::vector<DoubleType>  &der1_;
+  const DoubleType                n0_sign_;
+  const DoubleType                n1_sign_;
+  dsMath::RowColVal<DoubleType>  *out_;
+};
+
+//// b and e are triangle indexes, each triangle contributes 3 edges
+template <typename DoubleType>
+struct TriangleEdgeAssembleRHSTask {
+  static const size_t entries_per_item = 6;
+
+  TriangleEdgeAssembleRHSTask(const Region &r, size_t eq0, const std::vector<DoubleType> &flux, DoubleType s0, DoubleType s1, std::pair<int, DoubleType> *out) :
+    region_(r), eqindex0_(eq0), flux_(flux), n0_sign_(s0), n1_sign_(s1), out_(out) {}
+
+  void operator()(const size_t b, const size_t e);
+
+  const Region                  &region_;
+  const size_t                   eqindex0_;
+  const std::vector<DoubleType> &flux_;
+  const DoubleType               n0_sign_;
+  const DoubleType               n1_sign_;
+  std::pair<int, DoubleType>    *out_;
+};
+
+template <typename DoubleType>
+struct TriangleEdgeAssembleJacobianTask {
+  static const size_t entries_per_item = 18;
+
+  TriangleEdgeAssembleJacobianTask(const Region &r, size_t eq0, size_t eq1, const std::vector<DoubleType> &d0, const std::vector<DoubleType> &d1, const std::vector<DoubleType> &d2, DoubleType s0, DoubleType s1, dsMath::RowColVal<DoubleType> *out) :
+    region_(r), eqindex0_(eq0), eqindex1_(eq1), der0_(d0), der1_(d1), der2_(d2), n0_sign_(s0), n1_sign_(s1), out_(out) {}
+
+  void operator()(const size_t b, const size_t e);
+
+  const Region                   &region_;
+  const size_t                    eqindex0_;
+  const size_t                    eqindex1_;
+  const std::vector<DoubleType>  &der0_;
+  const std::vector<DoubleType>  &der1_;
+  const std::vector<DoubleType>  &der2_;
+  const DoubleType                n0_sign_;
+  const DoubleType                n1_sign_;
+  dsMath::RowColVal<DoubleType>  *out_;
+};
+
+//// b and e are tetrahedron indexes, each tetrahedron contributes 6 edges
+template <typename DoubleType>
+struct TetrahedronEdgeAssembleRHSTask {
+  static const size_t entries_per_item = 12;
+
+  TetrahedronEdgeAssembleRHSTask(const Region &r, size_t eq0, const std::vector<DoubleType> &flux, DoubleType s0, DoubleType s1, std::pair<int, DoubleType> *out) :
+    region_(r), eqindex0_(eq0), flux_(flux), n0_sign_(s0), n1_sign_(s1), out_(out) {}
+
+  void operator()(const size_t b, const size_t e);
+
+  const Region                  &region_;
+  const size_t                   eqindex0_;
+  const std::vector<DoubleType> &flux_;
+  const DoubleType               n0_sign_;
+  const DoubleType               n1_sign_;
+  std::pair<int, DoubleType>    *out_;
+};
+
+template <typename DoubleType>
+struct TetrahedronEdgeAssembleJacobianTask {
+  static const size_t entries_per_item = 48;
+
+  TetrahedronEdgeAssembleJacobianTask(const Region &r, size_t eq0, size_t eq1, const std::vector<DoubleType> &d0, const std::vector<DoubleType> &d1, const std::vector<DoubleType> &d2, const std::vector<DoubleType> &d3, DoubleType s0, DoubleType s1, dsMath::RowColVal<DoubleType> *out) :
+    region_(r), eqindex0_(eq0), eqindex1_(eq1), der0_(d0), der1_(d1), der2_(d2), der3_(d3), n0_sign_(s0), n1_sign_(s1), out_(out) {}
+
+  void operator()(const size_t b, const size_t e);
+
+  const Region                   &region_;
+  const size_t                    eqindex0_;
+  const size_t                    eqindex1_;
+  const std::vector<DoubleType>  &der0_;
+  const std::vector<DoubleType>  &der1_;
+  const std::vector<DoubleType>  &der2_;
+  const std::vector<DoubleType>  &der3_;
+  const DoubleType                n0_sign_;
+  const DoubleType                n1_sign_;
+  dsMath::RowColVal<DoubleType>  *out_;
+};
+
+template <typename DoubleType>
+struct NodeAssembleRHSTask {
+  static const size_t entries_per_item = 1;
+
+  NodeAssembleRHSTask(const Region &r, size_t eq0, const std::vector<DoubleType> &rhs, std::pair<int, DoubleType> *out) :
+    region_(r), eqindex0_(eq0), rhs_(rhs), out_(out) {}
+
+  void operator()(const size_t b, const size_t e);
+
+  const Region                  &region_;
+  const size_t                   eqindex0_;
+  const std::vector<DoubleType> &rhs_;
+  std::pair<int, DoubleType>    *out_;
+};
+
+template <typename DoubleType>
+struct NodeAssembleJacobianTask {
+  static const size_t entries_per_item = 1;
+
+  NodeAssembleJacobianTask(const Region &r, size_t eq0, size_t eq1, const std::vector<DoubleType> &der, dsMath::RowColVal<DoubleType> *out) :
+    region_(r), eqindex0_(eq0), eqindex1_(eq1), der_(der), out_(out) {}
+
+  void operator()(const size_t b, const size_t e);
+
+  const Region                   &region_;
+  const size_t                    eqindex0_;
+  const size_t                    eqindex1_;
+  const std::vector<DoubleType>  &der_;
+  dsMath::RowColVal<DoubleType>  *out_;
+};
+
+//// b and e index a list of nodes, such as the active nodes of a contact.
+//// When the equation index is size_t(-1), every entry goes to the given row,
+//// e.g. the circuit node a contact is connected to.
+template <typename DoubleType>
+struct NodeListAssembleRHSTask {
+  static const size_t entries_per_item = 1;
+
+  NodeListAssembleRHSTask(const Region &r, size_t eq0, size_t row, const std::vector<size_t> &nodes, const std::vector<DoubleType> &rhs, std::pair<int, DoubleType> *out) :
+    region_(r), eqindex0_(eq0), row_(row), nodes_(nodes), rhs_(rhs), out_(out) {}
+
+  void operator()(const size_t b, const size_t e);
+
+  const Region                  &region_;
+  const size_t                   eqindex0_;
+  const size_t                   row_;
+  const std::vector<size_t>     &nodes_;
+  const std::vector<DoubleType> &rhs_;
+  std::pair<int, DoubleType>    *out_;
+};
+
+//// Same as above, and the column is fixed when the second equation index is size_t(-1)
+template <typename DoubleType>
+struct NodeListAssembleJacobianTask {
+  static const size_t entries_per_item = 1;
+
+  NodeListAssembleJacobianTask(const Region &r, size_t eq0, size_t row, size_t eq1, size_t col, const std::vector<size_t> &nodes, const std::vector<DoubleType> &der, dsMath::RowColVal<DoubleType> *out) :
+    region_(r), eqindex0_(eq0), row_(row), eqindex1_(eq1), col_(col), nodes_(nodes), der_(der), out_(out) {}
+
+  void operator()(const size_t b, const size_t e);
+
+  const Region                   &region_;
+  const size_t                    eqindex0_;
+  const size_t                    row_;
+  const size_t                    eqindex1_;
+  const size_t                    col_;
+  const std::vector<size_t>      &nodes_;
+  const std::vector<DoubleType>  &der_;
+  dsMath::RowColVal<DoubleType>  *out_;
+};
+
+//// Splits [0, length) across the thread pool when "threads_available" and
+//// "threads_task_size" allow it, otherwise runs the task in the calling thread.
+//// The task must not evaluate models, since they are not thread safe.
+template <typename U> void
+AssembleRun(U &, size_t /*length*/);
+
+#endif
+
@@ -0,0 +1,22 @@
+template struct EdgeAssembleRHSTask<DBLTYPE>;
+template struct EdgeAssembleJacobianTask<DBLTYPE>;
+template struct TriangleEdgeAssembleRHSTask<DBLTYPE>;
+template struct TriangleEdgeAssembleJacobianTask<DBLTYPE>;
+template struct TetrahedronEdgeAssembleRHSTask<DBLTYPE>;
+template struct TetrahedronEdgeAssembleJacobianTask<DBLTYPE>;
+template struct NodeAssembleRHSTask<DBLTYPE>;
+template struct NodeAssembleJacobianTask<DBLTYPE>;
+template struct NodeListAssembleRHSTask<DBLTYPE>;
+template struct NodeListAssembleJacobianTask<DBLTYPE>;
+
+template void AssembleRun<EdgeAssembleRHSTask<DBLTYPE> >(EdgeAssembleRHSTask<DBLTYPE> &, size_t);
+template void AssembleRun<EdgeAssembleJacobianTask<DBLTYPE> >(EdgeAssembleJacobianTask<DBLTYPE> &, size_t);
+template void AssembleRun<TriangleEdgeAssembleRHSTask<DBLTYPE> >(TriangleEdgeAssembleRHSTask<DBLTYPE> &, size_t);
+template void AssembleRun<TriangleEdgeAssembleJacobianTask<DBLTYPE> >(TriangleEdgeAssembleJacobianTask<DBLTYPE> &, size_t);
+template void AssembleRun<TetrahedronEdgeAssembleRHSTask<DBLTYPE> >(TetrahedronEdgeAssembleRHSTask<DBLTYPE> &, size_t);
+template void AssembleRun<TetrahedronEdgeAssembleJacobianTask<DBLTYPE> >(TetrahedronEdgeAssembleJacobianTask<DBLTYPE> &, size_t);
+template void AssembleRun<NodeAssembleRHSTask<DBLTYPE> >(NodeAssembleRHSTask<DBLTYPE> &, size_t);
+template void AssembleRun<NodeAssembleJacobianTask<DBLTYPE> >(NodeAssembleJacobianTask<DBLTYPE> &, size_t);
+template void AssembleRun<NodeListAssembleRHSTask<DBLTYPE> >(NodeListAssembleRHSTask<DBLTYPE> &, size_t);
+template void AssembleRun<NodeListAssembleJacobianTask<DBLTYPE> >(NodeListAssembleJacobianTask<DBLTYPE> &, size_t);
+
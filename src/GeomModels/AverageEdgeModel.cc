@@ -23,8 +23,6 @@ limitations under the License.
 #include "EdgeSubModel.hh"
 #include "NodeModel.hh"
 #include "EdgeScalarData.hh"
-#include "Edge.hh"
-#include "Node.hh"
 #include "ModelErrors.hh"
 
 #include <cmath>
@@ -230,13 +228,14 @@ void AverageEdgeModel<DoubleType>::doMath(ConstNodeModelPtr nmp, EdgeScalarList<
 {
   const NodeScalarList<DoubleType> &nlist = nmp->GetScalarValues<DoubleType>();
 
-  const ConstEdgeList &edgeList = GetRegion().GetEdgeList();
-  elist.resize(edgeList.size());
-  for (size_t i = 0; i < edgeList.size(); ++i)
+  const Region &region = GetRegion();
+  const MeshTopology &topology = region.GetTopology();
+  elist.resize(region.GetNumberEdges());
+  for (size_t i = 0; i < elist.size(); ++i)
   {
-    const Edge &edge = *edgeList[i];
-    const size_t ni0 = edge.GetHead()->GetIndex();
-    const size_t ni1 = edge.GetTail()->GetIndex();
+    const MeshTopology::index_t *nl = topology.GetEdgeNodes(i);
+    const size_t ni0 = nl[0];
+    const size_t ni1 = nl[1];
     elist[i] = eval(nlist[ni0], nlist[ni1]);
   }
 }
@@ -246,19 +245,21 @@ void AverageEdgeModel<DoubleType>::doMath(ConstNodeModelPtr nmp, ConstNodeModelP
 {
   const NodeScalarList<DoubleType> &nlist = nmp->GetScalarValues<DoubleType>();
 
-  const ConstEdgeList &edgeList = GetRegion().GetEdgeList();
-  elist0.resize(edgeList.size());
-  elist1.resize(edgeList.size());
+  const Region &region = GetRegion();
+  const MeshTopology &topology = region.GetTopology();
+  const size_t numedges = region.GetNumberEdges();
+  elist0.resize(numedges);
+  elist1.resize(numedges);
 
   //// handle if the derivative model isn't available.  Implied a derivative w.r.t. itself
   if (nmp_d)
   {
     const NodeScalarList<DoubleType> &nlist_d = nmp_d->GetScalarValues<DoubleType>();
-    for (size_t i = 0; i < edgeList.size(); ++i)
+    for (size_t i = 0; i < numedges; ++i)
     {
-      const Edge &edge = *edgeList[i];
-      const size_t ni0 = edge.GetHead()->GetIndex();
-      const size_t ni1 = edge.GetTail()->GetIndex();
+      const MeshTopology::index_t *nl = topology.GetEdgeNodes(i);
+      const size_t ni0 = nl[0];
+      const size_t ni1 = nl[1];
       const std::pair<DoubleType, DoubleType> &out = eval(nlist[ni0], nlist_d[ni0], nlist[ni1], nlist_d[ni1]);
       elist0[i] = out.first;
       elist1[i] = out.second;
@@ -266,11 +267,11 @@ void AverageEdgeModel<DoubleType>::doMath(ConstNodeModelPtr nmp, ConstNodeModelP
   }
   else
   {
-    for (size_t i = 0; i < edgeList.size(); ++i)
+    for (size_t i = 0; i < numedges; ++i)
     {
-      const Edge &edge = *edgeList[i];
-      const size_t ni0 = edge.GetHead()->GetIndex();
-      const size_t ni1 = edge.GetTail()->GetIndex();
+      const MeshTopology::index_t *nl = topology.GetEdgeNodes(i);
+      const size_t ni0 = nl[0];
+      const size_t ni1 = nl[1];
       static const DoubleType one(1.0);
       const std::pair<DoubleType, DoubleType> &out = eval(nlist[ni0], one, nlist[ni1], one);
       elist0[i] = out.first;
@@ -294,11 +295,12 @@ void AverageEdgeModel<DoubleType>::doGradient(ConstNodeModelPtr nmp, EdgeScalarL
   }
   const EdgeScalarList<DoubleType> &invLen = em->GetScalarValues<DoubleType>();
 
+  const MeshTopology &topology = region.GetTopology();
   for (size_t i = 0; i < edgeList.size(); ++i)
   {
-    const Edge &edge = *edgeList[i];
-    const DoubleType ni0 = nlist[edge.GetHead()->GetIndex()];
-    const DoubleType ni1 = nlist[edge.GetTail()->GetIndex()];
+    const MeshTopology::index_t *nl = topology.GetEdgeNodes(i);
+    const DoubleType ni0 = nlist[nl[0]];
+    const DoubleType ni1 = nlist[nl[1]];
     const DoubleType ev  = scl * invLen[i];
     elist[i] = ev * (ni1 - ni0);
   }
@@ -324,12 +326,13 @@ void AverageEdgeModel<DoubleType>::doGradient(ConstNodeModelPtr /*nmp*/, ConstNo
   if (nmp_d)
   {
     const NodeScalarList<DoubleType> &nlist_d = nmp_d->GetScalarValues<DoubleType>();
+    const MeshTopology &topology = region.GetTopology();
     for (size_t i = 0; i < edgeList.size(); ++i)
     {
-      const Edge &edge = *edgeList[i];
+      const MeshTopology::index_t *nl = topology.GetEdgeNodes(i);
       const DoubleType ev  = scl * invLen[i];
-      const DoubleType ni0d = nlist_d[edge.GetHead()->GetIndex()];
-      const DoubleType ni1d = nlist_d[edge.GetTail()->GetIndex()];
+      const DoubleType ni0d = nlist_d[nl[0]];
+      const DoubleType ni1d = nlist_d[nl[1]];
       elist0[i] = -ev * ni0d;
       elist1[i] =  ev * ni1d;
     }
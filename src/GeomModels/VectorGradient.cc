@@ -84,11 +84,12 @@ void VectorGradient<DoubleType>::calc1d() const
 
   std::vector<size_t> zlist(el.size(), 1);
 
+  const MeshTopology &topology = r.GetTopology();
   for (size_t i = 0; i < el.size(); ++i)
   {
-    const Edge &edge = *el[i];
-    const DoubleType s0 = nsl[edge.GetHead()->GetIndex()];
-    const DoubleType s1 = nsl[edge.GetTail()->GetIndex()];
+    const MeshTopology::index_t *nl = topology.GetEdgeNodes(i);
+    const DoubleType s0 = nsl[nl[0]];
+    const DoubleType s1 = nsl[nl[1]];
 
     vgrad[i] *= (s1 - s0);
 
@@ -99,15 +100,14 @@ void VectorGradient<DoubleType>::calc1d() const
   }
 
   NodeScalarList<DoubleType> vx(nsl.size());
-  const Region::NodeToConstEdgeList_t &ntelist = r.GetNodeToEdgeList();
   for (size_t i = 0; i < vx.size(); ++i)
   {
-    const ConstEdgeList &el = ntelist[i];
+    const MeshTopology::index_t *eend = topology.GetNodeEdgesEnd(i);
     size_t count = 0;
     DoubleType val = 0.0;
-    for (ConstEdgeList::const_iterator eit = el.begin(); eit != el.end(); ++eit)
+    for (const MeshTopology::index_t *eit = topology.GetNodeEdgesBegin(i); eit != eend; ++eit)
     {
-      const size_t eindex = (*eit)->GetIndex();
+      const size_t eindex = *eit;
       if (zlist[eindex] != 0)
       {
         val += vgrad[eindex];
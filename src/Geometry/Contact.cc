@@ -17,6 +17,7 @@ limitations under the License.
 
 #include "Contact.hh"
 #include "Region.hh"
+#include "Device.hh"
 #include "Node.hh"
 #include "ContactEquationHolder.hh"
 #include "GeometryStream.hh"
@@ -112,6 +113,9 @@ void Contact::AddEquation(ContactEquationHolder &eq)
   const std::string nm  = eq.GetName();
   const std::string var = eq.GetVariable();
 
+  //// active nodes of the other contact equations may change
+  const_cast<DevicePtr>(GetRegion()->GetDevice())->SignalBoundaryChange();
+
   if (contactEquationPtrMap.count(nm))
   {
     ContactEquationHolder &oeq = contactEquationPtrMap[nm];
@@ -177,6 +181,8 @@ void Contact::DeleteEquation(ContactEquationHolder &eq)
 
   contactEquationPtrMap.erase(nm);
   variableEquationMap.erase(var);
+
+  const_cast<DevicePtr>(GetRegion()->GetDevice())->SignalBoundaryChange();
 }
 
 ContactEquationPtrMap_t &Contact::GetEquationPtrList()
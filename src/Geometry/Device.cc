@@ -32,7 +32,7 @@ limitations under the License.
 #include <vector>
 
 Device::Device(std::string devname, size_t dim)
-    : baseeqnnum(size_t(-1)), relError(0.0), absError(0.0)
+    : baseeqnnum(size_t(-1)), boundaryVersion(0), relError(0.0), absError(0.0)
 {
    dsAssert(!devname.empty(), "UNEXPECTED");
    deviceName = devname;
@@ -97,6 +97,7 @@ void Device::AddContact(const ContactPtr &cp)
    // There can be only one
    dsAssert(contactList.count(nm) == 0, "UNEXPECTED");
    contactList[nm]=cp;
+   SignalBoundaryChange();
 
    ConstRegionPtr crp = cp->GetRegion();
    (const_cast<RegionPtr>(crp))->SignalCallbacks("@@@ContactChange");
@@ -152,6 +153,7 @@ void Device::AddInterface(const InterfacePtr &ip)
    dsAssert(interfaceList.count(nm) == 0, "UNEXPECTED");
 
    interfaceList[nm]=ip;
+   SignalBoundaryChange();
 
     
    (const_cast<RegionPtr>(ip->GetRegion0()))->SignalCallbacks("@@@InterfaceChange");
@@ -422,6 +424,15 @@ void Device::RestoreSolutions(const std::string &suffix)
     }
 }
 
+void Device::ClearRecomputedModels()
+{
+    RegionList_t::iterator rit = regionList.begin();
+    for ( ; rit != regionList.end(); ++rit)
+    {
+        (rit->second)->ClearRecomputedModels();
+    }
+}
+
 void Device::UpdateContacts()
 {
   ContactList_t::iterator it = contactList.begin(); 
@@ -91,6 +91,9 @@ class Device
       void NoiseUpdate(const std::string &/*output*/, const std::vector<size_t> &/*permvec*/, const std::vector<std::complex<DoubleType> > &/*result*/);
 
       void UpdateContacts();
+
+      // called before each assembly, see Region::GetRecomputedModels
+      void ClearRecomputedModels();
       // Need to be careful with accessors and stuff
       // maintaining constness of contact
       void AddContact(const ContactPtr &);
@@ -181,6 +184,19 @@ class Device
 
     void SignalCallbacksOnInterface(const std::string &/*str*/, const Region *) const;
 
+    //// Changes whenever a contact, an interface, or one of their equations
+    //// is added or removed.  Lists of active contact and interface nodes
+    //// depend on all of these, and are rebuilt when this changes.
+    size_t GetBoundaryVersion() const
+    {
+      return boundaryVersion;
+    }
+
+    void SignalBoundaryChange()
+    {
+      ++boundaryVersion;
+    }
+
    private:
       Device();
       Device (const Device &);
@@ -201,6 +217,8 @@ class Device
 
       size_t baseeqnnum; // base equation number for this region
 
+      size_t boundaryVersion;
+
 #ifdef DEVSIM_EXTENDED_PRECISION
       float128 relError;
       float128 absError;
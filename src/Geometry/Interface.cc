@@ -21,6 +21,7 @@ limitations under the License.
 #include "GeometryStream.hh"
 #include "dsAssert.hh"
 #include "Region.hh"
+#include "Device.hh"
 #include "Node.hh"
 #include "Edge.hh"
 #include "Triangle.hh"
@@ -56,6 +57,10 @@ const std::string &Interface::GetDeviceName() const
 void Interface::AddInterfaceEquation(InterfaceEquationHolder &iep)
 {
     const std::string &name = iep.GetName();
+
+    //// active nodes of the other interface equations may change
+    const_cast<DevicePtr>(GetRegion0()->GetDevice())->SignalBoundaryChange();
+
     InterfaceEquationPtrMap_t::iterator it = interfaceEquationList.find(name);
     if (it == interfaceEquationList.end())
     {
@@ -80,6 +85,7 @@ void Interface::DeleteInterfaceEquation(InterfaceEquationHolder &iep)
       dsAssert(iep == it->second, "UNEXPECTED");
       std::ostringstream os; 
       interfaceEquationList.erase(it);
+      const_cast<DevicePtr>(GetRegion0()->GetDevice())->SignalBoundaryChange();
     }
 }
 
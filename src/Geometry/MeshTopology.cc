@@ -0,0 +1,126 @@
+/***
+DEVSIM
+Copyright 2013 Devsim LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+***/
+
+#include "MeshTopology.hh"
+#include "Region.hh"
+#include "Node.hh"
+#include "Edge.hh"
+#include "EdgeData.hh"
+#include "Triangle.hh"
+#include "Tetrahedron.hh"
+#include "dsAssert.hh"
+
+#include <limits>
+
+void MeshTopology::clear()
+{
+  std::vector<index_t>().swap(edgeToNode);
+  std::vector<index_t>().swap(nodeToEdgeOffset);
+  std::vector<index_t>().swap(nodeToEdge);
+  std::vector<index_t>().swap(triangleToNode);
+  std::vector<index_t>().swap(triangleToEdge);
+  std::vector<index_t>().swap(tetrahedronToNode);
+  std::vector<index_t>().swap(tetrahedronToEdge);
+  std::vector<index_t>().swap(tetrahedronEdgeOpposite);
+}
+
+/// Requires the indexes and the element to edge lists to be set
+void MeshTopology::Create(const Region &region)
+{
+  clear();
+
+  const ConstNodeList        &nodeList        = region.GetNodeList();
+  const ConstEdgeList        &edgeList        = region.GetEdgeList();
+  const ConstTriangleList    &triangleList    = region.GetTriangleList();
+  const ConstTetrahedronList &tetrahedronList = region.GetTetrahedronList();
+
+  const size_t max_index = static_cast<size_t>(std::numeric_limits<index_t>::max());
+  dsAssert(nodeList.size() < max_index, "UNEXPECTED");
+  dsAssert(2 * edgeList.size() < max_index, "UNEXPECTED");
+  dsAssert(triangleList.size() < max_index, "UNEXPECTED");
+  dsAssert(tetrahedronList.size() < max_index, "UNEXPECTED");
+
+  edgeToNode.resize(2 * edgeList.size());
+  nodeToEdgeOffset.assign(nodeList.size() + 1, 0);
+  for (size_t i = 0; i < edgeList.size(); ++i)
+  {
+    const Edge &edge = *edgeList[i];
+    const index_t nh = static_cast<index_t>(edge.GetHead()->GetIndex());
+    const index_t nt = static_cast<index_t>(edge.GetTail()->GetIndex());
+    edgeToNode[2*i]     = nh;
+    edgeToNode[2*i + 1] = nt;
+    ++nodeToEdgeOffset[nh + 1];
+    ++nodeToEdgeOffset[nt + 1];
+  }
+
+  for (size_t i = 0; i < nodeList.size(); ++i)
+  {
+    nodeToEdgeOffset[i + 1] += nodeToEdgeOffset[i];
+  }
+
+  //// edges are visited in index order, same as GetNodeToEdgeList
+  nodeToEdge.resize(2 * edgeList.size());
+  std::vector<index_t> fill(nodeToEdgeOffset.begin(), nodeToEdgeOffset.end() - 1);
+  for (size_t i = 0; i < edgeList.size(); ++i)
+  {
+    nodeToEdge[fill[edgeToNode[2*i]]++]     = static_cast<index_t>(i);
+    nodeToEdge[fill[edgeToNode[2*i + 1]]++] = static_cast<index_t>(i);
+  }
+
+  const Region::TriangleToConstEdgeList_t &ttelist = region.GetTriangleToEdgeList();
+  if (!ttelist.empty())
+  {
+    triangleToNode.resize(3 * triangleList.size());
+    triangleToEdge.resize(3 * triangleList.size());
+    for (size_t i = 0; i < triangleList.size(); ++i)
+    {
+      const ConstNodeList &nl = triangleList[i]->GetNodeList();
+      const ConstEdgeList &el = ttelist[i];
+      for (size_t j = 0; j < 3; ++j)
+      {
+        triangleToNode[3*i + j] = static_cast<index_t>(nl[j]->GetIndex());
+        triangleToEdge[3*i + j] = static_cast<index_t>(el[j]->GetIndex());
+      }
+    }
+  }
+
+  const Region::TetrahedronToConstEdgeDataList_t &ttedlist = region.GetTetrahedronToEdgeDataList();
+  if (!ttedlist.empty())
+  {
+    tetrahedronToNode.resize(4 * tetrahedronList.size());
+    tetrahedronToEdge.resize(6 * tetrahedronList.size());
+    tetrahedronEdgeOpposite.resize(12 * tetrahedronList.size());
+    for (size_t i = 0; i < tetrahedronList.size(); ++i)
+    {
+      const ConstNodeList &nl = tetrahedronList[i]->GetNodeList();
+      for (size_t j = 0; j < 4; ++j)
+      {
+        tetrahedronToNode[4*i + j] = static_cast<index_t>(nl[j]->GetIndex());
+      }
+
+      const ConstEdgeDataList &edl = ttedlist[i];
+      for (size_t j = 0; j < 6; ++j)
+      {
+        const EdgeData &edata = *edl[j];
+        tetrahedronToEdge[6*i + j]               = static_cast<index_t>(edata.edge->GetIndex());
+        tetrahedronEdgeOpposite[12*i + 2*j]     = static_cast<index_t>(edata.nodeopp[0]->GetIndex());
+        tetrahedronEdgeOpposite[12*i + 2*j + 1] = static_cast<index_t>(edata.nodeopp[1]->GetIndex());
+      }
+    }
+  }
+}
+
@@ -0,0 +1,102 @@
+/***
+DEVSIM
+Copyright 2013 Devsim LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+***/
+
+#ifndef MESH_TOPOLOGY_HH
+#define MESH_TOPOLOGY_HH
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+class Region;
+
+//// Connectivity of a finalized region, stored as contiguous arrays of local
+//// indexes.  This is a compact copy of the pointer based lists in Region,
+//// meant for loops visiting every edge or element, where chasing pointers
+//// through Edge, Triangle and Tetrahedron objects costs cache misses.
+////
+//// Element edges are in the same order as GetTriangleToEdgeList and
+//// GetTetrahedronToEdgeDataList, so element edge model data can be indexed
+//// the same way.
+class MeshTopology {
+  public:
+    typedef std::int32_t index_t;
+
+    MeshTopology() {}
+
+    void Create(const Region &);
+    void clear();
+
+    /// head and tail of edge i
+    const index_t *GetEdgeNodes(size_t i) const
+    {
+      return &edgeToNode[2*i];
+    }
+
+    /// edges of node i are in [GetNodeEdgesBegin(i), GetNodeEdgesEnd(i))
+    const index_t *GetNodeEdgesBegin(size_t i) const
+    {
+      return nodeToEdge.data() + nodeToEdgeOffset[i];
+    }
+
+    const index_t *GetNodeEdgesEnd(size_t i) const
+    {
+      return nodeToEdge.data() + nodeToEdgeOffset[i + 1];
+    }
+
+    /// edge j of the triangle is opposite of node j
+    const index_t *GetTriangleNodes(size_t i) const
+    {
+      return &triangleToNode[3*i];
+    }
+
+    const index_t *GetTriangleEdges(size_t i) const
+    {
+      return &triangleToEdge[3*i];
+    }
+
+    const index_t *GetTetrahedronNodes(size_t i) const
+    {
+      return &tetrahedronToNode[4*i];
+    }
+
+    const index_t *GetTetrahedronEdges(size_t i) const
+    {
+      return &tetrahedronToEdge[6*i];
+    }
+
+    /// for edge j of the tetrahedron, the 2 nodes opposite of it on the
+    /// triangles sharing the edge, in the same order as EdgeData::nodeopp
+    const index_t *GetTetrahedronEdgeOppositeNodes(size_t i, size_t j) const
+    {
+      return &tetrahedronEdgeOpposite[12*i + 2*j];
+    }
+
+  private:
+    MeshTopology(const MeshTopology &);
+    MeshTopology &operator=(const MeshTopology &);
+
+    std::vector<index_t> edgeToNode;
+    std::vector<index_t> nodeToEdgeOffset;
+    std::vector<index_t> nodeToEdge;
+    std::vector<index_t> triangleToNode;
+    std::vector<index_t> triangleToEdge;
+    std::vector<index_t> tetrahedronToNode;
+    std::vector<index_t> tetrahedronToEdge;
+    std::vector<index_t> tetrahedronEdgeOpposite;
+};
+#endif
+
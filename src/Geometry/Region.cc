@@ -39,12 +39,16 @@ limitations under the License.
 #include "InterfaceNodeModel.hh"
 
 #include "dsAssert.hh"
+#include "PhaseTimer.hh"
+#include "parallel_for.hh"
 
 #include <algorithm>
 #include <vector>
 #include <map>
 #include <string>
 #include <iterator>
+#include <chrono>
+#include <sstream>
 namespace {
 template <typename T> void deleteVectorPointers(std::vector<T *> &x)
 {
@@ -101,6 +105,287 @@ const Node *findNodeOppositeOfTriangleEdge(const Edge &edge, const Triangle &tri
 }
 }// anonymous namespace
 
+namespace {
+//// true when the element has all of the nodes
+template <typename T>
+bool hasNodes(const T &element, const ConstNodePtr *nodes, size_t nlen)
+{
+  const ConstNodeList &nl = element.GetNodeList();
+  for (size_t i = 0; i < nlen; ++i)
+  {
+    if (std::find(nl.begin(), nl.end(), nodes[i]) == nl.end())
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+//// Appends the candidates having all of the nodes, keeping their order.
+//// When the candidates are the sorted element list of one node, this gives
+//// the same result as intersecting the sorted lists of every node.
+template <typename T>
+void appendElementsWithNodes(const std::vector<const T *> &candidates, const ConstNodePtr *nodes, size_t nlen, std::vector<const T *> &out)
+{
+  for (typename std::vector<const T *>::const_iterator it = candidates.begin(); it != candidates.end(); ++it)
+  {
+    if (hasNodes(**it, nodes, nlen))
+    {
+      out.push_back(*it);
+    }
+  }
+}
+
+template <typename T>
+const T *findElementWithNodes(const std::vector<const T *> &candidates, const ConstNodePtr *nodes, size_t nlen)
+{
+  for (typename std::vector<const T *>::const_iterator it = candidates.begin(); it != candidates.end(); ++it)
+  {
+    if (hasNodes(**it, nodes, nlen))
+    {
+      return *it;
+    }
+  }
+  return NULL;
+}
+
+//// The tasks below each write the entries of their own range of elements,
+//// so the results do not depend on the number of threads.
+//// They must not call dsAssert, the callers check the results afterwards.
+
+//// Elements on both nodes of each edge, sorted by index
+template <typename T>
+class EdgeToElementTask : public myrangetask {
+  public:
+    typedef std::vector<std::vector<const T *> > list_t;
+
+    EdgeToElementTask(const ConstEdgeList &el, const list_t &ntl, list_t &etl) : edgeList_(el), nodeToElementList_(ntl), edgeToElementList_(etl)
+    {
+    }
+
+    void operator()(const size_t b, const size_t e) const
+    {
+      for (size_t i = b; i < e; ++i)
+      {
+        const Edge &edge = *edgeList_[i];
+        ConstNodePtr nh = edge.GetHead();
+        ConstNodePtr nt = edge.GetTail();
+
+        const std::vector<const T *> &nht = nodeToElementList_[nh->GetIndex()];
+        const std::vector<const T *> &ntt = nodeToElementList_[nt->GetIndex()];
+
+        //// scan the shorter list for the other node
+        if (nht.size() <= ntt.size())
+        {
+          appendElementsWithNodes(nht, &nt, 1, edgeToElementList_[i]);
+        }
+        else
+        {
+          appendElementsWithNodes(ntt, &nh, 1, edgeToElementList_[i]);
+        }
+      }
+    }
+
+  private:
+    const ConstEdgeList &edgeList_;
+    const list_t        &nodeToElementList_;
+    list_t              &edgeToElementList_;
+};
+
+//// Enforces that edge j is opposite of node j
+class TriangleToEdgeTask : public myrangetask {
+  public:
+    TriangleToEdgeTask(const Region &r, Region::TriangleToConstEdgeList_t &tel) : region_(r), triangleToEdgeList_(tel)
+    {
+    }
+
+    void operator()(const size_t b, const size_t e) const
+    {
+      const ConstTriangleList &triangleList = region_.GetTriangleList();
+      for (size_t i = b; i < e; ++i)
+      {
+        const ConstNodeList &nl = triangleList[i]->GetNodeList();
+        ConstEdgeList &el = triangleToEdgeList_[i];
+        el.resize(3);
+        for (size_t j = 0; j < 3; ++j)
+        {
+          el[j] = region_.FindEdge(nl[(j + 1) % 3], nl[(j + 2) % 3]);
+        }
+      }
+    }
+
+  private:
+    const Region                      &region_;
+    Region::TriangleToConstEdgeList_t &triangleToEdgeList_;
+};
+
+class TriangleToTetrahedronTask : public myrangetask {
+  public:
+    TriangleToTetrahedronTask(const Region &r, Region::TriangleToConstTetrahedronList_t &ttl) : region_(r), triangleToTetrahedronList_(ttl)
+    {
+    }
+
+    void operator()(const size_t b, const size_t e) const
+    {
+      const ConstTriangleList &triangleList = region_.GetTriangleList();
+      const Region::NodeToConstTetrahedronList_t &ntt = region_.GetNodeToTetrahedronList();
+      for (size_t i = b; i < e; ++i)
+      {
+        const ConstNodeList &cnl = triangleList[i]->GetNodeList();
+        appendElementsWithNodes(ntt[cnl[0]->GetIndex()], &cnl[1], 2, triangleToTetrahedronList_[i]);
+      }
+    }
+
+  private:
+    const Region                             &region_;
+    Region::TriangleToConstTetrahedronList_t &triangleToTetrahedronList_;
+};
+
+//// Enforces that triangle j is opposite of node j
+class TetrahedronToTriangleTask : public myrangetask {
+  public:
+    TetrahedronToTriangleTask(const Region &r, Region::TetrahedronToConstTriangleList_t &ttl) : region_(r), tetrahedronToTriangleList_(ttl)
+    {
+    }
+
+    void operator()(const size_t b, const size_t e) const
+    {
+      const ConstTetrahedronList &tetrahedronList = region_.GetTetrahedronList();
+      for (size_t i = b; i < e; ++i)
+      {
+        const ConstNodeList &nl = tetrahedronList[i]->GetNodeList();
+        ConstTriangleList &el = tetrahedronToTriangleList_[i];
+        el.resize(4);
+        for (size_t j = 0; j < 4; ++j)
+        {
+          el[j] = region_.FindTriangle(nl[(j + 1) % 4], nl[(j + 2) % 4], nl[(j + 3) % 4]);
+        }
+      }
+    }
+
+  private:
+    const Region                             &region_;
+    Region::TetrahedronToConstTriangleList_t &tetrahedronToTriangleList_;
+};
+
+//// The edges of each tetrahedron are sorted by index, which is the order the
+//// edges used to be visited in
+class TetrahedronToEdgeDataTask : public myrangetask {
+  public:
+    TetrahedronToEdgeDataTask(const Region &r, Region::TetrahedronToConstEdgeDataList_t &tel, std::vector<char> &valid) : region_(r), tetrahedronToEdgeDataList_(tel), valid_(valid)
+    {
+    }
+
+    void operator()(const size_t b, const size_t e) const
+    {
+      const ConstTetrahedronList &tetrahedronList = region_.GetTetrahedronList();
+      const Region::TetrahedronToConstTriangleList_t &ttl = region_.GetTetrahedronToTriangleList();
+      const Region::TriangleToConstEdgeList_t &tel = region_.GetTriangleToEdgeList();
+
+      for (size_t i = b; i < e; ++i)
+      {
+        const ConstNodeList &nl = tetrahedronList[i]->GetNodeList();
+
+        ConstEdgePtr edges[6];
+        size_t elen = 0;
+        for (size_t j = 0; j < 3; ++j)
+        {
+          for (size_t k = j + 1; k < 4; ++k)
+          {
+            ConstEdgePtr eptr = region_.FindEdge(nl[j], nl[k]);
+            if (eptr)
+            {
+              edges[elen++] = eptr;
+            }
+          }
+        }
+        std::sort(edges, edges + elen, EdgeCompIndex());
+
+        const ConstTriangleList &trl = ttl[i];
+        ConstEdgeDataList &el = tetrahedronToEdgeDataList_[i];
+        el.reserve(elen);
+
+        bool ok = true;
+        for (size_t j = 0; j < elen; ++j)
+        {
+          ConstEdgePtr eptr = edges[j];
+          EdgeData *edata = new EdgeData();
+          edata->edge = eptr;
+          size_t trindex = 0;
+          for (size_t k = 0; k < trl.size(); ++k)
+          {
+            const Triangle &triangle = *trl[k];
+            const ConstEdgeList &triangleEdgeList = tel[triangle.GetIndex()];
+            if (std::find(triangleEdgeList.begin(), triangleEdgeList.end(), eptr) != triangleEdgeList.end())
+            {
+              if (trindex < 2)
+              {
+                edata->triangle[trindex] = trl[k];
+                edata->triangle_index[trindex] = k;
+                edata->nodeopp[trindex] = findNodeOppositeOfTriangleEdge(*eptr, triangle);
+              }
+              ++trindex;
+            }
+          }
+          ok = ok && (trindex == 2);
+          el.push_back(edata);
+        }
+        valid_[i] = ok;
+      }
+    }
+
+  private:
+    const Region                             &region_;
+    Region::TetrahedronToConstEdgeDataList_t &tetrahedronToEdgeDataList_;
+    std::vector<char>                        &valid_;
+};
+
+//// Time spent in each step of FinalizeMesh, for the verbose output
+class FinalizeTimes {
+  public:
+    FinalizeTimes() : last_(std::chrono::steady_clock::now())
+    {
+    }
+
+    /// Ends the current step
+    void Mark(const char *name)
+    {
+      const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+      times_.push_back(std::make_pair(name, std::chrono::duration<double>(now - last_).count()));
+      last_ = now;
+    }
+
+    void Write(const Region &region) const
+    {
+      //// The message is only formatted when the debug_level prints it
+      GlobalData::DBEntry_t dbent = GlobalData::GetInstance().GetDBEntryOnRegion(&region, "debug_level");
+      if (!dbent.first || (OutputStream::GetVerbosity(dbent.second.GetString()) == OutputStream::Verbosity_t::V0))
+      {
+        return;
+      }
+
+      std::ostringstream os;
+      os << "Finalized region " << region.GetName() << " on device " << region.GetDeviceName() << " with "
+         << region.GetNumberNodes() << " nodes, "
+         << region.GetNumberEdges() << " edges, "
+         << region.GetNumberTriangles() << " triangles, "
+         << region.GetNumberTetrahedrons() << " tetrahedra\n";
+      double total = 0.0;
+      for (size_t i = 0; i < times_.size(); ++i)
+      {
+        os << "  " << times_[i].first << " " << times_[i].second << " s\n";
+        total += times_[i].second;
+      }
+      os << "  total " << total << " s\n";
+      GeometryStream::WriteOut(OutputStream::OutputType::VERBOSE1, region, os.str());
+    }
+
+  private:
+    std::chrono::steady_clock::time_point last_;
+    std::vector<std::pair<const char *, double> > times_;
+};
+}// anonymous namespace
+
 
 template <typename DoubleType>
 const GradientField<DoubleType> &Region::GetGradientField() const
@@ -377,17 +662,26 @@ void Region::CreateNodeToEdgeList()
   // need to get all edges at this point
   nodeToEdgeList.clear();
   nodeToEdgeList.resize(nodeList.size());
+
+  std::vector<size_t> counts(nodeList.size());
   for (size_t i = 0; i < edgeList.size(); ++i)
   {
-    const size_t nh = edgeList[i]->GetHead()->GetIndex();
-    const size_t nt = edgeList[i]->GetTail()->GetIndex();
-    nodeToEdgeList[nh].push_back(edgeList[i]); 
-    nodeToEdgeList[nt].push_back(edgeList[i]); 
+    ++counts[edgeList[i]->GetHead()->GetIndex()];
+    ++counts[edgeList[i]->GetTail()->GetIndex()];
   }
 
   for (size_t i = 0; i < nodeToEdgeList.size(); ++i)
   {
-    std::sort(nodeToEdgeList[i].begin(), nodeToEdgeList[i].end(), EdgeCompIndex());
+    nodeToEdgeList[i].reserve(counts[i]);
+  }
+
+  //// edges are visited in index order, so each list is sorted by edge index
+  for (size_t i = 0; i < edgeList.size(); ++i)
+  {
+    const size_t nh = edgeList[i]->GetHead()->GetIndex();
+    const size_t nt = edgeList[i]->GetTail()->GetIndex();
+    nodeToEdgeList[nh].push_back(edgeList[i]); 
+    nodeToEdgeList[nt].push_back(edgeList[i]); 
   }
 }
 
@@ -396,20 +690,32 @@ void Region::CreateNodeToTriangleList()
 {
   nodeToTriangleList.clear();
   nodeToTriangleList.resize(nodeList.size());
+
+  std::vector<size_t> counts(nodeList.size());
   for (size_t i = 0; i < triangleList.size(); ++i)
   {
-    ConstTrianglePtr ctp = triangleList[i];
-    const std::vector<ConstNodePtr> &nodes = ctp->GetNodeList();
+    const std::vector<ConstNodePtr> &nodes = triangleList[i]->GetNodeList();
     for (size_t j = 0; j < nodes.size(); ++j)
     {
-      nodeToTriangleList[nodes[j]->GetIndex()].push_back(ctp);
+      ++counts[nodes[j]->GetIndex()];
     }
   }
 
-  // triangle intersection below requires sorted vectors
   for (size_t i = 0; i < nodeToTriangleList.size(); ++i)
   {
-    std::sort(nodeToTriangleList[i].begin(), nodeToTriangleList[i].end(), TriangleCompIndex());
+    nodeToTriangleList[i].reserve(counts[i]);
+  }
+
+  // triangle intersection below requires sorted vectors
+  // triangles are visited in index order, so each list is sorted
+  for (size_t i = 0; i < triangleList.size(); ++i)
+  {
+    ConstTrianglePtr ctp = triangleList[i];
+    const std::vector<ConstNodePtr> &nodes = ctp->GetNodeList();
+    for (size_t j = 0; j < nodes.size(); ++j)
+    {
+      nodeToTriangleList[nodes[j]->GetIndex()].push_back(ctp);
+    }
   }
 }
 
@@ -419,62 +725,57 @@ void Region::CreateNodeToTetrahedronList()
 {
   nodeToTetrahedronList.clear();
   nodeToTetrahedronList.resize(nodeList.size());
+
+  std::vector<size_t> counts(nodeList.size());
   for (size_t i = 0; i < tetrahedronList.size(); ++i)
   {
-    ConstTetrahedronPtr ctp = tetrahedronList[i];
-//    std::cerr << "ctp " << ctp->GetIndex() << "\n";
-    const std::vector<ConstNodePtr> &nodes = ctp->GetNodeList();
-//    dsAssert(nodes.size() == 4, "UNEXPECTED");
+    const std::vector<ConstNodePtr> &nodes = tetrahedronList[i]->GetNodeList();
     for (size_t j = 0; j < nodes.size(); ++j)
     {
-      nodeToTetrahedronList[nodes[j]->GetIndex()].push_back(ctp);
-//      std::cerr << nodes[j]->GetIndex() << " " << j << " " << ctp->GetIndex() << "\n";
+      ++counts[nodes[j]->GetIndex()];
     }
   }
 
-  // tetrahedron intersection below requires sorted vectors
   for (size_t i = 0; i < nodeToTetrahedronList.size(); ++i)
   {
-    std::sort(nodeToTetrahedronList[i].begin(), nodeToTetrahedronList[i].end(), TetrahedronCompIndex());
+    nodeToTetrahedronList[i].reserve(counts[i]);
+  }
+
+  // tetrahedron intersection below requires sorted vectors
+  // tetrahedra are visited in index order, so each list is sorted
+  for (size_t i = 0; i < tetrahedronList.size(); ++i)
+  {
+    ConstTetrahedronPtr ctp = tetrahedronList[i];
+    const std::vector<ConstNodePtr> &nodes = ctp->GetNodeList();
+    for (size_t j = 0; j < nodes.size(); ++j)
+    {
+      nodeToTetrahedronList[nodes[j]->GetIndex()].push_back(ctp);
+    }
   }
 }
 
 /// Requires Node, edge, and triangle indices to be set
-/// The STL intersection requires to triangle indexes in
+/// The search requires the triangle indexes in
 /// nodeToTriangleList to be sorted
 void Region::CreateEdgeToTriangleList()
 {
   edgeToTriangleList.clear();
   edgeToTriangleList.resize(edgeList.size());
 
-  ConstTriangleList nout;
+  //// Given:
+  ////   list of triangles on head node of edge
+  ////   list of triangles on tail node of edge
+  ////   find all triangles connect to both nodes
+  EdgeToElementTask<Triangle> task(edgeList, nodeToTriangleList, edgeToTriangleList);
+  parallel_for(task, edgeList.size());
 
-  for (size_t i = 0; i < edgeList.size(); ++i)
+  if (dimension == 2)
   {
-    const size_t nh = edgeList[i]->GetHead()->GetIndex();
-    const size_t nt = edgeList[i]->GetTail()->GetIndex();
-
-    // need these to be sorted ranges so do sort above
-    const ConstTriangleList &nht = GetNodeToTriangleList()[nh];
-    const ConstTriangleList &ntt = GetNodeToTriangleList()[nt];
-
-    nout.clear();
-    //// Given:
-    ////   list of triangles on head node of edge
-    ////   list of triangles on tail node of edge
-    ////   find all triangles connect to both nodes
-    set_intersection(nht.begin(), nht.end(),
-      ntt.begin(), ntt.end(),
-      std::insert_iterator<ConstTriangleList>(nout, nout.begin()),
-      TriangleCompIndex()
-    );
-
-    if (dimension == 2)
+    for (size_t i = 0; i < edgeToTriangleList.size(); ++i)
     {
-      dsAssert(nout.size()==1 || nout.size()==2, "UNEXPECTED"); // only expect an edge to have up to 2 triangles
+      const size_t tlen = edgeToTriangleList[i].size();
+      dsAssert(tlen==1 || tlen==2, "UNEXPECTED"); // only expect an edge to have up to 2 triangles
     }
-
-    edgeToTriangleList[i] = nout;
   }
 }
 
@@ -484,34 +785,11 @@ void Region::CreateEdgeToTetrahedronList()
   edgeToTetrahedronList.clear();
   edgeToTetrahedronList.resize(edgeList.size());
 
-  ConstTetrahedronList nout;
-
-  for (size_t i = 0; i < edgeList.size(); ++i)
-  {
-    const size_t nh = edgeList[i]->GetHead()->GetIndex();
-    const size_t nt = edgeList[i]->GetTail()->GetIndex();
-
-    // need these to be sorted ranges so do sort above
-    const ConstTetrahedronList &nht = GetNodeToTetrahedronList()[nh];
-    const ConstTetrahedronList &ntt = GetNodeToTetrahedronList()[nt];
-
-    nout.clear();
-    //// Given:
-    ////   list of tetrahedrons on head node of edge
-    ////   list of tetrahedrons on tail node of edge
-    ////   find all tetrahedrons connect to both nodes
-    set_intersection(nht.begin(), nht.end(),
-      ntt.begin(), ntt.end(),
-      std::insert_iterator<ConstTetrahedronList>(nout, nout.begin()),
-      TetrahedronCompIndex()
-    );
-
-    edgeToTetrahedronList[i] = nout;
-  }
+  EdgeToElementTask<Tetrahedron> task(edgeList, nodeToTetrahedronList, edgeToTetrahedronList);
+  parallel_for(task, edgeList.size());
 }
 
-/// Requires EdgeToTriangleList
-/// Create reverse mapping
+/// Requires NodeToEdgeList
 /// Enforces that triangleToEdgeList has node not on edge
 /// For example:
 // triangle.GetNodeList[0] is not on region.GetTriangleToEdgeList[0]
@@ -521,99 +799,24 @@ void Region::CreateTriangleToEdgeList()
   triangleToEdgeList.clear();
   triangleToEdgeList.resize(triangleList.size());
 
-  for (size_t i = 0; i < triangleList.size(); ++i)
-  {
-    triangleToEdgeList[i].resize(3);
-  }
-
-  for (size_t i = 0; i < edgeList.size(); ++i)
-  {
-    ConstEdgePtr eptr = edgeList[i];
-    const ConstTriangleList &tlist = GetEdgeToTriangleList()[i];
-    for (ConstTriangleList::const_iterator tit = tlist.begin(); tit != tlist.end(); ++tit)
-    {
-      const size_t tindex = (*tit)->GetIndex();
-
-      const ConstNodeList &nl = (*tit)->GetNodeList();
-      ConstEdgeList &el = triangleToEdgeList[tindex];
-
-      for (size_t j = 0; j < 3; ++j)
-      {
-        ConstNodePtr np = nl[j];
-        if (!((np == eptr->GetHead()) || (np == eptr->GetTail())))
-        {
-          el[j] = eptr;
-          break;
-        }
-      }
-    }
-  }
+  TriangleToEdgeTask task(*this, triangleToEdgeList);
+  parallel_for(task, triangleList.size());
 }
 
-//// Ripoff of CreateTriangleToEdgeList
-//// but with significant modifications
-//// no guarantee of the edge ordering on the tetrahedron
-//// just depends on the order that the edges are visited
+//// Requires TetrahedronToTriangleList and TriangleToEdgeList
+//// The edges on each tetrahedron are in index order
 void Region::CreateTetrahedronToEdgeDataList()
 {
   tetrahedronToEdgeDataList.clear();
   tetrahedronToEdgeDataList.resize(tetrahedronList.size());
 
-#if 0
-  for (size_t i = 0; i < tetrahedronList.size(); ++i)
-  {
-    tetrahedronToEdgeList[i].resize(6);
-  }
-#endif
+  std::vector<char> valid(tetrahedronList.size());
+  TetrahedronToEdgeDataTask task(*this, tetrahedronToEdgeDataList, valid);
+  parallel_for(task, tetrahedronList.size());
 
-  for (size_t i = 0; i < edgeToTetrahedronList.size(); ++i)
+  for (size_t i = 0; i < valid.size(); ++i)
   {
-    ConstEdgePtr eptr = edgeList[i];
-    const ConstTetrahedronList &tlist = GetEdgeToTetrahedronList()[i];
-    for (ConstTetrahedronList::const_iterator tit = tlist.begin(); tit != tlist.end(); ++tit)
-    {
-      const size_t teindex = (*tit)->GetIndex();
-
-      ConstEdgeDataList &el = tetrahedronToEdgeDataList[teindex];
-
-      ConstTriangleList &trl = tetrahedronToTriangleList[teindex];
-
-      EdgeData *edata = new EdgeData();
-      edata->edge = eptr;
-      const size_t eindex = eptr->GetIndex();
-      size_t trindex = 0;
-      for (size_t j = 0; j < trl.size(); ++j)
-      {
-        const Triangle &triangle = *trl[j];
-        ConstEdgeList  &triangleEdgeList = triangleToEdgeList[triangle.GetIndex()];
-        for (size_t k = 0; k < 3; ++k)
-        {
-          const size_t teindex = triangleEdgeList[k]->GetIndex();
-          if (teindex == eindex)
-          {
-            edata->triangle[trindex] = trl[j];
-            edata->triangle_index[trindex] = j;
-            edata->nodeopp[trindex] = findNodeOppositeOfTriangleEdge(*eptr, triangle);
-            ++trindex;
-            break;
-          }
-        }
-      }
-      dsAssert(trindex == 2, "UNEXPECTED");
-      el.push_back(edata);
-#if 0
-      const ConstNodeList &nl = (*tit)->GetNodeList();
-      for (size_t j = 0; j < 6; ++j)
-      {
-        ConstNodePtr np = nl[j];
-        if (!((np == eptr->GetHead()) || (np == eptr->GetTail())))
-        {
-          el[j] = eptr;
-          break;
-        }
-      }
-#endif
-    }
+    dsAssert(valid[i], "UNEXPECTED");
   }
 }
 
@@ -623,78 +826,34 @@ void Region::CreateTriangleToTetrahedronList()
   triangleToTetrahedronList.clear();
   triangleToTetrahedronList.resize(triangleList.size());
 
-  ConstTetrahedronList nout0;
-  ConstTetrahedronList nout1;
+  TriangleToTetrahedronTask task(*this, triangleToTetrahedronList);
+  parallel_for(task, triangleList.size());
 
-  for (size_t i = 0; i < triangleList.size(); ++i)
+  for (size_t i = 0; i < triangleToTetrahedronList.size(); ++i)
   {
-    const Triangle &triangle = *triangleList[i];
-    const ConstNodeList &cnl = triangle.GetNodeList();
-
-    const size_t n0 = cnl[0]->GetIndex();
-    const size_t n1 = cnl[1]->GetIndex();
-    const size_t n2 = cnl[2]->GetIndex();
-
-    // need these to be sorted ranges so do sort above
-    const ConstTetrahedronList &nt0 = GetNodeToTetrahedronList()[n0];
-    const ConstTetrahedronList &nt1 = GetNodeToTetrahedronList()[n1];
-    const ConstTetrahedronList &nt2 = GetNodeToTetrahedronList()[n2];
-
-    nout0.clear();
-    nout1.clear();
-
-    set_intersection(nt0.begin(), nt0.end(),
-      nt1.begin(), nt1.end(),
-      std::insert_iterator<ConstTetrahedronList>(nout0, nout0.begin()),
-      TetrahedronCompIndex()
-    );
-
-    set_intersection(nout0.begin(), nout0.end(),
-      nt2.begin(), nt2.end(),
-      std::insert_iterator<ConstTetrahedronList>(nout1, nout1.begin()),
-      TetrahedronCompIndex()
-    );
-
-    dsAssert(nout1.size()==1 || nout1.size()==2, "UNEXPECTED"); // only expect triangle to have up to 1 tetrahedron
-
-    triangleToTetrahedronList[i] = nout1;
+    const size_t tlen = triangleToTetrahedronList[i].size();
+    dsAssert(tlen==1 || tlen==2, "UNEXPECTED"); // only expect triangle to have up to 1 tetrahedron
   }
 }
 
+/// Requires NodeToTriangleList
+/// Enforces that tetrahedronToTriangleList has node not on triangle
 void Region::CreateTetrahedronToTriangleList()
 {
   tetrahedronToTriangleList.clear();
   tetrahedronToTriangleList.resize(tetrahedronList.size());
 
-  for (size_t i = 0; i < tetrahedronList.size(); ++i)
-  {
-    tetrahedronToTriangleList[i].resize(4);
-  }
-
-  for (size_t i = 0; i < triangleList.size(); ++i)
+  if (nodeToTriangleList.empty())
   {
-    ConstTrianglePtr tptr = triangleList[i];
-    const ConstTetrahedronList &tlist = triangleToTetrahedronList[i];
-    for (ConstTetrahedronList::const_iterator tit = tlist.begin(); tit != tlist.end(); ++tit)
+    for (size_t i = 0; i < tetrahedronList.size(); ++i)
     {
-      const size_t tindex = (*tit)->GetIndex();
-
-      const ConstNodeList &nl = (*tit)->GetNodeList();
-
-      const ConstNodeList &trnl = (tptr)->GetNodeList();
-
-      ConstTriangleList &el = tetrahedronToTriangleList[tindex];
-      for (size_t j = 0; j < 4; ++j)
-      {
-        ConstNodePtr np = nl[j];
-        if (!((np == trnl[0]) || (np == trnl[1]) || (np == trnl[2])))
-        {
-          el[j] = tptr;
-          break;
-        }
-      }
+      tetrahedronToTriangleList[i].resize(4);
     }
+    return;
   }
+
+  TetrahedronToTriangleTask task(*this, tetrahedronToTriangleList);
+  parallel_for(task, tetrahedronList.size());
 }
 
 void Region::SetTriangleCenters()
@@ -746,6 +905,10 @@ void Region::SetTetrahedronCenters()
 //Performs the sort when we are done adding nodes and edges
 void Region::FinalizeMesh()
 {
+  PhaseTimerScope timer("region_finalize");
+
+  FinalizeTimes times;
+
   SetNodeIndexes();
 
   SetEdgeIndexes();
@@ -754,14 +917,22 @@ void Region::FinalizeMesh()
 
   SetTetrahedronIndexes();
 
+  times.Mark("indexes");
+
   CreateNodeToEdgeList();
 
+  times.Mark("node_to_edge");
+
   if (!triangleList.empty())
   {
     CreateNodeToTriangleList();
+    times.Mark("node_to_triangle");
     CreateEdgeToTriangleList();
+    times.Mark("edge_to_triangle");
     CreateTriangleToEdgeList();
+    times.Mark("triangle_to_edge");
     SetTriangleCenters();
+    times.Mark("triangle_centers");
   }
 
   if (!tetrahedronList.empty())
@@ -779,14 +950,26 @@ void Region::FinalizeMesh()
     }
 #endif
     CreateNodeToTetrahedronList();
+    times.Mark("node_to_tetrahedron");
     CreateEdgeToTetrahedronList();
+    times.Mark("edge_to_tetrahedron");
     CreateTriangleToTetrahedronList();
+    times.Mark("triangle_to_tetrahedron");
     CreateTetrahedronToTriangleList();
+    times.Mark("tetrahedron_to_triangle");
     CreateTetrahedronToEdgeDataList();
+    times.Mark("tetrahedron_to_edge_data");
     SetTetrahedronCenters();
+    times.Mark("tetrahedron_centers");
   }
 
+  topology.Create(*this);
+
+  times.Mark("topology");
+
   finalized = true;
+
+  times.Write(*this);
 }
 
 
@@ -1075,12 +1258,34 @@ TetrahedronEdgeModelPtr Region::AddTetrahedronEdgeModel(TetrahedronEdgeModel *em
 }
 
 
+size_t Region::GetDependencyId(const std::string &str)
+{
+  DependencyIdMap_t::iterator it = dependencyIds.find(str);
+  if (it != dependencyIds.end())
+  {
+    return it->second;
+  }
+
+  const size_t id = dependencyNames.size();
+  dependencyIds[str] = id;
+  dependencyNames.push_back(str);
+  dependents.resize(id + 1);
+  signalCount.resize(id + 1, 0);
+  recomputedFlags.resize(id + 1, 0);
+  return id;
+}
+
 /*
  * No differentation between NodeModels or EdgeModels
  */
 void Region::RegisterCallback(const std::string &mod, const std::string &dep)
 {
-    DependencyMap[mod].insert(dep);
+    if (DependencyMap[mod].insert(dep).second)
+    {
+        const size_t modid = GetDependencyId(mod);
+        const size_t depid = GetDependencyId(dep);
+        dependents[depid].push_back(modid);
+    }
 }
 
 void Region::UnregisterCallback(const std::string &mod)
@@ -1089,6 +1294,13 @@ void Region::UnregisterCallback(const std::string &mod)
     DependencyMap_t::iterator it = DependencyMap.find(mod);
     if (it != DependencyMap.end())
     {
+        const size_t modid = GetDependencyId(mod);
+        const std::set<std::string> &deps = it->second;
+        for (std::set<std::string>::const_iterator dit = deps.begin(); dit != deps.end(); ++dit)
+        {
+            std::vector<size_t> &dlist = dependents[GetDependencyId(*dit)];
+            dlist.erase(std::remove(dlist.begin(), dlist.end(), modid), dlist.end());
+        }
         DependencyMap.erase(it);
     }
 }
@@ -1096,66 +1308,63 @@ void Region::UnregisterCallback(const std::string &mod)
 /*
  * Does not yet handle cyclic dependencies
  * Does not mark the original dependency as being old
+ * Only the models depending on str are visited, and MarkOld recurses into
+ * their dependents, so the work is proportional to the affected models
  */
 void Region::SignalCallbacks(const std::string &str)
 {
-  typedef std::set<std::string> list_t; 
-  list_t list; 
-  DependencyMap_t::iterator it = DependencyMap.begin();
-  const DependencyMap_t::iterator end = DependencyMap.end();
-  for ( ; it != end; ++it)
-  {
-    // If this one has a dependency on str
-    if ((*it).second.count(str))
-    {
-      // put it in the set to be notified
-      list.insert(it->first);
-    }
-  }
+  const size_t id = GetDependencyId(str);
+  ++signalCount[id];
 
-  list_t::iterator lit = list.begin();
-  const list_t::iterator lend = list.end();
-  for ( ; lit != lend; ++lit)
+  // copied, since new names may be added while signaling
+  const std::vector<size_t> list(dependents[id]);
+
+  for (std::vector<size_t>::const_iterator lit = list.begin(); lit != list.end(); ++lit)
   {
-    dsAssert(!(nodeModels.count(*lit) && edgeModels.count(*lit) && triangleEdgeModels.count(*lit) && tetrahedronEdgeModels.count(*lit)), "UNEXPECTED");
-    if (nodeModels.count(*lit))
+    const std::string &name = dependencyNames[*lit];
+
+    NodeModelList_t::iterator nit = nodeModels.find(name);
+    if (nit != nodeModels.end())
     {
-      NodeModelPtr nmp = nodeModels[*lit];
+      NodeModelPtr nmp = nit->second;
       if ((nmp->IsUpToDate()))
       {
         nmp->MarkOld();
 //        This is what MarkOld does
-//        this->SignalCallbacks(*lit);
+//        this->SignalCallbacks(name);
       }
+      continue;
     }
-    else if (edgeModels.count(*lit))
+
+    EdgeModelList_t::iterator eit = edgeModels.find(name);
+    if (eit != edgeModels.end())
     {
-      EdgeModelPtr emp = edgeModels[*lit];
+      EdgeModelPtr emp = eit->second;
       if ((emp->IsUpToDate()))
       {
         emp->MarkOld();
-//        This is what MarkOld does
-//        this->SignalCallbacks(*lit);
       }
+      continue;
     }
-    else if (triangleEdgeModels.count(*lit))
+
+    TriangleEdgeModelList_t::iterator tit = triangleEdgeModels.find(name);
+    if (tit != triangleEdgeModels.end())
     {
-      TriangleEdgeModelPtr temp = triangleEdgeModels[*lit];
+      TriangleEdgeModelPtr temp = tit->second;
       if ((temp->IsUpToDate()))
       {
         temp->MarkOld();
-//        This is what MarkOld does
-//        this->SignalCallbacks(*lit);
       }
+      continue;
     }
-    else if (tetrahedronEdgeModels.count(*lit))
+
+    TetrahedronEdgeModelList_t::iterator teit = tetrahedronEdgeModels.find(name);
+    if (teit != tetrahedronEdgeModels.end())
     {
-      TetrahedronEdgeModelPtr temp = tetrahedronEdgeModels[*lit];
+      TetrahedronEdgeModelPtr temp = teit->second;
       if ((temp->IsUpToDate()))
       {
         temp->MarkOld();
-//        This is what MarkOld does
-//        this->SignalCallbacks(*lit);
       }
     }
   }
@@ -1163,6 +1372,36 @@ void Region::SignalCallbacks(const std::string &str)
   GetDevice()->SignalCallbacksOnInterface(str, this);
 }
 
+size_t Region::GetSignalCount(const std::string &str) const
+{
+  size_t ret = 0;
+  DependencyIdMap_t::const_iterator it = dependencyIds.find(str);
+  if (it != dependencyIds.end())
+  {
+    ret = signalCount[it->second];
+  }
+  return ret;
+}
+
+void Region::RecordRecompute(const std::string &str)
+{
+  const size_t id = GetDependencyId(str);
+  if (!recomputedFlags[id])
+  {
+    recomputedFlags[id] = 1;
+    recomputedModels.push_back(id);
+  }
+}
+
+void Region::ClearRecomputedModels()
+{
+  for (std::vector<size_t>::const_iterator it = recomputedModels.begin(); it != recomputedModels.end(); ++it)
+  {
+    recomputedFlags[*it] = 0;
+  }
+  recomputedModels.clear();
+}
+
 // number equations by order they are entered
 void Region::AddEquation(EquationHolder &eq)
 {
@@ -1299,6 +1538,15 @@ size_t Region::GetEquationNumber(size_t equation_index, ConstNodePtr np) const
     return num;
 }
 
+size_t Region::GetNodeEquationNumber(size_t equation_index, size_t node_index) const
+{
+    dsAssert(equation_index < numequations, "UNEXPECTED");
+    dsAssert(baseeqnnum != size_t(-1), "UNEXPECTED");
+    dsAssert(numequations != size_t(-1), "UNEXPECTED");
+    const size_t num =  baseeqnnum + equation_index * GetNumberNodes() + node_index;
+    return num;
+}
+
 void Region::SetBaseEquationNumber(size_t x)
 {
     baseeqnnum = x;
@@ -1345,9 +1593,18 @@ std::vector<std::string> Region::GetVariableList() const
 template <typename DoubleType>
 void Region::Update(const std::vector<DoubleType> &result)
 {
+        PhaseTimerScope timer("region_update");
+
         absError = 0.0;
         relError = 0.0;
 
+        //// everything recalculated for the iteration leading to this update
+        lastRecomputedModels.clear();
+        for (std::vector<size_t>::const_iterator it = recomputedModels.begin(); it != recomputedModels.end(); ++it)
+        {
+          lastRecomputedModels.push_back(dependencyNames[*it]);
+        }
+
         if (!numequations)
         {
             return;
@@ -1427,6 +1684,8 @@ void Region::NoiseUpdate(const std::string &output, const std::vector<size_t> &p
 template <typename DoubleType>
 void Region::Assemble(dsMath::RealRowColValueVec<DoubleType> &m, dsMath::RHSEntryVec<DoubleType> &v, dsMathEnum::WhatToLoad w, dsMathEnum::TimeMode t)
 {
+    PhaseTimerScope timer("region_assemble");
+
     if (numequations)
     {
       const EquationPtrMap_t &ep = GetEquationPtrList();
@@ -1595,6 +1854,7 @@ void Region::SetMaterial(const std::string &new_material)
   }
 
   materialName = new_material;
+  gd.SignalDBChange();
 }
 
 
@@ -1687,6 +1947,18 @@ void Region::SetModelExprDataCache(ModelExprDataCachePtr<double> p)
   modelExprDataCache_double = p;
 }
 
+template <>
+SharedExprCachePtr<double> Region::GetSharedExprCache()
+{
+  return sharedExprCache_double;
+}
+
+template <>
+void Region::SetSharedExprCache(SharedExprCachePtr<double> p)
+{
+  sharedExprCache_double = p;
+}
+
 #ifdef DEVSIM_EXTENDED_PRECISION
 template <>
 ModelExprDataCachePtr<float128> Region::GetModelExprDataCache()
@@ -1699,102 +1971,48 @@ void Region::SetModelExprDataCache(ModelExprDataCachePtr<float128> p)
 {
   modelExprDataCache_float128 = p;
 }
+
+template <>
+SharedExprCachePtr<float128> Region::GetSharedExprCache()
+{
+  return sharedExprCache_float128;
+}
+
+template <>
+void Region::SetSharedExprCache(SharedExprCachePtr<float128> p)
+{
+  sharedExprCache_float128 = p;
+}
 #endif
 
 
+//// The node to element lists are sorted by index, so the first match found
+//// is the one with the lowest index
 ConstEdgePtr Region::FindEdge(ConstNodePtr nh, ConstNodePtr nt) const
 {
-  ConstEdgePtr ret = NULL;
-
-  ConstEdgeList nout;
-  // need these to be sorted ranges so do sort above
   const ConstEdgeList &nht = GetNodeToEdgeList()[nh->GetIndex()];
-  const ConstEdgeList &ntt = GetNodeToEdgeList()[nt->GetIndex()];
-
-  set_intersection(nht.begin(), nht.end(),
-    ntt.begin(), ntt.end(),
-    std::insert_iterator<ConstEdgeList>(nout, nout.begin()),
-    EdgeCompIndex()
-  );
 
-  if (!nout.empty())
+  for (ConstEdgeList::const_iterator it = nht.begin(); it != nht.end(); ++it)
   {
-    ret = nout[0];
+    if (((*it)->GetHead() == nt) || ((*it)->GetTail() == nt))
+    {
+      return *it;
+    }
   }
 
-  return ret;
+  return NULL;
 }
 
 ConstTrianglePtr Region::FindTriangle(ConstNodePtr n0, ConstNodePtr n1, ConstNodePtr n2) const
 {
-  ConstTrianglePtr ret = NULL;
-
-  // need these to be sorted ranges so do sort above
-  const ConstTriangleList &tl0 = GetNodeToTriangleList()[n0->GetIndex()];
-  const ConstTriangleList &tl1 = GetNodeToTriangleList()[n1->GetIndex()];
-  const ConstTriangleList &tl2 = GetNodeToTriangleList()[n2->GetIndex()];
-
-  ConstTriangleList nout1;
-  ConstTriangleList nout2;
-
-  set_intersection(tl0.begin(), tl0.end(),
-    tl1.begin(), tl1.end(),
-    std::insert_iterator<ConstTriangleList>(nout1, nout1.begin()),
-    TriangleCompIndex()
-  );
-
-  set_intersection(nout1.begin(), nout1.end(),
-    tl2.begin(), tl2.end(),
-    std::insert_iterator<ConstTriangleList>(nout2, nout2.begin()),
-    TriangleCompIndex()
-  );
-
-  if (!nout2.empty())
-  {
-    ret = nout2[0];
-  }
-
-  return ret;
+  const ConstNodePtr nodes[2] = {n1, n2};
+  return findElementWithNodes(GetNodeToTriangleList()[n0->GetIndex()], nodes, 2);
 }
 
 ConstTetrahedronPtr Region::FindTetrahedron(ConstNodePtr n0, ConstNodePtr n1, ConstNodePtr n2, ConstNodePtr n3) const
 {
-  ConstTetrahedronPtr ret = NULL;
-
-  // need these to be sorted ranges so do sort above
-  const ConstTetrahedronList &tl0 = GetNodeToTetrahedronList()[n0->GetIndex()];
-  const ConstTetrahedronList &tl1 = GetNodeToTetrahedronList()[n1->GetIndex()];
-  const ConstTetrahedronList &tl2 = GetNodeToTetrahedronList()[n2->GetIndex()];
-  const ConstTetrahedronList &tl3 = GetNodeToTetrahedronList()[n3->GetIndex()];
-
-  ConstTetrahedronList nout1;
-  ConstTetrahedronList nout2;
-  ConstTetrahedronList nout3;
-
-  set_intersection(tl0.begin(), tl0.end(),
-    tl1.begin(), tl1.end(),
-    std::insert_iterator<ConstTetrahedronList>(nout1, nout1.begin()),
-    TetrahedronCompIndex()
-  );
-
-  set_intersection(nout1.begin(), nout1.end(),
-    tl2.begin(), tl2.end(),
-    std::insert_iterator<ConstTetrahedronList>(nout2, nout2.begin()),
-    TetrahedronCompIndex()
-  );
-
-  set_intersection(nout2.begin(), nout2.end(),
-    tl3.begin(), tl3.end(),
-    std::insert_iterator<ConstTetrahedronList>(nout3, nout3.begin()),
-    TetrahedronCompIndex()
-  );
-
-  if (!nout3.empty())
-  {
-    ret = nout3[0];
-  }
-
-  return ret;
+  const ConstNodePtr nodes[3] = {n1, n2, n3};
+  return findElementWithNodes(GetNodeToTetrahedronList()[n0->GetIndex()], nodes, 3);
 }
 
 bool Region::UseExtendedPrecisionType(const std::string &t) const
@@ -1811,6 +2029,8 @@ bool Region::UseExtendedPrecisionType(const std::string &t) const
       ret = x.second;
     }
   }
+#else
+  (void) t;
 #endif
   return ret;
 }
@@ -18,6 +18,7 @@ limitations under the License.
 #ifndef REGION_HH
 #define REGION_HH
 #include "MathEnum.hh"
+#include "MeshTopology.hh"
 
 #ifdef DEVSIM_EXTENDED_PRECISION
 #include "Float128.hh"
@@ -49,6 +50,8 @@ template <typename T> class ObjectCache;
 namespace MEE {
 template <typename DoubleType>
 class ModelExprData;
+template <typename DoubleType>
+class SharedExprCache;
 }
 
 template <typename DoubleType>
@@ -60,6 +63,9 @@ using WeakModelExprDataCachePtr = std::weak_ptr<ModelExprDataCache<DoubleType> >
 template <typename DoubleType>
 using ModelExprDataCachePtr = std::shared_ptr<ModelExprDataCache<DoubleType> >;
 
+template <typename DoubleType>
+using SharedExprCachePtr = std::shared_ptr<MEE::SharedExprCache<DoubleType> >;
+
 class Device;
 typedef Device *DevicePtr;
 typedef const Device *ConstDevicePtr;
@@ -171,6 +177,7 @@ class Region
       typedef std::map<std::string, EdgeModelPtr> EdgeModelList_t;
       typedef std::map<std::string, NodeModelPtr> NodeModelList_t;
       typedef std::map<std::string, std::set<std::string> > DependencyMap_t;
+      typedef std::map<std::string, size_t> DependencyIdMap_t;
 
       Region(std::string, std::string, size_t, ConstDevicePtr);
       ~Region();
@@ -268,6 +275,11 @@ class Region
         return triangleToTetrahedronList;
       }
 
+      //// index based copy of the lists above, available after FinalizeMesh
+      const MeshTopology &GetTopology() const {
+        return topology;
+      }
+
       const TetrahedronToConstTriangleList_t &GetTetrahedronToTriangleList() const {
         return tetrahedronToTriangleList;
       }
@@ -284,9 +296,22 @@ class Region
       // Note that a NodeModelPtr can signal both EdgeModels and NodeModels
       void SignalCallbacks(const std::string &);
 
+      // number of times callbacks were signaled for a name
+      size_t GetSignalCount(const std::string &) const;
+
       // unregister a model when it is destructed
       void UnregisterCallback(const std::string &);
 
+      // models report when their values are recalculated
+      void RecordRecompute(const std::string &);
+      // forget the models recorded so far, before each assembly
+      void ClearRecomputedModels();
+      // models recalculated, in order, from the last assembly to the last solution update
+      const std::vector<std::string> &GetRecomputedModels() const
+      {
+        return lastRecomputedModels;
+      }
+
       // note that these can be used to alias the same model with multiple names
       NodeModelPtr AddNodeModel(NodeModel *);
       EdgeModelPtr AddEdgeModel(EdgeModel *);
@@ -334,6 +359,7 @@ class Region
       std::string GetEquationNameFromVariable(const std::string &) const;
 
       size_t GetEquationNumber(size_t /*equation index*/, ConstNodePtr) const;
+      size_t GetNodeEquationNumber(size_t /*equation index*/, size_t /*node index*/) const;
       void SetBaseEquationNumber(size_t);
       size_t GetBaseEquationNumber() const;
       size_t GetNumberEquations() const;
@@ -406,6 +432,13 @@ class Region
     template <typename DoubleType>
     void SetModelExprDataCache(ModelExprDataCachePtr<DoubleType>);
 
+    //// subexpressions shared by the expression models of this region
+    template <typename DoubleType>
+    SharedExprCachePtr<DoubleType> GetSharedExprCache();
+
+    template <typename DoubleType>
+    void SetSharedExprCache(SharedExprCachePtr<DoubleType>);
+
     bool UseExtendedPrecisionModels() const;
     bool UseExtendedPrecisionEquations() const;
    private:
@@ -480,12 +513,28 @@ class Region
       TetrahedronToConstTriangleList_t tetrahedronToTriangleList; 
       TriangleToConstTetrahedronList_t triangleToTetrahedronList; 
 
+      MeshTopology topology;
+
       NodeModelList_t            nodeModels;
       EdgeModelList_t            edgeModels;
       TriangleEdgeModelList_t    triangleEdgeModels;
       TetrahedronEdgeModelList_t tetrahedronEdgeModels;
 
+      size_t GetDependencyId(const std::string &);
+
+      //// model name to the names it depends on
       DependencyMap_t DependencyMap;
+      //// integer ids for every name registered or signaled
+      DependencyIdMap_t        dependencyIds;
+      std::vector<std::string> dependencyNames;
+      //// for each id, the ids of the models depending on it
+      std::vector<std::vector<size_t> > dependents;
+      std::vector<size_t>               signalCount;
+
+      //// ids of the models recalculated since the last assembly, each listed once
+      std::vector<size_t>      recomputedModels;
+      std::vector<char>        recomputedFlags;
+      std::vector<std::string> lastRecomputedModels;
 
       size_t baseeqnnum; // base equation number for this region
       size_t numequations;
@@ -509,6 +558,11 @@ class Region
 #ifdef DEVSIM_EXTENDED_PRECISION
       WeakModelExprDataCachePtr<float128> modelExprDataCache_float128;
 #endif
+
+      SharedExprCachePtr<double> sharedExprCache_double;
+#ifdef DEVSIM_EXTENDED_PRECISION
+      SharedExprCachePtr<float128> sharedExprCache_float128;
+#endif
 };
 
 #endif
@@ -24,6 +24,7 @@ limitations under the License.
 #include "GlobalData.hh"
 #include "AdditionalMath.hh"
 #include "kahan.hh"
+#include "VectorMathFunc.hh"
 
 #include "Interpreter.hh"
 
@@ -356,7 +357,8 @@ void MathEval<DoubleType>::InitializeBuiltInMathFunc()
   {
     const std::string &name   = Eqomfp::Tables::GetUnaryTable<DoubleType>(i).name;
     Eqomfp::unaryfuncptr<DoubleType> func = Eqomfp::Tables::GetUnaryTable<DoubleType>(i).func;
-    FuncPtrMap_[name]       = Eqomfp::MathWrapperPtr<DoubleType>(new Eqomfp::MathWrapper1<DoubleType>(name, func));
+    Eqomfp::unaryvectorfuncptr<DoubleType> vfunc = Eqomfp::GetUnaryVectorFunc<DoubleType>(name);
+    FuncPtrMap_[name]       = Eqomfp::MathWrapperPtr<DoubleType>(new Eqomfp::MathWrapper1<DoubleType>(name, func, vfunc));
   }
   for (size_t i = 0; Eqomfp::Tables::GetBinaryTable<DoubleType>(i).name != NULL; ++i)
   {
@@ -512,18 +514,6 @@ void MathEval<DoubleType>::EvaluateMathFunc(const std::string &func, std::vector
     typename std::map<std::string, Eqomfp::MathWrapperPtr<DoubleType>>::const_iterator it = FuncPtrMap_.find(func);
     const Eqomfp::MathWrapper<DoubleType> &MyFunc = *(it->second);
     error += Eqomfp::MathPacketRun(MyFunc, dvals, vvals, result, vlen);
-//    MyFunc.Evaluate(dvals, vvals, error, result, 0, vlen);
-    //// TODO: in the future not call this function but the schedular
-#if 0
-    Eqomfp::MathPacket MyPacket(MyFunc, dvals, vvals, result, vlen);
-    MyPacket(0, vlen);
-    error += MyPacket.getErrorString();
-    if (FPECheck::CheckFPE(MyPacket.getFPEFlag()))
-    {
-      //// Raise FPE in the main thread
-      FPECheck::raiseFPE(MyPacket.getFPEFlag());
-    }
-#endif
   }
   else
   {
@@ -533,6 +523,23 @@ void MathEval<DoubleType>::EvaluateMathFunc(const std::string &func, std::vector
   }
 }
 
+template <typename DoubleType>
+const Eqomfp::MathWrapper<DoubleType> *MathEval<DoubleType>::GetMathWrapper(const std::string &func) const
+{
+  const Eqomfp::MathWrapper<DoubleType> *ret = NULL;
+
+  if (!tclMathFuncMap_.count(func))
+  {
+    typename std::map<std::string, Eqomfp::MathWrapperPtr<DoubleType>>::const_iterator it = FuncPtrMap_.find(func);
+    if (it != FuncPtrMap_.end())
+    {
+      ret = (it->second).get();
+    }
+  }
+
+  return ret;
+}
+
 template <typename DoubleType>
 void MathEval<DoubleType>::AddTclMath(const std::string &funcname, size_t numargs)
 {
@@ -35,6 +35,9 @@ class MathEval {
     DoubleType EvaluateMathFunc(const std::string &, std::vector<DoubleType> &, std::string &) const ;
     void   EvaluateMathFunc(const std::string &, std::vector<DoubleType> &, const std::vector<const std::vector<DoubleType> *> &, std::string &, std::vector<DoubleType> &, size_t vlen) const;
 
+    /// NULL for scripting language functions, or when the function does not exist
+    const Eqomfp::MathWrapper<DoubleType> *GetMathWrapper(const std::string &) const;
+
     void   EvaluateTclMathFunc(const std::string &, std::vector<DoubleType> &, const std::vector<const std::vector<DoubleType> *> &, std::string &, std::vector<DoubleType> &) const;
 
     static MathEval &GetInstance();
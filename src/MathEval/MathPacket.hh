@@ -18,83 +18,44 @@ limitations under the License.
 #ifndef MATHPACKET_HH
 #define MATHPACKET_HH
 
-#include "FPECheck.hh"
-#include "mypacket.hh"
+#include "parallel_for.hh"
+#include "mymutex.hh"
 
 #include <string>
 #include <vector>
-
-class mycondition;
-class mymutex;
+#include <map>
 
 namespace Eqomfp {
 
 template <typename DoubleType>
 class MathWrapper;
 
+//// Evaluates a function on subranges from several threads.  Error messages
+//// are kept for each subrange, and joined in order of the ranges.
 template <typename DoubleType>
-class MathPacket {
+class MathPacket : public myrangetask {
   public:
     MathPacket(const MathWrapper<DoubleType> &, const std::vector<DoubleType> &, const std::vector<const std::vector<DoubleType> *> &, std::vector<DoubleType> &);
 
-    //// We are done with this unit when this function returns.
-    void operator()(const size_t rbeg, const size_t rend);
+    void operator()(const size_t rbeg, const size_t rend) const;
 
-    void join(const MathPacket &);
+    std::string getErrorString() const;
 
-    FPECheck::FPEFlag_t getFPEFlag() const;
-    const std::string & getErrorString() const;
-    size_t              getNumberProcessed() const;
   private:
     MathPacket();
-//    ~MathPacket();
-//    MathPacket(const MathPacket &);
-
+    MathPacket(const MathPacket &);
     MathPacket &operator=(const MathPacket &);
 
-    const MathWrapper<DoubleType>         &wrapperClass_;
+    const MathWrapper<DoubleType>                       &wrapperClass_;
     const std::vector<DoubleType>                       &dvals_;
     const std::vector<const std::vector<DoubleType> *>  &vvals_;
     std::vector<DoubleType>                             &result_;
-    std::string                                      errorString_;
-    FPECheck::FPEFlag_t                              fpeFlag_;
-    size_t                                           num_processed_;
+    mutable mymutex                                      mutex_;
+    mutable std::map<size_t, std::string>                errorStrings_;
 };
 
 
 template <typename DoubleType>
 std::string MathPacketRun(const MathWrapper<DoubleType> &, const std::vector<DoubleType> &, const std::vector<const std::vector<DoubleType> *> &, std::vector<DoubleType> &, size_t);
-
-template <typename DoubleType>
-class MathPacketRange : public mypacket
-{
-  public:
-    //// Copy so we have fpe status of each one
-    MathPacketRange(MathPacket<DoubleType>, size_t, size_t,
-        mymutex &,
-        mycondition &,
-        size_t &,
-        size_t
-    );
-    void run();
-
-    //// intent is to join the copy with the original
-    const MathPacket<DoubleType> &GetMathPacket();
-
-    ~MathPacketRange() {}
-  private:
-
-    MathPacket<DoubleType> mathPacket_;
-    size_t     beg_;
-    size_t     end_;
-    /// Mutex to lock when updating count
-    mymutex     &mutex_;
-    /// Condition variable to signal when done
-    mycondition &cond_;
-    // Count is number of items processed
-    size_t      &count_;
-    size_t       max_count_;
-  
-};
 }
 #endif
@@ -37,6 +37,20 @@ MathWrapper<DoubleType>::~MathWrapper()
 
 template <typename DoubleType>
 void MathWrapper<DoubleType>::Evaluate(const std::vector<DoubleType> &dvals, const std::vector<const std::vector<DoubleType> *> &vvals, std::string &error, std::vector<DoubleType> &result, const size_t vbeg, const size_t vend) const
+{
+  std::vector<const DoubleType *> vptrs(vvals.size());
+  for (size_t i = 0; i < vvals.size(); ++i)
+  {
+    if (vvals[i])
+    {
+      vptrs[i] = vvals[i]->data() + vbeg;
+    }
+  }
+  this->Evaluate(dvals, vptrs, error, result.data() + vbeg, vend - vbeg);
+}
+
+template <typename DoubleType>
+void MathWrapper<DoubleType>::Evaluate(const std::vector<DoubleType> &dvals, const std::vector<const DoubleType *> &vptrs, std::string &error, DoubleType *result, const size_t n) const
 {
   if (dvals.size() != this->GetNumberArguments())
   {
@@ -46,7 +60,7 @@ void MathWrapper<DoubleType>::Evaluate(const std::vector<DoubleType> &dvals, con
   }
   else
   {
-    this->DerivedEvaluate(dvals, vvals, result, vbeg, vend);
+    this->DerivedEvaluate(dvals, vptrs, result, n);
   }
 }
 
@@ -70,18 +84,21 @@ DoubleType MathWrapper<DoubleType>::Evaluate(const std::vector<DoubleType> &vals
 }
 
 template <typename DoubleType>
-void MathWrapper1<DoubleType>::DerivedEvaluate(const std::vector<DoubleType> &/*dvals*/, const std::vector<const std::vector<DoubleType> *> &vvals, std::vector<DoubleType> &result, const size_t vbeg, const size_t vend) const
+void MathWrapper1<DoubleType>::DerivedEvaluate(const std::vector<DoubleType> &/*dvals*/, const std::vector<const DoubleType *> &vptrs, DoubleType *vr, const size_t n) const
 {
-  dsAssert(vvals[0] != NULL, "UNEXPECTED");
+  dsAssert(vptrs[0] != NULL, "UNEXPECTED");
 
-//  const std::vector<DoubleType> &vals = *vvals[0];
-  DoubleType       *vr = &result[vbeg];
-  const DoubleType *v0 = &((*vvals[0])[vbeg]);
+  const DoubleType *v0 = vptrs[0];
+
+  if (vfuncptr_)
+  {
+    vfuncptr_(v0, vr, n);
+    return;
+  }
 
-//    std::transform(vals.begin(), vals.end(), result.begin(), std::ptr_fun(funcptr_));
-  for (size_t i = vbeg; i < vend; ++i)
+  for (size_t i = 0; i < n; ++i)
   {
-    *(vr++) = funcptr_(*(v0++));
+    vr[i] = funcptr_(v0[i]);
   }
 }
 
@@ -92,42 +109,34 @@ DoubleType MathWrapper1<DoubleType>::DerivedEvaluate(const std::vector<DoubleTyp
 }
 
 template <typename DoubleType>
-void MathWrapper2<DoubleType>::DerivedEvaluate(const std::vector<DoubleType> &dvals, const std::vector<const std::vector<DoubleType> *> &vvals, std::vector<DoubleType> &result, const size_t vbeg, const size_t vend) const
+void MathWrapper2<DoubleType>::DerivedEvaluate(const std::vector<DoubleType> &dvals, const std::vector<const DoubleType *> &vptrs, DoubleType *vr, const size_t n) const
 {
-  dsAssert(vvals[0] || vvals[1], "UNEXPECTED");
+  dsAssert(vptrs[0] || vptrs[1], "UNEXPECTED");
 
-  if (vvals[0] && vvals[1])
-  {
-    const DoubleType *v0 = &((*vvals[0])[vbeg]);
-    const DoubleType *v1 = &((*vvals[1])[vbeg]);
-    DoubleType       *vr = &result[vbeg];
+  const DoubleType *v0 = vptrs[0];
+  const DoubleType *v1 = vptrs[1];
 
-    for (size_t i = vbeg; i < vend; ++i)
+  if (v0 && v1)
+  {
+    for (size_t i = 0; i < n; ++i)
     {
-      *(vr++) = funcptr_(*(v0++), *(v1++));
+      vr[i] = funcptr_(v0[i], v1[i]);
     }
-
   }
-  else if (vvals[0])
+  else if (v0)
   {
-    const DoubleType *v0 = &((*vvals[0])[vbeg]);
     const DoubleType dval1 = dvals[1];
-    DoubleType       *vr = &result[vbeg];
-
-    for (size_t i = vbeg; i < vend; ++i)
+    for (size_t i = 0; i < n; ++i)
     {
-      *(vr++) = funcptr_(*(v0++), dval1);
+      vr[i] = funcptr_(v0[i], dval1);
     }
   }
-  else if (vvals[1])
+  else if (v1)
   {
-    const DoubleType *v1 = &((*vvals[1])[vbeg]);
     const DoubleType dval0 = dvals[0];
-    DoubleType       *vr = &result[vbeg];
-
-    for (size_t i = vbeg; i < vend; ++i)
+    for (size_t i = 0; i < n; ++i)
     {
-      *(vr++) = funcptr_(dval0, *(v1++));
+      vr[i] = funcptr_(dval0, v1[i]);
     }
   }
 }
@@ -139,9 +148,9 @@ DoubleType MathWrapper2<DoubleType>::DerivedEvaluate(const std::vector<DoubleTyp
 }
 
 template <typename DoubleType>
-void MathWrapper3<DoubleType>::DerivedEvaluate(const std::vector<DoubleType> &dvals, const std::vector<const std::vector<DoubleType> *> &vvals, std::vector<DoubleType> &result, const size_t vbeg, const size_t vend) const
+void MathWrapper3<DoubleType>::DerivedEvaluate(const std::vector<DoubleType> &dvals, const std::vector<const DoubleType *> &vptrs, DoubleType *result, const size_t n) const
 {
-  dsAssert(vvals[0] || vvals[1] || vvals[2], "UNEXPECTED");
+  dsAssert(vptrs[0] || vptrs[1] || vptrs[2], "UNEXPECTED");
 
   DoubleType vals[3];
   for (size_t i = 0; i < 3; ++i)
@@ -149,13 +158,13 @@ void MathWrapper3<DoubleType>::DerivedEvaluate(const std::vector<DoubleType> &dv
     vals[i] = dvals[i];
   }
 
-  for (size_t i = vbeg; i < vend; ++i)
+  for (size_t i = 0; i < n; ++i)
   {
     for (size_t j = 0; j < 3; ++j)
     {
-      if (vvals[j])
+      if (vptrs[j])
       {
-        vals[j] = (*vvals[j])[i];
+        vals[j] = vptrs[j][i];
       }
     }
 
@@ -171,9 +180,9 @@ DoubleType MathWrapper3<DoubleType>::DerivedEvaluate(const std::vector<DoubleTyp
 
 
 template <typename DoubleType>
-void MathWrapper4<DoubleType>::DerivedEvaluate(const std::vector<DoubleType> &dvals, const std::vector<const std::vector<DoubleType> *> &vvals, std::vector<DoubleType> &result, const size_t vbeg, const size_t vend) const
+void MathWrapper4<DoubleType>::DerivedEvaluate(const std::vector<DoubleType> &dvals, const std::vector<const DoubleType *> &vptrs, DoubleType *result, const size_t n) const
 {
-  dsAssert(vvals[0] || vvals[1] || vvals[2] || vvals[3], "UNEXPECTED");
+  dsAssert(vptrs[0] || vptrs[1] || vptrs[2] || vptrs[3], "UNEXPECTED");
 
   DoubleType vals[4];
   for (size_t i = 0; i < 4; ++i)
@@ -181,13 +190,13 @@ void MathWrapper4<DoubleType>::DerivedEvaluate(const std::vector<DoubleType> &dv
     vals[i] = dvals[i];
   }
 
-  for (size_t i = vbeg; i < vend; ++i)
+  for (size_t i = 0; i < n; ++i)
   {
     for (size_t j = 0; j < 4; ++j)
     {
-      if (vvals[j])
+      if (vptrs[j])
       {
-        vals[j] = (*vvals[j])[i];
+        vals[j] = vptrs[j][i];
       }
     }
 
@@ -216,52 +225,45 @@ inline bool IsInt(DoubleType x)
 
 
 template <typename DoubleType>
-void PowWrapper<DoubleType>::DerivedEvaluate(const std::vector<DoubleType> &dvals, const std::vector<const std::vector<DoubleType> *> &vvals, std::vector<DoubleType> &result, const size_t vbeg, const size_t vend) const
+void PowWrapper<DoubleType>::DerivedEvaluate(const std::vector<DoubleType> &dvals, const std::vector<const DoubleType *> &vptrs, DoubleType *vr, const size_t n) const
 {
-  dsAssert(vvals[0] || vvals[1], "UNEXPECTED");
+  dsAssert(vptrs[0] || vptrs[1], "UNEXPECTED");
 
-  if (vvals[0] && vvals[1])
-  {
-    const DoubleType *v0 = &((*vvals[0])[vbeg]);
-    const DoubleType *v1 = &((*vvals[1])[vbeg]);
-    DoubleType       *vr = &result[vbeg];
+  const DoubleType *v0 = vptrs[0];
+  const DoubleType *v1 = vptrs[1];
 
-    for (size_t i = vbeg; i < vend; ++i)
+  if (v0 && v1)
+  {
+    for (size_t i = 0; i < n; ++i)
     {
-      *(vr++) = pow(*(v0++), *(v1++));
+      vr[i] = pow(v0[i], v1[i]);
     }
-
   }
-  else if (vvals[0])
+  else if (v0)
   {
-    const DoubleType *v0 = &((*vvals[0])[vbeg]);
     const DoubleType dval1 = dvals[1];
-    DoubleType       *vr = &result[vbeg];
 
     if (IsInt(dval1))
     {
-      for (size_t i = vbeg; i < vend; ++i)
+      for (size_t i = 0; i < n; ++i)
       {
-        *(vr++) = pow(*(v0++), static_cast<int>(dval1));
+        vr[i] = pow(v0[i], static_cast<int>(dval1));
       }
     }
     else
     {
-      for (size_t i = vbeg; i < vend; ++i)
+      for (size_t i = 0; i < n; ++i)
       {
-        *(vr++) = pow(*(v0++), dval1);
+        vr[i] = pow(v0[i], dval1);
       }
     }
   }
-  else if (vvals[1])
+  else if (v1)
   {
-    const DoubleType *v1 = &((*vvals[1])[vbeg]);
     const DoubleType dval0 = dvals[0];
-    DoubleType       *vr = &result[vbeg];
-
-    for (size_t i = vbeg; i < vend; ++i)
+    for (size_t i = 0; i < n; ++i)
     {
-      *(vr++) = pow(dval0, *(v1++));
+      vr[i] = pow(dval0, v1[i]);
     }
   }
 }
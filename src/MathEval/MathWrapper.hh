@@ -20,6 +20,7 @@ limitations under the License.
 #include <memory>
 #include <vector>
 #include <string>
+#include <cstddef>
 
 namespace Eqomfp {
 template <typename DoubleType>
@@ -36,6 +37,9 @@ template <typename DoubleType>
 using ternaryfuncptr = DoubleType (*)(DoubleType, DoubleType, DoubleType);
 template <typename DoubleType>
 using quaternaryfuncptr = DoubleType (*)(DoubleType, DoubleType, DoubleType, DoubleType);
+/// evaluates a unary function on n entries at once
+template <typename DoubleType>
+using unaryvectorfuncptr = void (*)(const DoubleType *, DoubleType *, size_t);
 
 
 template <typename DoubleType>
@@ -44,6 +48,8 @@ class MathWrapper {
     MathWrapper(const std::string &name, const size_t narg) : name_(name), nargs_(narg) {};
 
     void Evaluate(const std::vector<DoubleType> &/*dvals*/, const std::vector<const std::vector<DoubleType> *> &/*vvals*/, std::string &/*error*/, std::vector<DoubleType> &/*result*/, size_t /*vbeg*/, size_t /*vend*/) const;
+    /// vptrs point to the first of n entries for each vector argument, or NULL for the ones taken from dvals
+    void Evaluate(const std::vector<DoubleType> &/*dvals*/, const std::vector<const DoubleType *> &/*vptrs*/, std::string &/*error*/, DoubleType * /*result*/, size_t /*n*/) const;
     DoubleType Evaluate(const std::vector<DoubleType> &/*vals*/, std::string &/*error*/) const;
 
     virtual ~MathWrapper() = 0;
@@ -54,7 +60,7 @@ class MathWrapper {
 
   protected:  
 
-    virtual void DerivedEvaluate(const std::vector<DoubleType> &/*dvals*/, const std::vector<const std::vector<DoubleType> *> &/*vvals*/, std::vector<DoubleType> &/*result*/, size_t /*vbeg*/, size_t /*vend*/) const = 0;
+    virtual void DerivedEvaluate(const std::vector<DoubleType> &/*dvals*/, const std::vector<const DoubleType *> &/*vptrs*/, DoubleType * /*result*/, size_t /*n*/) const = 0;
     virtual DoubleType DerivedEvaluate(const std::vector<DoubleType> &/*vals*/) const = 0;
 
   private:
@@ -71,16 +77,18 @@ class MathWrapper {
 template <typename DoubleType>
 class MathWrapper1 : public MathWrapper<DoubleType> {
   public:
-    MathWrapper1(const std::string &name, unaryfuncptr<DoubleType> fptr) : MathWrapper<DoubleType>(name, 1), funcptr_(fptr) {};
+    /// vfptr may be NULL, in which case fptr is called for each entry
+    MathWrapper1(const std::string &name, unaryfuncptr<DoubleType> fptr, unaryvectorfuncptr<DoubleType> vfptr = NULL) : MathWrapper<DoubleType>(name, 1), funcptr_(fptr), vfuncptr_(vfptr) {};
     ~MathWrapper1() {}
 
   protected:
 
-    void DerivedEvaluate(const std::vector<DoubleType> &/*dvals*/, const std::vector<const std::vector<DoubleType> *> &/*vvals*/, std::vector<DoubleType> &/*result*/, size_t /*vbeg*/, size_t /*vend*/) const;
+    void DerivedEvaluate(const std::vector<DoubleType> &/*dvals*/, const std::vector<const DoubleType *> &/*vptrs*/, DoubleType * /*result*/, size_t /*n*/) const;
     DoubleType DerivedEvaluate(const std::vector<DoubleType> &/*vals*/) const;
 
   private:
-    unaryfuncptr<DoubleType> funcptr_;
+    unaryfuncptr<DoubleType>       funcptr_;
+    unaryvectorfuncptr<DoubleType> vfuncptr_;
 };
 
 //// 2
@@ -92,7 +100,7 @@ class MathWrapper2 : public MathWrapper<DoubleType> {
 
   protected:
 
-    void DerivedEvaluate(const std::vector<DoubleType> &/*dvals*/, const std::vector<const std::vector<DoubleType> *> &/*vvals*/, std::vector<DoubleType> &/*result*/, size_t /*vbeg*/, size_t /*vend*/) const;
+    void DerivedEvaluate(const std::vector<DoubleType> &/*dvals*/, const std::vector<const DoubleType *> &/*vptrs*/, DoubleType * /*result*/, size_t /*n*/) const;
     DoubleType DerivedEvaluate(const std::vector<DoubleType> &/*vals*/) const;
 
   private:
@@ -108,7 +116,7 @@ class MathWrapper3 : public MathWrapper<DoubleType> {
 
   protected:
 
-    void DerivedEvaluate(const std::vector<DoubleType> &/*dvals*/, const std::vector<const std::vector<DoubleType> *> &/*vvals*/, std::vector<DoubleType> &/*result*/, size_t /*vbeg*/, size_t /*vend*/) const;
+    void DerivedEvaluate(const std::vector<DoubleType> &/*dvals*/, const std::vector<const DoubleType *> &/*vptrs*/, DoubleType * /*result*/, size_t /*n*/) const;
     DoubleType DerivedEvaluate(const std::vector<DoubleType> &/*vals*/) const;
 
   private:
@@ -124,7 +132,7 @@ class MathWrapper4 : public MathWrapper<DoubleType> {
 
   protected:
 
-    void DerivedEvaluate(const std::vector<DoubleType> &/*dvals*/, const std::vector<const std::vector<DoubleType> *> &/*vvals*/, std::vector<DoubleType> &/*result*/, size_t /*vbeg*/, size_t /*vend*/) const;
+    void DerivedEvaluate(const std::vector<DoubleType> &/*dvals*/, const std::vector<const DoubleType *> &/*vptrs*/, DoubleType * /*result*/, size_t /*n*/) const;
     DoubleType DerivedEvaluate(const std::vector<DoubleType> &/*vals*/) const;
 
   private:
@@ -139,7 +147,7 @@ class PowWrapper : public MathWrapper<DoubleType> {
 
   protected:
 
-    void DerivedEvaluate(const std::vector<DoubleType> &/*dvals*/, const std::vector<const std::vector<DoubleType> *> &/*vvals*/, std::vector<DoubleType> &/*result*/, size_t /*vbeg*/, size_t /*vend*/) const;
+    void DerivedEvaluate(const std::vector<DoubleType> &/*dvals*/, const std::vector<const DoubleType *> &/*vptrs*/, DoubleType * /*result*/, size_t /*n*/) const;
     DoubleType DerivedEvaluate(const std::vector<DoubleType> &/*vals*/) const;
 
   private:
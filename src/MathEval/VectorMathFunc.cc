@@ -0,0 +1,721 @@
+/***
+DEVSIM
+Copyright 2013 Devsim LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+***/
+
+#include "VectorMathFunc.hh"
+#include "Bernoulli.hh"
+#include "Fermi.hh"
+#include "MiscMathFunc.hh"
+
+#ifdef DEVSIM_EXTENDED_PRECISION
+#include "Float128.hh"
+#endif
+
+#include <cmath>
+#include <cfenv>
+#include <cstring>
+#include <cstdint>
+#include <limits>
+
+//// The cpu specific versions are selected by the dynamic loader, based on the cpu features
+#if defined(DEVSIM_VECTOR_MATH) && defined(__x86_64__) && defined(__linux__) && defined(__GNUC__)
+#define VECTOR_MATH_CLONES __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define VECTOR_MATH_CLONES
+#endif
+
+//// Everything called from a kernel loop has to be inlined for the loop to vectorize
+#if defined(__GNUC__)
+#define VECTOR_MATH_INLINE inline __attribute__((always_inline))
+#else
+#define VECTOR_MATH_INLINE inline
+#endif
+
+namespace {
+//// Number of entries checked for a valid range and evaluated together
+const size_t block_size = 1024;
+
+const double vlnmax = std::log(std::numeric_limits<double>::max());
+
+VECTOR_MATH_INLINE uint64_t AsBits(double x)
+{
+  uint64_t u;
+  std::memcpy(&u, &x, sizeof(u));
+  return u;
+}
+
+VECTOR_MATH_INLINE double AsDouble(uint64_t u)
+{
+  double x;
+  std::memcpy(&x, &u, sizeof(x));
+  return x;
+}
+
+/// 2^n for -1022 <= n <= 1023
+VECTOR_MATH_INLINE double Pow2(int64_t n)
+{
+  return AsDouble(static_cast<uint64_t>(n + 1023) << 52);
+}
+
+/// Rounds 0 <= x < 2^51 toward zero
+VECTOR_MATH_INLINE double Trunc(double x)
+{
+  const double shift = 4503599627370496.0;
+  const double r = (x + shift) - shift;
+  return (r > x) ? r - 1.0 : r;
+}
+
+/// exp(x) for x < 709.78, going to 0 below -745.13
+/// The reduced argument is within ln(2)/2 so the Taylor series is accurate to the last bit.
+VECTOR_MATH_INLINE double Exp(double x)
+{
+  const double log2e = 1.4426950408889634;
+  /// ln(2) split so that n * ln2hi is exact
+  const double ln2hi = 6.93147180369123816490e-01;
+  const double ln2lo = 1.90821492927058770002e-10;
+  /// 1.5 * 2^52, rounds to an integer in the low bits of the mantissa
+  const double shift = 6755399441055744.0;
+  const double xmin  = -745.1332191019411;
+  const double xmax  = 709.78;
+
+  double xc = (x < xmin) ? xmin : x;
+  xc = (xc > xmax) ? xmax : xc;
+
+  double kd = xc * log2e + shift;
+  const uint64_t ki = AsBits(kd);
+  kd -= shift;
+
+  const double r = (xc - kd * ln2hi) - kd * ln2lo;
+
+  double p = 1.0 / 6227020800.0;
+  p = p * r + 1.0 / 479001600.0;
+  p = p * r + 1.0 / 39916800.0;
+  p = p * r + 1.0 / 3628800.0;
+  p = p * r + 1.0 / 362880.0;
+  p = p * r + 1.0 / 40320.0;
+  p = p * r + 1.0 / 5040.0;
+  p = p * r + 1.0 / 720.0;
+  p = p * r + 1.0 / 120.0;
+  p = p * r + 1.0 / 24.0;
+  p = p * r + 1.0 / 6.0;
+  p = p * r + 0.5;
+  p = p * r + 1.0;
+  p = p * r + 1.0;
+
+  /// scale in two steps, since 2^n is not a normal number for the whole range
+  const int64_t n  = static_cast<int64_t>(ki & 0x000fffffffffffffULL) - (static_cast<int64_t>(1) << 51);
+  const int64_t n1 = static_cast<int64_t>(static_cast<uint64_t>(n + 2048) >> 1) - 1024;
+  const int64_t n2 = n - n1;
+  const double ret = (p * Pow2(n1)) * Pow2(n2);
+
+  return (x < xmin) ? 0.0 : ret;
+}
+
+/// log(x) for positive normal x
+VECTOR_MATH_INLINE double Log(double x)
+{
+  const double ln2hi = 6.93147180369123816490e-01;
+  const double ln2lo = 1.90821492927058770002e-10;
+
+  /// x = 2^k * m, with sqrt(0.5) <= m < sqrt(2)
+  uint64_t u = AsBits(x) + (0x3ff0000000000000ULL - 0x3fe6a09e00000000ULL);
+  const double kd = AsDouble(0x4330000000000000ULL | (u >> 52)) - (4503599627370496.0 + 1023.0);
+  u = (u & 0x000fffffffffffffULL) + 0x3fe6a09e00000000ULL;
+  const double f = AsDouble(u) - 1.0;
+
+  /// log(1+f) = 2 atanh(s) = f - f^2/2 + s (f^2/2 + R)
+  const double s = f / (2.0 + f);
+  const double z = s * s;
+  double R = 1.0 / 23.0;
+  R = R * z + 1.0 / 21.0;
+  R = R * z + 1.0 / 19.0;
+  R = R * z + 1.0 / 17.0;
+  R = R * z + 1.0 / 15.0;
+  R = R * z + 1.0 / 13.0;
+  R = R * z + 1.0 / 11.0;
+  R = R * z + 1.0 / 9.0;
+  R = R * z + 1.0 / 7.0;
+  R = R * z + 1.0 / 5.0;
+  R = R * z + 1.0 / 3.0;
+  R *= 2.0 * z;
+
+  const double hfsq = 0.5 * f * f;
+  return s * (hfsq + R) + kd * ln2lo - hfsq + f + kd * ln2hi;
+}
+
+/// x^(1/3) for positive normal x, polished with a Newton step
+VECTOR_MATH_INLINE double Cbrt(double x)
+{
+  const double y = Exp(Log(x) * (1.0 / 3.0));
+  return y - (y * y * y - x) / (3.0 * y * y);
+}
+
+/// true when every entry is at least lo and at most hi, NaN is never in range
+VECTOR_MATH_INLINE bool InRange(const double *x, size_t n, double lo, double hi)
+{
+  uint64_t bad = 0;
+  for (size_t i = 0; i < n; ++i)
+  {
+    bad += ((x[i] >= lo) && (x[i] <= hi)) ? 0 : 1;
+  }
+  return bad == 0;
+}
+
+//// Each kernel has a range check, an array evaluation and the scalar function for everything else.
+//// Since every branch is computed for every entry, the kernels may raise
+//// floating point exceptions for results which are thrown away.  The range
+//// check may also raise an invalid exception comparing a NaN.  They are
+//// reset, so that only the scalar fallback reports them as before.
+template <typename K>
+VECTOR_MATH_INLINE void RunKernel(const double *x, double *y, size_t n)
+{
+  for (size_t b = 0; b < n; b += block_size)
+  {
+    const size_t len = ((n - b) < block_size) ? (n - b) : block_size;
+
+    std::fexcept_t flags;
+    std::fegetexceptflag(&flags, FE_ALL_EXCEPT);
+    const bool ok = InRange(x + b, len, K::lo, K::hi) && K::Evaluate(x + b, y + b, len);
+    std::fesetexceptflag(&flags, FE_ALL_EXCEPT);
+
+    if (!ok)
+    {
+      for (size_t i = b; i < (b + len); ++i)
+      {
+        y[i] = K::Scalar(x[i]);
+      }
+    }
+  }
+}
+
+//// Same series and branches as in Bernoulli.cc, with exp(-|x|) so nothing overflows
+struct BernoulliKernel {
+  static constexpr double lo = -std::numeric_limits<double>::max();
+  static constexpr double hi = std::numeric_limits<double>::max();
+
+  static VECTOR_MATH_INLINE bool Evaluate(const double *x, double *y, size_t n)
+  {
+    for (size_t i = 0; i < n; ++i)
+    {
+      const double v  = x[i];
+      const double fx = std::fabs(v);
+      const bool   small = fx < 1.0e-4;
+
+      const double xs = small ? v : 0.0;
+      double d  = 1.0;
+      double xv = xs;
+      d += 1./2. * xv;
+      xv *= xs;
+      d += 1./6. * xv;
+      xv *= xs;
+      d += 1./24. * xv;
+
+      /// one division for both branches
+      const double t   = Exp(-fx);
+      const double num = small ? 1.0 : ((v > 0.0) ? v * t : v);
+      const double den = small ? d : ((v > 0.0) ? 1.0 - t : t - 1.0);
+
+      double ret = num / den;
+      ret = (v >= vlnmax) ? 0.0 : ret;
+      y[i] = ret;
+    }
+    return true;
+  }
+
+  static double Scalar(double x)
+  {
+    return Bernoulli(x);
+  }
+};
+
+struct derBernoulliKernel {
+  static constexpr double lo = -std::numeric_limits<double>::max();
+  static constexpr double hi = std::numeric_limits<double>::max();
+
+  static VECTOR_MATH_INLINE bool Evaluate(const double *x, double *y, size_t n)
+  {
+    for (size_t i = 0; i < n; ++i)
+    {
+      const double v  = x[i];
+      const double fx = std::fabs(v);
+      const bool   small = fx < 1.0e-4;
+
+      const double xs = small ? v : 0.0;
+      double num = -1./2.;
+      double den = 1.0;
+      double xv = xs;
+      num -= 1./3. * xv;
+      den += xv;
+      xv *= xs;
+      num -= 1./8. * xv;
+      den += 7./12. * xv;
+      xv *= xs;
+      num -= 1./30. * xv;
+      den += 1./4. * xv;
+
+      /// (exp(x) (1 - x) - 1) / (exp(x) - 1)^2 in terms of t = exp(-|x|)
+      const double t    = Exp(-fx);
+      const double em1  = small ? 1.0 : ((v > 0.0) ? 1.0 - t : t - 1.0);
+      const double rnum = (v > 0.0) ? t * ((1.0 - v) - t) : t * (1.0 - v) - 1.0;
+
+      double ret = small ? num : rnum;
+      ret /= small ? den : em1 * em1;
+      ret = (v >= vlnmax) ? 0.0 : ret;
+      y[i] = ret;
+    }
+    return true;
+  }
+
+  static double Scalar(double x)
+  {
+    return derBernoulli(x);
+  }
+};
+
+//// W. J. Cody's rational approximations, all three ranges are evaluated and the right one is selected
+VECTOR_MATH_INLINE double Erfc(double x)
+{
+  const double thresh = 0.46875;
+  const double xbig   = 27.3;
+  const double sqrpi  = 5.6418958354775628695e-1;
+
+  const double a[5] = {3.16112374387056560e00, 1.13864154151050156e02, 3.77485237685302021e02, 3.20937758913846947e03, 1.85777706184603153e-1};
+  const double b[4] = {2.36012909523441209e01, 2.44024637934444173e02, 1.28261652607737228e03, 2.84423683343917062e03};
+  const double c[9] = {5.64188496988670089e-1, 8.88314979438837594e00, 6.61191906371416295e01, 2.98635138197400131e02, 8.81952221241769090e02, 1.71204761263407058e03, 2.05107837782607147e03, 1.23033935479799725e03, 2.15311535474403846e-8};
+  const double d[8] = {1.57449261107098347e01, 1.17693950891312499e02, 5.37181101862009858e02, 1.62138957456669019e03, 3.29079923573345963e03, 4.36261909014324716e03, 3.43936767414372164e03, 1.23033935480374942e03};
+  const double p[6] = {3.05326634961232344e-1, 3.60344899949804439e-1, 1.25781726111229246e-1, 1.60837851487422766e-2, 6.58749161529837803e-4, 1.63153871373020978e-2};
+  const double q[5] = {2.56852019228982242e00, 1.87295284992346725e00, 5.27905102951428412e-1, 6.05183413124413191e-2, 2.33520497626869185e-3};
+
+  const double y = std::fabs(x);
+
+  /// erf(y) for y <= thresh
+  const double y1   = (y < thresh) ? y : thresh;
+  const double ysq1 = y1 * y1;
+  double xnum = a[4] * ysq1;
+  double xden = ysq1;
+  for (size_t i = 0; i < 3; ++i)
+  {
+    xnum = (xnum + a[i]) * ysq1;
+    xden = (xden + b[i]) * ysq1;
+  }
+  const double num1 = y1 * (xnum + a[3]);
+  const double den1 = xden + b[3];
+
+  /// erfc(y) / exp(-y^2) for thresh < y <= 4
+  double y2 = (y < thresh) ? thresh : y;
+  y2 = (y2 > 4.0) ? 4.0 : y2;
+  xnum = c[8] * y2;
+  xden = y2;
+  for (size_t i = 0; i < 7; ++i)
+  {
+    xnum = (xnum + c[i]) * y2;
+    xden = (xden + d[i]) * y2;
+  }
+  const double num2 = xnum + c[7];
+  const double den2 = xden + d[7];
+
+  /// erfc(y) / exp(-y^2) for y > 4, the series in 1/y^2 multiplied through by y^10
+  double y3 = (y < 4.0) ? 4.0 : y;
+  y3 = (y3 > xbig) ? xbig : y3;
+  const double u = y3 * y3;
+  xnum = p[4] * u;
+  xden = q[4] * u;
+  for (size_t i = 4; i > 0; --i)
+  {
+    xnum = (xnum + p[i - 1]) * u;
+    xden = (xden + q[i - 1]) * u;
+  }
+  xnum += p[5];
+  xden += 1.0;
+  const double num3 = sqrpi * u * xden - xnum;
+  const double den3 = u * xden * y3;
+
+  /// the divisions are the slowest part, so only one is done
+  const bool   small = y <= thresh;
+  const bool   mid   = y < 4.0;
+  const double ratio = (small ? num1 : (mid ? num2 : num3)) / (small ? den1 : (mid ? den2 : den3));
+
+  /// exp(-y^2) split to keep the rounding error of y^2 out of the exponent
+  const double yc  = mid ? y2 : y3;
+  const double ysq = Trunc(yc * 16.0) * 0.0625;
+  const double del = (yc - ysq) * (yc + ysq);
+  double erfcl = Exp(-ysq * ysq) * Exp(-del) * ratio;
+  erfcl = (y > xbig) ? 0.0 : erfcl;
+
+  const double erfc_pos = small ? 1.0 - ratio : erfcl;
+
+  return (x < 0.0) ? (1.0 - erfc_pos) + 1.0 : erfc_pos;
+}
+
+struct ErfcKernel {
+  static constexpr double lo = -std::numeric_limits<double>::max();
+  static constexpr double hi = std::numeric_limits<double>::max();
+
+  static VECTOR_MATH_INLINE bool Evaluate(const double *x, double *y, size_t n)
+  {
+    for (size_t i = 0; i < n; ++i)
+    {
+      y[i] = Erfc(x[i]);
+    }
+    return true;
+  }
+
+  static double Scalar(double x)
+  {
+    return std::erfc(x);
+  }
+};
+
+//// x * x overflows outside of the range, which is left to the scalar version
+struct derfdxKernel {
+  static constexpr double lo = -1.0e150;
+  static constexpr double hi =  1.0e150;
+
+  static VECTOR_MATH_INLINE bool Evaluate(const double *x, double *y, size_t n)
+  {
+    for (size_t i = 0; i < n; ++i)
+    {
+      y[i] = M_2_SQRTPI * Exp(-x[i] * x[i]);
+    }
+    return true;
+  }
+
+  static double Scalar(double x)
+  {
+    return derfdx(x);
+  }
+};
+
+struct derfcdxKernel {
+  static constexpr double lo = -1.0e150;
+  static constexpr double hi =  1.0e150;
+
+  static VECTOR_MATH_INLINE bool Evaluate(const double *x, double *y, size_t n)
+  {
+    for (size_t i = 0; i < n; ++i)
+    {
+      y[i] = -M_2_SQRTPI * Exp(-x[i] * x[i]);
+    }
+    return true;
+  }
+
+  static double Scalar(double x)
+  {
+    return derfcdx(x);
+  }
+};
+
+//// Same expressions as in Fermi.cc, both branches are evaluated with the argument clamped to their range
+constexpr double fermi_breakpoint = 8.46296036621705;
+constexpr double fermi_offset = -0.0137050034663995;
+/// keeps the powers in Expansion finite
+constexpr double fermi_rmax = 1.0e200;
+
+VECTOR_MATH_INLINE void InvFermiAndDerivative(double r, double &f, double &df)
+{
+  const double sqrt1_8 = 0.35355339059327373;
+  const double c1 = -4.9500897298752622e-3;
+  const double c2 =  1.4838577128872821e-4;
+  const double c3 = -4.4256301190009895e-6;
+  /// sqrt(pi)/2, 3/4 sqrt(pi) and -pi^2/6
+  const double d0 = 0.88622692545275801;
+  const double d1 = 1.3293403881791370;
+  const double d3 = -1.6449340668482264;
+
+  const bool   joyce = r < fermi_breakpoint;
+  const double rj = joyce ? r : fermi_breakpoint;
+  const double re = joyce ? fermi_breakpoint : r;
+
+  double R = rj;
+  double sum = Log(rj);
+  sum += sqrt1_8 * R;
+  R *= rj;
+  sum += c1 * R;
+  R *= rj;
+  sum += c2 * R;
+  R *= rj;
+  sum += c3 * R;
+
+  double dsum = 1.0 / rj;
+  R = rj;
+  dsum += sqrt1_8;
+  dsum += 2.0 * c1 * R;
+  R *= rj;
+  dsum += 3.0 * c2 * R;
+  R *= rj;
+  dsum += 4.0 * c3 * R;
+
+  /// (d1 r)^(4/3) and (d1 r)^(1/3)
+  const double a    = d1 * re;
+  const double cbrt = Cbrt(a);
+  const double expansion = std::sqrt(a * cbrt + d3) + fermi_offset;
+  const double dexpansion = d0 * cbrt / expansion;
+
+  f  = joyce ? sum : expansion;
+  df = joyce ? dsum : dexpansion;
+}
+
+struct InvFermiKernel {
+  static constexpr double lo = std::numeric_limits<double>::min();
+  static constexpr double hi = fermi_rmax;
+
+  static VECTOR_MATH_INLINE bool Evaluate(const double *x, double *y, size_t n)
+  {
+    for (size_t i = 0; i < n; ++i)
+    {
+      double f, df;
+      InvFermiAndDerivative(x[i], f, df);
+      y[i] = f;
+    }
+    return true;
+  }
+
+  static double Scalar(double x)
+  {
+    return InvFermi(x);
+  }
+};
+
+struct dInvFermidxKernel {
+  static constexpr double lo = std::numeric_limits<double>::min();
+  static constexpr double hi = fermi_rmax;
+
+  static VECTOR_MATH_INLINE bool Evaluate(const double *x, double *y, size_t n)
+  {
+    for (size_t i = 0; i < n; ++i)
+    {
+      double f, df;
+      InvFermiAndDerivative(x[i], f, df);
+      y[i] = df;
+    }
+    return true;
+  }
+
+  static double Scalar(double x)
+  {
+    return dInvFermidx(x);
+  }
+};
+
+//// One Newton step of Fermi.cc for the entries of a block with a state of 1.
+//// The state becomes 0 once an entry has converged, and 2 if it leaves the
+//// range where InvFermi is evaluated.  The step halving loop is replaced by
+//// scaling with the power of 2 it would have reached.  Returns the number
+//// of entries needing another step.
+VECTOR_MATH_INLINE uint64_t FermiStep(const double *x, double *r, double *state, size_t n)
+{
+  for (size_t i = 0; i < n; ++i)
+  {
+    const double ri = r[i];
+    double f, fp;
+    InvFermiAndDerivative(ri, f, fp);
+    f -= x[i];
+    double upd = -f / fp;
+
+    /// halving until upd + r > 0 ends at 2^-(e+1), where 2^e <= -upd / r < 2^(e+1)
+    const double   qmax = 1.1235582092889474e307;
+    const bool     negative = (upd + ri) <= 0.0;
+    const double   q  = std::fabs(upd / ri);
+    const double   qc = (q < qmax) ? q : qmax;
+    const uint64_t biased = AsBits(qc) >> 52;
+    upd = negative ? upd * AsDouble((2045 - biased) << 52) : upd;
+
+    const double rn   = ri + upd;
+    const double rerr = std::fabs(upd) / (std::fabs(rn) + 1.0e-10);
+    const bool   ok   = (rn >= std::numeric_limits<double>::min()) && (rn <= fermi_rmax) && (q < qmax);
+    const double s    = state[i];
+    const bool   act  = s == 1.0;
+
+    const double next = (rerr > 1.0e-13) ? 1.0 : 0.0;
+    const double snew = ok ? next : 2.0;
+
+    r[i] = (act && ok) ? rn : ri;
+    state[i] = act ? snew : s;
+  }
+
+  uint64_t running = 0;
+  for (size_t i = 0; i < n; ++i)
+  {
+    running += (state[i] == 1.0) ? 1 : 0;
+  }
+  return running;
+}
+
+//// The Newton iteration of Fermi.cc applied to a block at once.  Converged
+//// entries are no longer updated, so every entry takes the same steps as in
+//// the scalar version.  y is only written on success.
+VECTOR_MATH_INLINE bool FermiBlock(const double *x, double *y, size_t n)
+{
+  double r[block_size];
+  double state[block_size];
+
+  for (size_t i = 0; i < n; ++i)
+  {
+    r[i] = Exp(x[i]);
+    state[i] = 1.0;
+  }
+
+  for (size_t it = 0; (it < 20) && FermiStep(x, r, state, n); ++it)
+  {
+  }
+
+  if (!InRange(state, n, 0.0, 1.0))
+  {
+    return false;
+  }
+
+  for (size_t i = 0; i < n; ++i)
+  {
+    y[i] = r[i];
+  }
+  return true;
+}
+
+struct FermiKernel {
+  static constexpr double lo = -700.0;
+  static constexpr double hi =  200.0;
+
+  static VECTOR_MATH_INLINE bool Evaluate(const double *x, double *y, size_t n)
+  {
+    return FermiBlock(x, y, n);
+  }
+
+  static double Scalar(double x)
+  {
+    return Fermi(x);
+  }
+};
+
+struct dFermidxKernel {
+  static constexpr double lo = -700.0;
+  static constexpr double hi =  200.0;
+
+  static VECTOR_MATH_INLINE bool Evaluate(const double *x, double *y, size_t n)
+  {
+    double r[block_size];
+    if (!FermiBlock(x, r, n))
+    {
+      return false;
+    }
+    for (size_t i = 0; i < n; ++i)
+    {
+      double f, df;
+      InvFermiAndDerivative(r[i], f, df);
+      y[i] = 1.0 / df;
+    }
+    return true;
+  }
+
+  static double Scalar(double x)
+  {
+    return dFermidx(x);
+  }
+};
+}
+
+VECTOR_MATH_CLONES void BernoulliArray(const double *x, double *y, size_t n)
+{
+  RunKernel<BernoulliKernel>(x, y, n);
+}
+
+VECTOR_MATH_CLONES void derBernoulliArray(const double *x, double *y, size_t n)
+{
+  RunKernel<derBernoulliKernel>(x, y, n);
+}
+
+VECTOR_MATH_CLONES void erfcArray(const double *x, double *y, size_t n)
+{
+  RunKernel<ErfcKernel>(x, y, n);
+}
+
+VECTOR_MATH_CLONES void derfdxArray(const double *x, double *y, size_t n)
+{
+  RunKernel<derfdxKernel>(x, y, n);
+}
+
+VECTOR_MATH_CLONES void derfcdxArray(const double *x, double *y, size_t n)
+{
+  RunKernel<derfcdxKernel>(x, y, n);
+}
+
+VECTOR_MATH_CLONES void InvFermiArray(const double *x, double *y, size_t n)
+{
+  RunKernel<InvFermiKernel>(x, y, n);
+}
+
+VECTOR_MATH_CLONES void dInvFermidxArray(const double *x, double *y, size_t n)
+{
+  RunKernel<dInvFermidxKernel>(x, y, n);
+}
+
+VECTOR_MATH_CLONES void FermiArray(const double *x, double *y, size_t n)
+{
+  RunKernel<FermiKernel>(x, y, n);
+}
+
+VECTOR_MATH_CLONES void dFermidxArray(const double *x, double *y, size_t n)
+{
+  RunKernel<dFermidxKernel>(x, y, n);
+}
+
+namespace Eqomfp {
+#ifdef DEVSIM_VECTOR_MATH
+namespace {
+struct UnaryVectorTblEntry {
+  const char *name;
+  unaryvectorfuncptr<double> func;
+};
+
+UnaryVectorTblEntry UnaryVectorTable_double[] = {
+  {"B",           BernoulliArray},
+  {"dBdx",        derBernoulliArray},
+  {"erfc",        erfcArray},
+  {"derfdx",      derfdxArray},
+  {"derfcdx",     derfcdxArray},
+  {"Fermi",       FermiArray},
+  {"dFermidx",    dFermidxArray},
+  {"InvFermi",    InvFermiArray},
+  {"dInvFermidx", dInvFermidxArray},
+  {NULL, NULL}
+};
+}
+#endif
+
+template <>
+unaryvectorfuncptr<double> GetUnaryVectorFunc(const std::string &name)
+{
+#ifdef DEVSIM_VECTOR_MATH
+  for (size_t i = 0; UnaryVectorTable_double[i].name != NULL; ++i)
+  {
+    if (name == UnaryVectorTable_double[i].name)
+    {
+      return UnaryVectorTable_double[i].func;
+    }
+  }
+#else
+  (void) name;
+#endif
+  return NULL;
+}
+
+#ifdef DEVSIM_EXTENDED_PRECISION
+template <>
+unaryvectorfuncptr<float128> GetUnaryVectorFunc(const std::string &)
+{
+  return NULL;
+}
+#endif
+}
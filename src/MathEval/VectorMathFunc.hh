@@ -0,0 +1,50 @@
+/***
+DEVSIM
+Copyright 2013 Devsim LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+***/
+
+#ifndef VECTOR_MATH_FUNC_HH
+#define VECTOR_MATH_FUNC_HH
+#include "MathWrapper.hh"
+#include <string>
+#include <cstddef>
+
+//// Array versions of the special functions, written without branches so
+//// that the compiler vectorizes them.  With DEVSIM_VECTOR_MATH on x86_64,
+//// AVX-512, AVX2 and baseline versions are compiled and the one for the
+//// running cpu is picked at load time.
+////
+//// Blocks containing arguments outside of the range handled by a kernel,
+//// e.g. infinities or NaN, are evaluated with the scalar functions so the
+//// results and floating point exceptions are the same as before.
+////
+//// There is no kernel for erf, since evaluating every range of the rational
+//// approximation is slower than the library version.
+void BernoulliArray(const double *, double *, size_t);
+void derBernoulliArray(const double *, double *, size_t);
+void erfcArray(const double *, double *, size_t);
+void derfdxArray(const double *, double *, size_t);
+void derfcdxArray(const double *, double *, size_t);
+void InvFermiArray(const double *, double *, size_t);
+void dInvFermidxArray(const double *, double *, size_t);
+void FermiArray(const double *, double *, size_t);
+void dFermidxArray(const double *, double *, size_t);
+
+namespace Eqomfp {
+/// The array version of a unary function, or NULL if there is none or they are disabled
+template <typename DoubleType>
+unaryvectorfuncptr<DoubleType> GetUnaryVectorFunc(const std::string &);
+}
+#endif
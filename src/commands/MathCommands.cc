@@ -22,6 +22,7 @@ limitations under the License.
 #include "Newton.hh"
 #include "DirectLinearSolver.hh"
 #include "IterativeLinearSolver.hh"
+#include "MatrixFreeLinearSolver.hh"
 
 #include "ContactEquationHolder.hh"
 #include "Region.hh"
@@ -31,12 +32,94 @@ limitations under the License.
 #include "CheckFunctions.hh"
 #include "dsAssert.hh"
 #include "GlobalData.hh"
+#include "PhaseTimer.hh"
+#include "OutputStream.hh"
 #include <sstream>
 
 using namespace dsValidate;
 
 namespace dsCommand {
 
+namespace {
+/// Creates the linear solver from the solver_type, preconditioner, fill_level and linear_iterations options
+template <typename DoubleType>
+std::unique_ptr<dsMath::LinearSolver<DoubleType>>
+CreateLinearSolver(CommandHandler &data, std::string &errorString)
+{
+  const std::string &solver_type = data.GetStringOption("solver_type");
+  const int linear_iterations = data.GetIntegerOption("linear_iterations");
+
+  std::unique_ptr<dsMath::LinearSolver<DoubleType>> linearSolver;
+
+  if (solver_type == "direct")
+  {
+    linearSolver = std::unique_ptr<dsMath::LinearSolver<DoubleType>>(new dsMath::DirectLinearSolver<DoubleType>);
+  }
+  else if (solver_type == "mkl_pardiso")
+  {
+    if (dsMath::DirectLinearSolver<DoubleType>::IsAvailable(dsMath::DirectSolver_t::MKL_PARDISO))
+    {
+      linearSolver = std::unique_ptr<dsMath::LinearSolver<DoubleType>>(new dsMath::DirectLinearSolver<DoubleType>(dsMath::DirectSolver_t::MKL_PARDISO));
+    }
+    else
+    {
+      std::ostringstream os;
+      os << "\"mkl_pardiso\" solver support not available in this version\n";
+      errorString = os.str();
+    }
+  }
+  else if (linear_iterations <= 0)
+  {
+    std::ostringstream os;
+    os << "\"linear_iterations\" must be positive\n";
+    errorString = os.str();
+  }
+  else if (solver_type == "iterative")
+  {
+    const std::string &preconditioner = data.GetStringOption("preconditioner");
+    const int fill_level = data.GetIntegerOption("fill_level");
+    if (preconditioner == "block")
+    {
+      dsMath::IterativeLinearSolver<DoubleType> *iterative = new dsMath::IterativeLinearSolver<DoubleType>;
+      iterative->SetLinearIterations(linear_iterations);
+      linearSolver = std::unique_ptr<dsMath::LinearSolver<DoubleType>>(iterative);
+    }
+    else if ((preconditioner == "ilu") && (fill_level >= 0))
+    {
+      dsMath::IterativeLinearSolver<DoubleType> *iterative = new dsMath::IterativeLinearSolver<DoubleType>(dsMath::IterativePreconditioner_t::ILU, fill_level);
+      iterative->SetLinearIterations(linear_iterations);
+      linearSolver = std::unique_ptr<dsMath::LinearSolver<DoubleType>>(iterative);
+    }
+    else if (preconditioner == "ilu")
+    {
+      std::ostringstream os;
+      os << "\"fill_level\" cannot be negative\n";
+      errorString = os.str();
+    }
+    else
+    {
+      std::ostringstream os;
+      os << "\"block\" and \"ilu\" are the only valid preconditioners\n";
+      errorString = os.str();
+    }
+  }
+  else if (solver_type == "matrix_free")
+  {
+    dsMath::MatrixFreeLinearSolver<DoubleType> *matrix_free = new dsMath::MatrixFreeLinearSolver<DoubleType>;
+    matrix_free->SetLinearIterations(linear_iterations);
+    linearSolver = std::unique_ptr<dsMath::LinearSolver<DoubleType>>(matrix_free);
+  }
+  else
+  {
+    std::ostringstream os;
+    os << "\"direct\", \"mkl_pardiso\", \"iterative\" and \"matrix_free\" are the only valid solver types\n";
+    errorString = os.str();
+  }
+
+  return linearSolver;
+}
+}
+
 template <typename DoubleType>
 void
 solveCmdImpl(CommandHandler &data)
@@ -44,7 +127,6 @@ solveCmdImpl(CommandHandler &data)
   std::string errorString;
 //    const std::string commandName = data.GetCommandName();
   const std::string &type = data.GetStringOption("type");
-  const std::string &solver_type = data.GetStringOption("solver_type");
 
   const DoubleType tdelta = data.GetDoubleOption("tdelta");
   const DoubleType gamma  = data.GetDoubleOption("gamma");
@@ -117,28 +199,25 @@ solveCmdImpl(CommandHandler &data)
   const DoubleType frequency = data.GetDoubleOption("frequency");
   const std::string &outputNode = data.GetStringOption("output_node");
 
+  std::vector<DoubleType> frequencies;
+  {
+    std::vector<double> values;
+    if (!data.GetObjectHolder("frequencies").GetDoubleList(values))
+    {
+      data.SetErrorResult("\"frequencies\" must be a list of floats\n");
+      return;
+    }
+    frequencies.assign(values.begin(), values.end());
+  }
+  ObjectHolderList_t frequency_results;
+
   dsMath::Newton<DoubleType> solver;
   solver.SetAbsError(absolute_error);
   solver.SetRelError(relative_error);
   solver.SetQRelError(charge_error);
   solver.SetMaxIter(maximum_iterations);
 
-  std::unique_ptr<dsMath::LinearSolver<DoubleType>> linearSolver;
-
-  if (solver_type == "direct")
-  {
-    linearSolver = std::unique_ptr<dsMath::LinearSolver<DoubleType>>(new dsMath::DirectLinearSolver<DoubleType>);
-  }
-  else if (solver_type == "iterative")
-  {
-    linearSolver = std::unique_ptr<dsMath::LinearSolver<DoubleType>>(new dsMath::IterativeLinearSolver<DoubleType>);
-  }
-  else
-  {
-    std::ostringstream os;
-    os << "\"direct\" and \"iterative\" are the only valid simulation types\n";
-    errorString = os.str();
-  }
+  std::unique_ptr<dsMath::LinearSolver<DoubleType>> linearSolver = CreateLinearSolver<DoubleType>(data, errorString);
 
   if (!errorString.empty())
   {
@@ -152,10 +231,18 @@ solveCmdImpl(CommandHandler &data)
   {
     res = solver.Solve(*linearSolver, dsMath::TimeMethods::DCOnly<DoubleType>(), p_ohm);
   }
+  else if ((type == "ac") && !frequencies.empty())
+  {
+    res = solver.ACSolve(*linearSolver, frequencies, frequency_results);
+  }
   else if (type == "ac")
   {
     res = solver.ACSolve(*linearSolver, frequency);
   }
+  else if ((type == "noise") && !frequencies.empty())
+  {
+    res = solver.NoiseSolve(outputNode, *linearSolver, frequencies, frequency_results);
+  }
   else if (type == "noise")
   {
     res = solver.NoiseSolve(outputNode, *linearSolver, frequency);
@@ -183,6 +270,10 @@ solveCmdImpl(CommandHandler &data)
     os << "Convergence failure!\n";
     errorString = os.str();
   }
+  else if (!frequencies.empty() && ((type == "ac") || (type == "noise")))
+  {
+    data.SetObjectResult(ObjectHolder(frequency_results));
+  }
   else if (p_ohm)
   {
     data.SetObjectResult(ObjectHolder(ohm));
@@ -216,8 +307,12 @@ solveCmd(CommandHandler &data)
     {"relative_error",     "0", dsGetArgs::optionType::FLOAT, dsGetArgs::requiredType::OPTIONAL},
     {"maximum_iterations", "20", dsGetArgs::optionType::INTEGER, dsGetArgs::requiredType::OPTIONAL},
     {"frequency",    "0.0", dsGetArgs::optionType::FLOAT, dsGetArgs::requiredType::OPTIONAL},
+    {"frequencies",  "", dsGetArgs::optionType::LIST, dsGetArgs::requiredType::OPTIONAL},
     {"output_node",  "", dsGetArgs::optionType::STRING, dsGetArgs::requiredType::OPTIONAL},
     {"solver_type",  "direct", dsGetArgs::optionType::STRING, dsGetArgs::requiredType::OPTIONAL},
+    {"preconditioner", "block", dsGetArgs::optionType::STRING, dsGetArgs::requiredType::OPTIONAL},
+    {"fill_level",   "1", dsGetArgs::optionType::INTEGER, dsGetArgs::requiredType::OPTIONAL},
+    {"linear_iterations", "100", dsGetArgs::optionType::INTEGER, dsGetArgs::requiredType::OPTIONAL},
     {"tdelta",       "0.0", dsGetArgs::optionType::FLOAT, dsGetArgs::requiredType::OPTIONAL},
     {"charge_error", "0.0", dsGetArgs::optionType::FLOAT, dsGetArgs::requiredType::OPTIONAL},
     {"gamma",        "1.0", dsGetArgs::optionType::FLOAT, dsGetArgs::requiredType::OPTIONAL},
@@ -259,6 +354,199 @@ solveCmd(CommandHandler &data)
   }
 }
 
+template <typename DoubleType>
+void
+sweepCmdImpl(CommandHandler &data)
+{
+  std::string errorString;
+
+  const std::string &deviceName  = data.GetStringOption("device");
+  const std::string &contactName = data.GetStringOption("contact");
+  const std::string &paramName   = data.GetStringOption("name");
+  const int maximum_divisions    = data.GetIntegerOption("maximum_divisions");
+  const bool use_predictor       = data.GetBooleanOption("predictor");
+
+  Device   *device = NULL;
+  Contact  *contact = NULL;
+
+  if (!contactName.empty())
+  {
+    errorString = ValidateDeviceAndContact(deviceName, contactName, device, contact);
+  }
+
+  std::vector<double> values;
+  if (errorString.empty() && !data.GetObjectHolder("values").GetDoubleList(values))
+  {
+    errorString = "\"values\" must be a list of floats\n";
+  }
+
+  //// The step is divided by 1 << divisions, which must fit in an int
+  if (errorString.empty() && ((maximum_divisions < 0) || (maximum_divisions > 30)))
+  {
+    errorString = "\"maximum_divisions\" must be from 0 to 30\n";
+  }
+
+  if (!errorString.empty())
+  {
+    data.SetErrorResult(errorString);
+    return;
+  }
+
+  dsMath::Newton<DoubleType> solver;
+  solver.SetAbsError(data.GetDoubleOption("absolute_error"));
+  solver.SetRelError(data.GetDoubleOption("relative_error"));
+  solver.SetMaxIter(data.GetIntegerOption("maximum_iterations"));
+
+  std::unique_ptr<dsMath::LinearSolver<DoubleType>> linearSolver = CreateLinearSolver<DoubleType>(data, errorString);
+
+  if (!errorString.empty())
+  {
+    data.SetErrorResult(errorString);
+    return;
+  }
+
+  GlobalData &gdata = GlobalData::GetInstance();
+
+  //// Continuation starts from the present value of the parameter
+  double bias = values.empty() ? 0.0 : values[0];
+  {
+    GlobalData::DBEntry_t dbent = gdata.GetDBEntryOnDevice(deviceName, paramName);
+    if (dbent.first)
+    {
+      std::pair<bool, double> dval = dbent.second.GetDouble();
+      if (dval.first)
+      {
+        bias = dval.second;
+      }
+    }
+  }
+
+  //// The factorization kept by the solver belongs to the last converged point
+  bool have_factorization = false;
+
+  ObjectHolderList_t points;
+
+  for (size_t i = 0; i < values.size(); ++i)
+  {
+    const double target = values[i];
+
+    //// The step to the target is halved for each division
+    int divisions = 0;
+    for (;;)
+    {
+      const double next = (divisions == 0) ? target : bias + (target - bias) / static_cast<double>(1 << divisions);
+
+      solver.BackupSolutions("_sweep");
+      gdata.AddDBEntryOnDevice(deviceName, paramName, ObjectHolder(next));
+
+      if (use_predictor && have_factorization)
+      {
+        solver.Predict(*linearSolver);
+      }
+
+      const bool converged = solver.Solve(*linearSolver, dsMath::TimeMethods::DCOnly<DoubleType>(), NULL);
+      have_factorization = converged;
+
+      if (converged)
+      {
+        bias = next;
+        if (next == target)
+        {
+          break;
+        }
+        divisions -= 1;
+        continue;
+      }
+
+      solver.RestoreSolutions("_sweep");
+      gdata.AddDBEntryOnDevice(deviceName, paramName, ObjectHolder(bias));
+
+      if ((next == bias) || (divisions >= maximum_divisions))
+      {
+        std::ostringstream os;
+        os << "Convergence failure for \"" << paramName << "\" at " << next << "\n";
+        data.SetErrorResult(os.str());
+        return;
+      }
+
+      divisions += 1;
+      std::ostringstream os;
+      os << "Reducing step for \"" << paramName << "\" to " << (bias + (target - bias) / static_cast<double>(1 << divisions)) << "\n";
+      OutputStream::WriteOut(OutputStream::OutputType::INFO, os.str());
+    }
+
+    ObjectHolderMap_t point;
+    point["value"] = ObjectHolder(bias);
+    if (contact)
+    {
+      ObjectHolderMap_t currents;
+      const ContactEquationPtrMap_t &cepm = contact->GetEquationPtrList();
+      for (ContactEquationPtrMap_t::const_iterator cepmit = cepm.begin(); cepmit != cepm.end(); ++cepmit)
+      {
+        currents[cepmit->second.GetName()] = ObjectHolder(cepmit->second.GetCurrent<double>());
+      }
+      point["currents"] = ObjectHolder(currents);
+    }
+    points.push_back(ObjectHolder(point));
+  }
+
+  data.SetObjectResult(ObjectHolder(points));
+}
+
+void
+sweepCmd(CommandHandler &data)
+{
+  std::string errorString;
+
+  static dsGetArgs::Option option[] =
+  {
+    {"device",             "", dsGetArgs::optionType::STRING, dsGetArgs::requiredType::REQUIRED, mustBeValidDevice},
+    {"name",               "", dsGetArgs::optionType::STRING, dsGetArgs::requiredType::REQUIRED, stringCannotBeEmpty},
+    {"values",             "", dsGetArgs::optionType::LIST, dsGetArgs::requiredType::REQUIRED},
+    {"contact",            "", dsGetArgs::optionType::STRING, dsGetArgs::requiredType::OPTIONAL},
+    {"absolute_error",     "0", dsGetArgs::optionType::FLOAT, dsGetArgs::requiredType::OPTIONAL},
+    {"relative_error",     "0", dsGetArgs::optionType::FLOAT, dsGetArgs::requiredType::OPTIONAL},
+    {"maximum_iterations", "20", dsGetArgs::optionType::INTEGER, dsGetArgs::requiredType::OPTIONAL},
+    {"maximum_divisions",  "10", dsGetArgs::optionType::INTEGER, dsGetArgs::requiredType::OPTIONAL},
+    {"predictor",          "true", dsGetArgs::optionType::BOOLEAN, dsGetArgs::requiredType::OPTIONAL},
+    {"solver_type",        "direct", dsGetArgs::optionType::STRING, dsGetArgs::requiredType::OPTIONAL},
+    {"preconditioner",     "block", dsGetArgs::optionType::STRING, dsGetArgs::requiredType::OPTIONAL},
+    {"fill_level",         "1", dsGetArgs::optionType::INTEGER, dsGetArgs::requiredType::OPTIONAL},
+    {"linear_iterations",  "100", dsGetArgs::optionType::INTEGER, dsGetArgs::requiredType::OPTIONAL},
+    {NULL,  NULL, dsGetArgs::optionType::STRING, dsGetArgs::requiredType::OPTIONAL}
+  };
+
+  dsGetArgs::switchList switches = NULL;
+
+  bool error = data.processOptions(option, switches, errorString);
+
+  if (error)
+  {
+      data.SetErrorResult(errorString);
+      return;
+  }
+
+  {
+    bool extended_solver = false;
+    GlobalData &gdata = GlobalData::GetInstance();
+    auto dbent = gdata.GetDBEntryOnGlobal("extended_solver");
+    if (dbent.first)
+    {
+      auto oh = dbent.second.GetBoolean();
+      extended_solver = (oh.first && oh.second);
+    }
+
+    if (extended_solver)
+    {
+      sweepCmdImpl<extended_type>(data);
+    }
+    else
+    {
+      sweepCmdImpl<double>(data);
+    }
+  }
+}
+
 void
 getContactCurrentCmd(CommandHandler &data)
 {
@@ -352,10 +640,57 @@ getContactCurrentCmd(CommandHandler &data)
     return;
 }
 
+void
+getPhaseTimingsCmd(CommandHandler &data)
+{
+    std::string errorString;
+
+    static dsGetArgs::Option option[] = {
+        {"reset", "false", dsGetArgs::optionType::BOOLEAN, dsGetArgs::requiredType::OPTIONAL},
+        {NULL,  NULL, dsGetArgs::optionType::STRING, dsGetArgs::requiredType::OPTIONAL}
+    };
+
+    dsGetArgs::switchList switches = NULL;
+
+
+    bool error = data.processOptions(option, switches, errorString);
+
+    if (error)
+    {
+        data.SetErrorResult(errorString);
+        return;
+    }
+
+    PhaseTimer &timer = PhaseTimer::GetInstance();
+
+    ObjectHolderMap_t ohm;
+    const PhaseTimer::PhaseList_t &plist = timer.GetPhaseList();
+    for (PhaseTimer::PhaseList_t::const_iterator it = plist.begin(); it != plist.end(); ++it)
+    {
+      const PhaseTimer::PhaseData &phase = it->second;
+      ObjectHolderMap_t pmap;
+      pmap["count"]        = ObjectHolder(static_cast<int>(phase.count));
+      pmap["total_time"]   = ObjectHolder(phase.total_time);
+      pmap["maximum_time"] = ObjectHolder(phase.maximum_time);
+      pmap["peak_memory"]  = ObjectHolder(static_cast<double>(phase.peak_memory));
+      ohm[it->first] = ObjectHolder(pmap);
+    }
+    ohm["peak_memory"] = ObjectHolder(static_cast<double>(PhaseTimer::GetPeakMemory()));
+
+    if (data.GetBooleanOption("reset"))
+    {
+      timer.Clear();
+    }
+
+    data.SetObjectResult(ObjectHolder(ohm));
+}
+
 Commands MathCommands[] = {
     {"get_contact_current",  getContactCurrentCmd},
     {"get_contact_charge",   getContactCurrentCmd},
+    {"get_phase_timings",    getPhaseTimingsCmd},
     {"solve",                solveCmd},
+    {"sweep",                sweepCmd},
     {NULL, NULL}
 };
 
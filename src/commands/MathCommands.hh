@@ -24,6 +24,8 @@ extern Commands MathCommands[];
 void getContactCurrentCmd(CommandHandler &);
 void getContactCurrentCmd(CommandHandler &);
 void solveCmd(CommandHandler &);
+void sweepCmd(CommandHandler &);
+void getPhaseTimingsCmd(CommandHandler &);
 }
 
 #endif
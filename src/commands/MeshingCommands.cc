@@ -27,8 +27,12 @@ limitations under the License.
 #include "DevsimReader.hh"
 #include "DevsimWriter.hh"
 #include "DevsimRestartWriter.hh"
+#include "DevsimBinaryWriter.hh"
 #include "FloodsWriter.hh"
 #include "VTKWriter.hh"
+#ifdef VTKWRITER
+#include "AsyncWriter.hh"
+#endif
 #include "TecplotWriter.hh"
 #include "dsAssert.hh"
 #include "GmshReader.hh"
@@ -714,6 +718,10 @@ writeDevicesCmd(CommandHandler &data)
         {"file",     "", dsGetArgs::optionType::STRING, dsGetArgs::requiredType::REQUIRED, NULL},
         {"device",     "", dsGetArgs::optionType::STRING, dsGetArgs::requiredType::OPTIONAL, NULL},
         {"type",     "", dsGetArgs::optionType::STRING, dsGetArgs::requiredType::OPTIONAL, NULL},
+        {"vtk_format",     "base64", dsGetArgs::optionType::STRING, dsGetArgs::requiredType::OPTIONAL, NULL},
+        {"vtk_partitioned", "false", dsGetArgs::optionType::BOOLEAN, dsGetArgs::requiredType::OPTIONAL, NULL},
+        {"models",     "", dsGetArgs::optionType::LIST, dsGetArgs::requiredType::OPTIONAL, NULL},
+        {"asynchronous", "false", dsGetArgs::optionType::BOOLEAN, dsGetArgs::requiredType::OPTIONAL, NULL},
         {NULL,  NULL, dsGetArgs::optionType::STRING, dsGetArgs::requiredType::OPTIONAL, NULL}
     };
 
@@ -731,6 +739,25 @@ writeDevicesCmd(CommandHandler &data)
     const std::string &fileName = data.GetStringOption("file");
     const std::string &device   = data.GetStringOption("device");
     const std::string &type = data.GetStringOption("type");
+    const bool asynchronous = data.GetBooleanOption("asynchronous");
+#ifdef VTKWRITER
+    const std::string &vtkFormat = data.GetStringOption("vtk_format");
+    const bool vtkPartitioned = data.GetBooleanOption("vtk_partitioned");
+    std::vector<std::string> models;
+    {
+      ObjectHolder mdata = data.GetObjectHolder("models");
+      if (mdata.IsList())
+      {
+        bool ok = mdata.GetStringList(models);
+        if (!ok)
+        {
+          errorString += "Option \"models\" could not be converted to a list of strings\n";
+          data.SetErrorResult(errorString);
+          return;
+        }
+      }
+    }
+#endif
 
     std::unique_ptr<MeshWriter> mw;
 
@@ -738,6 +765,10 @@ writeDevicesCmd(CommandHandler &data)
     {
         mw = std::unique_ptr<MeshWriter>(new DevsimRestartWriter());
     }
+    else if (type == "devsim_binary")
+    {
+        mw = std::unique_ptr<MeshWriter>(new DevsimBinaryWriter());
+    }
     else if (type == "devsim_data")
     {
         mw = std::unique_ptr<MeshWriter>(new DevsimWriter());
@@ -749,9 +780,43 @@ writeDevicesCmd(CommandHandler &data)
     else if (type == "vtk")
     {
 #ifdef VTKWRITER
-        mw = std::unique_ptr<MeshWriter>(new VTKWriter());
+        VTKWriter::DataFormat format = VTKWriter::DataFormat::BASE64;
+        if (vtkFormat == "appended")
+        {
+          format = VTKWriter::DataFormat::APPENDED;
+        }
+        else if (vtkFormat != "base64")
+        {
+          errorString += "vtk_format: " + vtkFormat + " is not a valid format.  Please select from \"base64\" or \"appended\".\n";
+          data.SetErrorResult(errorString);
+          return;
+        }
+        if (asynchronous)
+        {
+          VTKWriter vw(format, vtkPartitioned, models);
+          bool ret = true;
+          if (device.empty())
+          {
+            ret = vw.QueueMeshes(fileName, errorString);
+          }
+          else
+          {
+            ret = vw.QueueMesh(device, fileName, errorString);
+          }
+
+          if (!ret)
+          {
+            data.SetErrorResult(errorString);
+          }
+          else
+          {
+            data.SetEmptyResult();
+          }
+          return;
+        }
+        mw = std::unique_ptr<MeshWriter>(new VTKWriter(format, vtkPartitioned, models));
 #else
-        errorString += "VTK support was not built into this version.  Please select from \"devsim\", \"devsim_data\", \"floops\", or \"tecplot\".\n";
+        errorString += "VTK support was not built into this version.  Please select from \"devsim\", \"devsim_binary\", \"devsim_data\", \"floops\", or \"tecplot\".\n";
         data.SetErrorResult(errorString);
         return;
 #endif
@@ -762,7 +827,14 @@ writeDevicesCmd(CommandHandler &data)
     }
     else
     {
-        errorString += "type: " + type + " is not a valid type.  Please select from \"devsim\", \"devsim_data\", \"floops\", \"vtk\", or \"tecplot\".\n";
+        errorString += "type: " + type + " is not a valid type.  Please select from \"devsim\", \"devsim_binary\", \"devsim_data\", \"floops\", \"vtk\", or \"tecplot\".\n";
+        data.SetErrorResult(errorString);
+        return;
+    }
+
+    if (asynchronous)
+    {
+        errorString += "asynchronous: only supported for the \"vtk\" type.\n";
         data.SetErrorResult(errorString);
         return;
     }
@@ -789,6 +861,43 @@ writeDevicesCmd(CommandHandler &data)
     }
 }
 
+void 
+waitForWritesCmd(CommandHandler &data)
+{
+    std::string errorString;
+
+    using namespace dsGetArgs;
+    static dsGetArgs::Option option[] = {
+        {NULL,  NULL, dsGetArgs::optionType::STRING, dsGetArgs::requiredType::OPTIONAL, NULL}
+    };
+
+    dsGetArgs::switchList switches = NULL;
+
+
+    bool error = data.processOptions(option, switches, errorString);
+
+    if (error)
+    {
+        data.SetErrorResult(errorString);
+        return;
+    }
+
+    bool ret = true;
+#ifdef VTKWRITER
+    ret = AsyncWriter::GetInstance().WaitForWrites(errorString);
+#endif
+
+    if (!ret)
+    {
+      data.SetErrorResult(errorString);
+      return;
+    }
+    else
+    {
+      data.SetEmptyResult();
+    }
+}
+
 #ifndef GENIUSREADER
 namespace {
 void NoGeniusSupport(CommandHandler &data)
@@ -1405,6 +1514,7 @@ Commands MeshingCommands[] = {
     {"create_device",  createDeviceCmd},
     {"load_devices",   loadDevicesCmd},
     {"write_devices",  writeDevicesCmd},
+    {"wait_for_writes", waitForWritesCmd},
     {"create_gmsh_mesh", createGmshMeshCmd},
     {"add_gmsh_contact", addGmshContactCmd},
     {"add_gmsh_interface", addGmshInterfaceCmd},
@@ -43,6 +43,7 @@ void createGmshMeshCmd(CommandHandler &);
 void finalizeMeshCmd(CommandHandler &);
 void loadDevicesCmd(CommandHandler &);
 void writeDevicesCmd(CommandHandler &);
+void waitForWritesCmd(CommandHandler &);
 }
 
 #endif
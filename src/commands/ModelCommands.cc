@@ -1099,6 +1099,11 @@ void SetListAsResult(CommandHandler &data, const std::string &type, const std::s
     data.SetErrorResult(os.str());
     return;
   }
+  else if (data.GetBooleanOption("as_array"))
+  {
+    //// copied in one block, instead of creating an object for each value
+    data.SetObjectResult(ObjectHolder(vals));
+  }
   else
   {
     data.SetDoubleListResult(vals);
@@ -1119,6 +1124,7 @@ printNodeValuesCmd(CommandHandler &data)
       {"device",   "", dsGetArgs::optionType::STRING, dsGetArgs::requiredType::REQUIRED, mustBeValidDevice},
       {"region",   "", dsGetArgs::optionType::STRING, dsGetArgs::requiredType::REQUIRED, stringCannotBeEmpty},
       {"name",     "", dsGetArgs::optionType::STRING, dsGetArgs::requiredType::REQUIRED, stringCannotBeEmpty},
+      {"as_array", "false", dsGetArgs::optionType::BOOLEAN, dsGetArgs::requiredType::OPTIONAL},
       {NULL,  NULL, dsGetArgs::optionType::STRING, dsGetArgs::requiredType::OPTIONAL}
   };
 
@@ -1204,6 +1210,7 @@ printEdgeValuesCmd(CommandHandler &data)
     {"device",   "", dsGetArgs::optionType::STRING, dsGetArgs::requiredType::REQUIRED, mustBeValidDevice},
     {"region",   "", dsGetArgs::optionType::STRING, dsGetArgs::requiredType::REQUIRED, stringCannotBeEmpty},
     {"name",     "", dsGetArgs::optionType::STRING, dsGetArgs::requiredType::REQUIRED, stringCannotBeEmpty},
+    {"as_array", "false", dsGetArgs::optionType::BOOLEAN, dsGetArgs::requiredType::OPTIONAL},
     {NULL,  NULL, dsGetArgs::optionType::STRING, dsGetArgs::requiredType::OPTIONAL}
   };
 
@@ -1290,6 +1297,7 @@ printElementEdgeValuesCmd(CommandHandler &data)
     {"device",   "", dsGetArgs::optionType::STRING, dsGetArgs::requiredType::REQUIRED, mustBeValidDevice},
     {"region",   "", dsGetArgs::optionType::STRING, dsGetArgs::requiredType::REQUIRED, stringCannotBeEmpty},
     {"name",     "", dsGetArgs::optionType::STRING, dsGetArgs::requiredType::REQUIRED, stringCannotBeEmpty},
+    {"as_array", "false", dsGetArgs::optionType::BOOLEAN, dsGetArgs::requiredType::OPTIONAL},
     {NULL,  NULL, dsGetArgs::optionType::STRING, dsGetArgs::requiredType::OPTIONAL}
   };
 
@@ -1543,6 +1551,10 @@ getNodeModelListCmd(CommandHandler &data)
       data.SetStringListResult(GetKeys(nml));
     }
   }
+  else if (commandName == "get_recomputed_model_list")
+  {
+    data.SetStringListResult(reg->GetRecomputedModels());
+  }
 }
 
 void 
@@ -2083,6 +2095,7 @@ Commands ModelCommands[] = {
     {"get_interface_model_values", getInterfaceValuesCmd},
     {"get_node_model_list",  getNodeModelListCmd},
     {"get_node_model_values",      printNodeValuesCmd},
+    {"get_recomputed_model_list",  getNodeModelListCmd},
     {"interface_model",      createInterfaceNodeModelCmd},
     {"interface_normal_model", createInterfaceNormalModelCmd},
     {"node_model",           createNodeModelCmd},
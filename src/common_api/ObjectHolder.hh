@@ -45,6 +45,8 @@ class ObjectHolder {
     //// Guaranteed these do not change passed values
     explicit ObjectHolder(ObjectHolderMap_t &);
     explicit ObjectHolder(ObjectHolderList_t &);
+    /// A contiguous array of doubles in Python, and a list in Tcl
+    explicit ObjectHolder(const std::vector<double> &);
 
 
 
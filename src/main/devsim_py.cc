@@ -18,6 +18,7 @@ limitations under the License.
 #include "Python.h"
 #include "GlobalData.hh"
 #include "TimeData.hh"
+#include "MatrixCache.hh"
 #include "NodeKeeper.hh"
 #include "InstanceKeeper.hh"
 #include "DefaultDerivatives.hh"
@@ -25,6 +26,7 @@ limitations under the License.
 #include "FPECheck.hh"
 #include "MathEval.hh"
 #include "MaterialDB.hh"
+#include "PhaseTimer.hh"
 #include "PythonAppInit.hh"
 #ifdef DEVSIM_EXTENDED_PRECISION
 #include "Float128.hh"
@@ -61,9 +63,12 @@ int main(int argc, char * argv[])
 
     MathEval<double>::DestroyInstance();
     TimeData<double>::DestroyInstance();
+    dsMath::MatrixCache<double>::DestroyInstance();
+    PhaseTimer::DestroyInstance();
 #ifdef DEFSIM_EXTENDED_PRECISION
     MathEval<float128>::DestroyInstance();
     TimeData<float128>::DestroyInstance();
+    dsMath::MatrixCache<float128>::DestroyInstance();
 #endif
 #endif
     return ret;
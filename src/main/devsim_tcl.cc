@@ -17,6 +17,7 @@ limitations under the License.
 
 #include "GlobalData.hh"
 #include "TimeData.hh"
+#include "MatrixCache.hh"
 #include "NodeKeeper.hh"
 #include "InstanceKeeper.hh"
 #include "DefaultDerivatives.hh"
@@ -24,6 +25,7 @@ limitations under the License.
 #include "FPECheck.hh"
 #include "MathEval.hh"
 #include "MaterialDB.hh"
+#include "PhaseTimer.hh"
 #include <tcl.h>
 #include <cstdio>
 
@@ -54,6 +56,8 @@ int main(int argc, char * argv[])
     InstanceKeeper::delete_instance();
     MathEval<double>::DestroyInstance();
     TimeData<double>::DestroyInstance();
+    dsMath::MatrixCache<double>::DestroyInstance();
+    PhaseTimer::DestroyInstance();
 }
 
 
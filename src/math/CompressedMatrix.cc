@@ -19,6 +19,7 @@ limitations under the License.
 #include "MatrixEntries.hh"
 #include "OutputStream.hh"
 #include "dsAssert.hh"
+#include "PhaseTimer.hh"
 
 #include <sstream>
 #include <utility>
@@ -26,7 +27,7 @@ limitations under the License.
 
 namespace dsMath {
 template <typename DoubleType>
-CompressedMatrix<DoubleType>::CompressedMatrix(size_t sz, MatrixType mt, CompressionType ct) : Matrix<DoubleType>(sz), matType_(mt), compressionType_(ct), compressed(false)
+CompressedMatrix<DoubleType>::CompressedMatrix(size_t sz, MatrixType mt, CompressionType ct) : Matrix<DoubleType>(sz), matType_(mt), compressionType_(ct), compressed(false), symbolicstatus_(SymbolicStatus_t::NEW_SYMBOLIC)
 {
   Symbolic_.resize(this->size());
   OutOfBandEntries_Real.resize(this->size());
@@ -211,11 +212,7 @@ void CompressedMatrix<DoubleType>::AddEntry(int r, int c, DoubleType v)
   dsAssert(static_cast<size_t>(c) < this->size(), "UNEXPECTED");
 #endif
 
-  if (v == 0.0)
-  {
-    return;
-  }
-  else if (compressionType_ == CompressionType::CRM)
+  if (compressionType_ == CompressionType::CRM)
   {
     int tmp = r;
     r = c;
@@ -224,13 +221,21 @@ void CompressedMatrix<DoubleType>::AddEntry(int r, int c, DoubleType v)
 
   if (compressed)
   {
-    /// need to adapt for handling of out of band entries
-    /// and recompressing matrix
-    const RowInd &ri = Symbolic_[c];
-    RowInd::const_iterator rit = ri.find(r);
-    if (rit != ri.end())
+    int slot = CacheSlot(RealSlots_, r, c);
+    if (v == 0.0)
+    {
+      return;
+    }
+    else if (slot < 0)
+    {
+      /// the entry may have been zero when the cache was resolved
+      slot = FindSlot(r, c);
+      UpdateSlot(RealSlots_, slot);
+    }
+
+    if (slot >= 0)
     {
-      Ax_[rit->second] += v;
+      Ax_[slot] += v;
     }
     else
     {
@@ -241,6 +246,11 @@ void CompressedMatrix<DoubleType>::AddEntry(int r, int c, DoubleType v)
   }
   else
   {
+    CacheSlot(RealSlots_, r, c);
+    if (v == 0.0)
+    {
+      return;
+    }
     AddSymbolic(r, c);
     /// the double entry is initialized to zero (property of map)
     OutOfBandEntries_Real[r][c] += v;
@@ -257,11 +267,7 @@ void CompressedMatrix<DoubleType>::AddImagEntry(int r, int c, DoubleType v)
   dsAssert(static_cast<size_t>(c) < this->size(), "UNEXPECTED");
 #endif
 
-  if (v == 0.0)
-  {
-    return;
-  }
-  else if (compressionType_ == CompressionType::CRM)
+  if (compressionType_ == CompressionType::CRM)
   {
     int tmp = r;
     r = c;
@@ -270,11 +276,20 @@ void CompressedMatrix<DoubleType>::AddImagEntry(int r, int c, DoubleType v)
 
   if (compressed)
   {
-    const RowInd &ri = Symbolic_[c];
-    RowInd::const_iterator rit = ri.find(r);
-    if (rit != ri.end())
+    int slot = CacheSlot(ImagSlots_, r, c);
+    if (v == 0.0)
+    {
+      return;
+    }
+    else if (slot < 0)
+    {
+      slot = FindSlot(r, c);
+      UpdateSlot(ImagSlots_, slot);
+    }
+
+    if (slot >= 0)
     {
-      Az_[rit->second] += v;
+      Az_[slot] += v;
     }
     else
     {
@@ -285,6 +300,11 @@ void CompressedMatrix<DoubleType>::AddImagEntry(int r, int c, DoubleType v)
   }
   else
   {
+    CacheSlot(ImagSlots_, r, c);
+    if (v == 0.0)
+    {
+      return;
+    }
     AddSymbolic(r, c);
     /// the double entry is initialized to zero (property of map)
     OutOfBandEntries_Imag[r][c] += v;
@@ -333,22 +353,28 @@ void CompressedMatrix<DoubleType>::DecompressMatrix()
 #endif
 
   /// size is 1 past in compressed column
+  /// Symbolic_ keeps the pattern, so only the values are moved out of band.
+  /// This does not go through AddEntry, so the slot caches are left alone.
   for (size_t i = 0; i < sz; ++i)
   {
     const size_t beg = Ap_[i];
     const size_t end = Ap_[i+1];
     for (size_t j = beg; j < end; ++ j)
     {
-      AddEntry(Ai_[j], i, Ax_[j]);
+      const DoubleType x = Ax_[j];
+      if (x != 0.0)
+      {
+        OutOfBandEntries_Real[Ai_[j]][i] += x;
+      }
     }
     if (GetMatrixType() == MatrixType::COMPLEX)
     {
       for (size_t j = beg; j < end; ++ j)
       {
-        const double z = Az_[j];
+        const DoubleType z = Az_[j];
         if (z != 0.0)
         {
-          AddEntry(Ai_[j], i, z);
+          OutOfBandEntries_Imag[Ai_[j]][i] += z;
         }
       }
     }
@@ -362,22 +388,26 @@ void CompressedMatrix<DoubleType>::DecompressMatrix()
 template <typename DoubleType>
 void CompressedMatrix<DoubleType>::Finalize()
 {
+  PhaseTimerScope timer("matrix_finalize");
+
   if (!compressed)
   {
     symbolicstatus_ = SymbolicStatus_t::NEW_SYMBOLIC;
 
     CreateMatrix();
+    /// out of band entries are already stored by (row, col) in compressed order
     for (size_t i = 0; i < OutOfBandEntries_Real.size(); ++i)
     {
       typename ColValueEntry::iterator it = OutOfBandEntries_Real[i].begin();
       const typename ColValueEntry::iterator itend = OutOfBandEntries_Real[i].end();
       for ( ; it != itend; ++it)
       {
-        AddEntry(i, it->first, it->second);
+        const int slot = FindSlot(i, it->first);
+        dsAssert(slot >= 0, "UNEXPECTED");
+        Ax_[slot] += it->second;
       }
+      OutOfBandEntries_Real[i].clear();
     }
-    OutOfBandEntries_Real.clear();
-    OutOfBandEntries_Real.resize(this->size());
 
     if (GetMatrixType() == MatrixType::COMPLEX)
     {
@@ -387,16 +417,22 @@ void CompressedMatrix<DoubleType>::Finalize()
         const typename ColValueEntry::iterator itend = OutOfBandEntries_Imag[i].end();
         for ( ; it != itend; ++it)
         {
-          AddImagEntry(i, it->first, it->second);
+          const int slot = FindSlot(i, it->first);
+          dsAssert(slot >= 0, "UNEXPECTED");
+          Az_[slot] += it->second;
         }
+        OutOfBandEntries_Imag[i].clear();
       }
-      OutOfBandEntries_Imag.clear();
-      OutOfBandEntries_Imag.resize(this->size());
     }
+
+    ResolveSlots(RealSlots_);
+    ResolveSlots(ImagSlots_);
   }
   else
   {
     symbolicstatus_ = SymbolicStatus_t::SAME_SYMBOLIC;
+    ResetSlots(RealSlots_);
+    ResetSlots(ImagSlots_);
   }
 }
 
@@ -404,22 +440,80 @@ template <typename DoubleType>
 void CompressedMatrix<DoubleType>::ClearMatrix()
 {
 //  compressed = false;
-  size_t sz = Ax_.size();
-  Ax_.clear();
-  Ax_.resize(sz);
+  /// keep the storage, so the next assembly does not allocate
+  std::fill(Ax_.begin(), Ax_.end(), 0.0);
   if (GetMatrixType() == MatrixType::COMPLEX)
   {
-    Az_.clear();
-    Az_.resize(sz);
+    std::fill(Az_.begin(), Az_.end(), 0.0);
   }
 
-  OutOfBandEntries_Real.clear();
-  OutOfBandEntries_Real.resize(sz);
-  if (GetMatrixType() == MatrixType::COMPLEX)
+  for (size_t i = 0; i < OutOfBandEntries_Real.size(); ++i)
   {
-    OutOfBandEntries_Imag.clear();
-    OutOfBandEntries_Imag.resize(sz);
+    OutOfBandEntries_Real[i].clear();
   }
+  for (size_t i = 0; i < OutOfBandEntries_Imag.size(); ++i)
+  {
+    OutOfBandEntries_Imag[i].clear();
+  }
+
+  ResetSlots(RealSlots_);
+  ResetSlots(ImagSlots_);
+}
+
+/// Only valid when compressed, returns -1 for an entry outside the pattern
+template <typename DoubleType>
+int CompressedMatrix<DoubleType>::FindSlot(int r, int c) const
+{
+  const RowInd &ri = Symbolic_[c];
+  RowInd::const_iterator rit = ri.find(r);
+  return (rit != ri.end()) ? rit->second : -1;
+}
+
+/// Advances the cache by one entry and returns its slot.  A slot of -1 means
+/// the matrix is not compressed yet, or that the entry is not in the pattern.
+template <typename DoubleType>
+int CompressedMatrix<DoubleType>::CacheSlot(SlotCache &sc, int r, int c)
+{
+  const size_t pos = sc.pos++;
+  if ((pos < sc.rows.size()) && (sc.rows[pos] == r) && (sc.cols[pos] == c))
+  {
+    return sc.slots[pos];
+  }
+
+  /// assembly order changed, so the rest of the cache is of no use
+  sc.rows.resize(pos);
+  sc.cols.resize(pos);
+  sc.slots.resize(pos);
+
+  sc.rows.push_back(r);
+  sc.cols.push_back(c);
+  sc.slots.push_back(compressed ? FindSlot(r, c) : -1);
+
+  return sc.slots.back();
+}
+
+/// Update the slot of the entry most recently passed to CacheSlot
+template <typename DoubleType>
+void CompressedMatrix<DoubleType>::UpdateSlot(SlotCache &sc, int slot)
+{
+  sc.slots[sc.pos - 1] = slot;
+}
+
+/// Called after CreateMatrix, since every slot may have moved
+template <typename DoubleType>
+void CompressedMatrix<DoubleType>::ResolveSlots(SlotCache &sc)
+{
+  for (size_t i = 0; i < sc.rows.size(); ++i)
+  {
+    sc.slots[i] = FindSlot(sc.rows[i], sc.cols[i]);
+  }
+  sc.pos = 0;
+}
+
+template <typename DoubleType>
+void CompressedMatrix<DoubleType>::ResetSlots(SlotCache &sc)
+{
+  sc.pos = 0;
 }
 
 namespace {
@@ -91,6 +91,24 @@ class CompressedMatrix : public Matrix<DoubleType> {
         void DecompressMatrix();
 
     private:
+        //// The (row, col) of every entry in the order it was added, along with
+        //// its position in Ax_/Az_.  Newton assembles the same entries in the same
+        //// order every iteration, so the slot is found with two integer compares
+        //// instead of a hash lookup.
+        struct SlotCache {
+          SlotCache() : pos(0) {}
+          IntVec_t rows;
+          IntVec_t cols;
+          IntVec_t slots;
+          size_t   pos;
+        };
+
+        int  FindSlot(int, int) const;
+        int  CacheSlot(SlotCache &, int, int);
+        void UpdateSlot(SlotCache &, int);
+        void ResolveSlots(SlotCache &);
+        void ResetSlots(SlotCache &);
+
         CompressedMatrix();
         // Make sure that we copy all aspects(including pointers) later on
         CompressedMatrix(const CompressedMatrix<DoubleType> &);
@@ -110,6 +128,8 @@ class CompressedMatrix : public Matrix<DoubleType> {
         DoubleVec_t<DoubleType> Az_;
         bool compressed;
         SymbolicStatus_t symbolicstatus_;
+        SlotCache RealSlots_;
+        SlotCache ImagSlots_;
 };
 
 }
@@ -17,6 +17,11 @@ limitations under the License.
 
 #include "DirectLinearSolver.hh"
 #include "Preconditioner.hh"
+#include "SuperLUPreconditioner.hh"
+#ifdef USE_MKL_PARDISO
+#include "MKLPardisoPreconditioner.hh"
+#endif
+#include "dsAssert.hh"
 
 #include "OutputStream.hh"
 
@@ -25,8 +30,50 @@ limitations under the License.
 //#include <iostream>
 namespace dsMath {
 template <typename DoubleType>
-DirectLinearSolver<DoubleType>::DirectLinearSolver()
-{}
+DirectLinearSolver<DoubleType>::DirectLinearSolver(DirectSolver_t dst) : direct_solver_(dst)
+{
+  dsAssert(IsAvailable(dst), "UNEXPECTED");
+}
+
+template <typename DoubleType>
+bool DirectLinearSolver<DoubleType>::IsAvailable(DirectSolver_t dst)
+{
+  bool ret = false;
+  if (dst == DirectSolver_t::SUPERLU)
+  {
+    ret = true;
+  }
+  else if (dst == DirectSolver_t::MKL_PARDISO)
+  {
+#ifdef USE_MKL_PARDISO
+    ret = true;
+#endif
+  }
+  return ret;
+}
+
+template <typename DoubleType>
+Preconditioner<DoubleType> *DirectLinearSolver<DoubleType>::CreatePreconditioner(size_t numeqns)
+{
+  return CreateACPreconditioner(PEnum::TransposeType_t::NOTRANS, numeqns);
+}
+
+template <typename DoubleType>
+Preconditioner<DoubleType> *DirectLinearSolver<DoubleType>::CreateACPreconditioner(PEnum::TransposeType_t trans_type, size_t numeqns)
+{
+  Preconditioner<DoubleType> *preconditioner = NULL;
+#ifdef USE_MKL_PARDISO
+  if (direct_solver_ == DirectSolver_t::MKL_PARDISO)
+  {
+    preconditioner = new MKLPardisoPreconditioner<DoubleType>(numeqns, trans_type);
+  }
+  else
+#endif
+  {
+    preconditioner = new SuperLUPreconditioner<DoubleType>(numeqns, trans_type, PEnum::LUType_t::FULL);
+  }
+  return preconditioner;
+}
 
 namespace {
 void WriteOutProblem(bool factored, bool solved)
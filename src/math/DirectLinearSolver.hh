@@ -20,14 +20,29 @@ limitations under the License.
 #include "LinearSolver.hh"
 
 namespace dsMath {
+/// Sparse direct factorization used by the preconditioner
+/// MKL_PARDISO is threaded and is only available when built with MKL_PARDISO
+enum class DirectSolver_t {SUPERLU, MKL_PARDISO};
+
 // Special case
 // x = inv(A) b
 template <typename DoubleType>
 class DirectLinearSolver : public LinearSolver<DoubleType>
 {
    public:
-        DirectLinearSolver();
+        explicit DirectLinearSolver(DirectSolver_t = DirectSolver_t::SUPERLU);
         ~DirectLinearSolver() {};
+
+        Preconditioner<DoubleType> *CreatePreconditioner(size_t /*numeqns*/);
+        Preconditioner<DoubleType> *CreateACPreconditioner(PEnum::TransposeType_t, size_t /*numeqns*/);
+
+        DirectSolver_t GetDirectSolver() const
+        {
+          return direct_solver_;
+        }
+
+        /// whether the backend was compiled in
+        static bool IsAvailable(DirectSolver_t);
    protected:
    private:
         bool SolveImpl(Matrix<DoubleType> &, Preconditioner<DoubleType> &, std::vector<DoubleType> &, std::vector<DoubleType> & );
@@ -36,6 +51,8 @@ class DirectLinearSolver : public LinearSolver<DoubleType>
 
         DirectLinearSolver(const DirectLinearSolver &);
         DirectLinearSolver &operator=(const DirectLinearSolver &);
+
+        DirectSolver_t direct_solver_;
 };
 }
 
@@ -0,0 +1,487 @@
+/***
+DEVSIM
+Copyright 2013 Devsim LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+***/
+
+#include "ILUPreconditioner.hh"
+#include "CompressedMatrix.hh"
+#include "ParallelOpEqual.hh"
+#include "GlobalData.hh"
+#include "Device.hh"
+#include "Region.hh"
+#include "OutputStream.hh"
+#include "dsAssert.hh"
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <sstream>
+
+#include <cmath>
+using std::abs;
+
+namespace dsMath {
+namespace {
+//// Factors the rows of one level, which only depend on rows of earlier levels
+template <typename DoubleType>
+class ILUFactorRows : public OpEqualRangeTask {
+  public:
+    ILUFactorRows(const int *rows, const IntVec_t &rowptr, const IntVec_t &colind, const IntVec_t &diag, DoubleVec_t<DoubleType> &values) : rows_(rows), rowptr_(rowptr), colind_(colind), diag_(diag), values_(values)
+    {
+    }
+
+    void operator()(const size_t b, const size_t e) const
+    {
+      for (size_t r = b; r < e; ++r)
+      {
+        const int i    = rows_[r];
+        const int rbeg = rowptr_[i];
+        const int rend = rowptr_[i + 1];
+        for (int p = rbeg; p < diag_[i]; ++p)
+        {
+          const int k = colind_[p];
+          const DoubleType lik = (values_[p] /= values_[diag_[k]]);
+
+          //// both rows are sorted, so the search continues from the last match
+          int s = p + 1;
+          for (int q = diag_[k] + 1; q < rowptr_[k + 1]; ++q)
+          {
+            const int j = colind_[q];
+            while ((s < rend) && (colind_[s] < j))
+            {
+              ++s;
+            }
+            if (s == rend)
+            {
+              break;
+            }
+            else if (colind_[s] == j)
+            {
+              values_[s] -= lik * values_[q];
+            }
+          }
+        }
+
+        DoubleType &pivot = values_[diag_[i]];
+        if (pivot == 0.0)
+        {
+          //// replace a zero pivot by a small value relative to the row
+          DoubleType rmax = 0.0;
+          for (int p = rbeg; p < rend; ++p)
+          {
+            rmax = std::max(rmax, static_cast<DoubleType>(abs(values_[p])));
+          }
+          pivot = (rmax != 0.0) ? std::numeric_limits<DoubleType>::epsilon() * rmax : static_cast<DoubleType>(1.0);
+        }
+      }
+    }
+
+  private:
+    const int                *rows_;
+    const IntVec_t           &rowptr_;
+    const IntVec_t           &colind_;
+    const IntVec_t           &diag_;
+    DoubleVec_t<DoubleType>  &values_;
+};
+
+//// y = inv(L) y, for the rows of one level
+template <typename DoubleType>
+class ILULowerSolveRows : public OpEqualRangeTask {
+  public:
+    ILULowerSolveRows(const int *rows, const IntVec_t &rowptr, const IntVec_t &colind, const IntVec_t &diag, const DoubleVec_t<DoubleType> &values, DoubleVec_t<DoubleType> &y) : rows_(rows), rowptr_(rowptr), colind_(colind), diag_(diag), values_(values), y_(y)
+    {
+    }
+
+    void operator()(const size_t b, const size_t e) const
+    {
+      for (size_t r = b; r < e; ++r)
+      {
+        const int i = rows_[r];
+        DoubleType val = y_[i];
+        for (int p = rowptr_[i]; p < diag_[i]; ++p)
+        {
+          val -= values_[p] * y_[colind_[p]];
+        }
+        y_[i] = val;
+      }
+    }
+
+  private:
+    const int                     *rows_;
+    const IntVec_t                &rowptr_;
+    const IntVec_t                &colind_;
+    const IntVec_t                &diag_;
+    const DoubleVec_t<DoubleType> &values_;
+    DoubleVec_t<DoubleType>       &y_;
+};
+
+//// x = inv(U) x, for the rows of one level
+template <typename DoubleType>
+class ILUUpperSolveRows : public OpEqualRangeTask {
+  public:
+    ILUUpperSolveRows(const int *rows, const IntVec_t &rowptr, const IntVec_t &colind, const IntVec_t &diag, const DoubleVec_t<DoubleType> &values, DoubleVec_t<DoubleType> &x) : rows_(rows), rowptr_(rowptr), colind_(colind), diag_(diag), values_(values), x_(x)
+    {
+    }
+
+    void operator()(const size_t b, const size_t e) const
+    {
+      for (size_t r = b; r < e; ++r)
+      {
+        const int i = rows_[r];
+        DoubleType val = x_[i];
+        for (int p = diag_[i] + 1; p < rowptr_[i + 1]; ++p)
+        {
+          val -= values_[p] * x_[colind_[p]];
+        }
+        x_[i] = val / values_[diag_[i]];
+      }
+    }
+
+  private:
+    const int                     *rows_;
+    const IntVec_t                &rowptr_;
+    const IntVec_t                &colind_;
+    const IntVec_t                &diag_;
+    const DoubleVec_t<DoubleType> &values_;
+    DoubleVec_t<DoubleType>       &x_;
+};
+
+void RunLevel(const OpEqualRangeTask &task, size_t length)
+{
+  ForwardOpEqual forward(task);
+  OpEqualRun(forward, length);
+}
+
+//// Groups rows by level, keeping increasing row order within a level
+void BucketLevels(const IntVec_t &level, size_t num_levels, IntVec_t &level_ptr, IntVec_t &level_rows)
+{
+  level_ptr.clear();
+  level_ptr.resize(num_levels + 1);
+  for (size_t i = 0; i < level.size(); ++i)
+  {
+    ++level_ptr[level[i] + 1];
+  }
+  for (size_t l = 0; l < num_levels; ++l)
+  {
+    level_ptr[l + 1] += level_ptr[l];
+  }
+
+  IntVec_t next(level_ptr.begin(), level_ptr.end() - 1);
+  level_rows.resize(level.size());
+  for (size_t i = 0; i < level.size(); ++i)
+  {
+    level_rows[next[level[i]]++] = i;
+  }
+}
+}
+
+template <typename DoubleType>
+ILUPreconditioner<DoubleType>::ILUPreconditioner(size_t numeqns, PEnum::TransposeType_t transpose, size_t fill_level) : Preconditioner<DoubleType>(numeqns, transpose), fill_level_(fill_level), symbolic_(false)
+{
+}
+
+template <typename DoubleType>
+ILUPreconditioner<DoubleType>::~ILUPreconditioner()
+{
+}
+
+//// Equations of a region are numbered by equation, then node.  Here they are
+//// numbered by node, then equation.  Everything else, e.g. circuit nodes,
+//// is placed at the end in the original order.
+template <typename DoubleType>
+void ILUPreconditioner<DoubleType>::CreateNodeOrdering()
+{
+  const size_t numeqns = Preconditioner<DoubleType>::size();
+
+  iperm_.clear();
+  iperm_.resize(numeqns, -1);
+  perm_.clear();
+  perm_.reserve(numeqns);
+
+  GlobalData &gdata = GlobalData::GetInstance();
+  const GlobalData::DeviceList_t &dlist = gdata.GetDeviceList();
+  GlobalData::DeviceList_t::const_iterator dit  = dlist.begin();
+  GlobalData::DeviceList_t::const_iterator dend = dlist.end();
+  for ( ; dit != dend; ++dit)
+  {
+    const Device &device = *(dit->second);
+    const Device::RegionList_t &rlist = device.GetRegionList();
+
+    Device::RegionList_t::const_iterator rit  = rlist.begin();
+    Device::RegionList_t::const_iterator rend = rlist.end();
+    for ( ; rit != rend; ++rit)
+    {
+      const Region &region = *(rit->second);
+      if (region.GetBaseEquationNumber() == size_t(-1))
+      {
+        continue;
+      }
+
+      const size_t neqns  = region.GetNumberEquations();
+      const size_t nnodes = region.GetNumberNodes();
+      for (size_t n = 0; n < nnodes; ++n)
+      {
+        for (size_t i = 0; i < neqns; ++i)
+        {
+          const size_t row = region.GetNodeEquationNumber(i, n);
+          if ((row < numeqns) && (iperm_[row] == -1))
+          {
+            iperm_[row] = perm_.size();
+            perm_.push_back(row);
+          }
+        }
+      }
+    }
+  }
+
+  for (size_t row = 0; row < numeqns; ++row)
+  {
+    if (iperm_[row] == -1)
+    {
+      iperm_[row] = perm_.size();
+      perm_.push_back(row);
+    }
+  }
+}
+
+template <typename DoubleType>
+void ILUPreconditioner<DoubleType>::CreateSymbolic(const CompressedMatrix<DoubleType> &cm)
+{
+  const size_t numeqns = Preconditioner<DoubleType>::size();
+  const IntVec_t &Cols = cm.GetCols();
+  const IntVec_t &Rows = cm.GetRows();
+
+  //// pattern of the reordered matrix by row, the diagonal is always present
+  std::vector<IntVec_t> pattern(numeqns);
+  for (size_t i = 0; i < numeqns; ++i)
+  {
+    pattern[i].push_back(i);
+  }
+  for (size_t c = 0; c < numeqns; ++c)
+  {
+    const int col = iperm_[c];
+    for (int k = Cols[c]; k < Cols[c + 1]; ++k)
+    {
+      pattern[iperm_[Rows[k]]].push_back(col);
+    }
+  }
+
+  rowptr_.clear();
+  rowptr_.reserve(numeqns + 1);
+  rowptr_.push_back(0);
+  colind_.clear();
+  diag_.clear();
+  diag_.resize(numeqns);
+
+  //// level of fill of each entry, needed from the upper part of earlier rows
+  std::vector<size_t> levels;
+  for (size_t i = 0; i < numeqns; ++i)
+  {
+    IntVec_t &prow = pattern[i];
+    std::sort(prow.begin(), prow.end());
+    prow.erase(std::unique(prow.begin(), prow.end()), prow.end());
+
+    if (fill_level_ == 0)
+    {
+      colind_.insert(colind_.end(), prow.begin(), prow.end());
+    }
+    else
+    {
+      typedef std::map<int, size_t> RowLevels_t;
+      RowLevels_t row;
+      for (size_t j = 0; j < prow.size(); ++j)
+      {
+        row[prow[j]] = 0;
+      }
+
+      //// entries inserted to the right of k are visited by this loop
+      for (RowLevels_t::iterator it = row.begin(); (it != row.end()) && (it->first < static_cast<int>(i)); ++it)
+      {
+        const int    k   = it->first;
+        const size_t lik = it->second;
+        for (int q = diag_[k] + 1; q < rowptr_[k + 1]; ++q)
+        {
+          const size_t lev = lik + levels[q] + 1;
+          if (lev <= fill_level_)
+          {
+            RowLevels_t::iterator jt = row.find(colind_[q]);
+            if (jt == row.end())
+            {
+              row.insert(std::make_pair(colind_[q], lev));
+            }
+            else if (lev < jt->second)
+            {
+              jt->second = lev;
+            }
+          }
+        }
+      }
+
+      for (RowLevels_t::const_iterator it = row.begin(); it != row.end(); ++it)
+      {
+        colind_.push_back(it->first);
+        levels.push_back(it->second);
+      }
+    }
+    IntVec_t().swap(prow);
+
+    diag_[i] = std::lower_bound(colind_.begin() + rowptr_[i], colind_.end(), static_cast<int>(i)) - colind_.begin();
+    rowptr_.push_back(colind_.size());
+  }
+
+  matrix_to_lu_.resize(Rows.size());
+  for (size_t c = 0; c < numeqns; ++c)
+  {
+    const int col = iperm_[c];
+    for (int k = Cols[c]; k < Cols[c + 1]; ++k)
+    {
+      const int row = iperm_[Rows[k]];
+      matrix_to_lu_[k] = std::lower_bound(colind_.begin() + rowptr_[row], colind_.begin() + rowptr_[row + 1], col) - colind_.begin();
+    }
+  }
+
+  values_.clear();
+  values_.resize(colind_.size());
+
+  CreateLevels();
+
+  std::ostringstream os;
+  os << "ILU(" << fill_level_ << ") matrix entries " << Rows.size()
+     << " factor entries " << colind_.size()
+     << " lower levels " << (lower_level_ptr_.size() - 1)
+     << " upper levels " << (upper_level_ptr_.size() - 1)
+     << "\n";
+  OutputStream::WriteOut(OutputStream::OutputType::INFO, os.str());
+}
+
+template <typename DoubleType>
+void ILUPreconditioner<DoubleType>::CreateLevels()
+{
+  const size_t numeqns = Preconditioner<DoubleType>::size();
+
+  IntVec_t level(numeqns);
+  size_t num_levels = 0;
+  for (size_t i = 0; i < numeqns; ++i)
+  {
+    int l = 0;
+    for (int p = rowptr_[i]; p < diag_[i]; ++p)
+    {
+      l = std::max(l, level[colind_[p]] + 1);
+    }
+    level[i] = l;
+    num_levels = std::max(num_levels, static_cast<size_t>(l + 1));
+  }
+  BucketLevels(level, num_levels, lower_level_ptr_, lower_level_rows_);
+
+  num_levels = 0;
+  for (size_t i = numeqns; i > 0; --i)
+  {
+    const size_t r = i - 1;
+    int l = 0;
+    for (int p = diag_[r] + 1; p < rowptr_[r + 1]; ++p)
+    {
+      l = std::max(l, level[colind_[p]] + 1);
+    }
+    level[r] = l;
+    num_levels = std::max(num_levels, static_cast<size_t>(l + 1));
+  }
+  BucketLevels(level, num_levels, upper_level_ptr_, upper_level_rows_);
+}
+
+template <typename DoubleType>
+bool ILUPreconditioner<DoubleType>::DerivedLUFactor(Matrix<DoubleType> *m)
+{
+  CompressedMatrix<DoubleType> *cm = dynamic_cast<CompressedMatrix<DoubleType> *>(m);
+  dsAssert(cm != NULL, "UNEXPECTED");
+  dsAssert(cm->GetCompressionType() == CompressionType::CCM, "UNEXPECTED");
+  dsAssert(!Preconditioner<DoubleType>::GetTransposeSolve(), "UNEXPECTED");
+
+  if (cm->GetMatrixType() != MatrixType::REAL)
+  {
+    std::ostringstream os;
+    os << "ILU preconditioner is only available for real matrices\n";
+    OutputStream::WriteOut(OutputStream::OutputType::ERROR, os.str());
+    return false;
+  }
+
+  if ((!symbolic_) || (cm->GetSymbolicStatus() == SymbolicStatus_t::NEW_SYMBOLIC))
+  {
+    CreateNodeOrdering();
+    CreateSymbolic(*cm);
+    symbolic_ = true;
+  }
+
+  const DoubleVec_t<DoubleType> &Vals = cm->GetReal();
+  values_.assign(values_.size(), 0.0);
+  for (size_t k = 0; k < Vals.size(); ++k)
+  {
+    values_[matrix_to_lu_[k]] += Vals[k];
+  }
+
+  for (size_t l = 0; (l + 1) < lower_level_ptr_.size(); ++l)
+  {
+    const int *rows = &lower_level_rows_[lower_level_ptr_[l]];
+    ILUFactorRows<DoubleType> task(rows, rowptr_, colind_, diag_, values_);
+    RunLevel(task, lower_level_ptr_[l + 1] - lower_level_ptr_[l]);
+  }
+
+  return true;
+}
+
+template <typename DoubleType>
+void ILUPreconditioner<DoubleType>::DerivedLUSolve(DoubleVec_t<DoubleType> &x, const DoubleVec_t<DoubleType> &b) const
+{
+  const size_t numeqns = Preconditioner<DoubleType>::size();
+
+  DoubleVec_t<DoubleType> y(numeqns);
+  for (size_t i = 0; i < numeqns; ++i)
+  {
+    y[iperm_[i]] = b[i];
+  }
+
+  for (size_t l = 0; (l + 1) < lower_level_ptr_.size(); ++l)
+  {
+    const int *rows = &lower_level_rows_[lower_level_ptr_[l]];
+    ILULowerSolveRows<DoubleType> task(rows, rowptr_, colind_, diag_, values_, y);
+    RunLevel(task, lower_level_ptr_[l + 1] - lower_level_ptr_[l]);
+  }
+
+  for (size_t l = 0; (l + 1) < upper_level_ptr_.size(); ++l)
+  {
+    const int *rows = &upper_level_rows_[upper_level_ptr_[l]];
+    ILUUpperSolveRows<DoubleType> task(rows, rowptr_, colind_, diag_, values_, y);
+    RunLevel(task, upper_level_ptr_[l + 1] - upper_level_ptr_[l]);
+  }
+
+  x.resize(numeqns);
+  for (size_t i = 0; i < numeqns; ++i)
+  {
+    x[perm_[i]] = y[i];
+  }
+}
+
+template <typename DoubleType>
+void ILUPreconditioner<DoubleType>::DerivedLUSolve(ComplexDoubleVec_t<DoubleType> &/*x*/, const ComplexDoubleVec_t<DoubleType> &/*b*/) const
+{
+  dsAssert(0, "UNEXPECTED");
+}
+}
+
+template class dsMath::ILUPreconditioner<double>;
+#ifdef DEVSIM_EXTENDED_PRECISION
+#include "Float128.hh"
+template class dsMath::ILUPreconditioner<float128>;
+#endif
+
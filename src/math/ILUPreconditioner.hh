@@ -0,0 +1,81 @@
+/***
+DEVSIM
+Copyright 2013 Devsim LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+***/
+
+#ifndef ILU_PRECONDITIONER_HH
+#define ILU_PRECONDITIONER_HH
+#include "Preconditioner.hh"
+#include <vector>
+
+namespace dsMath {
+template <typename DoubleType>
+class CompressedMatrix;
+
+//// Incomplete LU factorization with k levels of fill, ILU(k).
+////
+//// The rows are reordered so that all of the equations of a node are next
+//// to each other, instead of being grouped by equation as in the Region
+//// numbering.  The strong coupling between e.g. Potential, Electrons and
+//// Holes on the same node is then kept inside the factorization.
+////
+//// Rows whose dependencies are already factored form a level, and the rows
+//// of a level are factored and solved in parallel using the thread pool.
+template <typename DoubleType>
+class ILUPreconditioner : public Preconditioner<DoubleType> {
+  public:
+    ILUPreconditioner(size_t /*numeqns*/, PEnum::TransposeType_t /*tranpose*/, size_t /*fill_level*/);
+
+    ~ILUPreconditioner();
+
+  protected:
+    void DerivedLUSolve(DoubleVec_t<DoubleType> &x, const DoubleVec_t<DoubleType> &b) const;
+    void DerivedLUSolve(ComplexDoubleVec_t<DoubleType> &x, const ComplexDoubleVec_t<DoubleType> &b) const;
+    bool DerivedLUFactor(Matrix<DoubleType> *);
+
+  private:
+    ILUPreconditioner();
+    ILUPreconditioner(const ILUPreconditioner &);
+    ILUPreconditioner &operator=(const ILUPreconditioner &);
+
+    void CreateNodeOrdering();
+    void CreateSymbolic(const CompressedMatrix<DoubleType> &);
+    void CreateLevels();
+
+    size_t fill_level_;
+    bool   symbolic_;
+
+    /// new row from old row, and old row from new row
+    IntVec_t iperm_;
+    IntVec_t perm_;
+
+    /// compressed rows of the factors, with sorted columns
+    IntVec_t rowptr_;
+    IntVec_t colind_;
+    IntVec_t diag_;
+    DoubleVec_t<DoubleType> values_;
+
+    /// position in values_ for each entry of the compressed column matrix
+    IntVec_t matrix_to_lu_;
+
+    /// rows of each level for the lower and upper triangular factors
+    IntVec_t lower_level_ptr_;
+    IntVec_t lower_level_rows_;
+    IntVec_t upper_level_ptr_;
+    IntVec_t upper_level_rows_;
+};
+}
+#endif
+
@@ -17,6 +17,10 @@ limitations under the License.
 
 #include "IterativeLinearSolver.hh"
 #include "Preconditioner.hh"
+#include "BlockPreconditioner.hh"
+#include "SuperLUPreconditioner.hh"
+#include "ILUPreconditioner.hh"
+#include "Matrix.hh"
 
 #include "OutputStream.hh"
 #include "gmres.hh"
@@ -31,9 +35,19 @@ limitations under the License.
 //#include <iostream>
 namespace dsMath {
 template <typename DoubleType>
-IterativeLinearSolver<DoubleType>::IterativeLinearSolver() : restart_(50), linear_iterations_(100), relative_tolerance_(1e-20)
+IterativeLinearSolver<DoubleType>::IterativeLinearSolver(IterativePreconditioner_t ptype, size_t fill_level) : restart_(50), linear_iterations_(100), refinement_iterations_(10), relative_tolerance_(1e-20), preconditioner_type_(ptype), fill_level_(fill_level)
 {}
 
+template <typename DoubleType>
+Preconditioner<DoubleType> *IterativeLinearSolver<DoubleType>::CreatePreconditioner(size_t numeqns)
+{
+  if (preconditioner_type_ == IterativePreconditioner_t::ILU)
+  {
+    return new ILUPreconditioner<DoubleType>(numeqns, PEnum::TransposeType_t::NOTRANS, fill_level_);
+  }
+  return new BlockPreconditioner<DoubleType>(numeqns, PEnum::TransposeType_t::NOTRANS);
+}
+
 template <>
 bool IterativeLinearSolver<double>::SolveImpl(Matrix<double> &mat, Preconditioner<double> &pre, std::vector<double> &sol, std::vector<double> &rhs)
 {
@@ -48,7 +62,7 @@ bool IterativeLinearSolver<double>::SolveImpl(Matrix<double> &mat, Preconditione
     int m = restart_;
     int iter = linear_iterations_;
     double tol = relative_tolerance_;
-    int ret = GMRES(mat, sol, rhs, pre, m, iter, tol);
+    int gret = GMRES(mat, sol, rhs, pre, m, iter, tol);
     std::ostringstream os;
     os
       << "GMRES back vectors " << m
@@ -57,9 +71,16 @@ bool IterativeLinearSolver<double>::SolveImpl(Matrix<double> &mat, Preconditione
       << "/" << linear_iterations_
       << " relative tolerance " << tol
       << "/" << relative_tolerance_
-      << " linear convergence " << ret
+      << " linear convergence " << gret
       << "\n";
       OutputStream::WriteOut(OutputStream::OutputType::INFO, os.str());
+    ret = (gret == 0);
+    if (!ret)
+    {
+      std::ostringstream os;
+      os << "Iterative linear solve did not converge\n";
+      OutputStream::WriteOut(OutputStream::OutputType::ERROR, os.str());
+    }
   }
   else
   {
@@ -73,13 +94,134 @@ bool IterativeLinearSolver<double>::SolveImpl(Matrix<double> &mat, Preconditione
 }
 
 #ifdef DEVSIM_EXTENDED_PRECISION
+namespace {
+float128 Norm2(const std::vector<float128> &x)
+{
+  float128 ret = 0.0;
+  for (size_t i = 0; i < x.size(); ++i)
+  {
+    ret += x[i] * x[i];
+  }
+  return sqrt(ret);
+}
+}
+
+//// SuperLU factors the extended precision matrix in double precision
+template <>
+Preconditioner<float128> *IterativeLinearSolver<float128>::CreatePreconditioner(size_t numeqns)
+{
+  if (preconditioner_type_ == IterativePreconditioner_t::ILU)
+  {
+    return new ILUPreconditioner<float128>(numeqns, PEnum::TransposeType_t::NOTRANS, fill_level_);
+  }
+  return new SuperLUPreconditioner<float128>(numeqns, PEnum::TransposeType_t::NOTRANS, PEnum::LUType_t::FULL);
+}
+
+//// Mixed precision solve.  The double precision LU is used for iterative
+//// refinement, with the residual and the update in extended precision.
+//// If the refinement stalls, GMRES continues from the refined solution
+//// using the same LU as the preconditioner.
 template <>
 bool IterativeLinearSolver<float128>::SolveImpl(Matrix<float128> &mat, Preconditioner<float128> &pre, std::vector<float128> &sol, std::vector<float128> &rhs)
 {
-  bool ret = false;
+  bool ret = pre.LUFactor(&mat);
+  if (!ret)
+  {
+    std::ostringstream os;
+    os << "Matrix factorization failed\n";
+    OutputStream::WriteOut(OutputStream::OutputType::ERROR, os.str());
+    return ret;
+  }
+
+  ret = pre.LUSolve(sol, rhs);
+  if (!ret)
+  {
+    std::ostringstream os;
+    os << "Matrix solve failed\n";
+    OutputStream::WriteOut(OutputStream::OutputType::ERROR, os.str());
+    return ret;
+  }
+
+  float128 normb = Norm2(rhs);
+  if (normb == 0.0)
+  {
+    normb = 1.0;
+  }
+
+  std::vector<float128> ax;
+  std::vector<float128> r(rhs.size());
+  std::vector<float128> dx;
+
+  float128 resid = 0.0;
+  float128 last_resid = 0.0;
+  bool converged = false;
+  int refinements = 0;
+  for ( ; refinements <= refinement_iterations_; ++refinements)
+  {
+    mat.Multiply(sol, ax);
+    for (size_t i = 0; i < r.size(); ++i)
+    {
+      r[i] = rhs[i] - ax[i];
+    }
+
+    resid = Norm2(r) / normb;
+    if (resid <= relative_tolerance_)
+    {
+      converged = true;
+      break;
+    }
+    //// each step should gain about as many digits as the double precision solve
+    else if ((refinements != 0) && (resid > 0.5 * last_resid))
+    {
+      break;
+    }
+    else if (refinements == refinement_iterations_)
+    {
+      break;
+    }
+    last_resid = resid;
+
+    pre.LUSolve(dx, r);
+    for (size_t i = 0; i < sol.size(); ++i)
+    {
+      sol[i] += dx[i];
+    }
+  }
+
   std::ostringstream os;
-  os << "GMRES not implemented for extended precision\n";
-  OutputStream::WriteOut(OutputStream::OutputType::ERROR, os.str());
+  os
+    << "Iterative refinement steps " << refinements
+    << "/" << refinement_iterations_
+    << " relative residual " << static_cast<double>(resid)
+    << "/" << static_cast<double>(relative_tolerance_)
+    << "\n";
+
+  if (!converged)
+  {
+    int m = restart_;
+    int iter = linear_iterations_;
+    float128 tol = relative_tolerance_;
+    int gret = GMRES(mat, sol, rhs, pre, m, iter, tol);
+    os
+      << "GMRES back vectors " << m
+      << "/" << restart_
+      << " linear iterations " << iter
+      << "/" << linear_iterations_
+      << " relative tolerance " << static_cast<double>(tol)
+      << "/" << static_cast<double>(relative_tolerance_)
+      << " linear convergence " << gret
+      << "\n";
+    ret = (gret == 0);
+  }
+  OutputStream::WriteOut(OutputStream::OutputType::INFO, os.str());
+
+  if (!ret)
+  {
+    std::ostringstream os;
+    os << "Iterative linear solve did not converge\n";
+    OutputStream::WriteOut(OutputStream::OutputType::ERROR, os.str());
+  }
+
   return ret;
 }
 #endif
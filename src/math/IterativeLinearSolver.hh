@@ -20,14 +20,36 @@ limitations under the License.
 #include "LinearSolver.hh"
 
 namespace dsMath {
+/// BLOCK factors the diagonal blocks of each region with SuperLU
+/// ILU is an incomplete factorization with a chosen level of fill
+enum class IterativePreconditioner_t {BLOCK, ILU};
+
 // Special case
 // x = inv(A) b
 template <typename DoubleType>
 class IterativeLinearSolver : public LinearSolver<DoubleType>
 {
    public:
-        IterativeLinearSolver();
+        explicit IterativeLinearSolver(IterativePreconditioner_t = IterativePreconditioner_t::BLOCK, size_t /*fill_level*/ = 1);
         ~IterativeLinearSolver() {};
+
+        Preconditioner<DoubleType> *CreatePreconditioner(size_t /*numeqns*/);
+
+        IterativePreconditioner_t GetPreconditionerType() const
+        {
+          return preconditioner_type_;
+        }
+
+        size_t GetFillLevel() const
+        {
+          return fill_level_;
+        }
+
+        /// maximum number of GMRES iterations
+        void SetLinearIterations(int x)
+        {
+          linear_iterations_ = x;
+        }
    protected:
    private:
         bool SolveImpl(Matrix<DoubleType> &, Preconditioner<DoubleType> &, std::vector<DoubleType> &, std::vector<DoubleType> & );
@@ -39,7 +61,11 @@ class IterativeLinearSolver : public LinearSolver<DoubleType>
 
         int restart_;
         int linear_iterations_;
+        /// only used for the mixed precision solve
+        int refinement_iterations_;
         DoubleType relative_tolerance_;
+        IterativePreconditioner_t preconditioner_type_;
+        size_t fill_level_;
 };
 }
 #endif
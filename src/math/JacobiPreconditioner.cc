@@ -0,0 +1,98 @@
+/***
+DEVSIM
+Copyright 2013 Devsim LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+***/
+
+#include "JacobiPreconditioner.hh"
+#include "MatrixFreeOperator.hh"
+#include "OutputStream.hh"
+#include "dsAssert.hh"
+
+#include <sstream>
+
+namespace dsMath {
+template <typename DoubleType>
+JacobiPreconditioner<DoubleType>::JacobiPreconditioner(size_t numeqns, PEnum::TransposeType_t transpose) : Preconditioner<DoubleType>(numeqns, transpose)
+{
+}
+
+template <typename DoubleType>
+JacobiPreconditioner<DoubleType>::~JacobiPreconditioner()
+{
+}
+
+template <typename DoubleType>
+bool JacobiPreconditioner<DoubleType>::DerivedLUFactor(Matrix<DoubleType> *m)
+{
+  const MatrixFreeOperator<DoubleType> *op = dynamic_cast<MatrixFreeOperator<DoubleType> *>(m);
+  dsAssert(op, "UNEXPECTED");
+
+  const DoubleVec_t<DoubleType> &diagonal = op->GetDiagonal();
+
+  inverse_diagonal_.resize(diagonal.size());
+
+  size_t zero_count = 0;
+  for (size_t i = 0; i < diagonal.size(); ++i)
+  {
+    const DoubleType &d = diagonal[i];
+    if (d != 0.0)
+    {
+      inverse_diagonal_[i] = 1.0 / d;
+    }
+    else
+    {
+      //// rows without a diagonal entry are left unscaled
+      inverse_diagonal_[i] = 1.0;
+      ++zero_count;
+    }
+  }
+
+  if (zero_count)
+  {
+    std::ostringstream os;
+    os << "Jacobi preconditioner found " << zero_count << " rows without a diagonal entry\n";
+    OutputStream::WriteOut(OutputStream::OutputType::VERBOSE1, os.str());
+  }
+
+  return true;
+}
+
+template <typename DoubleType>
+void JacobiPreconditioner<DoubleType>::DerivedLUSolve(DoubleVec_t<DoubleType> &x, const DoubleVec_t<DoubleType> &b) const
+{
+  x.resize(b.size());
+  for (size_t i = 0; i < b.size(); ++i)
+  {
+    x[i] = inverse_diagonal_[i] * b[i];
+  }
+}
+
+template <typename DoubleType>
+void JacobiPreconditioner<DoubleType>::DerivedLUSolve(ComplexDoubleVec_t<DoubleType> &x, const ComplexDoubleVec_t<DoubleType> &b) const
+{
+  x.resize(b.size());
+  for (size_t i = 0; i < b.size(); ++i)
+  {
+    x[i] = inverse_diagonal_[i] * b[i];
+  }
+}
+}
+
+template class dsMath::JacobiPreconditioner<double>;
+#ifdef DEVSIM_EXTENDED_PRECISION
+#include "Float128.hh"
+template class dsMath::JacobiPreconditioner<float128>;
+#endif
+
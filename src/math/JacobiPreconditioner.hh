@@ -0,0 +1,47 @@
+/***
+DEVSIM
+Copyright 2013 Devsim LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+***/
+
+#ifndef JACOBI_PRECONDITIONER_HH
+#define JACOBI_PRECONDITIONER_HH
+#include "Preconditioner.hh"
+#include <vector>
+
+namespace dsMath {
+//// Scales each row by the inverse of its diagonal entry.  The diagonal is
+//// taken from a MatrixFreeOperator, so nothing has to be factored.
+template <typename DoubleType>
+class JacobiPreconditioner : public Preconditioner<DoubleType> {
+  public:
+    JacobiPreconditioner(size_t /*numeqns*/, PEnum::TransposeType_t /*tranpose*/);
+
+    ~JacobiPreconditioner();
+
+  protected:
+    void DerivedLUSolve(DoubleVec_t<DoubleType> &x, const DoubleVec_t<DoubleType> &b) const;
+    void DerivedLUSolve(ComplexDoubleVec_t<DoubleType> &x, const ComplexDoubleVec_t<DoubleType> &b) const;
+    bool DerivedLUFactor(Matrix<DoubleType> *);
+
+  private:
+    JacobiPreconditioner();
+    JacobiPreconditioner(const JacobiPreconditioner &);
+    JacobiPreconditioner &operator=(const JacobiPreconditioner &);
+
+    DoubleVec_t<DoubleType> inverse_diagonal_;
+};
+}
+#endif
+
@@ -17,6 +17,7 @@ limitations under the License.
 
 #include "LinearSolver.hh"
 #include "Preconditioner.hh"
+#include "SuperLUPreconditioner.hh"
 
 #include "OutputStream.hh"
 #include "dsTimer.hh"
@@ -33,6 +34,12 @@ template <typename DoubleType>
 LinearSolver<DoubleType>::~LinearSolver()
 {}
 
+template <typename DoubleType>
+Preconditioner<DoubleType> *LinearSolver<DoubleType>::CreateACPreconditioner(PEnum::TransposeType_t trans_type, size_t numeqns)
+{
+  return new SuperLUPreconditioner<DoubleType>(numeqns, trans_type, PEnum::LUType_t::FULL);
+}
+
 template <typename DoubleType>
 bool LinearSolver<DoubleType>::Solve(Matrix<DoubleType> &m, Preconditioner<DoubleType> &p, std::vector<DoubleType> &x, std::vector<DoubleType> &b)
 {
@@ -18,6 +18,7 @@ limitations under the License.
 #ifndef DS_LINEAR_SOLVER_HH
 #define DS_LINEAR_SOLVER_HH
 #include "dsMathTypes.hh"
+#include "Preconditioner.hh"
 
 // This is the base class for all nonlinear solver algorithms
 // Actually there really need to only 1 class since the iterative solvers
@@ -33,8 +34,6 @@ limitations under the License.
 namespace dsMath {
 template <typename DoubleType>
 class Matrix;
-template <typename DoubleType>
-class Preconditioner;
 /// This is the linear solver (inside the newton loop)
 template <typename DoubleType>
 class LinearSolver {
@@ -45,6 +44,11 @@ class LinearSolver {
        bool ACSolve(Matrix<DoubleType> &, Preconditioner<DoubleType> &, std::vector<std::complex<DoubleType>> &, std::vector<std::complex<DoubleType>> & );
        bool NoiseSolve(Matrix<DoubleType> &, Preconditioner<DoubleType> &, std::vector<std::complex<DoubleType>> &, std::vector<std::complex<DoubleType>> & );
 
+       /// The preconditioner does the factorization, so it is selected by the solver
+       virtual Preconditioner<DoubleType> *CreatePreconditioner(size_t /*numeqns*/) = 0;
+       /// Used for the complex ac and noise systems
+       virtual Preconditioner<DoubleType> *CreateACPreconditioner(PEnum::TransposeType_t, size_t /*numeqns*/);
+
     protected:
         LinearSolver();
     private:
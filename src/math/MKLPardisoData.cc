@@ -0,0 +1,241 @@
+/***
+DEVSIM
+Copyright 2013 Devsim LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+***/
+
+#include "MKLPardisoData.hh"
+#include "CompressedMatrix.hh"
+#include "dsAssert.hh"
+#include "OutputStream.hh"
+
+#include <sstream>
+
+#include "mkl_pardiso.h"
+#include "mkl_types.h"
+
+#ifdef DEVSIM_EXTENDED_PRECISION
+#include "Float128.hh"
+#endif
+
+namespace dsMath {
+namespace {
+//// real and complex unsymmetric
+const MKL_INT REAL_UNSYMMETRIC    = 11;
+const MKL_INT COMPLEX_UNSYMMETRIC = 13;
+}
+
+MKLPardisoData::MKLPardisoData(size_t numeqns, bool tran) : numeqns_(numeqns), transpose_(tran), mtype_(0), error_(0)
+{
+  static_assert(sizeof(MKL_INT) == sizeof(int), "MKL_INT must be the same size as int (LP64 interface)");
+
+  for (size_t i = 0; i < 64; ++i)
+  {
+    pt_[i] = 0;
+    iparm_[i] = 0;
+  }
+}
+
+MKLPardisoData::~MKLPardisoData()
+{
+  DeleteStorage();
+}
+
+void MKLPardisoData::DeleteStorage()
+{
+  if (mtype_ != 0)
+  {
+    MKL_INT maxfct = 1;
+    MKL_INT mnum   = 1;
+    MKL_INT phase  = -1;
+    MKL_INT n      = numeqns_;
+    MKL_INT nrhs   = 1;
+    MKL_INT msglvl = 0;
+    MKL_INT error  = 0;
+    double ddum = 0.0;
+    MKL_INT idum = 0;
+    pardiso(pt_, &maxfct, &mnum, &mtype_, &phase, &n, &ddum, &ia_[0], &ja_[0], &idum, &nrhs, iparm_, &msglvl, &ddum, &ddum, &error);
+    mtype_ = 0;
+  }
+}
+
+//// The compressed column arrays are the compressed rows of the transpose
+//// PARDISO is told to solve with the transpose to get the original system
+bool MKLPardisoData::Factor(int mtype, bool new_symbolic)
+{
+  if (new_symbolic || (mtype != mtype_))
+  {
+    DeleteStorage();
+
+    for (size_t i = 0; i < 64; ++i)
+    {
+      pt_[i] = 0;
+      iparm_[i] = 0;
+    }
+    iparm_[0]  = 1;  /* no solver default */
+    iparm_[1]  = 2;  /* nested dissection from METIS */
+    iparm_[3]  = 0;  /* no iterative-direct algorithm */
+    iparm_[4]  = 0;  /* no user fill-in reducing permutation */
+    iparm_[5]  = 0;  /* write solution into x */
+    iparm_[7]  = 2;  /* max numbers of iterative refinement steps */
+    iparm_[9]  = 13; /* perturb the pivot elements with 1E-13 */
+    iparm_[10] = 1;  /* use nonsymmetric permutation and scaling MPS */
+    iparm_[12] = 1;  /* maximum weighted matching */
+    iparm_[17] = -1; /* output number of nonzeros in the factor LU */
+    iparm_[18] = -1; /* output Mflops for LU factorization */
+    iparm_[34] = 1;  /* zero based indexing */
+  }
+
+  MKL_INT maxfct = 1;
+  MKL_INT mnum   = 1;
+  MKL_INT phase  = (mtype_ == 0) ? 12 : 22;
+  MKL_INT n      = numeqns_;
+  MKL_INT nrhs   = 1;
+  MKL_INT msglvl = 0;
+  MKL_INT idum   = 0;
+  double  ddum   = 0.0;
+  void   *a      = (mtype == REAL_UNSYMMETRIC) ? static_cast<void *>(&a_[0]) : static_cast<void *>(&z_[0]);
+
+  mtype_ = mtype;
+  error_ = 0;
+  pardiso(pt_, &maxfct, &mnum, &mtype_, &phase, &n, a, &ia_[0], &ja_[0], &idum, &nrhs, iparm_, &msglvl, &ddum, &ddum, &error_);
+
+  if (error_ != 0)
+  {
+    std::ostringstream os;
+    os << "PARDISO factorization failed with error " << error_ << "\n";
+    OutputStream::WriteOut(OutputStream::OutputType::INFO, os.str());
+    /// analysis is repeated the next time
+    DeleteStorage();
+  }
+
+  return (error_ == 0);
+}
+
+void MKLPardisoData::Solve(void *x, void *b)
+{
+  MKL_INT maxfct = 1;
+  MKL_INT mnum   = 1;
+  MKL_INT phase  = 33;
+  MKL_INT n      = numeqns_;
+  MKL_INT nrhs   = 1;
+  MKL_INT msglvl = 0;
+  MKL_INT idum   = 0;
+  void   *a      = (mtype_ == REAL_UNSYMMETRIC) ? static_cast<void *>(&a_[0]) : static_cast<void *>(&z_[0]);
+
+  /// 2 is the transpose of the compressed row matrix given to PARDISO
+  iparm_[11] = transpose_ ? 0 : 2;
+  pardiso(pt_, &maxfct, &mnum, &mtype_, &phase, &n, a, &ia_[0], &ja_[0], &idum, &nrhs, iparm_, &msglvl, b, x, &error_);
+}
+
+template <typename DoubleType>
+bool MKLPardisoData::LUFactorMatrix(CompressedMatrix<DoubleType> *cm)
+{
+  dsAssert(cm->GetCompressionType() == CompressionType::CCM, "UNEXPECTED");
+
+  const bool new_symbolic = (cm->GetSymbolicStatus() == SymbolicStatus_t::NEW_SYMBOLIC) || ia_.empty();
+  if (new_symbolic)
+  {
+    ia_ = cm->GetCols();
+    ja_ = cm->GetRows();
+  }
+
+  int mtype = 0;
+  if (cm->GetMatrixType() == MatrixType::REAL)
+  {
+    const DoubleVec_t<DoubleType> &vals = cm->GetReal();
+    a_.resize(vals.size());
+    for (size_t i = 0; i < vals.size(); ++i)
+    {
+      a_[i] = static_cast<double>(vals[i]);
+    }
+    mtype = REAL_UNSYMMETRIC;
+  }
+  else if (cm->GetMatrixType() == MatrixType::COMPLEX)
+  {
+    const DoubleVec_t<DoubleType> &rvals = cm->GetReal();
+    const DoubleVec_t<DoubleType> &ivals = cm->GetImag();
+    z_.resize(rvals.size());
+    for (size_t i = 0; i < rvals.size(); ++i)
+    {
+      z_[i] = ComplexDouble_t<double>(static_cast<double>(rvals[i]), static_cast<double>(ivals[i]));
+    }
+    mtype = COMPLEX_UNSYMMETRIC;
+  }
+
+  return Factor(mtype, new_symbolic);
+}
+
+template <typename DoubleType>
+void MKLPardisoData::LUSolve(DoubleVec_t<DoubleType> &x, const DoubleVec_t<DoubleType> &b)
+{
+  x.clear();
+  x.resize(numeqns_);
+
+  if ((mtype_ != REAL_UNSYMMETRIC) || (error_ != 0))
+  {
+    return;
+  }
+
+  DoubleVec_t<double> b64(b.size());
+  DoubleVec_t<double> x64(numeqns_);
+  for (size_t i = 0; i < b.size(); ++i)
+  {
+    b64[i] = static_cast<double>(b[i]);
+  }
+
+  Solve(&x64[0], &b64[0]);
+
+  for (size_t i = 0; i < x64.size(); ++i)
+  {
+    x[i] = static_cast<DoubleType>(x64[i]);
+  }
+}
+
+template <typename DoubleType>
+void MKLPardisoData::LUSolve(ComplexDoubleVec_t<DoubleType> &x, const ComplexDoubleVec_t<DoubleType> &b)
+{
+  x.clear();
+  x.resize(numeqns_);
+
+  if ((mtype_ != COMPLEX_UNSYMMETRIC) || (error_ != 0))
+  {
+    return;
+  }
+
+  ComplexDoubleVec_t<double> b64(b.size());
+  ComplexDoubleVec_t<double> x64(numeqns_);
+  for (size_t i = 0; i < b.size(); ++i)
+  {
+    b64[i] = ComplexDouble_t<double>(static_cast<double>(b[i].real()), static_cast<double>(b[i].imag()));
+  }
+
+  Solve(&x64[0], &b64[0]);
+
+  for (size_t i = 0; i < x64.size(); ++i)
+  {
+    x[i] = ComplexDouble_t<DoubleType>(static_cast<DoubleType>(x64[i].real()), static_cast<DoubleType>(x64[i].imag()));
+  }
+}
+
+template bool MKLPardisoData::LUFactorMatrix(CompressedMatrix<double> *);
+template void MKLPardisoData::LUSolve(DoubleVec_t<double> &, const DoubleVec_t<double> &);
+template void MKLPardisoData::LUSolve(ComplexDoubleVec_t<double> &, const ComplexDoubleVec_t<double> &);
+#ifdef DEVSIM_EXTENDED_PRECISION
+template bool MKLPardisoData::LUFactorMatrix(CompressedMatrix<float128> *);
+template void MKLPardisoData::LUSolve(DoubleVec_t<float128> &, const DoubleVec_t<float128> &);
+template void MKLPardisoData::LUSolve(ComplexDoubleVec_t<float128> &, const ComplexDoubleVec_t<float128> &);
+#endif
+}
+
@@ -0,0 +1,68 @@
+/***
+DEVSIM
+Copyright 2013 Devsim LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+***/
+
+#ifndef DS_MKL_PARDISO_DATA_HH
+#define DS_MKL_PARDISO_DATA_HH
+#include "dsMathTypes.hh"
+
+namespace dsMath {
+template <typename DoubleType>
+class CompressedMatrix;
+
+//// Threaded direct solver from the Intel Math Kernel Library
+//// The number of threads is controlled by MKL, e.g. MKL_NUM_THREADS
+class MKLPardisoData {
+  public:
+    MKLPardisoData(size_t /*numeqns*/, bool /*transpose*/);
+    ~MKLPardisoData();
+
+    template <typename DoubleType>
+    bool LUFactorMatrix(CompressedMatrix<DoubleType> *);
+
+    template <typename DoubleType>
+    void LUSolve(DoubleVec_t<DoubleType> &/*x*/, const DoubleVec_t<DoubleType> &/*b*/);
+
+    template <typename DoubleType>
+    void LUSolve(ComplexDoubleVec_t<DoubleType> &/*x*/, const ComplexDoubleVec_t<DoubleType> &/*b*/);
+
+    void DeleteStorage();
+
+  private:
+    MKLPardisoData();
+    MKLPardisoData(const MKLPardisoData &);
+    MKLPardisoData &operator=(const MKLPardisoData &);
+
+    bool Factor(int /*mtype*/, bool /*new_symbolic*/);
+    void Solve(void * /*x*/, void * /*b*/);
+
+    int          numeqns_;
+    bool         transpose_;
+    /// PARDISO internal data
+    void        *pt_[64];
+    int          iparm_[64];
+    /// matrix type of the current factorization, 0 when there is none
+    int          mtype_;
+    int          error_;
+    /// PARDISO requires the matrix during the solve
+    IntVec_t                    ia_;
+    IntVec_t                    ja_;
+    DoubleVec_t<double>         a_;
+    ComplexDoubleVec_t<double>  z_;
+};
+}
+#endif
+
@@ -0,0 +1,73 @@
+/***
+DEVSIM
+Copyright 2013 Devsim LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+***/
+
+#include "MKLPardisoPreconditioner.hh"
+#include "MKLPardisoData.hh"
+#include "CompressedMatrix.hh"
+#include "dsAssert.hh"
+#include <utility>
+#include <complex>
+
+
+namespace dsMath {
+template <typename DoubleType>
+MKLPardisoPreconditioner<DoubleType>::MKLPardisoPreconditioner(size_t sz, PEnum::TransposeType_t transpose) : Preconditioner<DoubleType>(sz, transpose), pardisoData_(NULL)
+{
+}
+
+template <typename DoubleType>
+MKLPardisoPreconditioner<DoubleType>::~MKLPardisoPreconditioner()
+{
+  delete pardisoData_;
+}
+
+template <typename DoubleType>
+bool MKLPardisoPreconditioner<DoubleType>::DerivedLUFactor(Matrix<DoubleType> *m)
+{
+  CompressedMatrix<DoubleType> *cm = dynamic_cast<CompressedMatrix<DoubleType> *>(m);
+  dsAssert(cm, "UNEXPECTED");
+  dsAssert(cm->GetCompressionType() == CompressionType::CCM, "UNEXPECTED");
+
+  if (!pardisoData_)
+  {
+    pardisoData_ = new MKLPardisoData(Preconditioner<DoubleType>::size(), Preconditioner<DoubleType>::GetTransposeSolve());
+  }
+
+  bool ret = pardisoData_->LUFactorMatrix(cm);
+  return ret;
+}
+
+template <typename DoubleType>
+void MKLPardisoPreconditioner<DoubleType>::DerivedLUSolve(DoubleVec_t<DoubleType> &x, const DoubleVec_t<DoubleType> &b) const
+{
+  pardisoData_->LUSolve(x, b);
+}
+
+template <typename DoubleType>
+void MKLPardisoPreconditioner<DoubleType>::DerivedLUSolve(ComplexDoubleVec_t<DoubleType> &x, const ComplexDoubleVec_t<DoubleType> &b) const
+{
+  pardisoData_->LUSolve(x, b);
+}
+}
+
+
+template class dsMath::MKLPardisoPreconditioner<double>;
+#ifdef DEVSIM_EXTENDED_PRECISION
+#include "Float128.hh"
+template class dsMath::MKLPardisoPreconditioner<float128>;
+#endif
+
@@ -0,0 +1,108 @@
+/***
+DEVSIM
+Copyright 2013 Devsim LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+***/
+
+#include "MatrixCache.hh"
+#include "Matrix.hh"
+#include "Preconditioner.hh"
+#include "OutputStream.hh"
+
+#ifdef DEVSIM_EXTENDED_PRECISION
+#include "Float128.hh"
+#endif
+
+#include <sstream>
+
+namespace dsMath {
+template <>
+MatrixCache<double> *MatrixCache<double>::instance = 0;
+
+#ifdef DEVSIM_EXTENDED_PRECISION
+template <>
+MatrixCache<float128> *MatrixCache<float128>::instance = 0;
+#endif
+
+template <typename DoubleType>
+MatrixCache<DoubleType>::MatrixCache()
+{
+}
+
+template <typename DoubleType>
+MatrixCache<DoubleType>::~MatrixCache()
+{
+}
+
+template <typename DoubleType>
+MatrixCache<DoubleType> &MatrixCache<DoubleType>::GetInstance()
+{
+    if (!instance)
+    {
+        instance = new MatrixCache<DoubleType>;
+    }
+    return *instance;
+}
+
+template <typename DoubleType>
+void MatrixCache<DoubleType>::DestroyInstance()
+{
+    if (instance)
+    {
+        delete instance;
+    }
+    instance = 0;
+}
+
+template <typename DoubleType>
+void MatrixCache<DoubleType>::Take(const std::string &key, std::unique_ptr<Matrix<DoubleType>> &matrix, std::unique_ptr<Preconditioner<DoubleType>> &preconditioner)
+{
+  matrix.reset();
+  preconditioner.reset();
+
+  if (matrix_ && (key == key_))
+  {
+    std::ostringstream os;
+    os << "Reusing matrix and factorization from previous solve\n";
+    OutputStream::WriteOut(OutputStream::OutputType::VERBOSE1, os.str());
+
+    matrix = std::move(matrix_);
+    preconditioner = std::move(preconditioner_);
+  }
+
+  Clear();
+}
+
+template <typename DoubleType>
+void MatrixCache<DoubleType>::Store(const std::string &key, std::unique_ptr<Matrix<DoubleType>> &matrix, std::unique_ptr<Preconditioner<DoubleType>> &preconditioner)
+{
+  key_ = key;
+  matrix_ = std::move(matrix);
+  preconditioner_ = std::move(preconditioner);
+}
+
+template <typename DoubleType>
+void MatrixCache<DoubleType>::Clear()
+{
+  key_.clear();
+  matrix_.reset();
+  preconditioner_.reset();
+}
+
+template class MatrixCache<double>;
+#ifdef DEVSIM_EXTENDED_PRECISION
+template class MatrixCache<float128>;
+#endif
+}
+
@@ -0,0 +1,62 @@
+/***
+DEVSIM
+Copyright 2013 Devsim LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+***/
+
+#ifndef DS_MATRIX_CACHE_HH
+#define DS_MATRIX_CACHE_HH
+#include <string>
+#include <memory>
+
+namespace dsMath {
+template <typename DoubleType>
+class Matrix;
+
+template <typename DoubleType>
+class Preconditioner;
+
+//// Holds the Newton matrix and preconditioner between solve commands, so
+//// that the compressed pattern, the column ordering and the LU storage do
+//// not have to be recreated for every bias point.
+//// The key describes the equation numbering of the devices and circuit.
+template <typename DoubleType>
+class MatrixCache
+{
+    public:
+        static MatrixCache &GetInstance();
+        static void DestroyInstance();
+
+        /// Transfers ownership to the caller, both are null if the key does not match
+        void Take(const std::string &/*key*/, std::unique_ptr<Matrix<DoubleType>> &, std::unique_ptr<Preconditioner<DoubleType>> &);
+
+        /// Takes ownership of the matrix and preconditioner for the next solve
+        void Store(const std::string &/*key*/, std::unique_ptr<Matrix<DoubleType>> &, std::unique_ptr<Preconditioner<DoubleType>> &);
+
+        void Clear();
+
+    private:
+        MatrixCache();
+        MatrixCache(MatrixCache &);
+        MatrixCache &operator=(MatrixCache &);
+        ~MatrixCache();
+        static MatrixCache *instance;
+
+        std::string                                 key_;
+        std::unique_ptr<Matrix<DoubleType>>         matrix_;
+        std::unique_ptr<Preconditioner<DoubleType>> preconditioner_;
+};
+}
+#endif
+
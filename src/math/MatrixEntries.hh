@@ -47,6 +47,7 @@ template <typename T>
 class RowColVal
 {
    public:
+      RowColVal() : row(-1), col(-1), val() {}
       RowColVal(int r, int c, T v) : row(r), col(c), val(v) {}
       int row;
       int col;
@@ -0,0 +1,111 @@
+/***
+DEVSIM
+Copyright 2013 Devsim LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+***/
+
+#include "MatrixFreeLinearSolver.hh"
+#include "JacobiPreconditioner.hh"
+
+#include "OutputStream.hh"
+#include "gmres.hh"
+
+#ifdef DEVSIM_EXTENDED_PRECISION
+#include "Float128.hh"
+#endif
+
+#include <sstream>
+
+namespace dsMath {
+//// Every linear iteration costs an assembly, so the tolerance is reachable
+template <typename DoubleType>
+MatrixFreeLinearSolver<DoubleType>::MatrixFreeLinearSolver() : restart_(50), linear_iterations_(100), relative_tolerance_(1e-12)
+{}
+
+template <typename DoubleType>
+Preconditioner<DoubleType> *MatrixFreeLinearSolver<DoubleType>::CreatePreconditioner(size_t numeqns)
+{
+  return new JacobiPreconditioner<DoubleType>(numeqns, PEnum::TransposeType_t::NOTRANS);
+}
+
+template <typename DoubleType>
+bool MatrixFreeLinearSolver<DoubleType>::SolveImpl(Matrix<DoubleType> &mat, Preconditioner<DoubleType> &pre, std::vector<DoubleType> &sol, std::vector<DoubleType> &rhs)
+{
+  bool ret = pre.LUFactor(&mat);
+  if (ret)
+  {
+    int m = restart_;
+    int iter = linear_iterations_;
+    DoubleType tol = relative_tolerance_;
+    const int gret = GMRES(mat, sol, rhs, pre, m, iter, tol);
+    std::ostringstream os;
+    os
+      << "Matrix free GMRES back vectors " << m
+      << "/" << restart_
+      << " linear iterations " << iter
+      << "/" << linear_iterations_
+      << " relative tolerance " << tol
+      << "/" << relative_tolerance_
+      << " linear convergence " << gret
+      << "\n";
+      OutputStream::WriteOut(OutputStream::OutputType::INFO, os.str());
+
+    ret = (gret == 0);
+    if (!ret)
+    {
+      std::ostringstream os;
+      os << "Matrix free linear solve did not converge\n";
+      OutputStream::WriteOut(OutputStream::OutputType::ERROR, os.str());
+    }
+  }
+  else
+  {
+    std::ostringstream os;
+    os << "Preconditioner setup failed\n";
+    OutputStream::WriteOut(OutputStream::OutputType::ERROR, os.str());
+  }
+
+  return ret;
+}
+
+template <typename DoubleType>
+bool MatrixFreeLinearSolver<DoubleType>::ACSolveImpl(Matrix<DoubleType> &mat, Preconditioner<DoubleType> &pre, std::vector<std::complex<DoubleType>> &sol, std::vector<std::complex<DoubleType>> &rhs)
+{
+  bool ret = false;
+  {
+    std::ostringstream os;
+    os << "AC matrix free solve not implemented\n";
+    OutputStream::WriteOut(OutputStream::OutputType::ERROR, os.str());
+  }
+  return ret;
+}
+
+template <typename DoubleType>
+bool MatrixFreeLinearSolver<DoubleType>::NoiseSolveImpl(Matrix<DoubleType> &mat, Preconditioner<DoubleType> &pre, std::vector<std::complex<DoubleType>> &sol, std::vector<std::complex<DoubleType>> &rhs)
+{
+  bool ret = false;
+  {
+    std::ostringstream os;
+    os << "Noise matrix free solve not implemented\n";
+    OutputStream::WriteOut(OutputStream::OutputType::ERROR, os.str());
+  }
+  return ret;
+}
+}
+
+template class dsMath::MatrixFreeLinearSolver<double>;
+#ifdef DEVSIM_EXTENDED_PRECISION
+template class dsMath::MatrixFreeLinearSolver<float128>;
+#endif
+
@@ -0,0 +1,55 @@
+/***
+DEVSIM
+Copyright 2013 Devsim LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+***/
+
+#ifndef DS_MATRIX_FREE_LINEAR_SOLVER_HH
+#define DS_MATRIX_FREE_LINEAR_SOLVER_HH
+#include "LinearSolver.hh"
+
+namespace dsMath {
+//// Newton-Krylov solve, where GMRES is applied to a MatrixFreeOperator
+//// with a Jacobi preconditioner.  Neither the jacobian nor a factorization
+//// is stored, at the cost of one assembly per linear iteration.
+template <typename DoubleType>
+class MatrixFreeLinearSolver : public LinearSolver<DoubleType>
+{
+   public:
+        MatrixFreeLinearSolver();
+        ~MatrixFreeLinearSolver() {};
+
+        Preconditioner<DoubleType> *CreatePreconditioner(size_t /*numeqns*/);
+
+        /// maximum number of GMRES iterations
+        void SetLinearIterations(int x)
+        {
+          linear_iterations_ = x;
+        }
+   protected:
+   private:
+        bool SolveImpl(Matrix<DoubleType> &, Preconditioner<DoubleType> &, std::vector<DoubleType> &, std::vector<DoubleType> & );
+        bool ACSolveImpl(Matrix<DoubleType> &, Preconditioner<DoubleType> &,  std::vector<std::complex<DoubleType>> &, std::vector<std::complex<DoubleType>> & );
+        bool NoiseSolveImpl(Matrix<DoubleType> &, Preconditioner<DoubleType> &, std::vector<std::complex<DoubleType>> &, std::vector<std::complex<DoubleType>> & );
+
+        MatrixFreeLinearSolver(const MatrixFreeLinearSolver &);
+        MatrixFreeLinearSolver &operator=(const MatrixFreeLinearSolver &);
+
+        int restart_;
+        int linear_iterations_;
+        DoubleType relative_tolerance_;
+};
+}
+#endif
+
@@ -0,0 +1,191 @@
+/***
+DEVSIM
+Copyright 2013 Devsim LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+***/
+
+#include "MatrixFreeOperator.hh"
+#include "PhaseTimer.hh"
+#include "dsAssert.hh"
+
+namespace dsMath {
+namespace {
+//// Accumulates y = A x, or y = A^T x, as the entries of A are added
+template <typename DoubleType>
+class JacobianProduct : public Matrix<DoubleType> {
+    public:
+        JacobianProduct(size_t sz, const DoubleVec_t<DoubleType> &x, DoubleVec_t<DoubleType> &y, bool transpose) : Matrix<DoubleType>(sz), x_(x), y_(y), transpose_(transpose)
+        {
+        }
+
+        void AddEntry(int r, int c, DoubleType v)
+        {
+          if (transpose_)
+          {
+            y_[c] += v * x_[r];
+          }
+          else
+          {
+            y_[r] += v * x_[c];
+          }
+        }
+
+        void AddEntry(int, int, ComplexDouble_t<DoubleType>)
+        {
+          dsAssert(0, "UNEXPECTED");
+        }
+
+        void AddImagEntry(int, int, DoubleType)
+        {
+          dsAssert(0, "UNEXPECTED");
+        }
+
+        void ClearMatrix()
+        {
+          dsAssert(0, "UNEXPECTED");
+        }
+
+        void Finalize()
+        {
+          dsAssert(0, "UNEXPECTED");
+        }
+
+        void Multiply(const DoubleVec_t<DoubleType> &, DoubleVec_t<DoubleType> &) const
+        {
+          dsAssert(0, "UNEXPECTED");
+        }
+
+        void TransposeMultiply(const DoubleVec_t<DoubleType> &, DoubleVec_t<DoubleType> &) const
+        {
+          dsAssert(0, "UNEXPECTED");
+        }
+
+        void Multiply(const ComplexDoubleVec_t<DoubleType> &, ComplexDoubleVec_t<DoubleType> &) const
+        {
+          dsAssert(0, "UNEXPECTED");
+        }
+
+        void TransposeMultiply(const ComplexDoubleVec_t<DoubleType> &, ComplexDoubleVec_t<DoubleType> &) const
+        {
+          dsAssert(0, "UNEXPECTED");
+        }
+
+    private:
+        const DoubleVec_t<DoubleType> &x_;
+        DoubleVec_t<DoubleType>       &y_;
+        const bool                     transpose_;
+};
+}
+
+template <typename DoubleType>
+JacobianLoader<DoubleType>::~JacobianLoader()
+{
+}
+
+template <typename DoubleType>
+MatrixFreeOperator<DoubleType>::MatrixFreeOperator(size_t sz) : Matrix<DoubleType>(sz), loader_(NULL), diagonal_(sz)
+{
+}
+
+template <typename DoubleType>
+MatrixFreeOperator<DoubleType>::~MatrixFreeOperator()
+{
+}
+
+template <typename DoubleType>
+void MatrixFreeOperator<DoubleType>::SetLoader(const JacobianLoader<DoubleType> *loader)
+{
+  loader_ = loader;
+}
+
+template <typename DoubleType>
+void MatrixFreeOperator<DoubleType>::AddEntry(int r, int c, DoubleType v)
+{
+  if (r == c)
+  {
+    diagonal_[r] += v;
+  }
+}
+
+template <typename DoubleType>
+void MatrixFreeOperator<DoubleType>::AddEntry(int, int, ComplexDouble_t<DoubleType>)
+{
+  dsAssert(0, "UNEXPECTED");
+}
+
+template <typename DoubleType>
+void MatrixFreeOperator<DoubleType>::AddImagEntry(int, int, DoubleType)
+{
+  dsAssert(0, "UNEXPECTED");
+}
+
+template <typename DoubleType>
+void MatrixFreeOperator<DoubleType>::ClearMatrix()
+{
+  diagonal_.assign(diagonal_.size(), 0.0);
+}
+
+template <typename DoubleType>
+void MatrixFreeOperator<DoubleType>::Finalize()
+{
+}
+
+template <typename DoubleType>
+void MatrixFreeOperator<DoubleType>::Apply(const DoubleVec_t<DoubleType> &x, DoubleVec_t<DoubleType> &y, bool transpose) const
+{
+  PhaseTimerScope timer("matrix_free_multiply");
+
+  dsAssert(loader_, "UNEXPECTED");
+  dsAssert(x.size() == diagonal_.size(), "UNEXPECTED");
+
+  y.clear();
+  y.resize(diagonal_.size());
+
+  JacobianProduct<DoubleType> product(diagonal_.size(), x, y, transpose);
+  loader_->Load(product);
+}
+
+template <typename DoubleType>
+void MatrixFreeOperator<DoubleType>::Multiply(const DoubleVec_t<DoubleType> &x, DoubleVec_t<DoubleType> &y) const
+{
+  Apply(x, y, false);
+}
+
+template <typename DoubleType>
+void MatrixFreeOperator<DoubleType>::TransposeMultiply(const DoubleVec_t<DoubleType> &x, DoubleVec_t<DoubleType> &y) const
+{
+  Apply(x, y, true);
+}
+
+template <typename DoubleType>
+void MatrixFreeOperator<DoubleType>::Multiply(const ComplexDoubleVec_t<DoubleType> &, ComplexDoubleVec_t<DoubleType> &) const
+{
+  dsAssert(0, "UNEXPECTED");
+}
+
+template <typename DoubleType>
+void MatrixFreeOperator<DoubleType>::TransposeMultiply(const ComplexDoubleVec_t<DoubleType> &, ComplexDoubleVec_t<DoubleType> &) const
+{
+  dsAssert(0, "UNEXPECTED");
+}
+}
+
+template class dsMath::JacobianLoader<double>;
+template class dsMath::MatrixFreeOperator<double>;
+#ifdef DEVSIM_EXTENDED_PRECISION
+#include "Float128.hh"
+template class dsMath::JacobianLoader<float128>;
+template class dsMath::MatrixFreeOperator<float128>;
+#endif
+
@@ -0,0 +1,83 @@
+/***
+DEVSIM
+Copyright 2013 Devsim LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+***/
+
+#ifndef DS_MATRIX_FREE_OPERATOR_HH
+#define DS_MATRIX_FREE_OPERATOR_HH
+#include "Matrix.hh"
+
+namespace dsMath {
+/// Reassembles the jacobian of the current solution into a matrix
+template <typename DoubleType>
+class JacobianLoader {
+  public:
+    virtual ~JacobianLoader() = 0;
+
+    /// Adds every entry of the jacobian, the matrix is not finalized
+    virtual void Load(Matrix<DoubleType> &) const = 0;
+};
+
+//// The jacobian is never stored.  Only the diagonal is kept from the
+//// entries added during the newton assembly, for use by a preconditioner.
+////
+//// Every Multiply reassembles the jacobian through the JacobianLoader and
+//// accumulates the product directly from the entries.  Since the solution
+//// does not change during the linear solve, the derivative models are
+//// already up to date and only the assembly loops are run again.
+template <typename DoubleType>
+class MatrixFreeOperator : public Matrix<DoubleType> {
+    public:
+        explicit MatrixFreeOperator(size_t);
+
+        ~MatrixFreeOperator();
+
+        /// Must be set before calling Multiply, the loader is not owned
+        void SetLoader(const JacobianLoader<DoubleType> *);
+
+        /// Only the diagonal entries are kept
+        void AddEntry(int, int, DoubleType);
+
+        void AddEntry(int, int, ComplexDouble_t<DoubleType>);
+
+        void AddImagEntry(int, int, DoubleType);
+
+        void ClearMatrix();
+
+        void Finalize();
+
+        void Multiply(const DoubleVec_t<DoubleType> &/*x*/, DoubleVec_t<DoubleType> &/*y*/) const;
+        void TransposeMultiply(const DoubleVec_t<DoubleType> &/*x*/, DoubleVec_t<DoubleType> &/*y*/) const;
+        void Multiply(const ComplexDoubleVec_t<DoubleType> &/*x*/, ComplexDoubleVec_t<DoubleType> &/*y*/) const;
+        void TransposeMultiply(const ComplexDoubleVec_t<DoubleType> &/*x*/, ComplexDoubleVec_t<DoubleType> &/*y*/) const;
+
+        const DoubleVec_t<DoubleType> &GetDiagonal() const
+        {
+          return diagonal_;
+        }
+
+    private:
+        MatrixFreeOperator();
+        MatrixFreeOperator(const MatrixFreeOperator &);
+        MatrixFreeOperator &operator=(const MatrixFreeOperator &);
+
+        void Apply(const DoubleVec_t<DoubleType> &/*x*/, DoubleVec_t<DoubleType> &/*y*/, bool /*transpose*/) const;
+
+        const JacobianLoader<DoubleType> *loader_;
+        DoubleVec_t<DoubleType>           diagonal_;
+};
+}
+#endif
+
@@ -23,20 +23,23 @@ limitations under the License.
 #include "InstanceKeeper.hh"
 #include "NodeKeeper.hh"
 #include "CompressedMatrix.hh"
-#include "SuperLUPreconditioner.hh"
+#include "MatrixCache.hh"
 #include "Device.hh"
 #include "Region.hh"
 #include "EquationHolder.hh"
 #include "OutputStream.hh"
 #include "dsAssert.hh"
 
-#include "BlockPreconditioner.hh"
 #include "IterativeLinearSolver.hh"
+#include "DirectLinearSolver.hh"
+#include "MatrixFreeLinearSolver.hh"
+#include "MatrixFreeOperator.hh"
 #include "TimeData.hh"
 
 #include "ObjectHolder.hh"
 #include "Interpreter.hh"
 #include "dsTimer.hh"
+#include "PhaseTimer.hh"
 
 #ifdef DEVSIM_EXTENDED_PRECISION
 #include "Float128.hh"
@@ -90,6 +93,8 @@ size_t Newton<DoubleType>::NumberEquationsAndSetDimension()
 
   dimension = 0;
 
+  std::ostringstream keystream;
+
   const GlobalData::DeviceList_t &dlist = gdata.GetDeviceList();
   {
     GlobalData::DeviceList_t::const_iterator dit  = dlist.begin();
@@ -106,6 +111,7 @@ size_t Newton<DoubleType>::NumberEquationsAndSetDimension()
       if (maxnum != size_t(-1))
       {
           os << "Device \"" << name << "\" has equations " << eqnnum << ":" << maxnum << "\n";
+          keystream << name << " " << eqnnum << ":" << maxnum << "\n";
           eqnnum = maxnum + 1;
       }
       else
@@ -132,13 +138,67 @@ size_t Newton<DoubleType>::NumberEquationsAndSetDimension()
       os << "Circuit " << " has equations " << eqnnum << ":" << maxnum << "\n";
       OutputStream::WriteOut(OutputStream::OutputType::INFO, os.str());
 #endif
+      keystream << "circuit " << eqnnum << ":" << maxnum << "\n";
       eqnnum = maxnum + 1;
     }
   }
 
+  numberingKey = keystream.str();
+
   return eqnnum;
 }
 
+//// A matrix from a previous solve may be reused when the equation numbering
+//// and the kind of preconditioner are the same
+template <typename DoubleType>
+std::string Newton<DoubleType>::GetMatrixKey(LinearSolver<DoubleType> &itermethod) const
+{
+  std::string ret = numberingKey;
+  if (IterativeLinearSolver<DoubleType> *ils = dynamic_cast<IterativeLinearSolver<DoubleType> *>(&itermethod))
+  {
+    std::ostringstream os;
+    os << "iterative " << static_cast<int>(ils->GetPreconditionerType()) << " " << ils->GetFillLevel() << "\n";
+    ret += os.str();
+  }
+  else if (dynamic_cast<MatrixFreeLinearSolver<DoubleType> *>(&itermethod))
+  {
+    ret += "matrix_free\n";
+  }
+  else if (DirectLinearSolver<DoubleType> *dls = dynamic_cast<DirectLinearSolver<DoubleType> *>(&itermethod))
+  {
+    std::ostringstream os;
+    os << "direct " << static_cast<int>(dls->GetDirectSolver()) << "\n";
+    ret += os.str();
+  }
+  return ret;
+}
+
+//// Repeats the matrix loads of the newton iteration, without the rhs
+template <typename DoubleType>
+class Newton<DoubleType>::JacobianLoad : public JacobianLoader<DoubleType> {
+  public:
+    JacobianLoad(Newton<DoubleType> &n, permvec_t &p, const TimeMethods::TimeParams<DoubleType> &t) : newton_(n), permvec_(p), timeinfo_(t)
+    {
+    }
+
+    void Load(Matrix<DoubleType> &matrix) const
+    {
+      std::vector<DoubleType> rhs(permvec_.size());
+
+      newton_.LoadMatrixAndRHS(matrix, rhs, permvec_, dsMathEnum::WhatToLoad::MATRIXONLY, dsMathEnum::TimeMode::DC, static_cast<DoubleType>(1.0));
+
+      if ((!timeinfo_.IsDCOnly()) && (timeinfo_.a0 != 0.0))
+      {
+        newton_.LoadMatrixAndRHS(matrix, rhs, permvec_, dsMathEnum::WhatToLoad::MATRIXONLY, dsMathEnum::TimeMode::TIME, timeinfo_.a0);
+      }
+    }
+
+  private:
+    Newton<DoubleType>                          &newton_;
+    permvec_t                                   &permvec_;
+    const TimeMethods::TimeParams<DoubleType>   &timeinfo_;
+};
+
 template <typename DoubleType>
 void Newton<DoubleType>::AssembleContactsAndInterfaces(RealRowColValueVec<DoubleType> &mat, RHSEntryVec<DoubleType> &rhs, permvec_t &permvec, Device &dev, dsMathEnum::WhatToLoad w, dsMathEnum::TimeMode t)
 {
@@ -300,6 +360,7 @@ template <typename T>
 void Newton<DoubleType>::LoadMatrixAndRHS(Matrix<DoubleType> &matrix, std::vector<T> &rhs, permvec_t &permvec, dsMathEnum::WhatToLoad w, dsMathEnum::TimeMode t, T scl)
 {
   dsTimer timer("LoadMatrixAndRHS");
+  PhaseTimerScope phase("load_matrix_and_rhs");
 
   RHSEntryVec<DoubleType>    v;
   RealRowColValueVec<DoubleType> m;
@@ -307,6 +368,10 @@ void Newton<DoubleType>::LoadMatrixAndRHS(Matrix<DoubleType> &matrix, std::vecto
   GlobalData &gdata = GlobalData::GetInstance();
   const GlobalData::DeviceList_t dlist = gdata.GetDeviceList();
 
+  //// The bulk assembly always creates matrix entries, they are not loaded for
+  //// a rhs only assembly, so the matrix is not disturbed between solves
+  const bool load_matrix = (w != dsMathEnum::WhatToLoad::RHS);
+
   GlobalData::DeviceList_t::const_iterator dit  = dlist.begin();
   GlobalData::DeviceList_t::const_iterator dend = dlist.end();
   for ( ; dit != dend; ++dit)
@@ -319,13 +384,19 @@ void Newton<DoubleType>::LoadMatrixAndRHS(Matrix<DoubleType> &matrix, std::vecto
 
     if (w != dsMathEnum::WhatToLoad::PERMUTATIONSONLY)
     {
-      LoadIntoMatrix(m, matrix, scl);
+      if (load_matrix)
+      {
+        LoadIntoMatrix(m, matrix, scl);
+      }
       LoadIntoRHS(v, rhs, scl);
 
       m.clear();
       v.clear();
       AssembleBulk(m, v, dev, w, t);
-      LoadIntoMatrixPermutated(m, matrix, permvec, scl);
+      if (load_matrix)
+      {
+        LoadIntoMatrixPermutated(m, matrix, permvec, scl);
+      }
       LoadIntoRHSPermutated(v, rhs, permvec, scl);
     }
   }
@@ -339,14 +410,20 @@ void Newton<DoubleType>::LoadMatrixAndRHS(Matrix<DoubleType> &matrix, std::vecto
       m.clear();
       v.clear();
       LoadMatrixAndRHSOnCircuit(m, v, w, t);
-      LoadIntoMatrix(m, matrix, scl, offset);
+      if (load_matrix)
+      {
+        LoadIntoMatrix(m, matrix, scl, offset);
+      }
       LoadIntoRHS(v, rhs, scl, offset);
     }
 
     m.clear();
     v.clear();
     AssembleTclEquations(m, v, w, t);
-    LoadIntoMatrixPermutated(m, matrix, permvec, scl);
+    if (load_matrix)
+    {
+      LoadIntoMatrixPermutated(m, matrix, permvec, scl);
+    }
     LoadIntoRHSPermutated(v, rhs, permvec, scl);
   }
 }
@@ -382,15 +459,89 @@ void Newton<DoubleType>::LoadCircuitRHSAC(std::vector<std::complex<DoubleType>>
   OutputStream::WriteOut(OutputStream::OutputType::INFO, os.str());
 }
 
+namespace {
 template <typename DoubleType>
-void Newton<DoubleType>::LoadMatrixAndRHSAC(Matrix<DoubleType> &matrix, std::vector<std::complex<DoubleType>> &rhs, permvec_t &permvec, DoubleType frequency)
+std::complex<DoubleType> GetJOmega(DoubleType frequency)
 {
 #ifdef DEVSIM_EXTENDED_PRECISION
   static const DoubleType two_pi = boost::math::constants::two_pi<DoubleType>();
 #else
   static const DoubleType two_pi = 2.0*M_PI;
 #endif
-  const std::complex<DoubleType> jOmega  = two_pi * std::complex<DoubleType>(0,1.0) * frequency;
+  return two_pi * std::complex<DoubleType>(0,1.0) * frequency;
+}
+
+//// Keeps the real entries loaded into it, so that the ac matrix can be
+//// formed for each frequency without assembling the devices again
+template <typename DoubleType>
+class RecordedMatrix : public Matrix<DoubleType> {
+  public:
+    explicit RecordedMatrix(size_t numeqns) : Matrix<DoubleType>(numeqns) {}
+
+    void AddEntry(int r, int c, DoubleType v)
+    {
+      entries_.push_back(RealRowColVal<DoubleType>(r, c, v));
+    }
+
+    void AddEntry(int, int, std::complex<DoubleType>)
+    {
+      dsAssert(false, "UNEXPECTED");
+    }
+
+    void AddImagEntry(int, int, DoubleType)
+    {
+      dsAssert(false, "UNEXPECTED");
+    }
+
+    void ClearMatrix()
+    {
+      entries_.clear();
+    }
+
+    void Finalize()
+    {
+    }
+
+    void Multiply(const DoubleVec_t<DoubleType> &, DoubleVec_t<DoubleType> &) const
+    {
+      dsAssert(false, "UNEXPECTED");
+    }
+
+    void TransposeMultiply(const DoubleVec_t<DoubleType> &, DoubleVec_t<DoubleType> &) const
+    {
+      dsAssert(false, "UNEXPECTED");
+    }
+
+    void Multiply(const ComplexDoubleVec_t<DoubleType> &, ComplexDoubleVec_t<DoubleType> &) const
+    {
+      dsAssert(false, "UNEXPECTED");
+    }
+
+    void TransposeMultiply(const ComplexDoubleVec_t<DoubleType> &, ComplexDoubleVec_t<DoubleType> &) const
+    {
+      dsAssert(false, "UNEXPECTED");
+    }
+
+    /// Loads the entries in the order they were recorded
+    template <typename T>
+    void LoadInto(Matrix<DoubleType> &matrix, T scl) const
+    {
+      for (typename RealRowColValueVec<DoubleType>::const_iterator it = entries_.begin(); it != entries_.end(); ++it)
+      {
+        const T val = scl * it->val;
+        matrix.AddEntry(it->row, it->col, val);
+      }
+    }
+
+  private:
+    RealRowColValueVec<DoubleType> entries_;
+};
+}
+
+template <typename DoubleType>
+void Newton<DoubleType>::LoadMatrixAndRHSAC(Matrix<DoubleType> &matrix, std::vector<std::complex<DoubleType>> &rhs, permvec_t &permvec, DoubleType frequency)
+{
+  const std::complex<DoubleType> jOmega  = GetJOmega(frequency);
 
   std::vector<DoubleType>                   r(rhs.size());
   std::vector<std::complex<DoubleType>> c(rhs.size());
@@ -400,7 +551,7 @@ void Newton<DoubleType>::LoadMatrixAndRHSAC(Matrix<DoubleType> &matrix, std::vec
 }
 
 template <typename DoubleType>
-void Newton<DoubleType>::RestoreSolutions()
+void Newton<DoubleType>::RestoreSolutions(const std::string &suffix)
 {
   GlobalData &gdata = GlobalData::GetInstance();
 
@@ -415,7 +566,7 @@ void Newton<DoubleType>::RestoreSolutions()
       std::string name = (dit->first);
       Device &dev =     *(dit->second);
       //// Transient may have other backup suffixes
-      dev.RestoreSolutions("_prev");
+      dev.RestoreSolutions(suffix);
     }
   }
 
@@ -423,13 +574,13 @@ void Newton<DoubleType>::RestoreSolutions()
     NodeKeeper &nk = NodeKeeper::instance();
     if (nk.HaveNodes())
     {
-      nk.CopySolution("dcop_prev", "dcop");
+      nk.CopySolution("dcop" + suffix, "dcop");
     }
   }
 }
 
 template <typename DoubleType>
-void Newton<DoubleType>::BackupSolutions()
+void Newton<DoubleType>::BackupSolutions(const std::string &suffix)
 {
   GlobalData &gdata = GlobalData::GetInstance();
 
@@ -444,7 +595,7 @@ void Newton<DoubleType>::BackupSolutions()
       std::string name = (dit->first);
       Device &dev =     *(dit->second);
       //// Transient may have other backup suffixes
-      dev.BackupSolutions("_prev");
+      dev.BackupSolutions(suffix);
     }
   }
 
@@ -452,59 +603,12 @@ void Newton<DoubleType>::BackupSolutions()
     NodeKeeper &nk = NodeKeeper::instance();
     if (nk.HaveNodes())
     {
-      nk.InitializeSolution("dcop_prev");
-      nk.CopySolution("dcop", "dcop_prev");
+      nk.InitializeSolution("dcop" + suffix);
+      nk.CopySolution("dcop", "dcop" + suffix);
     }
   }
 }
 
-namespace {
-Preconditioner<double> *CreatePreconditioner(LinearSolver<double> &itermethod, size_t numeqns)
-{
-  Preconditioner<double> *preconditioner;
-  if (dynamic_cast<IterativeLinearSolver<double> *>(&itermethod))
-  {
-    preconditioner = new BlockPreconditioner<double>(numeqns, PEnum::TransposeType_t::NOTRANS);
-  }
-  else
-  {
-    preconditioner = new SuperLUPreconditioner<double>(numeqns, PEnum::TransposeType_t::NOTRANS, PEnum::LUType_t::FULL);
-  }
-  return preconditioner;
-}
-
-#ifdef DEVSIM_EXTENDED_PRECISION
-Preconditioner<float128> *CreatePreconditioner(LinearSolver<float128> &itermethod, size_t numeqns)
-{
-  Preconditioner<float128> *preconditioner;
-  if (dynamic_cast<IterativeLinearSolver<float128> *>(&itermethod))
-  {
-    preconditioner = new BlockPreconditioner<float128>(numeqns, PEnum::TransposeType_t::NOTRANS);
-  }
-  else
-  {
-    preconditioner = new SuperLUPreconditioner<float128>(numeqns, PEnum::TransposeType_t::NOTRANS, PEnum::LUType_t::FULL);
-  }
-  return preconditioner;
-}
-#endif
-
-template <typename DoubleType>
-Preconditioner<DoubleType> *CreateACPreconditioner(PEnum::TransposeType_t trans_type, size_t numeqns)
-{
-  return new SuperLUPreconditioner<DoubleType>(numeqns, trans_type, PEnum::LUType_t::FULL);
-}
-
-#if 0
-#ifdef DEVSIM_EXTENDED_PRECISION
-Preconditioner<float128> *CreateACPreconditioner(PEnum::TransposeType_t trans_type, size_t numeqns)
-{
-  return new SuperLUPreconditioner<float128>(numeqns, trans_type, PEnum::LUType_t::FULL);
-}
-#endif
-#endif
-}
-
 namespace {
 void CallUpdateSolution(NodeKeeper &nk, const std::string &name, std::vector<double> &result)
 {
@@ -562,14 +666,33 @@ bool Newton<DoubleType>::Solve(LinearSolver<DoubleType> &itermethod, const TimeM
   std::unique_ptr<Matrix<DoubleType>> matrix;
   std::unique_ptr<Preconditioner<DoubleType>> preconditioner;
 
-  matrix = std::unique_ptr<Matrix<DoubleType>>(new CompressedMatrix<DoubleType>(numeqns));
-  preconditioner = std::unique_ptr<Preconditioner<DoubleType>>(CreatePreconditioner(itermethod, numeqns));
+  //// Reuse the pattern and factorization when the equation numbering has not changed
+  MatrixCache<DoubleType> &mcache = MatrixCache<DoubleType>::GetInstance();
+  const std::string matrix_key = GetMatrixKey(itermethod);
+  mcache.Take(matrix_key, matrix, preconditioner);
+
+  const bool matrix_free = (dynamic_cast<MatrixFreeLinearSolver<DoubleType> *>(&itermethod) != NULL);
+
+  if (matrix)
+  {
+    matrix->ClearMatrix();
+  }
+  else if (matrix_free)
+  {
+    matrix = std::unique_ptr<Matrix<DoubleType>>(new MatrixFreeOperator<DoubleType>(numeqns));
+    preconditioner = std::unique_ptr<Preconditioner<DoubleType>>(itermethod.CreatePreconditioner(numeqns));
+  }
+  else
+  {
+    matrix = std::unique_ptr<Matrix<DoubleType>>(new CompressedMatrix<DoubleType>(numeqns));
+    preconditioner = std::unique_ptr<Preconditioner<DoubleType>>(itermethod.CreatePreconditioner(numeqns));
+  }
 
   std::vector<DoubleType> rhs(numeqns);
 
   bool converged = false;
 
-  BackupSolutions();
+  BackupSolutions("_prev");
 
   /////
   ///// Permutation vector
@@ -591,6 +714,12 @@ bool Newton<DoubleType>::Solve(LinearSolver<DoubleType> &itermethod, const TimeM
 
   LoadMatrixAndRHS(*matrix, rhs, permvec, dsMathEnum::WhatToLoad::PERMUTATIONSONLY, dsMathEnum::TimeMode::DC, static_cast<DoubleType>(1.0));
 
+  JacobianLoad jacobian_load(*this, permvec, timeinfo);
+  if (matrix_free)
+  {
+    static_cast<MatrixFreeOperator<DoubleType> &>(*matrix).SetLoader(&jacobian_load);
+  }
+
   size_t divergence_count = 0;
   DoubleType last_rel_err = 0.0;
   DoubleType last_abs_err = 0.0;
@@ -608,6 +737,16 @@ bool Newton<DoubleType>::Solve(LinearSolver<DoubleType> &itermethod, const TimeM
 
     rhs = rhs_constant;
 
+    //// only models recalculated during this iteration are reported
+    {
+      GlobalData::DeviceList_t::const_iterator dit  = dlist.begin();
+      GlobalData::DeviceList_t::const_iterator dend = dlist.end();
+      for ( ; dit != dend; ++dit)
+      {
+        (dit->second)->ClearRecomputedModels();
+      }
+    }
+
 //        std::cerr << "Begin Load Matrix\n";
     /// This is the resistive portion (always assembled
     if (timeinfo.IsDCOnly())
@@ -735,7 +874,7 @@ bool Newton<DoubleType>::Solve(LinearSolver<DoubleType> &itermethod, const TimeM
 
   if (!converged)
   {
-    RestoreSolutions();
+    RestoreSolutions("_prev");
   }
   else
   {
@@ -766,9 +905,88 @@ bool Newton<DoubleType>::Solve(LinearSolver<DoubleType> &itermethod, const TimeM
     (*ohm)["iterations"] = ObjectHolder(iteration_list);
   }
 
+  if (matrix_free)
+  {
+    static_cast<MatrixFreeOperator<DoubleType> &>(*matrix).SetLoader(NULL);
+  }
+
+  mcache.Store(matrix_key, matrix, preconditioner);
+
   return converged;
 }
 
+template <typename DoubleType>
+bool Newton<DoubleType>::Predict(LinearSolver<DoubleType> &itermethod)
+{
+  NodeKeeper &nk = NodeKeeper::instance();
+  GlobalData &gdata = GlobalData::GetInstance();
+  const GlobalData::DeviceList_t      &dlist = gdata.GetDeviceList();
+
+  //// The preconditioner of an iterative solver is not the jacobian
+  if (!dynamic_cast<DirectLinearSolver<DoubleType> *>(&itermethod))
+  {
+    return false;
+  }
+
+  const size_t numeqns = NumberEquationsAndSetDimension();
+
+  std::unique_ptr<Matrix<DoubleType>> matrix;
+  std::unique_ptr<Preconditioner<DoubleType>> preconditioner;
+
+  MatrixCache<DoubleType> &mcache = MatrixCache<DoubleType>::GetInstance();
+  const std::string matrix_key = GetMatrixKey(itermethod);
+  mcache.Take(matrix_key, matrix, preconditioner);
+
+  if (!matrix || !preconditioner || !preconditioner->IsFactored())
+  {
+    mcache.Store(matrix_key, matrix, preconditioner);
+    return false;
+  }
+
+  if (nk.HaveNodes())
+  {
+    nk.InitializeSolution("dcop");
+  }
+
+  permvec_t permvec(numeqns);
+  for (size_t i = 0; i < permvec.size(); ++i)
+  {
+    permvec[i] = i;
+  }
+
+  //// The residual at the old solution with the new boundary conditions,
+  //// the matrix holding the factored jacobian is left untouched
+  std::vector<DoubleType> rhs(numeqns);
+  LoadMatrixAndRHS(*matrix, rhs, permvec, dsMathEnum::WhatToLoad::PERMUTATIONSONLY, dsMathEnum::TimeMode::DC, static_cast<DoubleType>(1.0));
+  LoadMatrixAndRHS(*matrix, rhs, permvec, dsMathEnum::WhatToLoad::RHS, dsMathEnum::TimeMode::DC, static_cast<DoubleType>(1.0));
+
+  std::vector<DoubleType> result(numeqns);
+  const bool solveok = preconditioner->LUSolve(result, rhs);
+
+  mcache.Store(matrix_key, matrix, preconditioner);
+
+  if (!solveok)
+  {
+    return false;
+  }
+
+  GlobalData::DeviceList_t::const_iterator dit  = dlist.begin();
+  GlobalData::DeviceList_t::const_iterator dend = dlist.end();
+  for ( ; dit != dend; ++dit)
+  {
+    Device *dev =      (dit->second);
+    dev->Update(result);
+  }
+
+  if (nk.HaveNodes())
+  {
+    CallUpdateSolution(nk, "dcop", result);
+    nk.TriggerCallbacksOnNodes();
+  }
+
+  return true;
+}
+
 template <typename DoubleType>
 void Newton<DoubleType>::PrintNumberEquations(size_t numeqns, ObjectHolderMap_t *ohm)
 {
@@ -1046,7 +1264,7 @@ bool Newton<DoubleType>::ACSolve(LinearSolver<DoubleType> &itermethod, DoubleTyp
 
 
   std::unique_ptr<Matrix<DoubleType>> matrix(new CompressedMatrix<DoubleType>(numeqns, MatrixType::COMPLEX, CompressionType::CCM));
-  std::unique_ptr<Preconditioner<DoubleType>> preconditioner(CreateACPreconditioner<DoubleType>(PEnum::TransposeType_t::NOTRANS, numeqns));
+  std::unique_ptr<Preconditioner<DoubleType>> preconditioner(itermethod.CreateACPreconditioner(PEnum::TransposeType_t::NOTRANS, numeqns));
 
   std::vector<std::complex<DoubleType>> rhs(numeqns);
 
@@ -1188,7 +1406,7 @@ bool Newton<DoubleType>::NoiseSolve(const std::string &output_name, LinearSolver
 
 
   std::unique_ptr<Matrix<DoubleType>> matrix(new CompressedMatrix<DoubleType>(numeqns, MatrixType::COMPLEX, CompressionType::CCM));
-  std::unique_ptr<Preconditioner<DoubleType>> preconditioner(CreateACPreconditioner<DoubleType>(PEnum::TransposeType_t::TRANS, numeqns));
+  std::unique_ptr<Preconditioner<DoubleType>> preconditioner(itermethod.CreateACPreconditioner(PEnum::TransposeType_t::TRANS, numeqns));
 
   std::vector<std::complex<DoubleType>> rhs(numeqns);
 
@@ -1252,6 +1470,184 @@ bool Newton<DoubleType>::NoiseSolve(const std::string &output_name, LinearSolver
   return converged;
 }
 
+template <typename DoubleType>
+bool Newton<DoubleType>::ACSolve(LinearSolver<DoubleType> &itermethod, const std::vector<DoubleType> &frequencies, ObjectHolderList_t &results)
+{
+  return FrequencySweep(std::string(), itermethod, frequencies, results);
+}
+
+template <typename DoubleType>
+bool Newton<DoubleType>::NoiseSolve(const std::string &output_name, LinearSolver<DoubleType> &itermethod, const std::vector<DoubleType> &frequencies, ObjectHolderList_t &results)
+{
+  dsAssert(!output_name.empty(), "UNEXPECTED");
+  return FrequencySweep(output_name, itermethod, frequencies, results);
+}
+
+template <typename DoubleType>
+bool Newton<DoubleType>::FrequencySweep(const std::string &output_name, LinearSolver<DoubleType> &itermethod, const std::vector<DoubleType> &frequencies, ObjectHolderList_t &results)
+{
+  NodeKeeper &nk = NodeKeeper::instance();
+  GlobalData &gdata = GlobalData::GetInstance();
+  const GlobalData::DeviceList_t      &dlist = gdata.GetDeviceList();
+
+  const bool is_noise = !output_name.empty();
+
+  const size_t numeqns = NumberEquationsAndSetDimension();
+
+  std::string circuit_real_name("ssac_real");
+  std::string circuit_imag_name("ssac_imag");
+  size_t outputeqnnum = size_t(-1);
+
+  if (is_noise)
+  {
+    if (!nk.HaveNodes())
+    {
+      std::ostringstream os;
+      os << "A circuit is required for a noise solve.\n";
+      OutputStream::WriteOut(OutputStream::OutputType::ERROR, os.str());
+      return false;
+    }
+
+    outputeqnnum = nk.GetEquationNumber(output_name);
+    if (outputeqnnum == size_t(-1))
+    {
+      std::ostringstream os;
+      os << "Circuit output " << output_name << " does not exist.\n";
+      OutputStream::WriteOut(OutputStream::OutputType::ERROR, os.str());
+      return false;
+    }
+
+    circuit_real_name = std::string("noise_") + output_name + "_real";
+    circuit_imag_name = std::string("noise_") + output_name + "_imag";
+  }
+
+  if (nk.HaveNodes())
+  {
+    nk.InitializeSolution(circuit_real_name);
+    nk.InitializeSolution(circuit_imag_name);
+    nk.InitializeSolution("dcop");
+  }
+
+  permvec_t permvec(numeqns);
+  for (size_t i = 0; i < permvec.size(); ++i)
+  {
+    permvec[i] = i;
+  }
+
+  //// The conductance and capacitance entries are the same for every frequency
+  RecordedMatrix<DoubleType> gmatrix(numeqns);
+  RecordedMatrix<DoubleType> cmatrix(numeqns);
+  {
+    std::vector<DoubleType> r(numeqns);
+    LoadMatrixAndRHS(gmatrix, r, permvec, dsMathEnum::WhatToLoad::PERMUTATIONSONLY, dsMathEnum::TimeMode::DC,   static_cast<DoubleType>(1.0));
+    LoadMatrixAndRHS(gmatrix, r, permvec, dsMathEnum::WhatToLoad::MATRIXONLY, dsMathEnum::TimeMode::DC,   static_cast<DoubleType>(1.0));
+    LoadMatrixAndRHS(cmatrix, r, permvec, dsMathEnum::WhatToLoad::MATRIXONLY, dsMathEnum::TimeMode::TIME, static_cast<DoubleType>(1.0));
+  }
+
+  std::vector<std::complex<DoubleType>> rhs(numeqns);
+  if (is_noise)
+  {
+    /// Since the circuit nodes are not permutated, we don't need to permutate the rhs
+    rhs[outputeqnnum] = 1.0;
+  }
+  else
+  {
+    LoadCircuitRHSAC(rhs);
+  }
+
+  /// The pattern is kept between frequencies
+  std::unique_ptr<Matrix<DoubleType>> matrix(new CompressedMatrix<DoubleType>(numeqns, MatrixType::COMPLEX, CompressionType::CCM));
+
+  std::vector<std::complex<DoubleType>> result(numeqns);
+
+  bool converged = true;
+
+  for (size_t i = 0; i < frequencies.size(); ++i)
+  {
+    matrix->ClearMatrix();
+    gmatrix.LoadInto(*matrix, static_cast<DoubleType>(1.0));
+    cmatrix.LoadInto(*matrix, GetJOmega(frequencies[i]));
+    matrix->Finalize();
+
+    //// The pivots from another frequency may not be stable, so each
+    //// frequency is factored from the start
+    std::unique_ptr<Preconditioner<DoubleType>> preconditioner(itermethod.CreateACPreconditioner(is_noise ? PEnum::TransposeType_t::TRANS : PEnum::TransposeType_t::NOTRANS, numeqns));
+
+    std::fill(result.begin(), result.end(), std::complex<DoubleType>(0.0));
+
+    bool solveok = false;
+    if (is_noise)
+    {
+      solveok = itermethod.NoiseSolve(*matrix, *preconditioner, result, rhs);
+    }
+    else
+    {
+      solveok = itermethod.ACSolve(*matrix, *preconditioner, result, rhs);
+    }
+
+    if (!solveok)
+    {
+      converged = false;
+      break;
+    }
+
+    ObjectHolderMap_t point;
+    point["frequency"] = ObjectHolder(static_cast<double>(frequencies[i]));
+    if (nk.HaveNodes())
+    {
+      ObjectHolderMap_t real_map;
+      ObjectHolderMap_t imag_map;
+      const size_t offset = nk.GetMinEquationNumber();
+      const NodeKeeper::NodeTable_t &ntable = nk.getNodeList();
+      for (NodeKeeper::NodeTable_t::const_iterator it = ntable.begin(); it != ntable.end(); ++it)
+      {
+        CircuitNode &cn = *(it->second);
+        if (cn.isGROUND())
+        {
+          continue;
+        }
+        const std::complex<DoubleType> &val = result[cn.GetNumber() + offset];
+        real_map[it->first] = ObjectHolder(static_cast<double>(val.real()));
+        imag_map[it->first] = ObjectHolder(static_cast<double>(val.imag()));
+      }
+      point["real"] = ObjectHolder(real_map);
+      point["imag"] = ObjectHolder(imag_map);
+    }
+    results.push_back(ObjectHolder(point));
+  }
+
+  if (converged && !frequencies.empty())
+  {
+    GlobalData::DeviceList_t::const_iterator dit  = dlist.begin();
+    GlobalData::DeviceList_t::const_iterator dend = dlist.end();
+    for ( ; dit != dend; ++dit)
+    {
+      Device *dev =      (dit->second);
+      if (is_noise)
+      {
+        dev->NoiseUpdate(output_name, permvec, result);
+      }
+      else
+      {
+        dev->ACUpdate(result);
+      }
+    }
+
+    if (nk.HaveNodes())
+    {
+      CallACUpdateSolution(nk, circuit_real_name, circuit_imag_name, result);
+    }
+
+    std::ostringstream os;
+    os << (is_noise ? "Noise" : "AC") << " Sweep:\n";
+    os << "number of equations " << numeqns << "\n";
+    os << "number of frequencies " << frequencies.size() << "\n";
+    OutputStream::WriteOut(OutputStream::OutputType::INFO, os.str());
+  }
+
+  return converged;
+}
+
 template <typename DoubleType>
 void Newton<DoubleType>::AssembleTclEquations(RealRowColValueVec<DoubleType> &mat, RHSEntryVec<DoubleType> &rhs, dsMathEnum::WhatToLoad w, dsMathEnum::TimeMode t)
 {
@@ -24,9 +24,11 @@ limitations under the License.
 #include <vector>
 #include <complex>
 #include <map>
+#include <string>
 
 class ObjectHolder;
 typedef std::map<std::string, ObjectHolder> ObjectHolderMap_t;
+typedef std::vector<ObjectHolder> ObjectHolderList_t;
 
 class Device;
 /// This is the outer nonlinear solver
@@ -166,6 +168,22 @@ class Newton {
         bool ACSolve(LinearSolver<DoubleType> &, DoubleType);
 
         bool NoiseSolve(const std::string &, LinearSolver<DoubleType> &, DoubleType);
+
+        /// Solves for each of the frequencies, with the matrix assembled once.
+        /// Appends the circuit node solution for each frequency to the list,
+        /// the device and circuit solutions are left at the last frequency.
+        bool ACSolve(LinearSolver<DoubleType> &, const std::vector<DoubleType> &, ObjectHolderList_t &);
+
+        bool NoiseSolve(const std::string &, LinearSolver<DoubleType> &, const std::vector<DoubleType> &, ObjectHolderList_t &);
+
+        /// First order predictor after a change in the boundary conditions.
+        /// Solves with the factorization kept from the last dc solve using a
+        /// direct solver, returns false if there is none to use.
+        bool Predict(LinearSolver<DoubleType> &);
+
+        /// Copies of the solutions under the given suffix
+        void BackupSolutions(const std::string &);
+        void RestoreSolutions(const std::string &);
         //Newton(LinearSolver<DoubleType> &iterator);
         void SetAbsError(DoubleType x)
         {
@@ -204,8 +222,10 @@ class Newton {
 
         size_t NumberEquationsAndSetDimension();
 
-        void BackupSolutions();
-        void RestoreSolutions();
+        std::string GetMatrixKey(LinearSolver<DoubleType> &) const;
+
+        /// Reloads the jacobian for a matrix free solve
+        class JacobianLoad;
 
         template <typename T>
         void LoadMatrixAndRHS(Matrix<DoubleType> &, std::vector<T> &, permvec_t &, dsMathEnum::WhatToLoad, dsMathEnum::TimeMode, T);
@@ -214,6 +234,9 @@ class Newton {
         void LoadMatrixAndRHSAC(Matrix<DoubleType> &, std::vector<std::complex<DoubleType>> &, permvec_t &, DoubleType);
         void LoadCircuitRHSAC(std::vector<std::complex<DoubleType>> &);
 
+        /// ac or noise (with the output name) solve for many frequencies
+        bool FrequencySweep(const std::string &, LinearSolver<DoubleType> &, const std::vector<DoubleType> &, ObjectHolderList_t &);
+
         void LoadMatrixAndRHSOnCircuit(RealRowColValueVec<DoubleType> &, RHSEntryVec<DoubleType> &rhs, dsMathEnum::WhatToLoad, dsMathEnum::TimeMode);
 
         void AssembleContactsAndInterfaces(RealRowColValueVec<DoubleType> &, RHSEntryVec<DoubleType> &, permvec_t &, Device &, dsMathEnum::WhatToLoad, dsMathEnum::TimeMode);
@@ -237,6 +260,9 @@ class Newton {
 
         size_t dimension;
 
+        /// equation numbering from the last call to NumberEquationsAndSetDimension
+        std::string numberingKey;
+
         static const DoubleType rhssign;
 };
 }
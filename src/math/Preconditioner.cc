@@ -19,6 +19,7 @@ limitations under the License.
 #include "dsAssert.hh"
 #include "Matrix.hh"
 #include "FPECheck.hh"
+#include "PhaseTimer.hh"
 #include "OutputStream.hh"
 namespace dsMath {
 template <typename DoubleType>
@@ -63,6 +64,7 @@ bool Preconditioner<DoubleType>::GetTransposeSolve()
 template <typename DoubleType>
 bool Preconditioner<DoubleType>::LUFactor(Matrix<DoubleType> *mat)
 {
+  PhaseTimerScope timer("lu_factor");
 
   factored = false;
   matrix_ = mat;
@@ -87,6 +89,8 @@ bool Preconditioner<DoubleType>::LUFactor(Matrix<DoubleType> *mat)
 template <typename DoubleType>
 bool Preconditioner<DoubleType>::LUSolve(DoubleVec_t<DoubleType> &x, const DoubleVec_t<DoubleType> &b) const
 {
+  PhaseTimerScope timer("lu_solve");
+
 #ifndef NDEBUG
   dsAssert(factored, "UNEXPECTED");
   dsAssert(static_cast<size_t>(b.size()) == size(), "UNEXPECTED");
@@ -117,6 +121,8 @@ bool Preconditioner<DoubleType>::LUSolve(DoubleVec_t<DoubleType> &x, const Doubl
 template <typename DoubleType>
 bool Preconditioner<DoubleType>::LUSolve(ComplexDoubleVec_t<DoubleType> &x, const ComplexDoubleVec_t<DoubleType> &b) const
 {
+  PhaseTimerScope timer("lu_solve");
+
 #ifndef NDEBUG
   dsAssert(factored, "UNEXPECTED");
   dsAssert(static_cast<size_t>(b.size()) == size(), "UNEXPECTED");
@@ -44,6 +44,9 @@ class Preconditioner {
 
     inline size_t size() const {return size_;}
 
+    /// true when the last LUFactor succeeded
+    inline bool IsFactored() const {return factored;}
+
   protected:
     virtual void DerivedLUSolve(DoubleVec_t<DoubleType> &x, const DoubleVec_t<DoubleType> &b) const =0;
     virtual void DerivedLUSolve(ComplexDoubleVec_t<DoubleType> &x, const ComplexDoubleVec_t<DoubleType> &b) const =0;
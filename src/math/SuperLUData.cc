@@ -21,6 +21,8 @@ limitations under the License.
 #include "dsAssert.hh"
 #include "OutputStream.hh"
 
+#include <sstream>
+
 #include "slu_ddefs.h"
 
 #ifdef DEVSIM_EXTENDED_PRECISION
@@ -61,6 +63,13 @@ SuperLUData::~SuperLUData()
   DeleteStorage();
 }
 
+//// The row permutation and the L/U storage of a successful full factorization
+//// are reused for a matrix with the same pattern
+bool SuperLUData::ReuseRowPermutation(SymbolicStatus_t sstatus) const
+{
+  return (sstatus == SymbolicStatus_t::SAME_SYMBOLIC) && (lutype_ == PEnum::LUType_t::FULL) && perm_c_ && etree_ && perm_r_ && L_ && U_ && (info_ == 0);
+}
+
 template <>
 bool SuperLUData::LUFactorMatrix(CompressedMatrix<double> *cm)
 {
@@ -112,23 +121,29 @@ bool SuperLUData::LUFactorRealMatrix(CompressedMatrix<DoubleType> *cm, const Dou
 
   const int n = numeqns_;
 
+  const bool same_row_perm = ReuseRowPermutation(sstatus);
+
   int *perm_c = perm_c_; /* column permutation vector */
   int *etree  = etree_;  /* column elimination tree */
 
-  if (perm_c_ && (sstatus == SymbolicStatus_t::SAME_SYMBOLIC))
+  if (same_row_perm)
+  {
+    //// L and U storage is reused by the factorization
+  }
+  else if (perm_c_ && (sstatus == SymbolicStatus_t::SAME_SYMBOLIC))
   {
     //// This is so it doesn't get deleted by DeleteStorage
     perm_c_ = NULL;
     etree_  = NULL;
+    DeleteStorage();
   }
   else
   {
     perm_c = intMalloc(n+1);
     etree  = intMalloc(n+1);
+    DeleteStorage();
   }
 
-  DeleteStorage();
-
   const IntVec_t    &Cols = cm->GetCols();
   const IntVec_t    &Rows = cm->GetRows();
 
@@ -176,9 +191,18 @@ bool SuperLUData::LUFactorRealMatrix(CompressedMatrix<DoubleType> *cm, const Dou
 
   dCreate_CompCol_Matrix(&A, n, n, nnz, vals, rows, cols,
                          SLU_NC, SLU_D, SLU_GE);
-  L = (SuperMatrix *) SUPERLU_MALLOC( sizeof(SuperMatrix) );
-  U = (SuperMatrix *) SUPERLU_MALLOC( sizeof(SuperMatrix) );
-  perm_r = intMalloc(n+1);
+  if (same_row_perm)
+  {
+    L = L_;
+    U = U_;
+    perm_r = perm_r_;
+  }
+  else
+  {
+    L = (SuperMatrix *) SUPERLU_MALLOC( sizeof(SuperMatrix) );
+    U = (SuperMatrix *) SUPERLU_MALLOC( sizeof(SuperMatrix) );
+    perm_r = intMalloc(n+1);
+  }
 
   /*
    * Get column permutation vector perm_c[], according to permc_spec:
@@ -192,6 +216,11 @@ bool SuperLUData::LUFactorRealMatrix(CompressedMatrix<DoubleType> *cm, const Dou
     permc_spec = options.ColPerm;
     get_perm_c(permc_spec, &A, perm_c);
   }
+  else if (same_row_perm)
+  {
+    //// previous pivots are kept unless they fail the pivot threshold
+    options.Fact = SamePattern_SameRowPerm;
+  }
   else
   {
     options.Fact = SamePattern;
@@ -262,6 +291,15 @@ bool SuperLUData::LUFactorRealMatrix(CompressedMatrix<DoubleType> *cm, const Dou
   Destroy_CompCol_Permuted(&AC);
   StatFree(&stat);
 
+  if (same_row_perm && (info_ != 0))
+  {
+    std::ostringstream os;
+    os << "Refactoring matrix without previous row permutation\n";
+    OutputStream::WriteOut(OutputStream::OutputType::VERBOSE1, os.str());
+    //// ReuseRowPermutation is false, now that info_ is set
+    return LUFactorRealMatrix(cm, Vals);
+  }
+
   return (info_ == 0);
 }
 
@@ -28,6 +28,8 @@ namespace dsMath {
 template <typename DoubleType>
 class CompressedMatrix;
 
+enum class SymbolicStatus_t;
+
 class SuperLUData {
   public:
     SuperLUData(size_t /*numeqns*/, bool /*transpose*/, PEnum::LUType_t /*lutype*/);
@@ -50,6 +52,8 @@ class SuperLUData {
     template <typename DoubleType>
     bool LUFactorComplexMatrix(CompressedMatrix<DoubleType> *, const ComplexDoubleVec_t<double> &);
 
+    bool ReuseRowPermutation(SymbolicStatus_t) const;
+
   private:    
     int          numeqns_;
     bool         transpose_;
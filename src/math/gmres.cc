@@ -10,6 +10,11 @@ http://math.nist.gov/iml++/gmres.h.txt
 #include <cmath>
 #include <vector>
 #include <complex>
+
+#ifdef DEVSIM_EXTENDED_PRECISION
+#include "Float128.hh"
+#endif
+
 namespace iml
 {
 
@@ -70,6 +75,25 @@ void GeneratePlaneRotation(const std::complex<double> &dx, const std::complex<do
 }
 #endif
 
+#ifdef DEVSIM_EXTENDED_PRECISION
+//// There is no blas routine in extended precision
+void GeneratePlaneRotation(const float128 &dx, const float128 &dy, float128 &cs, float128 &sn)
+{
+  if (dy == 0.0) {
+    cs = 1.0;
+    sn = 0.0;
+  } else if (abs(dy) > abs(dx)) {
+    float128 temp = dx / dy;
+    sn = 1.0 / sqrt( 1.0 + temp*temp );
+    cs = temp * sn;
+  } else {
+    float128 temp = dy / dx;
+    cs = 1.0 / sqrt( 1.0 + temp*temp );
+    sn = temp * cs;
+  }
+}
+#endif
+
 
 template<class Real> 
 void ApplyPlaneRotation(Real &dx, Real &dy, Real &cs, Real &sn)
@@ -185,7 +209,7 @@ class IMLVector {
 };
 
 template <typename T>
-IMLVector<T> operator*(const double x, const IMLVector<T> &v)
+IMLVector<T> operator*(const T &x, const IMLVector<T> &v)
 {
   return v * x;
 }
@@ -206,7 +230,7 @@ T dot(const IMLVector<T> &x, const IMLVector<T> &y)
 template <typename U>
 class IMLPreconditioner {
   public:
-    IMLPreconditioner(const dsMath::Preconditioner<double>& p) : pre_(p) {};
+    IMLPreconditioner(const dsMath::Preconditioner<U>& p) : pre_(p) {};
 
     IMLVector<U> solve(const IMLVector<U> &bv) const
     {
@@ -218,7 +242,7 @@ class IMLPreconditioner {
     }
     
   private:
-    const dsMath::Preconditioner<double> &pre_;
+    const dsMath::Preconditioner<U> &pre_;
 };
 
 #if 0
@@ -245,7 +269,7 @@ T norm(const IMLVector<T> &vec)
 template <typename T>
 class IMLMatrix {
   public:
-    IMLMatrix (const dsMath::Matrix<double> &m) : mat_(m) {}
+    IMLMatrix (const dsMath::Matrix<T> &m) : mat_(m) {}
 
     IMLVector<T> operator*(const IMLVector<T> &x) const
     {
@@ -255,7 +279,7 @@ class IMLMatrix {
     }
 
   private:
-    const dsMath::Matrix<double> &mat_;
+    const dsMath::Matrix<T> &mat_;
 };
 
 
@@ -341,6 +365,19 @@ template int GMRES
     int &,
     int &,
     double &);
+
+#ifdef DEVSIM_EXTENDED_PRECISION
+template int GMRES
+(
+    const iml::IMLMatrix<float128> &,
+    iml::IMLVector<float128> &,
+    const iml::IMLVector<float128> &,
+    const iml::IMLPreconditioner<float128> &,
+    dsMath::DenseMatrix<float128> &,
+    int &,
+    int &,
+    float128 &);
+#endif
 }
 
 //#include <iostream>
@@ -355,5 +392,15 @@ int GMRES(const Matrix<double> &A, DoubleVec_t<double> &x, const DoubleVec_t<dou
   x = ix.GetSTLVector();
   return ret;
 }
-}
 
+#ifdef DEVSIM_EXTENDED_PRECISION
+int GMRES(const Matrix<float128> &A, DoubleVec_t<float128> &x, const DoubleVec_t<float128> &b, const Preconditioner<float128> &M, int &m, int &max_iter, float128 &tol)
+{
+  iml::IMLVector<float128> ix(x);
+  RealDenseMatrix<float128> H(m+1);
+  int ret = GMRES(iml::IMLMatrix<float128>(A), ix, iml::IMLVector<float128>(b), iml::IMLPreconditioner<float128>(M), H, m, max_iter, tol);
+  x = ix.GetSTLVector();
+  return ret;
+}
+#endif
+}
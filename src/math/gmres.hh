@@ -26,12 +26,18 @@ http://math.nist.gov/iml++/gmres.h.txt
 #ifndef IML_GMRES_HH
 #define IML_GMRES_HH
 #include "dsMathTypes.hh"
+#ifdef DEVSIM_EXTENDED_PRECISION
+#include "Float128.hh"
+#endif
 namespace dsMath {
 template <typename DoubleType>
 class Matrix;
 template <typename DoubleType>
 class Preconditioner;
 int GMRES(const Matrix<double> &A, DoubleVec_t<double> &x, const DoubleVec_t<double> &b, const Preconditioner<double> &M, int &m, int &max_iter, double &tol);
+#ifdef DEVSIM_EXTENDED_PRECISION
+int GMRES(const Matrix<float128> &A, DoubleVec_t<float128> &x, const DoubleVec_t<float128> &b, const Preconditioner<float128> &M, int &m, int &max_iter, float128 &tol);
+#endif
 }
 namespace iml {
 template < class Operator, class Vector, class Preconditioner,
@@ -0,0 +1,161 @@
+/***
+DEVSIM
+Copyright 2013 Devsim LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+***/
+
+#include "AsyncWriter.hh"
+#include "mymutex.hh"
+#include "mycondition.hh"
+#include <cstdlib>
+
+AsyncWriteJob::~AsyncWriteJob()
+{
+}
+
+AsyncWriterThread::AsyncWriterThread(AsyncWriter &w, mymutex &m, mycondition &c)
+    : threadBaseClass(m, c), writer(w)
+{
+}
+
+AsyncWriterThread::~AsyncWriterThread()
+{
+}
+
+void AsyncWriterThread::run()
+{
+    writer.ThreadLoop();
+}
+
+AsyncWriter *AsyncWriter::instance_ = 0;
+
+namespace {
+void DestroyAsyncWriter()
+{
+    AsyncWriter::DestroyInstance();
+}
+}
+
+AsyncWriter &AsyncWriter::GetInstance()
+{
+    if (!instance_)
+    {
+        instance_ = new AsyncWriter;
+        std::atexit(DestroyAsyncWriter);
+    }
+    return *instance_;
+}
+
+void AsyncWriter::DestroyInstance()
+{
+    if (instance_)
+    {
+        delete instance_;
+    }
+    instance_ = 0;
+}
+
+AsyncWriter::AsyncWriter() : mutex_(new mymutex), condition_(new mycondition), busy_(false), exit_(false), failed_(false)
+{
+}
+
+//// Pending jobs are written before the thread exits
+AsyncWriter::~AsyncWriter()
+{
+    if (thread_)
+    {
+        mutex_->lock();
+        exit_ = true;
+        condition_->broadcast();
+        mutex_->unlock();
+        thread_->join();
+        thread_.reset();
+    }
+    delete condition_;
+    delete mutex_;
+}
+
+void AsyncWriter::Queue(AsyncWriteJobPtr job)
+{
+    mutex_->lock();
+    if (!thread_)
+    {
+        thread_ = std::unique_ptr<AsyncWriterThread>(new AsyncWriterThread(*this, *mutex_, *condition_));
+        thread_->start();
+    }
+
+    while (jobs_.size() >= max_queued_)
+    {
+        condition_->wait(*mutex_);
+    }
+
+    jobs_.push_back(job);
+    condition_->broadcast();
+    mutex_->unlock();
+}
+
+bool AsyncWriter::WaitForWrites(std::string &errorString)
+{
+    mutex_->lock();
+    while (busy_ || !jobs_.empty())
+    {
+        condition_->wait(*mutex_);
+    }
+
+    const bool ret = !failed_;
+    errorString += errorString_;
+    failed_ = false;
+    errorString_.clear();
+    mutex_->unlock();
+    return ret;
+}
+
+void AsyncWriter::ThreadLoop()
+{
+    mutex_->lock();
+    while (true)
+    {
+        if (!jobs_.empty())
+        {
+            AsyncWriteJobPtr job = jobs_.front();
+            jobs_.pop_front();
+            busy_ = true;
+            //// there is room in the queue again
+            condition_->broadcast();
+            mutex_->unlock();
+
+            std::string errorString;
+            const bool ok = job->Write(errorString);
+            job.reset();
+
+            mutex_->lock();
+            if (!ok)
+            {
+                failed_ = true;
+                errorString_ += errorString;
+            }
+            busy_ = false;
+            condition_->broadcast();
+        }
+        else if (exit_)
+        {
+            break;
+        }
+        else
+        {
+            condition_->wait(*mutex_);
+        }
+    }
+    mutex_->unlock();
+}
@@ -0,0 +1,90 @@
+/***
+DEVSIM
+Copyright 2013 Devsim LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+***/
+
+#ifndef ASYNC_WRITER_HH
+#define ASYNC_WRITER_HH
+#include "threadBaseClass.hh"
+#include <string>
+#include <deque>
+#include <memory>
+
+class mymutex;
+class mycondition;
+
+/// Work handed to the background thread.  It must only use data it owns,
+/// since the device may change while it runs, and it must not write to the
+/// OutputStream.
+class AsyncWriteJob {
+    public:
+        virtual ~AsyncWriteJob() = 0;
+        /// Errors are appended to the string
+        virtual bool Write(std::string &/*errorString*/) = 0;
+};
+
+typedef std::shared_ptr<AsyncWriteJob> AsyncWriteJobPtr;
+
+class AsyncWriter;
+
+class AsyncWriterThread : public threadBaseClass {
+    public:
+        AsyncWriterThread(AsyncWriter &, mymutex &, mycondition &);
+        ~AsyncWriterThread();
+        void run();
+    private:
+        AsyncWriter &writer;
+};
+
+/// Writes files on one background thread, in the order they were queued.
+/// The thread is started for the first job, and the pending jobs are
+/// finished by DestroyInstance, which is also registered with atexit.
+class AsyncWriter
+{
+    public:
+        static AsyncWriter &GetInstance();
+        static void DestroyInstance();
+
+        /// Blocks while the queue is full
+        void Queue(AsyncWriteJobPtr);
+
+        /// Blocks until all of the jobs are written.  Returns false when
+        /// any of them failed since the last call, with their errors.
+        bool WaitForWrites(std::string &/*errorString*/);
+
+        /// Called by the background thread
+        void ThreadLoop();
+
+    private:
+        AsyncWriter();
+        AsyncWriter(AsyncWriter &);
+        AsyncWriter &operator=(AsyncWriter &);
+        ~AsyncWriter();
+
+        static AsyncWriter *instance_;
+
+        /// the job being written is not counted
+        static const size_t max_queued_ = 2;
+
+        mymutex                      *mutex_;
+        mycondition                  *condition_;
+        std::unique_ptr<AsyncWriterThread> thread_;
+        std::deque<AsyncWriteJobPtr>  jobs_;
+        bool                          busy_;
+        bool                          exit_;
+        bool                          failed_;
+        std::string                   errorString_;
+};
+#endif
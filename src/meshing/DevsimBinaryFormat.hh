@@ -0,0 +1,69 @@
+/***
+DEVSIM
+Copyright 2013 Devsim LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+***/
+
+#ifndef DEVSIM_BINARY_FORMAT_HH
+#define DEVSIM_BINARY_FORMAT_HH
+#include <cstdint>
+#include <cstddef>
+
+//// Layout of the binary restart files written by DevsimBinaryWriter.
+////
+//// The file starts with a FileHeader and ends with the section table.
+//// The "skeleton" section is a restart file in the text format, which
+//// has the coordinates, the element lists and the values of the DATA
+//// models removed.  These are stored as columns in their own sections,
+//// each starting on a block_alignment boundary, so the loader can use them
+//// in place from a memory mapped file.
+////
+//// Column sections are named from the device, the region, contact or
+//// interface, and the model, e.g. "device/region/node_model/Potential".
+//// Interface node models are only kept as commands in the skeleton.
+//// Everything is written in the byte order of the machine writing the file.
+namespace dsDevsimBinary {
+static const char     magic[8]        = {'D', 'E', 'V', 'S', 'I', 'M', 'B', '\n'};
+static const uint32_t version         = 1;
+static const uint32_t byte_order_mark = 0x01020304;
+static const uint64_t block_alignment = 64;
+
+enum class SectionType : uint32_t {TEXT = 1, FLOAT64 = 2, INDEX64 = 3};
+
+struct FileHeader {
+  char     magic[8];
+  uint32_t version;
+  uint32_t byte_order;
+  uint64_t section_count;
+  /// offset of the section table from the start of the file
+  uint64_t table_offset;
+};
+
+//// In the section table, each entry is followed by name_length characters,
+//// padded with zeros to a multiple of 8 bytes
+struct SectionEntry {
+  uint32_t type;
+  uint32_t name_length;
+  /// number of characters, doubles or indexes
+  uint64_t count;
+  uint64_t offset;
+};
+
+inline uint64_t Align(uint64_t x, uint64_t a)
+{
+  return ((x + a - 1) / a) * a;
+}
+}
+#endif
+
@@ -0,0 +1,332 @@
+/***
+DEVSIM
+Copyright 2013 Devsim LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+***/
+
+#include "DevsimBinaryReader.hh"
+#include "DevsimLoader.hh"
+#include "MeshLoaderStructs.hh"
+#include <fstream>
+#include <sstream>
+#include <cstring>
+
+namespace dsDevsimBinary {
+BinaryFile::BinaryFile() : data_(NULL), size_(0)
+{
+}
+
+BinaryFile::~BinaryFile()
+{
+  Close();
+}
+
+void BinaryFile::Close()
+{
+  file_.Close();
+  data_ = NULL;
+  size_ = 0;
+  sections_.clear();
+}
+
+bool BinaryFile::IsBinaryFile(const std::string &filename)
+{
+  char buf[sizeof(magic)];
+  std::ifstream myfile(filename.c_str(), std::ios::in | std::ios::binary);
+  return myfile.read(buf, sizeof(buf)) && (std::memcmp(buf, magic, sizeof(magic)) == 0);
+}
+
+bool BinaryFile::Open(const std::string &filename, std::string &errorString)
+{
+  std::ostringstream os;
+
+  Close();
+
+  if (!file_.Open(filename, errorString))
+  {
+    return false;
+  }
+  data_ = file_.GetData();
+  size_ = file_.GetSize();
+
+  FileHeader header = FileHeader();
+  if (size_ < sizeof(header))
+  {
+    os << "File " << filename << " is too short for a binary restart file\n";
+  }
+  else
+  {
+    std::memcpy(&header, data_, sizeof(header));
+    if (std::memcmp(header.magic, magic, sizeof(magic)) != 0)
+    {
+      os << "File " << filename << " is not a binary restart file\n";
+    }
+    else if (header.byte_order != byte_order_mark)
+    {
+      os << "File " << filename << " was written on a machine with a different byte order\n";
+    }
+    else if (header.version != version)
+    {
+      os << "File " << filename << " has binary restart version " << header.version << ", expected version " << version << "\n";
+    }
+  }
+
+  uint64_t offset = header.table_offset;
+  for (uint64_t i = 0; os.str().empty() && (i < header.section_count); ++i)
+  {
+    SectionEntry entry;
+    if ((offset + sizeof(entry)) > size_)
+    {
+      os << "File " << filename << " has a truncated section table\n";
+      break;
+    }
+    std::memcpy(&entry, data_ + offset, sizeof(entry));
+    offset += sizeof(entry);
+
+    if ((offset + entry.name_length) > size_)
+    {
+      os << "File " << filename << " has a truncated section table\n";
+      break;
+    }
+    const std::string name(data_ + offset, entry.name_length);
+    offset = Align(offset + entry.name_length, 8);
+
+    uint64_t width = 1;
+    if (entry.type == static_cast<uint32_t>(SectionType::FLOAT64))
+    {
+      width = sizeof(double);
+    }
+    else if (entry.type == static_cast<uint32_t>(SectionType::INDEX64))
+    {
+      width = sizeof(uint64_t);
+    }
+
+    if ((entry.offset > size_) || (entry.count > ((size_ - entry.offset) / width)))
+    {
+      os << "File " << filename << " has a truncated section " << name << "\n";
+    }
+    else
+    {
+      sections_[name] = entry;
+    }
+  }
+
+  if (!os.str().empty())
+  {
+    Close();
+    errorString += os.str();
+    return false;
+  }
+  return true;
+}
+
+const char *BinaryFile::GetSection(const std::string &name, SectionType type, size_t &count) const
+{
+  const char *ret = NULL;
+  count = 0;
+
+  std::map<std::string, SectionEntry>::const_iterator it = sections_.find(name);
+  if ((it != sections_.end()) && (it->second.type == static_cast<uint32_t>(type)))
+  {
+    ret   = data_ + it->second.offset;
+    count = it->second.count;
+  }
+  return ret;
+}
+
+const char *BinaryFile::GetText(const std::string &name, size_t &count) const
+{
+  return GetSection(name, SectionType::TEXT, count);
+}
+
+const double *BinaryFile::GetDoubles(const std::string &name, size_t &count) const
+{
+  return reinterpret_cast<const double *>(GetSection(name, SectionType::FLOAT64, count));
+}
+
+const uint64_t *BinaryFile::GetIndexes(const std::string &name, size_t &count) const
+{
+  return reinterpret_cast<const uint64_t *>(GetSection(name, SectionType::INDEX64, count));
+}
+
+namespace {
+//// Sections of element lists are optional, but must have whole elements
+const uint64_t *GetElements(const BinaryFile &bfile, const std::string &name, size_t width, size_t &count, std::string &errorString)
+{
+  const uint64_t *ret = bfile.GetIndexes(name, count);
+  if (count % width)
+  {
+    std::ostringstream os;
+    os << "Section " << name << " has " << count << " indexes, which is not a multiple of " << width << "\n";
+    errorString += os.str();
+    ret = NULL;
+  }
+  count /= width;
+  return ret;
+}
+
+const char *ModelSectionName(dsMesh::Solution::ModelType mt)
+{
+  const char *ret = NULL;
+  if (mt == dsMesh::Solution::ModelType::NODE)
+  {
+    ret = "node_model/";
+  }
+  else if (mt == dsMesh::Solution::ModelType::EDGE)
+  {
+    ret = "edge_model/";
+  }
+  else if (mt == dsMesh::Solution::ModelType::TRIANGLEEDGE)
+  {
+    ret = "triangle_edge_model/";
+  }
+  else if (mt == dsMesh::Solution::ModelType::TETRAHEDRONEDGE)
+  {
+    ret = "tetrahedron_edge_model/";
+  }
+  return ret;
+}
+}
+
+bool ReadCoordinates(const BinaryFile &bfile, dsMesh::DevsimLoader &loader, std::string &errorString)
+{
+  const std::string name = loader.GetName() + "/coordinates";
+  size_t count = 0;
+  const double *p = bfile.GetDoubles(name, count);
+  if (!p || (count % 3))
+  {
+    errorString += "Missing or invalid section " + name + "\n";
+    return false;
+  }
+
+  std::vector<dsMesh::MeshCoordinate> coordinates;
+  coordinates.reserve(count / 3);
+  for (size_t i = 0; i < count; i += 3)
+  {
+    coordinates.push_back(dsMesh::MeshCoordinate(p[i], p[i + 1], p[i + 2]));
+  }
+  loader.AddCoordinates(coordinates);
+  return true;
+}
+
+bool ReadRegion(const BinaryFile &bfile, const std::string &deviceName, dsMesh::MeshRegion &region, std::string &errorString)
+{
+  const std::string prefix = deviceName + "/region/" + region.GetName() + "/";
+  const size_t errorSize = errorString.size();
+
+  size_t count = 0;
+  const uint64_t *p = GetElements(bfile, prefix + "nodes", 1, count, errorString);
+  for (size_t i = 0; p && (i < count); ++i)
+  {
+    region.AddNode(dsMesh::MeshNode(p[i]));
+  }
+
+  p = GetElements(bfile, prefix + "edges", 2, count, errorString);
+  for (size_t i = 0; p && (i < count); ++i, p += 2)
+  {
+    region.AddEdge(dsMesh::MeshEdge(p[0], p[1]));
+  }
+
+  p = GetElements(bfile, prefix + "triangles", 3, count, errorString);
+  for (size_t i = 0; p && (i < count); ++i, p += 3)
+  {
+    region.AddTriangle(dsMesh::MeshTriangle(p[0], p[1], p[2]));
+  }
+
+  p = GetElements(bfile, prefix + "tetrahedra", 4, count, errorString);
+  for (size_t i = 0; p && (i < count); ++i, p += 4)
+  {
+    region.AddTetrahedron(dsMesh::MeshTetrahedron(p[0], p[1], p[2], p[3]));
+  }
+
+  const dsMesh::MeshSolutionList_t &slist = region.GetSolutionList();
+  for (dsMesh::MeshSolutionList_t::const_iterator sit = slist.begin(); sit != slist.end(); ++sit)
+  {
+    dsMesh::Solution &sol = *(sit->second);
+    const char *model_section = ModelSectionName(sol.GetModelType());
+    if ((sol.GetDataType() != dsMesh::Solution::DataType::DATA) || sol.HasValues() || !model_section)
+    {
+      continue;
+    }
+
+    const std::string name = prefix + model_section + sit->first;
+    const double *v = bfile.GetDoubles(name, count);
+    if (!v)
+    {
+      errorString += "Missing section " + name + "\n";
+    }
+    else
+    {
+      sol.SetValues(v, v + count);
+    }
+  }
+
+  return errorString.size() == errorSize;
+}
+
+bool ReadContact(const BinaryFile &bfile, const std::string &deviceName, dsMesh::MeshContact &contact, std::string &errorString)
+{
+  const std::string prefix = deviceName + "/contact/" + contact.GetName() + "/";
+  const size_t errorSize = errorString.size();
+
+  size_t count = 0;
+  const uint64_t *p = GetElements(bfile, prefix + "nodes", 1, count, errorString);
+  for (size_t i = 0; p && (i < count); ++i)
+  {
+    contact.AddNode(dsMesh::MeshNode(p[i]));
+  }
+
+  p = GetElements(bfile, prefix + "edges", 2, count, errorString);
+  for (size_t i = 0; p && (i < count); ++i, p += 2)
+  {
+    contact.AddEdge(dsMesh::MeshEdge(p[0], p[1]));
+  }
+
+  p = GetElements(bfile, prefix + "triangles", 3, count, errorString);
+  for (size_t i = 0; p && (i < count); ++i, p += 3)
+  {
+    contact.AddTriangle(dsMesh::MeshTriangle(p[0], p[1], p[2]));
+  }
+
+  return errorString.size() == errorSize;
+}
+
+bool ReadInterface(const BinaryFile &bfile, const std::string &deviceName, dsMesh::MeshInterface &minterface, std::string &errorString)
+{
+  const std::string prefix = deviceName + "/interface/" + minterface.GetName() + "/";
+  const size_t errorSize = errorString.size();
+
+  size_t count = 0;
+  const uint64_t *p = GetElements(bfile, prefix + "nodes", 2, count, errorString);
+  for (size_t i = 0; p && (i < count); ++i, p += 2)
+  {
+    minterface.AddNodePair(dsMesh::MeshInterfaceNodePair(p[0], p[1]));
+  }
+
+  p = GetElements(bfile, prefix + "edges", 4, count, errorString);
+  for (size_t i = 0; p && (i < count); ++i, p += 4)
+  {
+    minterface.AddEdgePair(dsMesh::MeshEdge(p[0], p[1]), dsMesh::MeshEdge(p[2], p[3]));
+  }
+
+  p = GetElements(bfile, prefix + "triangles", 6, count, errorString);
+  for (size_t i = 0; p && (i < count); ++i, p += 6)
+  {
+    minterface.AddTrianglePair(dsMesh::MeshTriangle(p[0], p[1], p[2]), dsMesh::MeshTriangle(p[3], p[4], p[5]));
+  }
+
+  return errorString.size() == errorSize;
+}
+}
+
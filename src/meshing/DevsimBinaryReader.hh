@@ -0,0 +1,73 @@
+/***
+DEVSIM
+Copyright 2013 Devsim LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+***/
+
+#ifndef DEVSIM_BINARY_READER_HH
+#define DEVSIM_BINARY_READER_HH
+#include "DevsimBinaryFormat.hh"
+#include "MappedFile.hh"
+#include <string>
+#include <vector>
+#include <map>
+#include <cstddef>
+
+namespace dsMesh {
+class DevsimLoader;
+class MeshRegion;
+class MeshContact;
+class MeshInterface;
+}
+
+namespace dsDevsimBinary {
+//// Read only view of a binary restart file.  The file is memory mapped, so
+//// only the pages of the sections actually used are read from disk.
+class BinaryFile {
+  public:
+    BinaryFile();
+    ~BinaryFile();
+
+    /// Checks the magic number at the start of the file
+    static bool IsBinaryFile(const std::string &/*filename*/);
+
+    bool Open(const std::string &/*filename*/, std::string &/*errorString*/);
+
+    /// These return NULL if the section does not exist with the requested type
+    const char     *GetText(const std::string &, size_t &/*count*/) const;
+    const double   *GetDoubles(const std::string &, size_t &/*count*/) const;
+    const uint64_t *GetIndexes(const std::string &, size_t &/*count*/) const;
+
+  private:
+    BinaryFile(const BinaryFile &);
+    BinaryFile &operator=(const BinaryFile &);
+
+    const char *GetSection(const std::string &, SectionType, size_t &) const;
+    void Close();
+
+    dsUtility::MappedFile file_;
+    const char        *data_;
+    size_t             size_;
+    std::map<std::string, SectionEntry> sections_;
+};
+
+//// Called by the parser when the corresponding section of the skeleton is
+//// complete, to add the data stored in columns
+bool ReadCoordinates(const BinaryFile &, dsMesh::DevsimLoader &, std::string &/*errorString*/);
+bool ReadRegion(const BinaryFile &, const std::string &/*deviceName*/, dsMesh::MeshRegion &, std::string &/*errorString*/);
+bool ReadContact(const BinaryFile &, const std::string &/*deviceName*/, dsMesh::MeshContact &, std::string &/*errorString*/);
+bool ReadInterface(const BinaryFile &, const std::string &/*deviceName*/, dsMesh::MeshInterface &, std::string &/*errorString*/);
+}
+#endif
+
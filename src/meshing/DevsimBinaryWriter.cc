@@ -0,0 +1,450 @@
+/***
+DEVSIM
+Copyright 2013 Devsim LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+***/
+
+#include "DevsimBinaryWriter.hh"
+#include "DevsimBinaryFormat.hh"
+#include "GlobalData.hh"
+#include "Device.hh"
+#include "Coordinate.hh"
+#include "Region.hh"
+#include "Node.hh"
+#include "Edge.hh"
+#include "Triangle.hh"
+#include "Tetrahedron.hh"
+#include "Contact.hh"
+#include "Interface.hh"
+#include "NodeModel.hh"
+#include "EdgeModel.hh"
+#include "TriangleEdgeModel.hh"
+#include "TetrahedronEdgeModel.hh"
+#include "dsAssert.hh"
+#include "InterfaceNodeModel.hh"
+#include "EquationHolder.hh"
+#include "ContactEquationHolder.hh"
+#include "InterfaceEquationHolder.hh"
+#include <sstream>
+#include <fstream>
+#include <iomanip>
+#include <cstring>
+
+namespace {
+typedef std::vector<uint64_t> IndexColumn_t;
+
+//// Writes each section on a block boundary and keeps track of the section table
+class SectionWriter {
+  public:
+    SectionWriter(std::ostream &o) : out_(o), offset_(sizeof(dsDevsimBinary::FileHeader))
+    {
+      dsDevsimBinary::FileHeader header;
+      std::memset(&header, 0, sizeof(header));
+      out_.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    }
+
+    void WriteIndexes(const std::string &name, const IndexColumn_t &v)
+    {
+      WriteSection(name, dsDevsimBinary::SectionType::INDEX64, reinterpret_cast<const char *>(v.data()), v.size() * sizeof(uint64_t), v.size());
+    }
+
+    void WriteDoubles(const std::string &name, const std::vector<double> &v)
+    {
+      WriteSection(name, dsDevsimBinary::SectionType::FLOAT64, reinterpret_cast<const char *>(v.data()), v.size() * sizeof(double), v.size());
+    }
+
+    void WriteText(const std::string &name, const std::string &v)
+    {
+      WriteSection(name, dsDevsimBinary::SectionType::TEXT, v.data(), v.size(), v.size());
+    }
+
+    void Finish();
+
+  private:
+    void Pad(uint64_t);
+    void WriteSection(const std::string &, dsDevsimBinary::SectionType, const char *, size_t, size_t);
+
+    struct Entry {
+      dsDevsimBinary::SectionEntry entry;
+      std::string                  name;
+    };
+
+    std::ostream       &out_;
+    uint64_t            offset_;
+    std::vector<Entry>  entries_;
+};
+
+void SectionWriter::Pad(uint64_t alignment)
+{
+  const uint64_t aligned = dsDevsimBinary::Align(offset_, alignment);
+  static const char zeros[dsDevsimBinary::block_alignment] = {0};
+  out_.write(zeros, aligned - offset_);
+  offset_ = aligned;
+}
+
+void SectionWriter::WriteSection(const std::string &name, dsDevsimBinary::SectionType type, const char *data, size_t bytes, size_t count)
+{
+  Pad(dsDevsimBinary::block_alignment);
+
+  Entry e;
+  e.entry.type        = static_cast<uint32_t>(type);
+  e.entry.name_length = name.size();
+  e.entry.count       = count;
+  e.entry.offset      = offset_;
+  e.name              = name;
+  entries_.push_back(e);
+
+  out_.write(data, bytes);
+  offset_ += bytes;
+}
+
+void SectionWriter::Finish()
+{
+  Pad(8);
+
+  dsDevsimBinary::FileHeader header;
+  std::memcpy(header.magic, dsDevsimBinary::magic, sizeof(header.magic));
+  header.version       = dsDevsimBinary::version;
+  header.byte_order    = dsDevsimBinary::byte_order_mark;
+  header.section_count = entries_.size();
+  header.table_offset  = offset_;
+
+  for (std::vector<Entry>::const_iterator it = entries_.begin(); it != entries_.end(); ++it)
+  {
+    out_.write(reinterpret_cast<const char *>(&(it->entry)), sizeof(it->entry));
+    offset_ += sizeof(it->entry);
+    out_.write(it->name.data(), it->name.size());
+    offset_ += it->name.size();
+    Pad(8);
+  }
+
+  out_.seekp(0);
+  out_.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  out_.flush();
+}
+
+void WriteCoordinates(SectionWriter &sections, const std::string &prefix, const Device::CoordinateList_t &clist)
+{
+  std::vector<double> v;
+  v.reserve(3 * clist.size());
+  for (Device::CoordinateList_t::const_iterator cit = clist.begin(); cit != clist.end(); ++cit)
+  {
+    const Vector<double> &pos = (*cit)->Position();
+    v.push_back(pos.Getx());
+    v.push_back(pos.Gety());
+    v.push_back(pos.Getz());
+  }
+  sections.WriteDoubles(prefix + "coordinates", v);
+}
+
+void WriteNodes(SectionWriter &sections, const std::string &prefix, const ConstNodeList &nlist)
+{
+  IndexColumn_t v;
+  v.reserve(nlist.size());
+  for (ConstNodeList::const_iterator nit = nlist.begin(); nit != nlist.end(); ++nit)
+  {
+    v.push_back((*nit)->GetCoordinate().GetIndex());
+  }
+  sections.WriteIndexes(prefix + "nodes", v);
+}
+
+//// Writes the node indexes of each element in the list
+template <typename T>
+void WriteElements(SectionWriter &sections, const std::string &name, const std::vector<T> &elist)
+{
+  if (elist.empty())
+  {
+    return;
+  }
+
+  const size_t num_nodes = elist[0]->GetNodeList().size();
+  IndexColumn_t v;
+  v.reserve(num_nodes * elist.size());
+  for (typename std::vector<T>::const_iterator eit = elist.begin(); eit != elist.end(); ++eit)
+  {
+    const ConstNodeList &nlist = (*eit)->GetNodeList();
+    for (size_t i = 0; i < num_nodes; ++i)
+    {
+      v.push_back(nlist[i]->GetIndex());
+    }
+  }
+  sections.WriteIndexes(name, v);
+}
+
+//// Interface elements are written as the nodes of region0, followed by the nodes of region1
+template <typename T>
+void WriteElementPairs(SectionWriter &sections, const std::string &name, const std::vector<T> &elist0, const std::vector<T> &elist1)
+{
+  if (elist0.empty() || (elist0.size() != elist1.size()))
+  {
+    return;
+  }
+
+  const size_t num_nodes = elist0[0]->GetNodeList().size();
+  IndexColumn_t v;
+  v.reserve(2 * num_nodes * elist0.size());
+  for (size_t i = 0; i < elist0.size(); ++i)
+  {
+    const ConstNodeList &nlist0 = elist0[i]->GetNodeList();
+    const ConstNodeList &nlist1 = elist1[i]->GetNodeList();
+    for (size_t j = 0; j < num_nodes; ++j)
+    {
+      v.push_back(nlist0[j]->GetIndex());
+    }
+    for (size_t j = 0; j < num_nodes; ++j)
+    {
+      v.push_back(nlist1[j]->GetIndex());
+    }
+  }
+  sections.WriteIndexes(name, v);
+}
+
+//// Models serialized as DATA keep the empty DATA keyword in the skeleton,
+//// while their values go to a column, so they are never formatted as text.
+//// Everything else is copied verbatim.
+template <typename T>
+void WriteModels(std::ostream &skeleton, SectionWriter &sections, const std::string &kind, const std::string &prefix, const T &mlist)
+{
+  for (typename T::const_iterator nit = mlist.begin(); nit != mlist.end(); ++nit)
+  {
+    if ((nit->second)->IsSerializedAsData())
+    {
+      skeleton << "begin_" << kind << " \"" << nit->first << "\"\nDATA\nend_" << kind << "\n\n";
+      sections.WriteDoubles(prefix + kind + "/" + nit->first, (nit->second)->template GetScalarValues<double>());
+    }
+    else
+    {
+      (nit->second)->DevsimSerialize(skeleton);
+    }
+  }
+}
+
+//// Interface node models are only serialized as commands, and the text
+//// format has no DATA section for them, so they are copied verbatim
+template <typename T>
+void WriteCommandModels(std::ostream &skeleton, const T &mlist)
+{
+  for (typename T::const_iterator nit = mlist.begin(); nit != mlist.end(); ++nit)
+  {
+    (nit->second)->DevsimSerialize(skeleton);
+  }
+}
+
+template <typename T>
+void WriteEquations(std::ostream &skeleton, const T &eqlist)
+{
+  for (typename T::const_iterator eit = eqlist.begin(); eit != eqlist.end(); ++eit)
+  {
+    (eit->second).DevsimSerialize(skeleton);
+  }
+}
+
+bool WriteSingleDevice(const std::string &dname, std::ostream &skeleton, SectionWriter &sections, std::string &errorString)
+{
+  bool ret = true;
+  std::ostringstream os;
+
+  GlobalData   &gdata = GlobalData::GetInstance();
+
+  DevicePtr dp = gdata.GetDevice(dname);
+
+  if (!dp)
+  {
+    ret = false;
+    os << "ERROR: Device \"" << dname << "\" does not exist\n";
+  }
+  else
+  {
+    Device &dev = *dp;
+    const size_t dimension = dev.GetDimension();
+    const std::string device_prefix = dname + "/";
+
+    skeleton << "begin_device \"" << dname << "\"\n";
+
+    WriteCoordinates(sections, device_prefix, dev.GetCoordinateList());
+    skeleton << "begin_coordinates\nend_coordinates\n\n";
+
+    const Device::RegionList_t &rlist = dev.GetRegionList();
+    for (Device::RegionList_t::const_iterator rit = rlist.begin(); rit != rlist.end(); ++rit)
+    {
+      const std::string &rname = rit->first;
+      const Region      &reg   = *(rit->second);
+      const std::string  prefix = device_prefix + "region/" + rname + "/";
+
+      skeleton << "begin_region \"" << rname << "\" \"" << reg.GetMaterialName() << "\"\n";
+
+      WriteNodes(sections, prefix, reg.GetNodeList());
+
+      if (dimension == 1)
+      {
+        WriteElements(sections, prefix + "edges", reg.GetEdgeList());
+      }
+      else if (dimension == 2)
+      {
+        WriteElements(sections, prefix + "triangles", reg.GetTriangleList());
+      }
+      else if (dimension == 3)
+      {
+        WriteElements(sections, prefix + "tetrahedra", reg.GetTetrahedronList());
+      }
+
+      WriteModels(skeleton, sections, "node_model", prefix, reg.GetNodeModelList());
+      WriteModels(skeleton, sections, "edge_model", prefix, reg.GetEdgeModelList());
+      WriteModels(skeleton, sections, "triangle_edge_model", prefix, reg.GetTriangleEdgeModelList());
+      WriteModels(skeleton, sections, "tetrahedron_edge_model", prefix, reg.GetTetrahedronEdgeModelList());
+
+      WriteEquations(skeleton, reg.GetEquationPtrList());
+
+      skeleton << "end_region\n\n";
+    }
+
+    const Device::ContactList_t &ctlist = dev.GetContactList();
+    for (Device::ContactList_t::const_iterator cit = ctlist.begin(); cit != ctlist.end(); ++cit)
+    {
+      const std::string &cname = cit->first;
+      const Contact     &cnt   = *(cit->second);
+      const std::string  prefix = device_prefix + "contact/" + cname + "/";
+
+      skeleton << "begin_contact \"" << cname << "\" \"" << cnt.GetRegion()->GetName() << "\" \"" << cnt.GetMaterialName() << "\"\n";
+
+      if (dimension == 1)
+      {
+        const ConstNodeList_t &ctnodes = cnt.GetNodes();
+        IndexColumn_t v;
+        v.reserve(ctnodes.size());
+        for (ConstNodeList_t::const_iterator ctit = ctnodes.begin(); ctit != ctnodes.end(); ++ctit)
+        {
+          v.push_back((*ctit)->GetIndex());
+        }
+        sections.WriteIndexes(prefix + "nodes", v);
+      }
+      else if (dimension == 2)
+      {
+        WriteElements(sections, prefix + "edges", cnt.GetEdges());
+      }
+      else if (dimension == 3)
+      {
+        WriteElements(sections, prefix + "triangles", cnt.GetTriangles());
+      }
+
+      WriteEquations(skeleton, cnt.GetEquationPtrList());
+
+      skeleton << "end_contact\n\n";
+    }
+
+    const Device::InterfaceList_t &itlist = dev.GetInterfaceList();
+    for (Device::InterfaceList_t::const_iterator iit = itlist.begin(); iit != itlist.end(); ++iit)
+    {
+      const std::string &iname = iit->first;
+      const Interface   &iint  = *(iit->second);
+      const std::string  prefix = device_prefix + "interface/" + iname + "/";
+
+      skeleton << "begin_interface \"" << iname << "\" \"" << iint.GetRegion0()->GetName() << "\" \"" << iint.GetRegion1()->GetName() << "\"\n";
+
+      const ConstNodeList_t &itnodes0 = iint.GetNodes0();
+      const ConstNodeList_t &itnodes1 = iint.GetNodes1();
+      dsAssert(itnodes0.size() == itnodes1.size(), "UNEXPECTED");
+
+      if (dimension == 1)
+      {
+        IndexColumn_t v;
+        v.reserve(2 * itnodes0.size());
+        for (size_t i = 0; i < itnodes0.size(); ++i)
+        {
+          v.push_back(itnodes0[i]->GetIndex());
+          v.push_back(itnodes1[i]->GetIndex());
+        }
+        sections.WriteIndexes(prefix + "nodes", v);
+      }
+      else if (dimension == 2)
+      {
+        WriteElementPairs(sections, prefix + "edges", iint.GetEdges0(), iint.GetEdges1());
+      }
+      else if (dimension == 3)
+      {
+        WriteElementPairs(sections, prefix + "triangles", iint.GetTriangles0(), iint.GetTriangles1());
+      }
+
+      WriteCommandModels(skeleton, iint.GetInterfaceNodeModelList());
+
+      WriteEquations(skeleton, iint.GetInterfaceEquationList());
+
+      skeleton << "end_interface\n\n";
+    }
+
+    skeleton << "end_device\n\n";
+  }
+
+  errorString += os.str();
+  return ret;
+}
+
+bool WriteDevices(const std::vector<std::string> &dnames, const std::string &filename, std::string &errorString)
+{
+  bool ret = true;
+
+  std::ofstream myfile;
+  myfile.open(filename.c_str(), std::ios::out | std::ios::trunc | std::ios::binary);
+  if (!myfile)
+  {
+    errorString += "Could not open \"" + filename + "\" for writing\n";
+    return false;
+  }
+
+  SectionWriter sections(myfile);
+
+  std::ostringstream skeleton;
+  skeleton << std::setprecision(15) << std::scientific;
+
+  for (std::vector<std::string>::const_iterator dit = dnames.begin(); dit != dnames.end(); ++dit)
+  {
+    ret = WriteSingleDevice(*dit, skeleton, sections, errorString) && ret;
+  }
+
+  sections.WriteText("skeleton", skeleton.str());
+  sections.Finish();
+
+  if (!myfile)
+  {
+    ret = false;
+    errorString += "Error writing \"" + filename + "\"\n";
+  }
+
+  return ret;
+}
+}
+
+DevsimBinaryWriter::~DevsimBinaryWriter()
+{
+}
+
+bool DevsimBinaryWriter::WriteMesh_(const std::string &deviceName, const std::string &filename, std::string &errorString)
+{
+  return WriteDevices(std::vector<std::string>(1, deviceName), filename, errorString);
+}
+
+bool DevsimBinaryWriter::WriteMeshes_(const std::string &filename, std::string &errorString)
+{
+  std::vector<std::string> dnames;
+
+  GlobalData   &gdata = GlobalData::GetInstance();
+  const GlobalData::DeviceList_t &dlist = gdata.GetDeviceList();
+  for (GlobalData::DeviceList_t::const_iterator dit = dlist.begin(); dit != dlist.end(); ++dit)
+  {
+    dnames.push_back(dit->first);
+  }
+
+  return WriteDevices(dnames, filename, errorString);
+}
+
@@ -742,7 +742,7 @@ bool DevsimLoader::Instantiate_(const std::string &deviceName, std::string &erro
           }
           else if (data_type == Solution::DataType::DATA)
           {
-            Solution::values_t vals  = sol.GetValues();
+            const Solution::values_t &vals  = sol.GetValues();
             if (vals.size() != rp->GetNumberNodes())
             {
               ret = false;
@@ -772,7 +772,7 @@ bool DevsimLoader::Instantiate_(const std::string &deviceName, std::string &erro
           }
           else if (data_type == Solution::DataType::DATA)
           {
-            Solution::values_t vals  = sol.GetValues();
+            const Solution::values_t &vals  = sol.GetValues();
             if (vals.size() != rp->GetNumberEdges())
             {
               ret = false;
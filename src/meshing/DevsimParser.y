@@ -19,6 +19,7 @@ limitations under the License.
 #include "Devsimyystype.hh"
 #include "DevsimReader.hh"
 #include "DevsimLoader.hh"
+#include "DevsimBinaryReader.hh"
 #include "MeshKeeper.hh"
 #include "OutputStream.hh"
 #include <sstream>
@@ -113,7 +114,14 @@ end_devicecmd : END_DEVICE {
 
 coordinates : BEG_COORD 
         | coordinates coordinate 
-        | coordinates END_COORD 
+        | coordinates END_COORD {
+            std::string errorString;
+            if (dsDevsimParse::BinaryData && !dsDevsimBinary::ReadCoordinates(*dsDevsimParse::BinaryData, *dsDevsimParse::DevsimLoader, errorString))
+            {
+                Devsimerror(errorString.c_str());
+                YYABORT;
+            }
+        }
         ;
 
 coordinate : number number number
@@ -161,6 +169,12 @@ region : BEG_REGION WORD WORD  {
             }
             else
             {
+                std::string errorString;
+                if (dsDevsimParse::BinaryData && !dsDevsimBinary::ReadRegion(*dsDevsimParse::BinaryData, dsDevsimParse::DevsimLoader->GetName(), *dsDevsimParse::MeshRegion, errorString))
+                {
+                    Devsimerror(errorString.c_str());
+                    YYABORT;
+                }
                 dsDevsimParse::DevsimLoader->AddRegion(dsDevsimParse::MeshRegion);
                 dsDevsimParse::MeshRegion = NULL;
             }
@@ -542,6 +556,12 @@ contact : BEG_CONTACT WORD WORD WORD  {
             }
             else
             {
+                std::string errorString;
+                if (dsDevsimParse::BinaryData && !dsDevsimBinary::ReadContact(*dsDevsimParse::BinaryData, dsDevsimParse::DevsimLoader->GetName(), *dsDevsimParse::MeshContact, errorString))
+                {
+                    Devsimerror(errorString.c_str());
+                    YYABORT;
+                }
                 dsDevsimParse::DevsimLoader->AddContact(dsDevsimParse::MeshContact);
                 dsDevsimParse::MeshContact = NULL;
             }
@@ -582,6 +602,12 @@ interface : BEG_INTERFACE WORD WORD WORD  {
             }
             else
             {
+                std::string errorString;
+                if (dsDevsimParse::BinaryData && !dsDevsimBinary::ReadInterface(*dsDevsimParse::BinaryData, dsDevsimParse::DevsimLoader->GetName(), *dsDevsimParse::MeshInterface, errorString))
+                {
+                    Devsimerror(errorString.c_str());
+                    YYABORT;
+                }
                 dsDevsimParse::DevsimLoader->AddInterface(dsDevsimParse::MeshInterface);
                 dsDevsimParse::MeshInterface = NULL;
             }
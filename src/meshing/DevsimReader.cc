@@ -26,6 +26,7 @@ dsMesh::MeshContactPtr   MeshContact = NULL;
 dsMesh::MeshInterfacePtr MeshInterface = NULL;
 dsMesh::SolutionPtr      Sol= NULL;
 dsMesh::EquationPtr      Equation= NULL;
+const dsDevsimBinary::BinaryFile *BinaryData = NULL;
 std::string errors;
 }
 
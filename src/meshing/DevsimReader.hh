@@ -42,6 +42,10 @@ class Equation;
 typedef Equation   *EquationPtr;
 }
 
+namespace dsDevsimBinary {
+class BinaryFile;
+}
+
 namespace dsDevsimParse {
 extern int meshlineno;
 extern dsMesh::DevsimLoaderPtr    DevsimLoader;
@@ -50,6 +54,8 @@ extern dsMesh::MeshContactPtr   MeshContact;
 extern dsMesh::MeshInterfacePtr MeshInterface;
 extern dsMesh::SolutionPtr      Sol;
 extern dsMesh::EquationPtr      Equation;
+/// Set while the skeleton of a binary restart file is parsed
+extern const dsDevsimBinary::BinaryFile *BinaryData;
 extern std::string errors;
 
 void DeletePointers();
@@ -155,8 +155,14 @@ GmshLoader::~GmshLoader() {
 }
 
 
-void GmshLoader::GetUniqueNodesFromPhysicalNames(const std::vector<std::string> &pnames, MeshNodeList_t &mnlist)
+const MeshNodeList_t &GmshLoader::GetUniqueNodesFromPhysicalNames(const std::vector<std::string> &pnames, MeshNodeList_t &mnlist)
 {
+  //// already sorted and unique from Finalize_
+  if (pnames.size() == 1)
+  {
+    return gmshShapesMap[pnames[0]].Points;
+  }
+
   mnlist.clear();
   for (std::vector<std::string>::const_iterator pit = pnames.begin(); pit != pnames.end(); ++pit)
   {
@@ -173,10 +179,17 @@ void GmshLoader::GetUniqueNodesFromPhysicalNames(const std::vector<std::string>
   std::sort(mnlist.begin(), mnlist.end());
   MeshNodeList_t::iterator elnewend = std::unique(mnlist.begin(), mnlist.end());
   mnlist.erase(elnewend, mnlist.end());
+  return mnlist;
 }
 
-void GmshLoader::GetUniqueTetrahedraFromPhysicalNames(const std::vector<std::string> &pnames, MeshTetrahedronList_t &mnlist)
+const MeshTetrahedronList_t &GmshLoader::GetUniqueTetrahedraFromPhysicalNames(const std::vector<std::string> &pnames, MeshTetrahedronList_t &mnlist)
 {
+  //// already sorted and unique from Finalize_
+  if (pnames.size() == 1)
+  {
+    return gmshShapesMap[pnames[0]].Tetrahedra;
+  }
+
   mnlist.clear();
   for (std::vector<std::string>::const_iterator pit = pnames.begin(); pit != pnames.end(); ++pit)
   {
@@ -193,10 +206,17 @@ void GmshLoader::GetUniqueTetrahedraFromPhysicalNames(const std::vector<std::str
   std::sort(mnlist.begin(), mnlist.end());
   MeshTetrahedronList_t::iterator elnewend = std::unique(mnlist.begin(), mnlist.end());
   mnlist.erase(elnewend, mnlist.end());
+  return mnlist;
 }
 
-void GmshLoader::GetUniqueTrianglesFromPhysicalNames(const std::vector<std::string> &pnames, MeshTriangleList_t &mnlist)
+const MeshTriangleList_t &GmshLoader::GetUniqueTrianglesFromPhysicalNames(const std::vector<std::string> &pnames, MeshTriangleList_t &mnlist)
 {
+  //// already sorted and unique from Finalize_
+  if (pnames.size() == 1)
+  {
+    return gmshShapesMap[pnames[0]].Triangles;
+  }
+
   mnlist.clear();
   for (std::vector<std::string>::const_iterator pit = pnames.begin(); pit != pnames.end(); ++pit)
   {
@@ -213,10 +233,17 @@ void GmshLoader::GetUniqueTrianglesFromPhysicalNames(const std::vector<std::stri
   std::sort(mnlist.begin(), mnlist.end());
   MeshTriangleList_t::iterator elnewend = std::unique(mnlist.begin(), mnlist.end());
   mnlist.erase(elnewend, mnlist.end());
+  return mnlist;
 }
 
-void GmshLoader::GetUniqueEdgesFromPhysicalNames(const std::vector<std::string> &pnames, MeshEdgeList_t &mnlist)
+const MeshEdgeList_t &GmshLoader::GetUniqueEdgesFromPhysicalNames(const std::vector<std::string> &pnames, MeshEdgeList_t &mnlist)
 {
+  //// already sorted and unique from Finalize_
+  if (pnames.size() == 1)
+  {
+    return gmshShapesMap[pnames[0]].Lines;
+  }
+
   mnlist.clear();
   for (std::vector<std::string>::const_iterator pit = pnames.begin(); pit != pnames.end(); ++pit)
   {
@@ -233,6 +260,7 @@ void GmshLoader::GetUniqueEdgesFromPhysicalNames(const std::vector<std::string>
   std::sort(mnlist.begin(), mnlist.end());
   MeshEdgeList_t::iterator elnewend = std::unique(mnlist.begin(), mnlist.end());
   mnlist.erase(elnewend, mnlist.end());
+  return mnlist;
 }
 
 bool GmshLoader::Instantiate_(const std::string &deviceName, std::string &errorString)
@@ -273,10 +301,10 @@ bool GmshLoader::Instantiate_(const std::string &deviceName, std::string &errorS
 
   //// For each name in the region map, we create a list of nodes which are indexes
   {
-    MeshNodeList_t        mesh_nodes;
-    MeshTetrahedronList_t mesh_tetrahedra;
-    MeshTriangleList_t    mesh_triangles;
-    MeshEdgeList_t        mesh_edges;
+    MeshNodeList_t        merged_nodes;
+    MeshTetrahedronList_t merged_tetrahedra;
+    MeshTriangleList_t    merged_triangles;
+    MeshEdgeList_t        merged_edges;
 
     ConstTetrahedronList              tetrahedronList;
     ConstTriangleList                 triangleList;
@@ -284,11 +312,6 @@ bool GmshLoader::Instantiate_(const std::string &deviceName, std::string &errorS
 
     for (MapToRegionInfo_t::const_iterator rit = regionMap.begin(); rit != regionMap.end(); ++rit)
     {
-      mesh_nodes.clear();
-      mesh_tetrahedra.clear();
-      mesh_triangles.clear();
-      mesh_edges.clear();
-
       tetrahedronList.clear();
       triangleList.clear();
       edgeList.clear();
@@ -308,7 +331,7 @@ bool GmshLoader::Instantiate_(const std::string &deviceName, std::string &errorS
 
       Region &region = *regionptr;
 
-      GetUniqueNodesFromPhysicalNames(pnames, mesh_nodes);
+      const MeshNodeList_t &mesh_nodes = GetUniqueNodesFromPhysicalNames(pnames, merged_nodes);
 
       std::vector<NodePtr> &nodeList = RegionNameToNodeMap[regionName];
       processNodes(mesh_nodes, coordinate_list, nodeList);
@@ -332,18 +355,18 @@ bool GmshLoader::Instantiate_(const std::string &deviceName, std::string &errorS
 
       if (dimension == 3)
       {
-        GetUniqueTetrahedraFromPhysicalNames(pnames, mesh_tetrahedra);
+        const MeshTetrahedronList_t &mesh_tetrahedra = GetUniqueTetrahedraFromPhysicalNames(pnames, merged_tetrahedra);
         processTetrahedra(mesh_tetrahedra, nodeList, tetrahedronList);
         region.AddTetrahedronList(tetrahedronList);
       }
 
       if (dimension >= 2)
       {
-        GetUniqueTrianglesFromPhysicalNames(pnames, mesh_triangles);
+        const MeshTriangleList_t &mesh_triangles = GetUniqueTrianglesFromPhysicalNames(pnames, merged_triangles);
         processTriangles(mesh_triangles, nodeList, triangleList);
         region.AddTriangleList(triangleList);
       }
-      GetUniqueEdgesFromPhysicalNames(pnames, mesh_edges);
+      const MeshEdgeList_t &mesh_edges = GetUniqueEdgesFromPhysicalNames(pnames, merged_edges);
       processEdges(mesh_edges, nodeList, edgeList);
       region.AddEdgeList(edgeList);
       region.FinalizeMesh();
@@ -353,17 +376,14 @@ bool GmshLoader::Instantiate_(const std::string &deviceName, std::string &errorS
 
   //// Now process the contact
   {
-    MeshNodeList_t mesh_nodes;
-    MeshEdgeList_t mesh_edges;
-    MeshTriangleList_t mesh_triangles;
+    MeshNodeList_t merged_nodes;
+    MeshEdgeList_t merged_edges;
+    MeshTriangleList_t merged_triangles;
     ConstNodeList cnodes;
     ConstEdgeList cedges;
     ConstTriangleList ctriangles;
     for (MapToContactInfo_t::const_iterator cit = contactMap.begin(); cit != contactMap.end(); ++cit)
     {
-      mesh_nodes.clear();
-      mesh_edges.clear();
-      mesh_triangles.clear();
       const std::string &contactName = cit->first;
       const GmshContactInfo &cinfo   = cit->second;
 
@@ -383,9 +403,9 @@ bool GmshLoader::Instantiate_(const std::string &deviceName, std::string &errorS
 
       const std::vector<std::string> &pnames = cinfo.physical_names;
 
-      GetUniqueNodesFromPhysicalNames(pnames, mesh_nodes);
-      GetUniqueEdgesFromPhysicalNames(pnames, mesh_edges);
-      GetUniqueTrianglesFromPhysicalNames(pnames, mesh_triangles);
+      const MeshNodeList_t &mesh_nodes = GetUniqueNodesFromPhysicalNames(pnames, merged_nodes);
+      const MeshEdgeList_t &mesh_edges = GetUniqueEdgesFromPhysicalNames(pnames, merged_edges);
+      const MeshTriangleList_t &mesh_triangles = GetUniqueTrianglesFromPhysicalNames(pnames, merged_triangles);
 
       if (dimension == 2 && !mesh_triangles.empty())
       {
@@ -505,15 +525,11 @@ bool GmshLoader::Instantiate_(const std::string &deviceName, std::string &errorS
     ConstNodeList inodes[2];
     ConstEdgeList iedges[2];
     ConstTriangleList itriangles[2];
-    MeshNodeList_t mesh_nodes;
-    MeshEdgeList_t mesh_edges;
-    MeshTriangleList_t mesh_triangles;
+    MeshNodeList_t merged_nodes;
+    MeshEdgeList_t merged_edges;
+    MeshTriangleList_t merged_triangles;
     for (MapToInterfaceInfo_t::const_iterator iit = interfaceMap.begin(); iit != interfaceMap.end(); ++iit)
     {
-      mesh_nodes.clear();
-      mesh_edges.clear();
-      mesh_triangles.clear();
-
       const std::string &interfaceName = iit->first;
       const GmshInterfaceInfo &iinfo   = iit->second;
 
@@ -542,9 +558,9 @@ bool GmshLoader::Instantiate_(const std::string &deviceName, std::string &errorS
 
       const std::vector<std::string> &pnames = iinfo.physical_names;
 
-      GetUniqueNodesFromPhysicalNames(pnames, mesh_nodes);
-      GetUniqueEdgesFromPhysicalNames(pnames, mesh_edges);
-      GetUniqueTrianglesFromPhysicalNames(pnames, mesh_triangles);
+      const MeshNodeList_t &mesh_nodes = GetUniqueNodesFromPhysicalNames(pnames, merged_nodes);
+      const MeshEdgeList_t &mesh_edges = GetUniqueEdgesFromPhysicalNames(pnames, merged_edges);
+      const MeshTriangleList_t &mesh_triangles = GetUniqueTrianglesFromPhysicalNames(pnames, merged_triangles);
 
       Region *regionptr[2];
       regionptr[0] = dp->GetRegion(regionName0);
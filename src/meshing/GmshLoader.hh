@@ -182,10 +182,12 @@ class GmshLoader : public Mesh {
         bool Instantiate_(const std::string &, std::string &);
         bool Finalize_(std::string &);
 
-        void GetUniqueNodesFromPhysicalNames(const std::vector<std::string> &, MeshNodeList_t &);
-        void GetUniqueTetrahedraFromPhysicalNames(const std::vector<std::string> &, MeshTetrahedronList_t &);
-        void GetUniqueTrianglesFromPhysicalNames(const std::vector<std::string> &, MeshTriangleList_t &);
-        void GetUniqueEdgesFromPhysicalNames(const std::vector<std::string> &, MeshEdgeList_t &);
+        /// The list of the physical group is returned when there is only one
+        /// name, otherwise the merged list is created in the second argument
+        const MeshNodeList_t &GetUniqueNodesFromPhysicalNames(const std::vector<std::string> &, MeshNodeList_t &);
+        const MeshTetrahedronList_t &GetUniqueTetrahedraFromPhysicalNames(const std::vector<std::string> &, MeshTetrahedronList_t &);
+        const MeshTriangleList_t &GetUniqueTrianglesFromPhysicalNames(const std::vector<std::string> &, MeshTriangleList_t &);
+        const MeshEdgeList_t &GetUniqueEdgesFromPhysicalNames(const std::vector<std::string> &, MeshEdgeList_t &);
 
 
         GmshLoader();
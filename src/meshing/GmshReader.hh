@@ -53,6 +53,9 @@ extern std::string errors;
 void DeletePointers();
 
 bool LoadMeshesFromFile(const std::string &/*filename*/, const std::string&/*meshName*/, std::string &/*errorString*/);
+/// Files in the MSH 4.x format are read by LoadMesh4FromFile instead of the parser
+bool IsMeshFormat4(const std::string &/*filename*/);
+bool LoadMesh4FromFile(const std::string &/*filename*/, const std::string&/*meshName*/, std::string &/*errorString*/);
 bool LoadMeshesFromArgs(const std::string &/*meshName*/, const std::vector<double> &/*coordinate_list*/, const std::vector<std::string> &/*physical_names*/, const std::vector<size_t> &/*element_list*/, std::string &/*errorString*/);
 
 }
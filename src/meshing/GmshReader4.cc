@@ -0,0 +1,908 @@
+/***
+DEVSIM
+Copyright 2013 Devsim LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+***/
+
+#include "GmshReader.hh"
+#include "GmshLoader.hh"
+#include "MeshKeeper.hh"
+#include "parallel_for.hh"
+#include "MappedFile.hh"
+#include <fstream>
+#include <sstream>
+#include <cstring>
+#include <cstdlib>
+#include <cctype>
+#include <climits>
+#include <map>
+
+//// Reader for the MSH 4.1 format, in ascii or binary.  The file is memory
+//// mapped.  The sections are located serially, and the node
+//// and element blocks are then converted to numbers in parallel.
+namespace dsGmshParse {
+namespace {
+
+struct NodeBlock {
+  NodeBlock() : count(0), coordinates(3), offset(0), data(NULL) {}
+
+  size_t      count;
+  /// 3, plus the parametric coordinates
+  size_t      coordinates;
+  /// position of the first node in the output arrays
+  size_t      offset;
+  const char *data;
+  std::string errorString;
+};
+
+struct ElementBlock {
+  ElementBlock() : dimension(0), entity(0), element_type(dsMesh::Shapes::ElementType_t::UNKNOWN), number_nodes(0), count(0), offset(0), data(NULL) {}
+
+  int         dimension;
+  int         entity;
+  dsMesh::Shapes::ElementType_t element_type;
+  size_t      number_nodes;
+  size_t      count;
+  /// position of the first element in the output arrays
+  size_t      offset;
+  const char *data;
+  std::string errorString;
+};
+
+typedef std::vector<std::map<int, std::vector<int> > > EntityPhysicalTags_t;
+
+//// The mapped file is not null terminated, so each number is copied out
+//// before it is converted
+template <size_t N>
+bool GetAsciiToken(const char *&p, const char *end, char (&buf)[N])
+{
+  while ((p != end) && std::isspace(static_cast<unsigned char>(*p)))
+  {
+    ++p;
+  }
+  const char *b = p;
+  while ((p != end) && !std::isspace(static_cast<unsigned char>(*p)))
+  {
+    ++p;
+  }
+  const size_t len = p - b;
+  if ((len == 0) || (len >= N))
+  {
+    return false;
+  }
+  std::memcpy(buf, b, len);
+  buf[len] = '\0';
+  return true;
+}
+
+//// Numbers in ascii blocks are separated by any white space, so the lines
+//// only need to be counted to find the end of the block
+bool ReadAsciiSize(const char *&p, const char *end, size_t &v)
+{
+  char buf[32];
+  if (!GetAsciiToken(p, end, buf))
+  {
+    return false;
+  }
+  char *e = NULL;
+  v = std::strtoull(buf, &e, 10);
+  return (e != buf) && (*e == '\0');
+}
+
+bool ReadAsciiDouble(const char *&p, const char *end, double &v)
+{
+  char buf[64];
+  if (!GetAsciiToken(p, end, buf))
+  {
+    return false;
+  }
+  char *e = NULL;
+  v = std::strtod(buf, &e);
+  return (e != buf) && (*e == '\0');
+}
+
+bool ReadAsciiInt(const char *&p, const char *end, int &v)
+{
+  char buf[32];
+  if (!GetAsciiToken(p, end, buf))
+  {
+    return false;
+  }
+  char *e = NULL;
+  v = std::strtol(buf, &e, 10);
+  return (e != buf) && (*e == '\0');
+}
+
+template <typename T>
+void ReadBinaryValue(const char *&p, T &v)
+{
+  std::memcpy(&v, p, sizeof(T));
+  p += sizeof(T);
+}
+
+class NodeBlockTask : public myrangetask {
+  public:
+    NodeBlockTask(std::vector<NodeBlock> &b, bool bin, const char *end, std::vector<size_t> &t, std::vector<double> &c) : blocks_(b), binary_(bin), end_(end), tags_(t), coordinates_(c) {}
+
+    void operator()(const size_t b, const size_t e) const
+    {
+      for (size_t i = b; i < e; ++i)
+      {
+        ParseBlock(blocks_[i]);
+      }
+    }
+
+  private:
+    void ParseBlock(NodeBlock &block) const
+    {
+      const char *p = block.data;
+      size_t *tags = &tags_[0] + block.offset;
+      double *coordinates = &coordinates_[0] + 3 * block.offset;
+      double value = 0.0;
+
+      if (binary_)
+      {
+        for (size_t j = 0; j < block.count; ++j)
+        {
+          ReadBinaryValue(p, tags[j]);
+        }
+        for (size_t j = 0; j < block.count; ++j)
+        {
+          for (size_t k = 0; k < block.coordinates; ++k)
+          {
+            ReadBinaryValue(p, value);
+            if (k < 3)
+            {
+              coordinates[3*j + k] = value;
+            }
+          }
+        }
+        return;
+      }
+
+      bool ok = true;
+      for (size_t j = 0; ok && (j < block.count); ++j)
+      {
+        ok = ReadAsciiSize(p, end_, tags[j]);
+      }
+      for (size_t j = 0; ok && (j < block.count); ++j)
+      {
+        for (size_t k = 0; ok && (k < block.coordinates); ++k)
+        {
+          ok = ReadAsciiDouble(p, end_, value);
+          if (k < 3)
+          {
+            coordinates[3*j + k] = value;
+          }
+        }
+      }
+
+      if (!ok)
+      {
+        block.errorString = "ERROR: could not read the nodes of a $Nodes block\n";
+      }
+    }
+
+    std::vector<NodeBlock> &blocks_;
+    bool                    binary_;
+    const char             *end_;
+    std::vector<size_t>    &tags_;
+    std::vector<double>    &coordinates_;
+};
+
+class ElementBlockTask : public myrangetask {
+  public:
+    ElementBlockTask(std::vector<ElementBlock> &b, bool bin, const char *end, std::vector<size_t> &t, std::vector<size_t> &n) : blocks_(b), binary_(bin), end_(end), tags_(t), nodes_(n) {}
+
+    void operator()(const size_t b, const size_t e) const
+    {
+      for (size_t i = b; i < e; ++i)
+      {
+        ParseBlock(blocks_[i]);
+      }
+    }
+
+  private:
+    void ParseBlock(ElementBlock &block) const
+    {
+      const char *p = block.data;
+      size_t *tags = &tags_[0] + block.offset;
+      size_t *nodes = &nodes_[0] + 4 * block.offset;
+
+      bool ok = true;
+      for (size_t j = 0; ok && (j < block.count); ++j)
+      {
+        if (binary_)
+        {
+          ReadBinaryValue(p, tags[j]);
+        }
+        else
+        {
+          ok = ReadAsciiSize(p, end_, tags[j]);
+        }
+
+        for (size_t k = 0; ok && (k < block.number_nodes); ++k)
+        {
+          if (binary_)
+          {
+            ReadBinaryValue(p, nodes[4*j + k]);
+          }
+          else
+          {
+            ok = ReadAsciiSize(p, end_, nodes[4*j + k]);
+          }
+        }
+      }
+
+      if (!ok)
+      {
+        block.errorString = "ERROR: could not read the elements of an $Elements block\n";
+      }
+    }
+
+    std::vector<ElementBlock> &blocks_;
+    bool                       binary_;
+    const char                *end_;
+    std::vector<size_t>       &tags_;
+    /// 4 entries for each element, whatever the type
+    std::vector<size_t>       &nodes_;
+};
+
+class Msh4Parser {
+  public:
+    Msh4Parser(const char *data, size_t size, dsMesh::GmshLoader &l) : pos_(data), end_(data + size), binary_(false), loader_(l), entities_(4) {}
+
+    bool Parse(std::string &/*errorString*/);
+
+  private:
+    bool GetLine(std::string &);
+    bool GetHeaderLine(std::string &);
+    bool SkipLines(size_t);
+    bool SkipBytes(size_t);
+    bool ExpectEnd(const std::string &);
+    bool SkipSection(const std::string &);
+    template <typename T> bool ReadSize(T &);
+    bool ReadInt(int &);
+
+    bool ParseMeshFormat();
+    bool ParsePhysicalNames();
+    bool ParseEntities();
+    bool ParseNodes();
+    bool ParseElements();
+
+    const char          *pos_;
+    const char          *end_;
+    bool                 binary_;
+    dsMesh::GmshLoader  &loader_;
+    EntityPhysicalTags_t entities_;
+    std::ostringstream   errors_;
+};
+
+bool Msh4Parser::GetLine(std::string &line)
+{
+  if (pos_ >= end_)
+  {
+    return false;
+  }
+
+  const char *e = static_cast<const char *>(std::memchr(pos_, '\n', end_ - pos_));
+  if (!e)
+  {
+    e = end_;
+  }
+
+  const char *le = e;
+  if ((le != pos_) && (*(le - 1) == '\r'))
+  {
+    --le;
+  }
+  line.assign(pos_, le);
+
+  pos_ = (e == end_) ? end_ : e + 1;
+  return true;
+}
+
+//// Skips blank lines
+bool Msh4Parser::GetHeaderLine(std::string &line)
+{
+  bool ok = false;
+  while ((ok = GetLine(line)))
+  {
+    if (line.find_first_not_of(" \t") != std::string::npos)
+    {
+      break;
+    }
+  }
+  return ok;
+}
+
+bool Msh4Parser::SkipLines(size_t n)
+{
+  for (size_t i = 0; i < n; ++i)
+  {
+    const char *e = static_cast<const char *>(std::memchr(pos_, '\n', end_ - pos_));
+    if (!e)
+    {
+      return false;
+    }
+    pos_ = e + 1;
+  }
+  return true;
+}
+
+bool Msh4Parser::SkipBytes(size_t n)
+{
+  if (n > static_cast<size_t>(end_ - pos_))
+  {
+    return false;
+  }
+  pos_ += n;
+  return true;
+}
+
+bool Msh4Parser::ExpectEnd(const std::string &name)
+{
+  std::string line;
+  if (!GetHeaderLine(line) || (line.compare(0, name.size() + 4, "$End" + name) != 0))
+  {
+    errors_ << "ERROR: expected $End" << name << "\n";
+    return false;
+  }
+  return true;
+}
+
+bool Msh4Parser::SkipSection(const std::string &name)
+{
+  const std::string endname = "$End" + name;
+  std::string line;
+  while (GetLine(line))
+  {
+    if (line.compare(0, endname.size(), endname) == 0)
+    {
+      return true;
+    }
+  }
+  errors_ << "ERROR: expected " << endname << "\n";
+  return false;
+}
+
+template <typename T>
+bool Msh4Parser::ReadSize(T &v)
+{
+  if (binary_)
+  {
+    if (static_cast<size_t>(end_ - pos_) < sizeof(size_t))
+    {
+      return false;
+    }
+    size_t tmp = 0;
+    ReadBinaryValue(pos_, tmp);
+    v = static_cast<T>(tmp);
+    return true;
+  }
+  size_t tmp = 0;
+  const bool ok = ReadAsciiSize(pos_, end_, tmp);
+  v = static_cast<T>(tmp);
+  return ok;
+}
+
+bool Msh4Parser::ReadInt(int &v)
+{
+  if (binary_)
+  {
+    if (static_cast<size_t>(end_ - pos_) < sizeof(int))
+    {
+      return false;
+    }
+    ReadBinaryValue(pos_, v);
+    return true;
+  }
+  return ReadAsciiInt(pos_, end_, v);
+}
+
+bool Msh4Parser::ParseMeshFormat()
+{
+  std::string line;
+  if (!GetHeaderLine(line) || (line != "$MeshFormat"))
+  {
+    errors_ << "ERROR: expected $MeshFormat\n";
+    return false;
+  }
+
+  GetHeaderLine(line);
+  std::istringstream is(line);
+  std::string version;
+  int file_type = -1;
+  size_t data_size = 0;
+  is >> version >> file_type >> data_size;
+
+  if ((version != "4.1") || (file_type < 0) || (file_type > 1) || (data_size != sizeof(size_t)))
+  {
+    errors_ << "ERROR: MeshFormat " << line << " not supported\n";
+    return false;
+  }
+
+  binary_ = (file_type == 1);
+
+  if (binary_)
+  {
+    int one = 0;
+    if (!ReadInt(one) || (one != 1))
+    {
+      errors_ << "ERROR: binary mesh file does not have the byte order of this machine\n";
+      return false;
+    }
+    GetLine(line);
+  }
+
+  return ExpectEnd("MeshFormat");
+}
+
+//// Always ascii
+bool Msh4Parser::ParsePhysicalNames()
+{
+  std::string line;
+  GetHeaderLine(line);
+  size_t count = 0;
+  {
+    std::istringstream is(line);
+    is >> count;
+  }
+
+  for (size_t i = 0; i < count; ++i)
+  {
+    if (!GetHeaderLine(line))
+    {
+      errors_ << "ERROR: expected " << count << " physical names\n";
+      return false;
+    }
+
+    std::istringstream is(line);
+    int dim = -1;
+    int tag = 0;
+    is >> dim >> tag;
+
+    const std::string::size_type b = line.find('"');
+    const std::string::size_type e = line.rfind('"');
+    if (is.fail() || (b == std::string::npos) || (e == b))
+    {
+      errors_ << "ERROR: could not read physical name " << line << "\n";
+      return false;
+    }
+    const std::string name = line.substr(b + 1, e - b - 1);
+
+    if ((dim < 0) || (dim > 3))
+    {
+      errors_ << "ERROR: PhysicalName mapping " << tag << " to " << name << " cannot have dimension " << dim << "\n";
+      return false;
+    }
+    else if (tag < 1)
+    {
+      errors_ << "ERROR: PhysicalName mapping " << tag << " to " << name << " dimension " << dim << " must refer to a positive index\n";
+      return false;
+    }
+    else if (loader_.HasPhysicalName(dim, tag))
+    {
+      errors_ << "ERROR: PhysicalName mapping " << tag << " to " << name << " dimension " << dim << " cannot be used since " << tag << " already maps to " << loader_.GetPhysicalName(dim, tag) << "\n";
+      return false;
+    }
+    loader_.AddPhysicalName(dim, tag, name);
+  }
+
+  return ExpectEnd("PhysicalNames");
+}
+
+//// Only the physical tags of each entity are kept
+bool Msh4Parser::ParseEntities()
+{
+  size_t counts[4];
+  bool ok = true;
+  for (size_t d = 0; ok && (d < 4); ++d)
+  {
+    ok = ReadSize(counts[d]);
+  }
+
+  for (size_t d = 0; ok && (d < 4); ++d)
+  {
+    for (size_t i = 0; ok && (i < counts[d]); ++i)
+    {
+      int tag = 0;
+      ok = ReadInt(tag);
+
+      //// point coordinates or bounding box
+      const size_t number_doubles = (d == 0) ? 3 : 6;
+      for (size_t j = 0; ok && (j < number_doubles); ++j)
+      {
+        double v = 0.0;
+        if (binary_)
+        {
+          ok = SkipBytes(sizeof(double));
+        }
+        else
+        {
+          ok = ReadAsciiDouble(pos_, end_, v);
+        }
+      }
+
+      size_t number_physical = 0;
+      ok = ok && ReadSize(number_physical);
+      std::vector<int> &physical = entities_[d][tag];
+      physical.resize(number_physical);
+      for (size_t j = 0; ok && (j < number_physical); ++j)
+      {
+        ok = ReadInt(physical[j]);
+      }
+
+      if (ok && (d != 0))
+      {
+        size_t number_bounding = 0;
+        ok = ReadSize(number_bounding);
+        for (size_t j = 0; ok && (j < number_bounding); ++j)
+        {
+          int bounding = 0;
+          ok = ReadInt(bounding);
+        }
+      }
+    }
+  }
+
+  if (!ok)
+  {
+    errors_ << "ERROR: could not read $Entities\n";
+    return false;
+  }
+
+  if (binary_)
+  {
+    std::string line;
+    GetLine(line);
+  }
+
+  return ExpectEnd("Entities");
+}
+
+bool Msh4Parser::ParseNodes()
+{
+  size_t number_blocks = 0;
+  size_t number_nodes = 0;
+  size_t min_tag = 0;
+  size_t max_tag = 0;
+  if (!(ReadSize(number_blocks) && ReadSize(number_nodes) && ReadSize(min_tag) && ReadSize(max_tag)))
+  {
+    errors_ << "ERROR: could not read $Nodes\n";
+    return false;
+  }
+  if (!binary_)
+  {
+    SkipLines(1);
+  }
+
+  std::vector<NodeBlock> blocks(number_blocks);
+  size_t offset = 0;
+  for (size_t i = 0; i < number_blocks; ++i)
+  {
+    NodeBlock &block = blocks[i];
+
+    int entity_dim = 0;
+    int entity_tag = 0;
+    int parametric = 0;
+    bool ok = ReadInt(entity_dim) && ReadInt(entity_tag) && ReadInt(parametric) && ReadSize(block.count);
+    if (ok && !binary_)
+    {
+      ok = SkipLines(1);
+    }
+    if (!ok)
+    {
+      errors_ << "ERROR: could not read $Nodes block " << i << "\n";
+      return false;
+    }
+
+    if (parametric)
+    {
+      block.coordinates += entity_dim;
+    }
+
+    if ((offset + block.count) > number_nodes)
+    {
+      errors_ << "ERROR: $Nodes has more than " << number_nodes << " nodes\n";
+      return false;
+    }
+
+    block.offset = offset;
+    block.data = pos_;
+    offset += block.count;
+
+    if (binary_)
+    {
+      ok = SkipBytes(block.count * (sizeof(size_t) + block.coordinates * sizeof(double)));
+    }
+    else
+    {
+      ok = SkipLines(2 * block.count);
+    }
+
+    if (!ok)
+    {
+      errors_ << "ERROR: $Nodes block " << i << " is truncated\n";
+      return false;
+    }
+  }
+
+  if (offset != number_nodes)
+  {
+    errors_ << "ERROR: $Nodes expected " << number_nodes << " nodes, but has " << offset << "\n";
+    return false;
+  }
+
+  std::vector<size_t> tags(number_nodes);
+  std::vector<double> coordinates(3 * number_nodes);
+  NodeBlockTask task(blocks, binary_, end_, tags, coordinates);
+  parallel_for(task, blocks.size(), 1);
+
+  for (size_t i = 0; i < number_blocks; ++i)
+  {
+    if (!blocks[i].errorString.empty())
+    {
+      errors_ << blocks[i].errorString;
+      return false;
+    }
+  }
+
+  for (size_t i = 0; i < number_nodes; ++i)
+  {
+    if (tags[i] < 1)
+    {
+      errors_ << "ERROR: node index " << tags[i] << " must refer to a positive index\n";
+      return false;
+    }
+    loader_.AddCoordinate(tags[i], dsMesh::MeshCoordinate(coordinates[3*i], coordinates[3*i + 1], coordinates[3*i + 2]));
+  }
+
+  if (binary_)
+  {
+    std::string line;
+    GetLine(line);
+  }
+
+  return ExpectEnd("Nodes");
+}
+
+bool Msh4Parser::ParseElements()
+{
+  size_t number_blocks = 0;
+  size_t number_elements = 0;
+  size_t min_tag = 0;
+  size_t max_tag = 0;
+  if (!(ReadSize(number_blocks) && ReadSize(number_elements) && ReadSize(min_tag) && ReadSize(max_tag)))
+  {
+    errors_ << "ERROR: could not read $Elements\n";
+    return false;
+  }
+  if (!binary_)
+  {
+    SkipLines(1);
+  }
+
+  std::vector<ElementBlock> blocks(number_blocks);
+  size_t offset = 0;
+  for (size_t i = 0; i < number_blocks; ++i)
+  {
+    ElementBlock &block = blocks[i];
+
+    int element_number = 0;
+    bool ok = ReadInt(block.dimension) && ReadInt(block.entity) && ReadInt(element_number) && ReadSize(block.count);
+    if (ok && !binary_)
+    {
+      ok = SkipLines(1);
+    }
+    if (!ok)
+    {
+      errors_ << "ERROR: could not read $Elements block " << i << "\n";
+      return false;
+    }
+
+    switch (element_number)
+    {
+      case 15:
+        block.element_type = dsMesh::Shapes::ElementType_t::POINT;
+        block.number_nodes = 1;
+        break;
+      case 1:
+        block.element_type = dsMesh::Shapes::ElementType_t::LINE;
+        block.number_nodes = 2;
+        break;
+      case 2:
+        block.element_type = dsMesh::Shapes::ElementType_t::TRIANGLE;
+        block.number_nodes = 3;
+        break;
+      case 4:
+        block.element_type = dsMesh::Shapes::ElementType_t::TETRAHEDRON;
+        block.number_nodes = 4;
+        break;
+      default:
+        errors_ << "ERROR: Unable to process element of type " << element_number << "\n";
+        return false;
+    }
+
+    if ((block.dimension < 0) || (block.dimension > 3) || !entities_[block.dimension].count(block.entity))
+    {
+      errors_ << "ERROR: $Elements block " << i << " refers to entity " << block.entity << " of dimension " << block.dimension << " which is not in $Entities\n";
+      return false;
+    }
+
+    if ((offset + block.count) > number_elements)
+    {
+      errors_ << "ERROR: $Elements has more than " << number_elements << " elements\n";
+      return false;
+    }
+
+    block.offset = offset;
+    block.data = pos_;
+    offset += block.count;
+
+    if (binary_)
+    {
+      ok = SkipBytes(block.count * (1 + block.number_nodes) * sizeof(size_t));
+    }
+    else
+    {
+      ok = SkipLines(block.count);
+    }
+
+    if (!ok)
+    {
+      errors_ << "ERROR: $Elements block " << i << " is truncated\n";
+      return false;
+    }
+  }
+
+  if (offset != number_elements)
+  {
+    errors_ << "ERROR: $Elements expected " << number_elements << " elements, but has " << offset << "\n";
+    return false;
+  }
+
+  std::vector<size_t> tags(number_elements);
+  std::vector<size_t> nodes(4 * number_elements);
+  ElementBlockTask task(blocks, binary_, end_, tags, nodes);
+  parallel_for(task, blocks.size(), 1);
+
+  std::vector<int> node_indexes;
+  for (size_t i = 0; i < number_blocks; ++i)
+  {
+    const ElementBlock &block = blocks[i];
+    if (!block.errorString.empty())
+    {
+      errors_ << block.errorString;
+      return false;
+    }
+
+    //// elements of entities without a physical group are not used
+    const std::vector<int> &physical = entities_[block.dimension][block.entity];
+
+    node_indexes.resize(block.number_nodes);
+    for (size_t j = block.offset; j < (block.offset + block.count); ++j)
+    {
+      if (tags[j] < 1)
+      {
+        errors_ << "ERROR: element index " << tags[j] << " must be a positive index.\n";
+        return false;
+      }
+
+      for (size_t k = 0; k < block.number_nodes; ++k)
+      {
+        const size_t index = nodes[4*j + k];
+        if ((index < 1) || (index > static_cast<size_t>(INT_MAX)))
+        {
+          errors_ << "ERROR: element has non-positive index for nodes\n";
+          return false;
+        }
+        node_indexes[k] = index;
+      }
+
+      for (std::vector<int>::const_iterator it = physical.begin(); it != physical.end(); ++it)
+      {
+        if (*it < 1)
+        {
+          errors_ << "ERROR: physical number " << *it << " must be positive\n";
+          return false;
+        }
+        loader_.AddElement(dsMesh::GmshElement(tags[j], *it, block.element_type, node_indexes));
+      }
+    }
+  }
+
+  if (binary_)
+  {
+    std::string line;
+    GetLine(line);
+  }
+
+  return ExpectEnd("Elements");
+}
+
+bool Msh4Parser::Parse(std::string &errorString)
+{
+  bool ret = ParseMeshFormat();
+
+  std::string line;
+  while (ret && GetHeaderLine(line))
+  {
+    if (line == "$PhysicalNames")
+    {
+      ret = ParsePhysicalNames();
+    }
+    else if (line == "$Entities")
+    {
+      ret = ParseEntities();
+    }
+    else if (line == "$Nodes")
+    {
+      ret = ParseNodes();
+    }
+    else if (line == "$Elements")
+    {
+      ret = ParseElements();
+    }
+    else if (line[0] == '$')
+    {
+      ret = SkipSection(line.substr(1));
+    }
+    else
+    {
+      errors_ << "ERROR: unexpected line " << line << "\n";
+      ret = false;
+    }
+  }
+
+  errorString += errors_.str();
+  return ret;
+}
+}
+
+bool IsMeshFormat4(const std::string &fname)
+{
+  std::ifstream myfile(fname.c_str(), std::ios::in | std::ios::binary);
+  std::string line;
+  while (std::getline(myfile, line))
+  {
+    if (line.find_first_not_of(" \t\r") != std::string::npos)
+    {
+      break;
+    }
+  }
+  if (line.compare(0, 11, "$MeshFormat") != 0)
+  {
+    return false;
+  }
+  std::getline(myfile, line);
+  return (line.size() > 1) && (line[0] == '4') && (line[1] == '.');
+}
+
+bool LoadMesh4FromFile(const std::string &fname, const std::string &meshName, std::string &errorString)
+{
+  dsUtility::MappedFile mfile;
+  if (!mfile.Open(fname, errorString))
+  {
+    return false;
+  }
+
+  dsMesh::GmshLoaderPtr gmshLoaderp = new dsMesh::GmshLoader(meshName);
+  dsMesh::MeshKeeper &mk = dsMesh::MeshKeeper::GetInstance();
+  mk.AddMesh(gmshLoaderp);
+
+  Msh4Parser parser(mfile.GetData(), mfile.GetSize(), *gmshLoaderp);
+  return parser.Parse(errorString);
+}
+}
@@ -108,6 +108,11 @@ class Solution {
             values.push_back(x);
         }
 
+        void SetValues(const double *b, const double *e)
+        {
+            values.assign(b, e);
+        }
+
         ModelType GetModelType() const  {
             return model_type;
         }
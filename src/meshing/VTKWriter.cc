@@ -15,6 +15,7 @@ See the License for the specific language governing permissions and
 limitations under the License.
 ***/
 
+
 #include "VTKWriter.hh"
 #include "GlobalData.hh"
 #include "Device.hh"
@@ -32,6 +33,8 @@ limitations under the License.
 #include "MeshUtil.hh"
 #include "dsAssert.hh"
 #include "base64.hh"
+#include "parallel_for.hh"
+#include "AsyncWriter.hh"
 #include <sstream>
 #include <fstream>
 #include <iomanip>
@@ -41,6 +44,103 @@ limitations under the License.
 
 namespace VTK {
 
+//// Only one of the value lists is used, depending on the type.  The values
+//// are gathered on the main thread, since models are evaluated on demand,
+//// and Encode may then be called from any thread.
+struct DataArray {
+  DataArray() : components(1) {}
+
+  void Encode();
+
+  std::string                type;
+  std::string                name;
+  size_t                     components;
+  /// "ascii", "binary", or "appended"
+  std::string                format;
+  std::vector<double>        float_values;
+  std::vector<int>           int_values;
+  std::vector<unsigned char> byte_values;
+  /// text for the DataArray element, or the raw bytes for the appended data
+  std::string                data;
+};
+
+typedef std::vector<DataArray> DataArrayList_t;
+
+struct RegionData {
+  RegionData() : num_points(0), num_cells(0), has_point_data(false), has_cell_data(false) {}
+
+  std::string     filename;
+  size_t          num_points;
+  size_t          num_cells;
+  DataArray       points;
+  DataArrayList_t cells;
+  bool            has_point_data;
+  DataArrayList_t point_data;
+  bool            has_cell_data;
+  DataArrayList_t cell_data;
+  std::string     errorString;
+};
+
+typedef std::vector<RegionData> RegionDataList_t;
+
+//// An empty list of names selects all of the models
+class ModelFilter {
+  public:
+    explicit ModelFilter(const std::vector<std::string> &names) : names_(names.begin(), names.end()) {}
+
+    bool operator()(const std::string &name) const
+    {
+      return names_.empty() || (names_.count(name) != 0);
+    }
+
+  private:
+    std::set<std::string> names_;
+};
+
+template <typename T>
+void EncodeValues(const std::string &format, std::vector<T> &values, std::string &data)
+{
+  if (format == "binary")
+  {
+    data = dsUtility::convertVectorToZlibBase64(values);
+  }
+  else if (format == "appended")
+  {
+    data = dsUtility::convertVectorToZlibRaw(values);
+  }
+  else
+  {
+    std::ostringstream os;
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+      os << " " << static_cast<int>(values[i]);
+    }
+    data = os.str();
+  }
+  std::vector<T>().swap(values);
+}
+
+void DataArray::Encode()
+{
+  if (type == "Float64")
+  {
+    dsAssert(format != "ascii", "UNEXPECTED");
+    EncodeValues(format, float_values, data);
+  }
+  else if (type == "Int32")
+  {
+    EncodeValues(format, int_values, data);
+  }
+  else if (type == "UInt8")
+  {
+    EncodeValues(format, byte_values, data);
+  }
+  else
+  {
+    dsAssert(0, "UNEXPECTED");
+  }
+}
+
 void WriteHeader(std::ostream &myfile)
 {
   myfile <<
@@ -58,30 +158,69 @@ void WriteFooter(std::ostream &myfile)
   ;
 }
 
-void WriteDataArray(const std::vector<double> &nsl, const std::string &name, const size_t number_components, std::ostream &myfile)
+//// The offset of the next appended array is advanced past this one
+void WriteDataArray(const DataArray &da, size_t &offset, std::ostream &myfile)
 {
-  myfile << "<DataArray type=\"Float64\"";
+  myfile << "<DataArray type=\"" << da.type << "\"";
 
-  if (!name.empty())
+  if (!da.name.empty())
   {
-    myfile << " Name=\"" << name << "\"";
+    myfile << " Name=\"" << da.name << "\"";
   }
-  if (number_components != 1)
+  if (da.components != 1)
   {
-    myfile << " NumberOfComponents=\"" << number_components << "\"";
+    myfile << " NumberOfComponents=\"" << da.components << "\"";
   }
 
-  myfile << " format=\"binary\">\n"
-         << dsUtility::convertVectorToZlibBase64(nsl)
-         << "\n</DataArray>\n";
+  if (da.format == "appended")
+  {
+    myfile << " format=\"appended\" offset=\"" << offset << "\"/>\n";
+    offset += da.data.size();
+  }
+  else
+  {
+    myfile << " format=\"" << da.format << "\">\n"
+           << da.data
+           << "\n</DataArray>\n";
+  }
 }
 
-void WritePoints(const Region &reg, std::ostream &myfile)
+void WriteAppendedData(const DataArray &da, std::ostream &myfile)
 {
-  myfile << "<Points>\n";
+  if (da.format == "appended")
+  {
+    myfile.write(da.data.data(), da.data.size());
+  }
+}
 
+void WriteAppendedData(const DataArrayList_t &dal, std::ostream &myfile)
+{
+  for (DataArrayList_t::const_iterator it = dal.begin(); it != dal.end(); ++it)
+  {
+    WriteAppendedData(*it, myfile);
+  }
+}
+
+void AddFloatArray(const std::string &name, size_t components, const std::string &format, DataArrayList_t &dal)
+{
+  dal.push_back(DataArray());
+  DataArray &da = dal.back();
+  da.type = "Float64";
+  da.name = name;
+  da.components = components;
+  da.format = format;
+}
+
+void GatherPoints(const Region &reg, const std::string &format, RegionData &rd)
+{
   const ConstNodeList &cnl = reg.GetNodeList();
-  std::vector<double> points;
+
+  DataArray &da = rd.points;
+  da.type = "Float64";
+  da.components = 3;
+  da.format = format;
+
+  std::vector<double> &points = da.float_values;
   points.reserve(3*cnl.size());
   for (ConstNodeList::const_iterator it = cnl.begin(); it != cnl.end(); ++it)
   {
@@ -90,636 +229,630 @@ void WritePoints(const Region &reg, std::ostream &myfile)
     points.push_back(pos.Gety());
     points.push_back(pos.Getz());
   }
-
-  WriteDataArray(points, std::string(), 3, myfile);
-
-#if 0
-  for (ConstNodeList::const_iterator it = cnl.begin(); it != cnl.end(); ++it)
-  {
-    const Vector<double> &pos = (*it)->Position(); 
-    myfile
-      << " " << pos.Getx()
-      << " " << pos.Gety()
-      << " " << pos.Getz()
-      ;
-  }
-#endif
-
-  myfile << "</Points>\n";
 }
 
-void WritePointData(const Region &reg, std::ostream &myfile)
+void GatherPointData(const Region &reg, const ModelFilter &filter, const std::string &format, RegionData &rd)
 {
-  
   const Region::NodeModelList_t            &node_models             = reg.GetNodeModelList();
   const Region::EdgeModelList_t            &edge_models             = reg.GetEdgeModelList();
-#if 0
-  const Region::TriangleEdgeModelList_t    &triangle_edge_models    = reg.GetTriangleEdgeModelList();
-  const Region::TetrahedronEdgeModelList_t &tetrahedron_edge_models = reg.GetTetrahedronEdgeModelList();
-#endif
 
-//  if (node_models.empty() && edge_models.empty() && triangle_edge_models.empty() && tetrahedron_edge_models.empty())
-  if (node_models.empty() && edge_models.empty())
+  for (Region::NodeModelList_t::const_iterator it=node_models.begin(); it != node_models.end(); ++it)
   {
-    return;
-  }
+    const std::string &nm = it->first;
+    if (!filter(nm))
+    {
+      continue;
+    }
 
-  myfile << "<PointData>\n";
+    const NodeModel   &em = *(it->second);
 
-  if (!node_models.empty())
-  {
-    for (Region::NodeModelList_t::const_iterator it=node_models.begin(); it != node_models.end(); ++it)
-    {
-      const std::string &nm = it->first;
-      const NodeModel   &em = *(it->second);
+    rd.has_point_data = true;
 
-      if (em.GetDisplayType() == NodeModel::DisplayType::SCALAR)
-      {
-        const NodeScalarList<double> &nsl = em.GetScalarValues<double>();
-        WriteDataArray(nsl, nm, 1, myfile);
-      }
-      else if (em.GetDisplayType() == NodeModel::DisplayType::NODISPLAY)
-      {
-      }
-      else
-      {
-        dsAssert(0, "UNEXPECTED display type");
-      }
+    if (em.GetDisplayType() == NodeModel::DisplayType::SCALAR)
+    {
+      AddFloatArray(nm, 1, format, rd.point_data);
+      rd.point_data.back().float_values = em.GetScalarValues<double>();
+    }
+    else if (em.GetDisplayType() == NodeModel::DisplayType::NODISPLAY)
+    {
+    }
+    else
+    {
+      dsAssert(0, "UNEXPECTED display type");
     }
   }
 
   //// Edge Scalar Data
-  if (!edge_models.empty())
+  // Strange paraview bug requires scalar before vector data
+  for (Region::EdgeModelList_t::const_iterator it=edge_models.begin(); it != edge_models.end(); ++it)
   {
-    // Strange paraview bug requires scalar before vector data
-    for (Region::EdgeModelList_t::const_iterator it=edge_models.begin(); it != edge_models.end(); ++it)
+    const std::string &nm = it->first;
+    if (!filter(nm))
     {
-      const std::string &nm = it->first;
-      const EdgeModel &em = *(it->second);
-
-      if (em.GetDisplayType() == EdgeModel::DisplayType::SCALAR)
-      {
-        const NodeScalarList<double> &nsl = em.GetScalarValuesOnNodes<double>();
-        WriteDataArray(nsl, nm, 1, myfile);
-      }
+      continue;
     }
-  }
 
+    const EdgeModel &em = *(it->second);
 
-#if 0
-  //// Require user to use calculator filter
-  if (!triangle_edge_models.empty())
-  {
-    // Strange paraview bug requires scalar before vector data
-    std::vector<double> nsl;
-    for (Region::TriangleEdgeModelList_t::const_iterator it=triangle_edge_models.begin(); it != triangle_edge_models.end(); ++it)
-    {
-      const std::string &nm = it->first;
-      const TriangleEdgeModel &em = *(it->second);
-
-      if (em.GetDisplayType() == TriangleEdgeModel::DisplayType::SCALAR)
-      {
-        em.GetScalarValuesOnNodes<double>(TriangleEdgeModel::COUPLE, nsl);
-        WriteDataArray(nsl, nm, 1, myfile);
-      }
-      else if (em.GetDisplayType() == TriangleEdgeModel::DisplayType::NODISPLAY)
-      {
-      }
-      else
-      {
-        dsAssert(0, "UNEXPECTED display type");
-      }
-    }
-  }
+    rd.has_point_data = true;
 
-  if (!tetrahedron_edge_models.empty())
-  {
-    // Strange paraview bug requires scalar before vector data
-    for (Region::TetrahedronEdgeModelList_t::const_iterator it=tetrahedron_edge_models.begin(); it != tetrahedron_edge_models.end(); ++it)
+    if (em.GetDisplayType() == EdgeModel::DisplayType::SCALAR)
     {
-      const std::string &nm = it->first;
-      const TetrahedronEdgeModel &em = *(it->second);
-
-      std::vector<double> nsl;
-      if (em.GetDisplayType() == TetrahedronEdgeModel::DisplayType::SCALAR)
-      {
-        em.GetScalarValuesOnNodes<double>(TetrahedronEdgeModel::COUPLE, nsl);
-        WriteDataArray(nsl, nm, 1, myfile);
-      }
-      else if (em.GetDisplayType() == TetrahedronEdgeModel::DisplayType::NODISPLAY)
-      {
-      }
-      else
-      {
-        dsAssert(0, "UNEXPECTED display type");
-      }
+      AddFloatArray(nm, 1, format, rd.point_data);
+      rd.point_data.back().float_values = em.GetScalarValuesOnNodes<double>();
     }
   }
-#endif
 
   //// Vector<double> Edge Scalar Data
-  if (!edge_models.empty())
+  for (Region::EdgeModelList_t::const_iterator it=edge_models.begin(); it != edge_models.end(); ++it)
   {
-    // Strange paraview bug requires scalar before vector data
-    for (Region::EdgeModelList_t::const_iterator it=edge_models.begin(); it != edge_models.end(); ++it)
+    const std::string &nm = it->first;
+    if (!filter(nm))
     {
-      const std::string &nm = it->first;
-      const EdgeModel &em = *(it->second);
+      continue;
+    }
 
-      if (em.GetDisplayType() == EdgeModel::DisplayType::VECTOR)
-      {
-        const NodeVectorList<double> &nvl = em.GetVectorValuesOnNodes<double>();
+    const EdgeModel &em = *(it->second);
 
+    if (em.GetDisplayType() == EdgeModel::DisplayType::VECTOR)
+    {
+      const NodeVectorList<double> &nvl = em.GetVectorValuesOnNodes<double>();
 
-        std::vector<double> points;
-        points.reserve(3*nvl.size());
+      AddFloatArray(nm, 3, format, rd.point_data);
+      std::vector<double> &points = rd.point_data.back().float_values;
+      points.reserve(3*nvl.size());
 
-        const size_t len = nvl.size();
-        for (size_t i = 0; i < len; ++i)
-        {
-          const Vector<double> &val = nvl[i];
-          points.push_back(val.Getx());
-          points.push_back(val.Gety());
-          points.push_back(val.Getz());
-        }
-
-        WriteDataArray(points, nm, 3, myfile);
-      }
-      else if (em.GetDisplayType() == EdgeModel::DisplayType::SCALAR)
-      {
-      }
-      else if (em.GetDisplayType() == EdgeModel::DisplayType::NODISPLAY)
-      {
-      }
-      else
+      const size_t len = nvl.size();
+      for (size_t i = 0; i < len; ++i)
       {
-        dsAssert(0, "UNEXPECTED display type");
+        const Vector<double> &val = nvl[i];
+        points.push_back(val.Getx());
+        points.push_back(val.Gety());
+        points.push_back(val.Getz());
       }
     }
-  }
-
-  myfile << "</PointData>\n";
-}
-
-#if 0
-void WriteLineData(const Region &reg, std::ostream &myfile)
-{
-  const Region::EdgeModelList_t &nml = reg.GetEdgeModelList();
-
-  const std::vector<Vector<double>> unit = MeshUtil::GetUnitVector(reg);
-
-  if (!nml.empty())
-  {
-    myfile << "<CellData>\n";
-
-    // Strange paraview bug requires scalar before vector data
-    for (Region::EdgeModelList_t::const_iterator it=nml.begin(); it != nml.end(); ++it)
+    else if (em.GetDisplayType() == EdgeModel::DisplayType::SCALAR)
     {
-      const std::string &nm = it->first;
-      const EdgeModel &em = *(it->second);
-
-      if (em.GetDisplayType() == EdgeModel::DisplayType::SCALAR)
-      {
-        const EdgeScalarList<double> &nsl = em.GetScalarValues<double>();
-
-        myfile << "<DataArray Name=\"" << nm << "\" type=\"Float64\" format=\"binary\">\n";
-
-        myfile << convertVectorToZlibBase64(nsl);
-
-#if 0
-        dsAssert(nsl.size() == unit.size(), "UNEXPECTED");
-        const size_t len = unit.size();
-        for (size_t i = 0; i < len; ++i)
-        {
-          const double val = nsl[i];
-          myfile << " " << val;
-        }
-#endif
-        myfile << "\n</DataArray>\n";
-      }
     }
-    for (Region::EdgeModelList_t::const_iterator it=nml.begin(); it != nml.end(); ++it)
+    else if (em.GetDisplayType() == EdgeModel::DisplayType::NODISPLAY)
     {
-      const std::string &nm = it->first;
-      const EdgeModel &em = *(it->second);
-
-      if (em.GetDisplayType() == EdgeModel::DisplayType::VECTOR)
-      {
-        const EdgeScalarList<double> &nsl = em.GetScalarValues<double>();
-
-        myfile << "<DataArray Name=\"" << nm << "\" type=\"Float64\" NumberOfComponents=\"3\" format=\"binary\">\n";
-
-        std::vector<double> points;
-        points.reserve(3*nsl.size());
-
-        dsAssert(nsl.size() == unit.size(), "UNEXPECTED");
-        const size_t len = unit.size();
-        for (size_t i = 0; i < len; ++i)
-        {
-          Vector<double> val = unit[i];
-          val *= nsl[i];
-          points.push_back(val.Getx());
-          points.push_back(val.Gety());
-          points.push_back(val.Getz());
-        }
-        myfile << convertVectorToZlibBase64(points);
-#if 0
-        dsAssert(nsl.size() == unit.size(), "UNEXPECTED");
-        const size_t len = unit.size();
-        for (size_t i = 0; i < len; ++i)
-        {
-          Vector<double> val = unit[i];
-          val *= nsl[i];
-          myfile << " " << val.Getx()
-                 << " " << val.Gety()
-                 << " " << val.Getz();
-        }
-#endif
-        myfile << "\n</DataArray>\n";
-      }
     }
-    myfile << "</CellData>\n";
+    else
+    {
+      dsAssert(0, "UNEXPECTED display type");
+    }
   }
 }
-#endif
 
-void WriteElementData(const Region &reg, std::ostream &myfile)
+void GatherElementData(const Region &reg, const ModelFilter &filter, const std::string &format, RegionData &rd)
 {
   const Region::TriangleEdgeModelList_t    &triangle_edge_models    = reg.GetTriangleEdgeModelList();
   const Region::TetrahedronEdgeModelList_t &tetrahedron_edge_models = reg.GetTetrahedronEdgeModelList();
 
-  if (triangle_edge_models.empty() && tetrahedron_edge_models.empty())
+  for (Region::TriangleEdgeModelList_t::const_iterator it=triangle_edge_models.begin(); it != triangle_edge_models.end(); ++it)
   {
-    return;
-  }
-
-  myfile << "<CellData>\n";
-  if (!triangle_edge_models.empty())
-  {
-    std::vector<double> nsl;
-    for (Region::TriangleEdgeModelList_t::const_iterator it=triangle_edge_models.begin(); it != triangle_edge_models.end(); ++it)
+    const std::string &nm = it->first;
+    if (!filter(nm))
     {
-      const std::string &nm = it->first;
-      const TriangleEdgeModel &em = *(it->second);
+      continue;
+    }
 
-      if (em.GetDisplayType() == TriangleEdgeModel::DisplayType::SCALAR)
-      {
-        em.GetScalarValuesOnElements<double>(nsl);
-        WriteDataArray(nsl, nm, 1, myfile);
-      }
-      else if (em.GetDisplayType() == TriangleEdgeModel::DisplayType::NODISPLAY)
-      {
-      }
-      else
-      {
-        dsAssert(0, "UNEXPECTED display type");
-      }
+    const TriangleEdgeModel &em = *(it->second);
+
+    rd.has_cell_data = true;
+
+    if (em.GetDisplayType() == TriangleEdgeModel::DisplayType::SCALAR)
+    {
+      AddFloatArray(nm, 1, format, rd.cell_data);
+      em.GetScalarValuesOnElements<double>(rd.cell_data.back().float_values);
+    }
+    else if (em.GetDisplayType() == TriangleEdgeModel::DisplayType::NODISPLAY)
+    {
+    }
+    else
+    {
+      dsAssert(0, "UNEXPECTED display type");
     }
   }
 
-  if (!tetrahedron_edge_models.empty())
+  for (Region::TetrahedronEdgeModelList_t::const_iterator it=tetrahedron_edge_models.begin(); it != tetrahedron_edge_models.end(); ++it)
   {
-    for (Region::TetrahedronEdgeModelList_t::const_iterator it=tetrahedron_edge_models.begin(); it != tetrahedron_edge_models.end(); ++it)
+    const std::string &nm = it->first;
+    if (!filter(nm))
     {
-      const std::string &nm = it->first;
-      const TetrahedronEdgeModel &em = *(it->second);
+      continue;
+    }
 
-      std::vector<double> nsl;
-      if (em.GetDisplayType() == TetrahedronEdgeModel::DisplayType::SCALAR)
-      {
-        em.GetScalarValuesOnElements<double>(nsl);
-        WriteDataArray(nsl, nm, 1, myfile);
-      }
-      else if (em.GetDisplayType() == TetrahedronEdgeModel::DisplayType::NODISPLAY)
-      {
-      }
-      else
-      {
-        dsAssert(0, "UNEXPECTED display type");
-      }
+    const TetrahedronEdgeModel &em = *(it->second);
+
+    rd.has_cell_data = true;
+
+    if (em.GetDisplayType() == TetrahedronEdgeModel::DisplayType::SCALAR)
+    {
+      AddFloatArray(nm, 1, format, rd.cell_data);
+      em.GetScalarValuesOnElements<double>(rd.cell_data.back().float_values);
+    }
+    else if (em.GetDisplayType() == TetrahedronEdgeModel::DisplayType::NODISPLAY)
+    {
+    }
+    else
+    {
+      dsAssert(0, "UNEXPECTED display type");
     }
   }
+}
 
-  myfile << "</CellData>\n";
+//// connectivity, offsets, and types
+void CreateCellArrays(const std::string &format, RegionData &rd)
+{
+  rd.cells.resize(3);
+  rd.cells[0].type = "Int32";
+  rd.cells[0].name = "connectivity";
+  rd.cells[1].type = "Int32";
+  rd.cells[1].name = "offsets";
+  rd.cells[2].type = "UInt8";
+  rd.cells[2].name = "types";
+  for (size_t i = 0; i < 3; ++i)
+  {
+    rd.cells[i].format = format;
+  }
 }
 
-void WriteLines(const Region &reg, std::ostream &myfile)
+void GatherLines(const Region &reg, const std::string &format, RegionData &rd)
 {
   const ConstEdgeList &cel = reg.GetEdgeList();
 
-  std::ostringstream connectivity;
-  std::ostringstream offsets;
-  std::ostringstream types;
+  CreateCellArrays(format, rd);
+  std::vector<int>           &connectivity = rd.cells[0].int_values;
+  std::vector<int>           &offsets      = rd.cells[1].int_values;
+  std::vector<unsigned char> &types        = rd.cells[2].byte_values;
+  connectivity.reserve(2*cel.size());
+  offsets.reserve(cel.size());
+  types.reserve(cel.size());
 
   size_t off = 2;
   for (ConstEdgeList::const_iterator it = cel.begin(); it != cel.end(); ++it)
   {
-    size_t index0 = (*it)->GetHead()->GetIndex();
-    size_t index1 = (*it)->GetTail()->GetIndex();
-    connectivity << " " << index0 << " " << index1;
-    offsets << " " << off;
-    types << " 3";
+    connectivity.push_back((*it)->GetHead()->GetIndex());
+    connectivity.push_back((*it)->GetTail()->GetIndex());
+    offsets.push_back(off);
+    types.push_back(3);
 
     off += 2;
   }
-
-  myfile <<
-      "<Cells>\n";
-
-  myfile <<
-      "<DataArray type=\"Int32\" Name=\"connectivity\" format=\"ascii\">\n"
-      << connectivity.str() <<
-      "\n</DataArray>\n";
-
-  myfile <<
-      "<DataArray type=\"Int32\" Name=\"offsets\" format=\"ascii\">\n"
-      << offsets.str() <<
-      "\n</DataArray>\n";
-
-  myfile <<
-      "<DataArray type=\"UInt8\" Name=\"types\" format=\"ascii\">\n"
-      << types.str() <<
-      "\n</DataArray>\n";
-
-
-  myfile << "</Cells>\n";
 }
 
-void WriteTriangles(const Region &reg, std::ostream &myfile)
+void GatherTriangles(const Region &reg, const std::string &format, RegionData &rd)
 {
   const ConstTriangleList &ctl = reg.GetTriangleList();
 
-  std::ostringstream connectivity;
-  std::ostringstream offsets;
-  std::ostringstream types;
+  CreateCellArrays(format, rd);
+  std::vector<int>           &connectivity = rd.cells[0].int_values;
+  std::vector<int>           &offsets      = rd.cells[1].int_values;
+  std::vector<unsigned char> &types        = rd.cells[2].byte_values;
+  connectivity.reserve(3*ctl.size());
+  offsets.reserve(ctl.size());
+  types.reserve(ctl.size());
 
   size_t off = 3;
   for (ConstTriangleList::const_iterator it = ctl.begin(); it != ctl.end(); ++it)
   {
-
     const std::vector<ConstNodePtr> &nl = (*it)->GetNodeList();
 
-    connectivity
-              << " " << nl[0]->GetIndex()
-              << " " << nl[1]->GetIndex()
-              << " " << nl[2]->GetIndex();
-    offsets << " " << off;
-    types << " 5";
+    connectivity.push_back(nl[0]->GetIndex());
+    connectivity.push_back(nl[1]->GetIndex());
+    connectivity.push_back(nl[2]->GetIndex());
+    offsets.push_back(off);
+    types.push_back(5);
 
     off += 3;
   }
-
-  myfile <<
-      "<Cells>\n";
-
-  myfile <<
-      "<DataArray type=\"Int32\" Name=\"connectivity\" format=\"ascii\">\n"
-      << connectivity.str() <<
-      "\n</DataArray>\n";
-
-  myfile <<
-      "<DataArray type=\"Int32\" Name=\"offsets\" format=\"ascii\">\n"
-      << offsets.str() <<
-      "\n</DataArray>\n";
-
-  myfile <<
-      "<DataArray type=\"UInt8\" Name=\"types\" format=\"ascii\">\n"
-      << types.str() <<
-      "\n</DataArray>\n";
-
-
-  myfile << "</Cells>\n";
 }
 
-void WriteTetrahedrons(const Region &reg, std::ostream &myfile)
+void GatherTetrahedrons(const Region &reg, const std::string &format, RegionData &rd)
 {
   const ConstTetrahedronList &ctl = reg.GetTetrahedronList();
 
-  std::ostringstream connectivity;
-  std::ostringstream offsets;
-  std::ostringstream types;
+  CreateCellArrays(format, rd);
+  std::vector<int>           &connectivity = rd.cells[0].int_values;
+  std::vector<int>           &offsets      = rd.cells[1].int_values;
+  std::vector<unsigned char> &types        = rd.cells[2].byte_values;
+  connectivity.reserve(4*ctl.size());
+  offsets.reserve(ctl.size());
+  types.reserve(ctl.size());
 
   size_t off = 4;
   for (ConstTetrahedronList::const_iterator it = ctl.begin(); it != ctl.end(); ++it)
   {
-
     const std::vector<ConstNodePtr> &nl = (*it)->GetNodeList();
 
-    connectivity
-              << " " << nl[0]->GetIndex()
-              << " " << nl[1]->GetIndex()
-              << " " << nl[2]->GetIndex()
-              << " " << nl[3]->GetIndex();
-    offsets << " " << off;
-    types << " 10";
+    connectivity.push_back(nl[0]->GetIndex());
+    connectivity.push_back(nl[1]->GetIndex());
+    connectivity.push_back(nl[2]->GetIndex());
+    connectivity.push_back(nl[3]->GetIndex());
+    offsets.push_back(off);
+    types.push_back(10);
 
     off += 4;
   }
-
-  myfile <<
-      "<Cells>\n";
-
-  myfile <<
-      "<DataArray type=\"Int32\" Name=\"connectivity\" format=\"ascii\">\n"
-      << connectivity.str() <<
-      "\n</DataArray>\n";
-
-  myfile <<
-      "<DataArray type=\"Int32\" Name=\"offsets\" format=\"ascii\">\n"
-      << offsets.str() <<
-      "\n</DataArray>\n";
-
-  myfile <<
-      "<DataArray type=\"UInt8\" Name=\"types\" format=\"ascii\">\n"
-      << types.str() <<
-      "\n</DataArray>\n";
-
-
-  myfile << "</Cells>\n";
 }
 
-void WriteRegionWithEdgeData(const Region &reg, std::ostream &myfile)
+//// Cell connectivity is written as ascii, unless all of the data is appended
+void GatherRegion(const Region &reg, const ModelFilter &filter, VTKWriter::DataFormat format, RegionData &rd)
 {
-  const ConstNodeList &cnl = reg.GetNodeList();
-  const size_t num_points = cnl.size();
+  const std::string float_format = (format == VTKWriter::DataFormat::APPENDED) ? "appended" : "binary";
+  const std::string cell_format  = (format == VTKWriter::DataFormat::APPENDED) ? "appended" : "ascii";
+
+  rd.num_points = reg.GetNodeList().size();
 
-  size_t num_cells = 0;
   const size_t dim = reg.GetDimension();
 
+  GatherPoints(reg, float_format, rd);
+
   if (dim == 1)
   {
-    const ConstEdgeList &cel = reg.GetEdgeList();
-    num_cells = cel.size();
+    rd.num_cells = reg.GetEdgeList().size();
+    GatherLines(reg, cell_format, rd);
   }
   else if (dim == 2)
   {
-    const ConstTriangleList &cel = reg.GetTriangleList();
-    num_cells = cel.size();
+    rd.num_cells = reg.GetTriangleList().size();
+    GatherTriangles(reg, cell_format, rd);
   }
   else if (dim == 3)
   {
-    const ConstTetrahedronList &cel = reg.GetTetrahedronList();
-    num_cells = cel.size();
+    rd.num_cells = reg.GetTetrahedronList().size();
+    GatherTetrahedrons(reg, cell_format, rd);
+  }
+
+  GatherPointData(reg, filter, float_format, rd);
+
+  if ((dim == 2) || (dim == 3))
+  {
+    GatherElementData(reg, filter, float_format, rd);
   }
+}
+
+void WriteRegion(const RegionData &rd, std::ostream &myfile)
+{
+  size_t offset = 0;
+
+  WriteHeader(myfile);
 
   myfile <<
-         "<Piece NumberOfPoints=\"" << num_points << "\""
-         " NumberOfCells=\"" << num_cells << "\""
+         "<Piece NumberOfPoints=\"" << rd.num_points << "\""
+         " NumberOfCells=\"" << rd.num_cells << "\""
          ">\n"; 
 
-  WritePoints(reg, myfile);
+  myfile << "<Points>\n";
+  WriteDataArray(rd.points, offset, myfile);
+  myfile << "</Points>\n";
 
-  if (dim == 1)
+  if (!rd.cells.empty())
   {
-    WriteLines(reg, myfile);
+    myfile << "<Cells>\n";
+    for (DataArrayList_t::const_iterator it = rd.cells.begin(); it != rd.cells.end(); ++it)
+    {
+      WriteDataArray(*it, offset, myfile);
+    }
+    myfile << "</Cells>\n";
   }
-  else if (dim == 2)
+
+  if (rd.has_point_data)
   {
-    WriteTriangles(reg, myfile);
+    myfile << "<PointData>\n";
+    for (DataArrayList_t::const_iterator it = rd.point_data.begin(); it != rd.point_data.end(); ++it)
+    {
+      WriteDataArray(*it, offset, myfile);
+    }
+    myfile << "</PointData>\n";
   }
-  else if (dim == 3)
+
+  if (rd.has_cell_data)
   {
-    WriteTetrahedrons(reg, myfile);
+    myfile << "<CellData>\n";
+    for (DataArrayList_t::const_iterator it = rd.cell_data.begin(); it != rd.cell_data.end(); ++it)
+    {
+      WriteDataArray(*it, offset, myfile);
+    }
+    myfile << "</CellData>\n";
   }
 
-  WritePointData(reg, myfile);
+  myfile <<
+         "</Piece>\n"
+         ;
 
-//// deprecated
-#if 0
-  WriteLineData(reg, myfile);
-#endif
-  if ((dim == 2) || (dim == 3))
+  if (rd.points.format == "appended")
+  {
+    myfile << "</UnstructuredGrid>\n"
+              "<AppendedData encoding=\"raw\">\n"
+              "_";
+    WriteAppendedData(rd.points, myfile);
+    WriteAppendedData(rd.cells, myfile);
+    WriteAppendedData(rd.point_data, myfile);
+    WriteAppendedData(rd.cell_data, myfile);
+    myfile << "\n</AppendedData>\n"
+              "</VTKFile>\n";
+  }
+  else
   {
-    WriteElementData(reg, myfile);
+    WriteFooter(myfile);
   }
+}
 
+//// Compression and encoding is the expensive part, so each array is a
+//// separate task
+class EncodeTask : public myrangetask {
+  public:
+    explicit EncodeTask(const std::vector<DataArray *> &arrays) : arrays_(arrays) {}
 
-  myfile <<
-         "</Piece>\n"
-         ;
+    void operator()(const size_t b, const size_t e) const
+    {
+      for (size_t i = b; i < e; ++i)
+      {
+        arrays_[i]->Encode();
+      }
+    }
+
+  private:
+    const std::vector<DataArray *> &arrays_;
+};
+
+//// Errors are kept with each region, since they may not be reported from
+//// the other threads
+class WriteRegionTask : public myrangetask {
+  public:
+    explicit WriteRegionTask(RegionDataList_t &regions) : regions_(regions) {}
+
+    void operator()(const size_t b, const size_t e) const
+    {
+      for (size_t i = b; i < e; ++i)
+      {
+        RegionData &rd = regions_[i];
+
+        std::ofstream vtufile;
+        vtufile.open (rd.filename.c_str(), std::ios::out | std::ios::trunc | std::ios::binary);
+        if (vtufile.fail())
+        {
+          rd.errorString = "Could not open " + rd.filename + " for writing\n";
+        }
+        else
+        {
+          vtufile << std::setprecision(15) << std::scientific;
+
+          WriteRegion(rd, vtufile);
+
+          vtufile << "\n";
+        }
+        vtufile.close();
+      }
+    }
+
+  private:
+    RegionDataList_t &regions_;
+};
+
+//// The other threads are only used when parallel is true, since the
+//// thread pool may only be used from the main thread
+void EncodeAndWriteRegions(RegionDataList_t &regions, bool parallel)
+{
+  std::vector<DataArray *> arrays;
+  for (RegionDataList_t::iterator it = regions.begin(); it != regions.end(); ++it)
+  {
+    arrays.push_back(&(it->points));
+    for (size_t i = 0; i < it->cells.size(); ++i)
+    {
+      arrays.push_back(&(it->cells[i]));
+    }
+    for (size_t i = 0; i < it->point_data.size(); ++i)
+    {
+      arrays.push_back(&(it->point_data[i]));
+    }
+    for (size_t i = 0; i < it->cell_data.size(); ++i)
+    {
+      arrays.push_back(&(it->cell_data[i]));
+    }
+  }
+
+  EncodeTask encode(arrays);
+  WriteRegionTask write(regions);
+  if (parallel)
+  {
+    parallel_for(encode, arrays.size(), 1);
+    parallel_for(write, regions.size(), 1);
+  }
+  else
+  {
+    encode(0, arrays.size());
+    write(0, regions.size());
+  }
 }
 
-#if 0
-void WriteRegionWithTriangleData(const Region &reg, std::ostream &myfile)
+//// The pieces are relative to the .pvtu file
+std::string GetBaseName(const std::string &filename)
 {
-  const ConstNodeList &cnl = reg.GetNodeList();
-  const size_t num_points = cnl.size();
+  const std::string::size_type pos = filename.find_last_of("/\\");
+  return (pos == std::string::npos) ? filename : filename.substr(pos + 1);
+}
 
-  const ConstTriangleList &ctl = reg.GetTriangleList();
-  const size_t num_cells = ctl.size();
+//// The arrays of the first region which are also on all of the other regions
+void WritePDataArrays(const RegionDataList_t &regions, DataArrayList_t RegionData::*member, std::ostream &myfile)
+{
+  const DataArrayList_t &first = regions.front().*member;
+  for (DataArrayList_t::const_iterator it = first.begin(); it != first.end(); ++it)
+  {
+    bool found_all = true;
+    for (size_t i = 1; found_all && (i < regions.size()); ++i)
+    {
+      const DataArrayList_t &other = regions[i].*member;
+      bool found = false;
+      for (DataArrayList_t::const_iterator jt = other.begin(); jt != other.end(); ++jt)
+      {
+        if ((jt->name == it->name) && (jt->components == it->components))
+        {
+          found = true;
+          break;
+        }
+      }
+      found_all = found;
+    }
+
+    if (found_all)
+    {
+      myfile << "<PDataArray type=\"" << it->type << "\" Name=\"" << it->name << "\"";
+      if (it->components != 1)
+      {
+        myfile << " NumberOfComponents=\"" << it->components << "\"";
+      }
+      myfile << "/>\n";
+    }
+  }
+}
 
+void WritePVTU(const RegionDataList_t &regions, std::ostream &myfile)
+{
   myfile <<
-         "<Piece NumberOfPoints=\"" << num_points << "\""
-         " NumberOfCells=\"" << num_cells << "\""
-         ">\n"; 
+  "<?xml version=\"1.0\"?>\n"
+  "<VTKFile type=\"PUnstructuredGrid\" version=\"0.1\" byte_order=\"LittleEndian\" compressor=\"vtkZLibDataCompressor\">\n"
+  "<PUnstructuredGrid GhostLevel=\"0\">\n"
+  ;
 
-  WritePoints(reg, myfile);
-  WriteTriangles(reg, myfile);
+  if (!regions.empty())
+  {
+    myfile << "<PPointData>\n";
+    WritePDataArrays(regions, &RegionData::point_data, myfile);
+    myfile << "</PPointData>\n";
+    myfile << "<PCellData>\n";
+    WritePDataArrays(regions, &RegionData::cell_data, myfile);
+    myfile << "</PCellData>\n";
+  }
 
   myfile <<
-         "</Piece>\n"
-         ;
-}
-#endif
+  "<PPoints>\n"
+  "<PDataArray type=\"Float64\" NumberOfComponents=\"3\"/>\n"
+  "</PPoints>\n"
+  ;
 
-#if 0
-void WriteRegion(const Region &r, std::ostream &myfile)
-{
-  WriteRegionWithEdgeData(r, myfile);
-  WriteRegionWithTriangleData(r, myfile);
+  for (RegionDataList_t::const_iterator it = regions.begin(); it != regions.end(); ++it)
+  {
+    myfile << "<Piece Source=\"" << GetBaseName(it->filename) << "\"/>\n";
+  }
+
+  myfile <<
+  "</PUnstructuredGrid>\n"
+  "</VTKFile>\n"
+  ;
 }
-#endif
 
-bool WriteSingleDevice(const std::string &dname, const std::string &filename, std::string &errorString)
+//// Models are evaluated here, so this must be called from the main thread
+bool GatherDevice(const std::string &dname, const std::string &filename, VTKWriter::DataFormat format, const std::vector<std::string> &models, RegionDataList_t &regions, std::string &errorString)
 {
   bool ret = true;
-  std::ostringstream os;
 
   GlobalData   &gdata = GlobalData::GetInstance();
 
   DevicePtr dp = gdata.GetDevice(dname);
 
-  std::string vtmfilename = filename + ".vtm";
-  std::string visitfilename = filename + ".visit";
-
-
   if (!dp)
   {
     ret = false;
-    os << "ERROR: Device " << dname << " does not exist\n";
+    errorString += "ERROR: Device " + dname + " does not exist\n";
   }
   else
+  {
+    Device &dev = *dp;
+
+    const ModelFilter filter(models);
+
+    const Device::RegionList_t &rlist = dev.GetRegionList();
+    regions.resize(rlist.size());
+    size_t i = 0;
+    for (Device::RegionList_t::const_iterator rit = rlist.begin(); rit != rlist.end(); ++rit)
+    {
+      std::ostringstream istring;
+      istring << i;
+
+      RegionData &rd = regions[i];
+      rd.filename = filename + "_" + istring.str() + ".vtu";
+      //// TODO: create separate file for triangle data when we have some
+      GatherRegion(*(rit->second), filter, format, rd);
+      ++i;
+    }
+  }
+  return ret;
+}
+
+//// Only uses the gathered data, so this may be called from any thread
+bool WriteDevice(RegionDataList_t &regions, const std::string &filename, bool partitioned, bool parallel, std::string &errorString)
+{
+  bool ret = true;
+  std::ostringstream os;
+
+  std::string vtmfilename = filename + ".vtm";
+  std::string visitfilename = filename + ".visit";
+  std::string pvtufilename = filename + ".pvtu";
+
   {
     std::ofstream vtmfile;
     std::ofstream visitfile;
-    vtmfile.open (vtmfilename.c_str(), std::ios::out | std::ios::trunc | std::ios::binary);
-    visitfile.open (visitfilename.c_str(), std::ios::out | std::ios::trunc | std::ios::binary);
-    if (vtmfile.bad())
+    std::ofstream pvtufile;
+    if (partitioned)
+    {
+      pvtufile.open (pvtufilename.c_str(), std::ios::out | std::ios::trunc | std::ios::binary);
+    }
+    else
+    {
+      vtmfile.open (vtmfilename.c_str(), std::ios::out | std::ios::trunc | std::ios::binary);
+      visitfile.open (visitfilename.c_str(), std::ios::out | std::ios::trunc | std::ios::binary);
+    }
+    if (vtmfile.fail())
     {
       ret = false;
       os << "Could not open " << vtmfilename << " for writing\n";
     }
-    else if (visitfile.bad())
+    else if (visitfile.fail())
     {
       ret = false;
       os << "Could not open " << visitfilename << " for writing\n";
     }
+    else if (pvtufile.fail())
+    {
+      ret = false;
+      os << "Could not open " << pvtufilename << " for writing\n";
+    }
     else
     {
       vtmfile << std::setprecision(15) << std::scientific;
 
-      Device &dev = *dp;
+      EncodeAndWriteRegions(regions, parallel);
 
-      std::vector<std::string> vtufiles;
-
-      const Device::RegionList_t &rlist = dev.GetRegionList();
-      size_t i = 0;
-      for (Device::RegionList_t::const_iterator rit = rlist.begin(); rit != rlist.end(); ++rit)
+      for (RegionDataList_t::const_iterator it = regions.begin(); it != regions.end(); ++it)
       {
-        std::ostringstream istring;
-        istring << i;
-
-        const std::string vtufilename = filename + "_" + istring.str() + ".vtu";
-
-        std::ofstream vtufile;
-        vtufile.open (vtufilename.c_str(), std::ios::out | std::ios::trunc | std::ios::binary);
-        if (vtufile.bad())
+        if (!it->errorString.empty())
         {
-            ret = false;
-            os << "Could not open " << vtufilename << " for writing\n";
-            vtufile.close();
-            break;
+          ret = false;
+          os << it->errorString;
         }
-        else
-        {
-          vtufile << std::setprecision(15) << std::scientific;
-
-          WriteHeader(vtufile);
-          //// TODO: create separate file for triangle data when we have some
-          WriteRegionWithEdgeData(*(rit->second), vtufile);
-          WriteFooter(vtufile);
-
-          vtufile << "\n";
-          vtufile.close();
-          vtufiles.push_back(vtufilename);
-        }
-        ++i;
       }
 
-      if (ret)
+      if (ret && partitioned)
+      {
+        WritePVTU(regions, pvtufile);
+      }
+      else if (ret)
       {
         vtmfile <<
 "<?xml version=\"1.0\"?>\n"
 "<VTKFile type=\"vtkMultiBlockDataSet\" version=\"0.1\" byte_order=\"LittleEndian\" compressor=\"vtkZLibDataCompressor\">\n"
 "  <vtkMultiBlockDataSet>\n";
-        visitfile << "!NBLOCKS " << vtufiles.size() << "\n";
+        visitfile << "!NBLOCKS " << regions.size() << "\n";
         size_t i = 0;
-        for (std::vector<std::string>::iterator it = vtufiles.begin(); it != vtufiles.end(); ++it)
+        for (RegionDataList_t::const_iterator it = regions.begin(); it != regions.end(); ++it)
         {
           vtmfile <<
-"    <DataSet group=\"" << i << "\" dataset=\"" << 0 << "\" file=\"" << *it << "\"/>\n";
+"    <DataSet group=\"" << i << "\" dataset=\"" << 0 << "\" file=\"" << it->filename << "\"/>\n";
           ++i;
-          visitfile << *it << "\n";
+          visitfile << it->filename << "\n";
         }
         vtmfile <<
 "  </vtkMultiBlockDataSet>\n"
@@ -729,10 +862,52 @@ bool WriteSingleDevice(const std::string &dname, const std::string &filename, st
     }
     vtmfile.close();
     visitfile.close();
+    pvtufile.close();
   }
   errorString += os.str();
   return ret;
 }
+
+bool WriteSingleDevice(const std::string &dname, const std::string &filename, VTKWriter::DataFormat format, bool partitioned, const std::vector<std::string> &models, std::string &errorString)
+{
+  RegionDataList_t regions;
+  bool ret = GatherDevice(dname, filename, format, models, regions, errorString);
+  if (ret)
+  {
+    ret = WriteDevice(regions, filename, partitioned, true, errorString);
+  }
+  return ret;
+}
+
+class WriteDeviceJob : public AsyncWriteJob {
+  public:
+    WriteDeviceJob(const std::string &filename, bool partitioned) : filename_(filename), partitioned_(partitioned) {}
+
+    ~WriteDeviceJob() {}
+
+    RegionDataList_t &GetRegions()
+    {
+      return regions_;
+    }
+
+    bool Write(std::string &errorString)
+    {
+      return WriteDevice(regions_, filename_, partitioned_, false, errorString);
+    }
+
+  private:
+    RegionDataList_t regions_;
+    std::string      filename_;
+    bool             partitioned_;
+};
+}
+
+VTKWriter::VTKWriter() : format_(DataFormat::BASE64), partitioned_(false)
+{
+}
+
+VTKWriter::VTKWriter(DataFormat format, bool partitioned, const std::vector<std::string> &models) : format_(format), partitioned_(partitioned), models_(models)
+{
 }
 
 VTKWriter::~VTKWriter()
@@ -741,42 +916,48 @@ VTKWriter::~VTKWriter()
 
 bool VTKWriter::WriteMesh_(const std::string &deviceName, const std::string &filename, std::string &errorString)
 {
-    bool ret = true;
-    std::ostringstream os;
+    return VTK::WriteSingleDevice(deviceName, filename, format_, partitioned_, models_, errorString);
+}
 
-#if 0
-    std::ofstream myfile;
-    myfile.open (filename.c_str(), std::ios::out | std::ios::trunc | std::ios::binary);
-    if (myfile.bad())
+bool VTKWriter::WriteMeshes_(const std::string &filename, std::string &errorString)
+{
+    std::string dname;
+    bool ret = GetSingleDevice(dname, errorString);
+    if (ret && !dname.empty())
     {
-        ret = false;
-        os << "Could not open " << filename << " for writing\n";
+        ret = WriteMesh_(dname, filename, errorString);
     }
-    else
+
+    return ret;
+}
+
+bool VTKWriter::QueueMesh(const std::string &deviceName, const std::string &filename, std::string &errorString)
+{
+    std::shared_ptr<VTK::WriteDeviceJob> job(new VTK::WriteDeviceJob(filename, partitioned_));
+
+    bool ret = VTK::GatherDevice(deviceName, filename, format_, models_, job->GetRegions(), errorString);
+    if (ret)
     {
-#endif
-        ret = VTK::WriteSingleDevice(deviceName, filename, errorString);
-#if 0
+        AsyncWriter::GetInstance().Queue(job);
     }
-#endif
-    errorString += os.str();
     return ret;
 }
 
-bool VTKWriter::WriteMeshes_(const std::string &filename, std::string &errorString)
+bool VTKWriter::QueueMeshes(const std::string &filename, std::string &errorString)
 {
-    bool ret = true;
-    std::ostringstream os;
-
-#if 0
-    std::ofstream myfile;
-    myfile.open (filename.c_str(), std::ios::out | std::ios::trunc | std::ios::binary);
-    if (myfile.bad())
+    std::string dname;
+    bool ret = GetSingleDevice(dname, errorString);
+    if (ret && !dname.empty())
     {
-        ret = false;
-        os << "Could not open " << filename << " for writing\n";
+        ret = QueueMesh(dname, filename, errorString);
     }
-#endif
+    return ret;
+}
+
+//// The name is left empty when there are no devices
+bool VTKWriter::GetSingleDevice(std::string &dname, std::string &errorString)
+{
+    bool ret = true;
 
     GlobalData   &gdata = GlobalData::GetInstance();
     const GlobalData::DeviceList_t &dlist = gdata.GetDeviceList();
@@ -784,20 +965,12 @@ bool VTKWriter::WriteMeshes_(const std::string &filename, std::string &errorStri
     if (dlist.size() > 1)
     {
         ret = false;
-        os << "More than 1 device in simulation when output format only supports one device.\n";
+        errorString += "More than 1 device in simulation when output format only supports one device.\n";
     }
-    else
+    else if (!dlist.empty())
     {
-        for (GlobalData::DeviceList_t::const_iterator dit = dlist.begin(); dit != dlist.end(); ++dit)
-        {
-            const std::string &dname = dit->first;
-            ret = VTK::WriteSingleDevice(dname, filename, errorString);
-        }
+        dname = dlist.begin()->first;
     }
-#if 0
-    myfile.close();
-#endif
 
-    errorString += os.str();
     return ret;
 }
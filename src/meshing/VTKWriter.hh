@@ -19,12 +19,35 @@ limitations under the License.
 #define VTK_WRITER_HH
 #include "MeshWriter.hh"
 #include <string>
-/// Start out by writing the all out to one file
+#include <vector>
+/// Writes each region to its own .vtu file, with a .vtm multiblock file or
+/// a .pvtu partitioned file referencing them
 class VTKWriter : public MeshWriter {
     public:
+        /// BASE64 is compressed data inline in each DataArray
+        /// APPENDED is compressed raw data at the end of each file
+        enum class DataFormat {BASE64, APPENDED};
+
+        VTKWriter();
+        /// The .pvtu file is written instead of the .vtm file when partitioned is true
+        /// Only the models in the list are written, unless it is empty
+        VTKWriter(DataFormat, bool /*partitioned*/, const std::vector<std::string> &/*models*/);
         ~VTKWriter();
+
+        /// The data are gathered before returning, and the files are
+        /// written by the AsyncWriter thread.  Errors from writing the
+        /// files are reported by AsyncWriter::WaitForWrites.
+        bool QueueMeshes(const std::string &/*filename*/, std::string &/*errorString*/);
+        bool QueueMesh(const std::string &/*deviceName*/, const std::string &/*filename*/, std::string &/*errorString*/);
     private:
+        /// This format only supports one device
+        bool GetSingleDevice(std::string &/*deviceName*/, std::string &/*errorString*/);
+
         bool WriteMeshes_(const std::string &/*filename*/, std::string &/*errorString*/);
         bool WriteMesh_(const std::string &/*deviceName*/, const std::string &/*filename*/, std::string &/*errorString*/);
+
+        DataFormat               format_;
+        bool                     partitioned_;
+        std::vector<std::string> models_;
 };
 #endif
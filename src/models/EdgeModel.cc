@@ -23,6 +23,7 @@ limitations under the License.
 #include "Node.hh"
 #include "dsAssert.hh"
 #include "FPECheck.hh"
+#include "PhaseTimer.hh"
 #include "Vector.hh"
 #include "GeometryStream.hh"
 #include <cmath>
@@ -72,7 +73,9 @@ void EdgeModel::CalculateValues() const
   FPECheck::ClearFPE();
   if (!uptodate)
   {
+    PhaseTimerScope timer("model_evaluation");
     inprocess = true;
+    myregion->RecordRecompute(name);
     this->calcEdgeScalarValues();
     uptodate = true;
     inprocess = false;
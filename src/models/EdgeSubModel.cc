@@ -90,6 +90,13 @@ void EdgeSubModel<DoubleType>::calcEdgeScalarValues() const
     }
 }
 
+//// Same condition as Serialize
+template <typename DoubleType>
+bool EdgeSubModel<DoubleType>::IsSerializedAsData() const
+{
+  return parentModelName.empty() && !this->IsUniform();
+}
+
 template <typename DoubleType>
 void EdgeSubModel<DoubleType>::Serialize(std::ostream &of) const
 {
@@ -35,6 +35,8 @@ class EdgeSubModel : public EdgeModel
 
         void Serialize(std::ostream &) const;
 
+        bool IsSerializedAsData() const;
+
     private:
 
         EdgeSubModel();
@@ -22,6 +22,7 @@ limitations under the License.
 #include "Contact.hh"
 #include "dsAssert.hh"
 #include "FPECheck.hh"
+#include "PhaseTimer.hh"
 #include "GeometryStream.hh"
 
 #include <algorithm>
@@ -94,7 +95,9 @@ void NodeModel::CalculateValues() const
   FPECheck::ClearFPE();
   if (!uptodate)
   {
+    PhaseTimerScope timer("model_evaluation");
     inprocess = true;
+    myregion->RecordRecompute(name);
     this->calcNodeScalarValues();
     uptodate = true;
     inprocess = false;
@@ -154,6 +154,12 @@ class NodeModel {
 
         void DevsimSerialize(std::ostream &) const;
 
+        /// True when Serialize writes the values in a DATA section
+        virtual bool IsSerializedAsData() const
+        {
+          return false;
+        }
+
         const std::string &GetRegionName() const;
 
         const std::string &GetDeviceName() const;
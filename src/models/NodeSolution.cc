@@ -84,6 +84,13 @@ void NodeSolution<DoubleType>::setInitialValues()
     DefaultInitializeValues();
 }
 
+//// Same condition as Serialize
+template <typename DoubleType>
+bool NodeSolution<DoubleType>::IsSerializedAsData() const
+{
+  return parentModelName.empty() && !this->IsUniform();
+}
+
 template <typename DoubleType>
 void NodeSolution<DoubleType>::Serialize(std::ostream &of) const
 {
@@ -30,6 +30,8 @@ class NodeSolution : public NodeModel
 
         void Serialize(std::ostream &) const;
 
+        bool IsSerializedAsData() const;
+
         NodeSolution(const std::string &, RegionPtr);
         // This model depends on this model to calculate values
         NodeSolution(const std::string &, RegionPtr, NodeModelPtr);
@@ -18,13 +18,8 @@ limitations under the License.
 #ifndef PARALLEL_OP_EQUAL_HH
 #define PARALLEL_OP_EQUAL_HH
 
-//// Only for the typedef
-#include "FPECheck.hh"
-#include "mypacket.hh"
-class mymutex;
-class mycondition;
-
 #include <vector>
+#include <cstddef>
 
 template <typename U, typename DoubleType>
 struct SerialVectorVectorOpEqual {
@@ -65,60 +60,29 @@ struct SerialVectorScalarOpEqual {
   const U &op_;
 };
 
-template <typename U>
-class OpEqualPacket {
+//// For tasks defined outside of this library, such as compiled model expressions.
+//// The task must be safe to call on different ranges from several threads.
+class OpEqualRangeTask {
   public:
-    explicit OpEqualPacket(U &);
-
-    //// We are done with this unit when this function returns.
-    void operator()(const size_t rbeg, const size_t rend);
-
-    void join(const OpEqualPacket<U> &);
+    virtual ~OpEqualRangeTask() {}
+    virtual void operator()(const size_t b, const size_t e) const = 0;
+};
 
-    FPECheck::FPEFlag_t getFPEFlag() const;
-    size_t              getNumberProcessed() const;
+struct ForwardOpEqual {
+  explicit ForwardOpEqual(const OpEqualRangeTask &t) : task_(t) {}
 
-  private:
-    OpEqualPacket();
-    OpEqualPacket &operator=(const OpEqualPacket &);
+  void operator()(const size_t b, const size_t e)
+  {
+    task_(b, e);
+  }
 
-    U                    opEqualTask_;
-    FPECheck::FPEFlag_t  fpeFlag_;
-    size_t               num_processed_;
+  const OpEqualRangeTask &task_;
 };
 
+//// Runs the task over [0, length) with parallel_for.  Each subrange is
+//// processed by a copy of the task.
 template <typename U> void
 OpEqualRun(U &, size_t /*length*/);
 
-template <typename U>
-class OpEqualRange : public mypacket
-{
-  public:
-    //// Copy so we have fpe status of each one
-    OpEqualRange(U, size_t, size_t, mymutex &, mycondition &, size_t &, size_t);
-
-    void run();
-
-    //// intent is to join the copy with the original
-    OpEqualPacket<U> &GetOpEqualPacket();
-
-    ~OpEqualRange() {}
-
-  private:
-
-    OpEqualPacket<U> opEqualPacket_;
-    size_t           beg_;
-    size_t           end_;
-    /// Mutex to lock when updating count
-    mymutex     &mutex_;
-    /// Condition variable to signal when done
-    mycondition &cond_;
-    // Count is number of items processed
-    size_t      &count_;
-    // Count total count of items processed
-    size_t       max_count_;
-  
-};
-
 #endif
 
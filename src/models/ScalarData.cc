@@ -20,8 +20,165 @@ limitations under the License.
 
 #include "dsAssert.hh"
 
+#include <utility>
+#include <algorithm>
+
+namespace ScalarDataHelper {
+//// Evaluates a sum of products into the result in one pass.  Each range is
+//// processed in blocks, so the partial products stay in cache and every
+//// list is only read once.  The result must already hold the first factor
+//// of the first term.  The scale factors are applied to the sum.
+template <typename DoubleType>
+class SumOfProducts : public OpEqualRangeTask {
+  public:
+    explicit SumOfProducts(std::vector<DoubleType> &r) : result_(r) {}
+
+    void AddTerm()
+    {
+      terms_.push_back(std::vector<operand>());
+    }
+
+    /// the data is NULL for a scalar factor
+    void AddFactor(DoubleType v, const DoubleType *d)
+    {
+      operand x = {v, d};
+      terms_.back().push_back(x);
+    }
+
+    void AddScale(DoubleType v, const DoubleType *d)
+    {
+      operand x = {v, d};
+      scale_.push_back(x);
+    }
+
+    void operator()(const size_t b, const size_t e) const
+    {
+      DoubleType scratch[block_size];
+
+      for (size_t bb = b; bb < e; bb += block_size)
+      {
+        const size_t n = std::min(block_size, e - bb);
+        DoubleType *out = &result_[bb];
+
+        for (size_t t = 0; t < terms_.size(); ++t)
+        {
+          const std::vector<operand> &factors = terms_[t];
+          DoubleType *prod = (t == 0) ? out : scratch;
+
+          if (t != 0)
+          {
+            Load(factors[0], bb, n, prod);
+          }
+          for (size_t f = 1; f < factors.size(); ++f)
+          {
+            Multiply(factors[f], bb, n, prod);
+          }
+
+          if (t != 0)
+          {
+            for (size_t i = 0; i < n; ++i)
+            {
+              out[i] += scratch[i];
+            }
+          }
+        }
+
+        for (size_t f = 0; f < scale_.size(); ++f)
+        {
+          Multiply(scale_[f], bb, n, out);
+        }
+      }
+    }
+
+    static const size_t block_size = 512;
+
+  private:
+    struct operand {
+      DoubleType        value;
+      const DoubleType *data;
+    };
+
+    static void Load(const operand &x, size_t b, size_t n, DoubleType *r)
+    {
+      if (x.data)
+      {
+        std::copy(x.data + b, x.data + b + n, r);
+      }
+      else
+      {
+        std::fill(r, r + n, x.value);
+      }
+    }
+
+    static void Multiply(const operand &x, size_t b, size_t n, DoubleType *r)
+    {
+      if (x.data)
+      {
+        const DoubleType *d = x.data + b;
+        for (size_t i = 0; i < n; ++i)
+        {
+          r[i] *= d[i];
+        }
+      }
+      else
+      {
+        const DoubleType v = x.value;
+        for (size_t i = 0; i < n; ++i)
+        {
+          r[i] *= v;
+        }
+      }
+    }
+
+    std::vector<DoubleType>           &result_;
+    std::vector<std::vector<operand> > terms_;
+    std::vector<operand>               scale_;
+};
+
+template <typename DoubleType>
+const size_t SumOfProducts<DoubleType>::block_size;
+}
+
+template <typename T, typename DoubleType>
+const std::vector<DoubleType> &ScalarData<T, DoubleType>::factor::GetList() const
+{
+  if (model)
+  {
+    return model->template GetScalarValues<DoubleType>();
+  }
+  return *data;
+}
+
+template <typename T, typename DoubleType>
+typename ScalarData<T, DoubleType>::factor ScalarData<T, DoubleType>::MakeFactor(DoubleType v)
+{
+  factor ret;
+  ret.value = v;
+  ret.model = NULL;
+  return ret;
+}
+
+template <typename T, typename DoubleType>
+typename ScalarData<T, DoubleType>::factor ScalarData<T, DoubleType>::MakeFactor(const T *m)
+{
+  factor ret;
+  ret.value = 0.0;
+  ret.model = m;
+  return ret;
+}
+
 template <typename T, typename DoubleType>
-ScalarData<T, DoubleType>::ScalarData(const T &em) : refdata(0), isuniform(false), uniform_value(0.0)
+typename ScalarData<T, DoubleType>::factor ScalarData<T, DoubleType>::MakeFactor(const std::shared_ptr<std::vector<DoubleType> > &d)
+{
+  factor ret;
+  ret.value = 0.0;
+  ret.model = NULL;
+  ret.data  = d;
+  return ret;
+}
+
+template <typename T, typename DoubleType>
+ScalarData<T, DoubleType>::ScalarData(const T &em) : isuniform(false), uniform_value(0.0)
 {
   if (em.IsUniform())
   {
@@ -30,8 +187,7 @@ ScalarData<T, DoubleType>::ScalarData(const T &em) : refdata(0), isuniform(false
   }
   else
   {
-    refdata = &em;
-//    values = em.GetScalarValues();
+    terms.push_back(term_t(1, MakeFactor(&em)));
   }
 
   length = em.GetLength();
@@ -39,19 +195,27 @@ ScalarData<T, DoubleType>::ScalarData(const T &em) : refdata(0), isuniform(false
 }
 
 template <typename T, typename DoubleType>
-ScalarData<T, DoubleType>::ScalarData(const std::vector<DoubleType> &esl) : refdata(0), isuniform(false), uniform_value(0.0)
+ScalarData<T, DoubleType>::ScalarData(const std::vector<DoubleType> &esl) : isuniform(false), uniform_value(0.0)
 {
-  values = esl;
-  length = values.size();
+  terms.push_back(term_t(1, MakeFactor(std::make_shared<std::vector<DoubleType> >(esl))));
+  length = esl.size();
 }
 
 template <typename T, typename DoubleType>
-ScalarData<T, DoubleType>::ScalarData(DoubleType v, size_t l) : refdata(0), isuniform(true), uniform_value(v), length(l)
+ScalarData<T, DoubleType>::ScalarData(std::vector<DoubleType> &&esl) : isuniform(false), uniform_value(0.0)
 {
+  length = esl.size();
+  terms.push_back(term_t(1, MakeFactor(std::make_shared<std::vector<DoubleType> >(std::move(esl)))));
 }
 
 template <typename T, typename DoubleType>
-ScalarData<T, DoubleType>::ScalarData(const ScalarData<T, DoubleType> &em) : refdata(em.refdata), values(em.values), isuniform(em.isuniform), uniform_value(em.uniform_value), length(em.length)
+ScalarData<T, DoubleType>::ScalarData(DoubleType v, size_t l) : isuniform(true), uniform_value(v), length(l)
+{
+}
+
+//// Lists are shared with the copy, until one of them is assigned to
+template <typename T, typename DoubleType>
+ScalarData<T, DoubleType>::ScalarData(const ScalarData<T, DoubleType> &em) : terms(em.terms), scale(em.scale), isuniform(em.isuniform), uniform_value(em.uniform_value), length(em.length)
 {
 }
 
@@ -60,8 +224,8 @@ ScalarData<T, DoubleType> &ScalarData<T, DoubleType>::operator=(const ScalarData
 {
   if (this != &em)
   {
-    refdata       = em.refdata;
-    values        = em.values;
+    terms         = em.terms;
+    scale         = em.scale;
     isuniform     = em.isuniform;
     uniform_value = em.uniform_value;
     length        = em.length;
@@ -70,27 +234,122 @@ ScalarData<T, DoubleType> &ScalarData<T, DoubleType>::operator=(const ScalarData
 }
 
 template <typename T, typename DoubleType>
-ScalarData<T, DoubleType>::ScalarData() : refdata(0), isuniform(true), uniform_value(0.0), length(0)
+ScalarData<T, DoubleType>::ScalarData() : isuniform(true), uniform_value(0.0), length(0)
+{
+}
+
+template <typename T, typename DoubleType>
+bool ScalarData<T, DoubleType>::IsList() const
 {
+  return IsFactor() && (!terms[0][0].IsScalar());
 }
 
 template <typename T, typename DoubleType>
-void ScalarData<T, DoubleType>::MakeAssignable() const
+bool ScalarData<T, DoubleType>::IsFactor() const
+{
+  return (!isuniform) && (terms.size() == 1) && (terms[0].size() == 1) && scale.empty();
+}
+
+//// A product of several terms is scaled after they are added
+template <typename T, typename DoubleType>
+void ScalarData<T, DoubleType>::AppendFactor(const factor &x)
+{
+  if ((terms.size() == 1) && scale.empty())
+  {
+    terms[0].push_back(x);
+  }
+  else
+  {
+    scale.push_back(x);
+  }
+}
+
+template <typename T, typename DoubleType>
+void ScalarData<T, DoubleType>::Evaluate() const
+{
+  if (isuniform || IsList())
+  {
+    return;
+  }
+
+  //// Starting from a copy of the first factor is cheaper than writing the result twice
+  const factor &first = terms[0][0];
+  std::shared_ptr<std::vector<DoubleType> > result;
+  if (first.IsScalar())
+  {
+    result = std::make_shared<std::vector<DoubleType> >(length, first.value);
+  }
+  else
+  {
+    result = std::make_shared<std::vector<DoubleType> >(first.GetList());
+  }
+
+  ScalarDataHelper::SumOfProducts<DoubleType> task(*result);
+  for (size_t t = 0; t < terms.size(); ++t)
+  {
+    const term_t &factors = terms[t];
+    task.AddTerm();
+    for (size_t f = 0; f < factors.size(); ++f)
+    {
+      if (factors[f].IsScalar())
+      {
+        task.AddFactor(factors[f].value, NULL);
+      }
+      else
+      {
+        const std::vector<DoubleType> &l = factors[f].GetList();
+        dsAssert(l.size() == length, "UNEXPECTED");
+        task.AddFactor(0.0, l.data());
+      }
+    }
+  }
+
+  for (size_t f = 0; f < scale.size(); ++f)
+  {
+    if (scale[f].IsScalar())
+    {
+      task.AddScale(scale[f].value, NULL);
+    }
+    else
+    {
+      const std::vector<DoubleType> &l = scale[f].GetList();
+      dsAssert(l.size() == length, "UNEXPECTED");
+      task.AddScale(0.0, l.data());
+    }
+  }
+
+  ForwardOpEqual foo(task);
+  OpEqualRun(foo, length);
+
+  terms.assign(1, term_t(1, MakeFactor(result)));
+  scale.clear();
+}
+
+//// The list is copied when it is shared with another ScalarData, or belongs to a model
+template <typename T, typename DoubleType>
+std::vector<DoubleType> &ScalarData<T, DoubleType>::MakeAssignable()
 {
   if (isuniform)
   {
-    values.clear();
-    values.resize(length, uniform_value);
+    terms.assign(1, term_t(1, MakeFactor(std::make_shared<std::vector<DoubleType> >(length, uniform_value))));
     uniform_value = 0.0;
     isuniform = false;
   }
-  else if (refdata)
+  else
   {
-    values = refdata->template GetScalarValues<DoubleType>();
-    refdata = NULL;
+    Evaluate();
   }
+
+  factor &x = terms[0][0];
+  if (x.model || (x.data.use_count() > 1))
+  {
+    x = MakeFactor(std::make_shared<std::vector<DoubleType> >(x.GetList()));
+  }
+
+  return *x.data;
 }
 
+//// Entries are usually read in a loop, so the deferred operations are evaluated once
 template <typename T, typename DoubleType>
 DoubleType ScalarData<T, DoubleType>::operator[](size_t x) const
 {
@@ -99,15 +358,10 @@ DoubleType ScalarData<T, DoubleType>::operator[](size_t x) const
   {
     ret = uniform_value;
   }
-  else if (refdata)
-  {
-    const std::vector<DoubleType> &y = refdata->template GetScalarValues<DoubleType>();
-
-    ret = y[x];
-  }
   else
   {
-    ret = values[x];
+    Evaluate();
+    ret = terms[0][0].GetList()[x];
   }
 
   return ret;
@@ -116,28 +370,125 @@ DoubleType ScalarData<T, DoubleType>::operator[](size_t x) const
 template <typename T, typename DoubleType>
 DoubleType &ScalarData<T, DoubleType>::operator[](size_t x)
 {
-  MakeAssignable();
-
-  return values[x];
+  return MakeAssignable()[x];
 }
 
 template <typename T, typename DoubleType>
 const std::vector<DoubleType> &ScalarData<T, DoubleType>::GetScalarList() const
 {
-  const std::vector<DoubleType> *data = &values;
-
   if (isuniform)
   {
     //// We are still uniform
-    values.clear();
-    values.resize(length, uniform_value);
+    uniform_values.clear();
+    uniform_values.resize(length, uniform_value);
+    return uniform_values;
   }
-  else if (refdata)
+
+  Evaluate();
+
+  return terms[0][0].GetList();
+}
+
+//// Operations are only deferred when they can be evaluated from left to
+//// right, so the result is the same as evaluating each operation in turn.
+template <typename T, typename DoubleType>
+void ScalarData<T, DoubleType>::DeferOp(const ScalarData &esd, const ScalarDataHelper::times_equal<DoubleType> &)
+{
+  if (isuniform || IsFactor())
   {
-    data = &(refdata->template GetScalarValues<DoubleType>());
+    //// x * (y0 + y1) == (y0 + y1) * x
+    const factor x = isuniform ? MakeFactor(uniform_value) : terms[0][0];
+    terms = esd.terms;
+    scale = esd.scale;
+    uniform_value = 0.0;
+    isuniform = false;
+    AppendFactor(x);
   }
+  else
+  {
+    if (!esd.IsFactor())
+    {
+      esd.Evaluate();
+    }
+    AppendFactor(esd.terms[0][0]);
+  }
+}
 
-  return *data;
+template <typename T, typename DoubleType>
+void ScalarData<T, DoubleType>::DeferOp(const ScalarData &esd, const ScalarDataHelper::plus_equal<DoubleType> &)
+{
+  if (!esd.scale.empty())
+  {
+    esd.Evaluate();
+  }
+
+  if (isuniform)
+  {
+    //// u + (y0 + y1) == (y0 + y1) + u
+    sum_t sum = esd.terms;
+    sum.push_back(term_t(1, MakeFactor(uniform_value)));
+    terms.swap(sum);
+    uniform_value = 0.0;
+    isuniform = false;
+    return;
+  }
+
+  if (!scale.empty())
+  {
+    Evaluate();
+  }
+
+  if (esd.terms.size() == 1)
+  {
+    terms.push_back(esd.terms[0]);
+  }
+  else if (terms.size() == 1)
+  {
+    //// x + (y0 + y1) == (y0 + y1) + x
+    sum_t sum = esd.terms;
+    sum.push_back(terms[0]);
+    terms.swap(sum);
+  }
+  else
+  {
+    esd.Evaluate();
+    terms.push_back(esd.terms[0]);
+  }
+}
+
+template <typename T, typename DoubleType> template <typename V>
+void ScalarData<T, DoubleType>::DeferOp(const ScalarData &esd, const V &myop)
+{
+  std::vector<DoubleType> &values = MakeAssignable();
+
+  const std::vector<DoubleType> &ovals = esd.GetScalarList();
+
+  SerialVectorVectorOpEqual<V, DoubleType> foo(values, ovals, myop);
+  OpEqualRun(foo, values.size());
+}
+
+template <typename T, typename DoubleType>
+void ScalarData<T, DoubleType>::DeferScalarOp(const DoubleType &v, const ScalarDataHelper::times_equal<DoubleType> &)
+{
+  AppendFactor(MakeFactor(v));
+}
+
+template <typename T, typename DoubleType>
+void ScalarData<T, DoubleType>::DeferScalarOp(const DoubleType &v, const ScalarDataHelper::plus_equal<DoubleType> &)
+{
+  if (!scale.empty())
+  {
+    Evaluate();
+  }
+  terms.push_back(term_t(1, MakeFactor(v)));
+}
+
+template <typename T, typename DoubleType> template <typename V>
+void ScalarData<T, DoubleType>::DeferScalarOp(const DoubleType &v, const V &myop)
+{
+  std::vector<DoubleType> &values = MakeAssignable();
+  SerialVectorScalarOpEqual<V, DoubleType> foo(values, v, myop);
+  OpEqualRun(foo, values.size());
 }
 
 template <typename T, typename DoubleType> template <typename V>
@@ -160,14 +511,14 @@ ScalarData<T, DoubleType> &ScalarData<T, DoubleType>::op_equal_data(const Scalar
     const DoubleType &oval = esd.uniform_value;
     this->op_equal_scalar(oval, myop);
   }
+  else if (this == &esd)
+  {
+    const ScalarData<T, DoubleType> other(esd);
+    DeferOp(other, myop);
+  }
   else
   {
-    MakeAssignable();
-
-    const std::vector<DoubleType> &ovals = esd.GetScalarList();
-
-    SerialVectorVectorOpEqual<V, DoubleType> foo(values, ovals, myop);
-    OpEqualRun(foo, values.size());
+    DeferOp(esd, myop);
   }
   return *this;
 }
@@ -181,9 +532,7 @@ ScalarData<T, DoubleType> &ScalarData<T, DoubleType>::op_equal_scalar(const Doub
   }
   else
   {
-    MakeAssignable();
-    SerialVectorScalarOpEqual<V, DoubleType> foo(values, v, myop);
-    OpEqualRun(foo, values.size());
+    DeferScalarOp(v, myop);
   }
   return *this;
 }
@@ -18,6 +18,7 @@ limitations under the License.
 #ifndef SCALAR_DATA_HH
 #define SCALAR_DATA_HH
 #include <vector>
+#include <memory>
 #include <cstddef>
 
 namespace ScalarDataHelper {
@@ -87,6 +88,7 @@ class ScalarData {
         explicit ScalarData(const T &);
         ScalarData(const ScalarData &);
         explicit ScalarData(const std::vector<DoubleType> &);
+        explicit ScalarData(std::vector<DoubleType> &&);
 
         ScalarData &operator=(const ScalarData &);
 
@@ -137,13 +139,55 @@ class ScalarData {
 
     private:
 
-        void MakeAssignable() const;
+        //// A factor of a deferred product, either a scalar value, a model,
+        //// or a list computed by an earlier evaluation
+        struct factor {
+          DoubleType                                value;
+          const reftype                            *model;
+          std::shared_ptr<std::vector<DoubleType> > data;
+
+          bool IsScalar() const
+          {
+            return (!model) && (!data);
+          }
+
+          const std::vector<DoubleType> &GetList() const;
+        };
+
+        //// factors are multiplied from left to right
+        typedef std::vector<factor> term_t;
+        //// terms are added from left to right
+        typedef std::vector<term_t> sum_t;
+
+        static factor MakeFactor(DoubleType);
+        static factor MakeFactor(const reftype *);
+        static factor MakeFactor(const std::shared_ptr<std::vector<DoubleType> > &);
+
+        bool IsList() const;
+        bool IsFactor() const;
+        void AppendFactor(const factor &);
+        void Evaluate() const;
+        std::vector<DoubleType> &MakeAssignable();
+
+        void DeferOp(const ScalarData &, const ScalarDataHelper::times_equal<DoubleType> &);
+        void DeferOp(const ScalarData &, const ScalarDataHelper::plus_equal<DoubleType> &);
+        template <typename V> void DeferOp(const ScalarData &, const V &);
+
+        void DeferScalarOp(const DoubleType &, const ScalarDataHelper::times_equal<DoubleType> &);
+        void DeferScalarOp(const DoubleType &, const ScalarDataHelper::plus_equal<DoubleType> &);
+        template <typename V> void DeferScalarOp(const DoubleType &, const V &);
 
         ScalarData();
-        mutable const reftype *refdata;
-        mutable std::vector<DoubleType> values;
-        mutable bool           isuniform;
-        mutable DoubleType     uniform_value;
-        size_t                 length;
+        //// Non uniform data is a sum of products, multiplied by the scale
+        //// factors.  Multiplications and additions are recorded in the same
+        //// order they are requested, and evaluated together in a single pass
+        //// once the values are needed.
+        mutable sum_t                   terms;
+        mutable term_t                  scale;
+        //// storage for GetScalarList of uniform data
+        mutable std::vector<DoubleType> uniform_values;
+        bool                            isuniform;
+        DoubleType                      uniform_value;
+        size_t                          length;
 };
 #endif
@@ -18,6 +18,7 @@ limitations under the License.
 #include "TetrahedronEdgeModel.hh"
 #include "Region.hh"
 #include "FPECheck.hh"
+#include "PhaseTimer.hh"
 #include "Device.hh"
 #include "dsAssert.hh"
 #include "EdgeData.hh"
@@ -70,7 +71,9 @@ void TetrahedronEdgeModel::CalculateValues() const
   FPECheck::ClearFPE();
   if (!uptodate)
   {
+    PhaseTimerScope timer("model_evaluation");
     inprocess = true;
+    myregion->RecordRecompute(name);
     this->calcTetrahedronEdgeScalarValues();
     uptodate = true;
     inprocess = false;
@@ -90,6 +90,13 @@ void TetrahedronEdgeSubModel<DoubleType>::calcTetrahedronEdgeScalarValues() cons
     }
 }
 
+//// Same condition as Serialize
+template <typename DoubleType>
+bool TetrahedronEdgeSubModel<DoubleType>::IsSerializedAsData() const
+{
+  return parentModelName.empty() && !this->IsUniform();
+}
+
 template <typename DoubleType>
 void TetrahedronEdgeSubModel<DoubleType>::Serialize(std::ostream &of) const
 {
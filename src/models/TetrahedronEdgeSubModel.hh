@@ -32,6 +32,8 @@ class TetrahedronEdgeSubModel : public TetrahedronEdgeModel
 
         void Serialize(std::ostream &) const;
 
+        bool IsSerializedAsData() const;
+
         static TetrahedronEdgeModelPtr CreateTetrahedronEdgeSubModel(const std::string &, RegionPtr, TetrahedronEdgeModel::DisplayType);
         static TetrahedronEdgeModelPtr CreateTetrahedronEdgeSubModel(const std::string &, RegionPtr, TetrahedronEdgeModel::DisplayType, ConstTetrahedronEdgeModelPtr);
 
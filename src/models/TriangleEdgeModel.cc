@@ -19,6 +19,7 @@ limitations under the License.
 #include "TriangleEdgeScalarData.hh"
 #include "Region.hh"
 #include "FPECheck.hh"
+#include "PhaseTimer.hh"
 #include "Device.hh"
 #include "dsAssert.hh"
 #include "Edge.hh"
@@ -68,7 +69,9 @@ void TriangleEdgeModel::CalculateValues() const
   FPECheck::ClearFPE();
   if (!uptodate)
   {
+    PhaseTimerScope timer("model_evaluation");
     inprocess = true;
+    myregion->RecordRecompute(name);
     this->calcTriangleEdgeScalarValues();
     uptodate = true;
     inprocess = false;
@@ -141,6 +141,12 @@ class TriangleEdgeModel {
 
         void DevsimSerialize(std::ostream &) const;
 
+        /// True when Serialize writes the values in a DATA section
+        virtual bool IsSerializedAsData() const
+        {
+          return false;
+        }
+
         const std::string &GetRegionName() const;
 
         const std::string &GetDeviceName() const;
@@ -91,6 +91,13 @@ void TriangleEdgeSubModel<DoubleType>::calcTriangleEdgeScalarValues() const
     }
 }
 
+//// Same condition as Serialize
+template <typename DoubleType>
+bool TriangleEdgeSubModel<DoubleType>::IsSerializedAsData() const
+{
+  return parentModelName.empty() && !this->IsUniform();
+}
+
 template <typename DoubleType>
 void TriangleEdgeSubModel<DoubleType>::Serialize(std::ostream &of) const
 {
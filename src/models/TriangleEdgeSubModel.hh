@@ -32,6 +32,8 @@ class TriangleEdgeSubModel : public TriangleEdgeModel
 
         void Serialize(std::ostream &) const;
 
+        bool IsSerializedAsData() const;
+
         static TriangleEdgeModelPtr CreateTriangleEdgeSubModel(const std::string &, RegionPtr, TriangleEdgeModel::DisplayType);
         static TriangleEdgeModelPtr CreateTriangleEdgeSubModel(const std::string &, RegionPtr, TriangleEdgeModel::DisplayType, ConstTriangleEdgeModelPtr);
 
@@ -16,7 +16,7 @@ limitations under the License.
 ***/
 
 #include "myThreadPool.hh"
-#include "myqueue.hh"
+#include "myscheduler.hh"
 #include "GlobalData.hh"
 #include "OutputStream.hh"
 #include "ObjectHolder.hh"
@@ -25,7 +25,6 @@ limitations under the License.
 
 
 myThreadPool *myThreadPool::instance_ = 0;
-myqueue      *myThreadPool::queue_ = 0;
 
 myThreadPool &myThreadPool::GetInstance()
 {
@@ -98,39 +97,77 @@ size_t GetMinimumTaskSize()
 
   return ret;
 }
+
+bool GetThreadPinning()
+{
+  bool ret = false;
+  GlobalData &gdata = GlobalData::GetInstance();
+  GlobalData::DBEntry_t dbent = gdata.GetDBEntryOnGlobal("threads_pin");
+  if (dbent.first)
+  {
+    ObjectHolder::IntegerEntry_t ient = dbent.second.GetInteger();
+    if (!ient.first)
+    {
+      std::ostringstream os;
+      os << "Expected 0 or 1 for \"threads_pin\" parameter, but " << dbent.second.GetString() << " was given.\n";
+      OutputStream::WriteOut(OutputStream::OutputType::INFO, os.str());
+    }
+    else
+    {
+      ret = (ient.second != 0);
+    }
+  }
+
+  return ret;
 }
 
-myThreadPool::myThreadPool()
+myscheduler *CreateScheduler(size_t numthreads, bool pin, size_t mintasksize)
 {
-  //// The interpreter must be created at this point
-  const size_t numthreads = GetThreadsToStart();  
-  const size_t mintasksize = GetMinimumTaskSize();  
-  queue_ = new myqueue(numthreads, mintasksize);
+  myscheduler *ret = new myscheduler(numthreads, pin);
   if (numthreads > 1)
   {
-    queue_->StartThreads();
+    std::ostringstream os;
+    os << "Using " << numthreads << " threads.\n";
+    os << "Using " << mintasksize << " minimum task size.\n";
+    OutputStream::WriteOut(OutputStream::OutputType::INFO, os.str());
   }
+  return ret;
+}
+}
+
+myThreadPool::myThreadPool()
+{
+  //// The interpreter must be created at this point
+  const size_t mintasksize = GetMinimumTaskSize();
+  scheduler_ = CreateScheduler(GetThreadsToStart(), GetThreadPinning(), mintasksize);
+  scheduler_->SetGrainSize(mintasksize);
 }
 
 
-myqueue &myThreadPool::GetQueue()
+myscheduler &myThreadPool::GetScheduler()
 {
   //// Check to see if requirement changed
-  const size_t threads_set = GetThreadsToStart();
-  if (queue_->GetNumberThreads() != threads_set)
+  const size_t mintasksize = GetMinimumTaskSize();
+
+  size_t threads_set = GetThreadsToStart();
+  if (threads_set == 0)
   {
-    queue_->ChangeNumberThreads(threads_set);
+    threads_set = 1;
   }
+  const bool pin_set = GetThreadPinning();
 
-  const size_t task_size = GetMinimumTaskSize();
-  queue_->SetMinimumTaskSize(task_size);
+  if ((scheduler_->GetNumberThreads() != threads_set) || (scheduler_->IsPinned() != pin_set))
+  {
+    delete scheduler_;
+    scheduler_ = CreateScheduler(threads_set, pin_set, mintasksize);
+  }
+  scheduler_->SetGrainSize(mintasksize);
 
-  return *queue_;
+  return *scheduler_;
 }
 
 myThreadPool::~myThreadPool()
 {
-  queue_->ExitThreads();
-  delete queue_;
+  delete scheduler_;
 }
 
@@ -16,8 +16,12 @@ limitations under the License.
 ***/
 
 
-class myqueue;
+#include <cstddef>
 
+class myscheduler;
+
+//// Owns the scheduler used by parallel_for, configured from the
+//// "threads_available", "threads_task_size" and "threads_pin" parameters
 class myThreadPool
 {
   public:
@@ -25,7 +29,9 @@ class myThreadPool
 
     static void DestroyInstance();
 
-    static myqueue &GetQueue();
+    /// Restarts the threads when the parameters changed since the last call.
+    /// Must not be called from the worker threads.
+    myscheduler &GetScheduler();
 
   private:
     myThreadPool();
@@ -34,6 +40,6 @@ class myThreadPool
     ~myThreadPool();
 
     static myThreadPool *instance_;
-    static myqueue      *queue_;
+    myscheduler         *scheduler_;
 };
 
@@ -0,0 +1,166 @@
+/***
+DEVSIM
+Copyright 2013 Devsim LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+***/
+
+#ifndef MYDEQUE_HH
+#define MYDEQUE_HH
+#include <atomic>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Lock free work stealing deque of pointers (Chase and Lev).
+ *
+ * Only the thread owning the deque may call push and pop, which work on the
+ * bottom end.  Any other thread may call steal, which takes from the top
+ * end.  The storage grows as needed, and old storage is only released when
+ * the deque is destroyed, since a thief may still be reading from it.
+ */
+template <typename T>
+class mydeque {
+  public:
+    mydeque() : top_(0), bottom_(0), array_(new ring(64))
+    {
+    }
+
+    ~mydeque()
+    {
+      delete array_.load(std::memory_order_relaxed);
+      for (size_t i = 0; i < retired_.size(); ++i)
+      {
+        delete retired_[i];
+      }
+    }
+
+    void push(T *x)
+    {
+      const int64_t b = bottom_.load(std::memory_order_relaxed);
+      const int64_t t = top_.load(std::memory_order_acquire);
+      ring *a = array_.load(std::memory_order_relaxed);
+      if ((b - t) > static_cast<int64_t>(a->mask))
+      {
+        retired_.push_back(a);
+        a = a->grow(t, b);
+        array_.store(a, std::memory_order_release);
+      }
+      a->put(b, x);
+      bottom_.store(b + 1, std::memory_order_release);
+    }
+
+    /// NULL when empty
+    T *pop()
+    {
+      const int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+      ring *a = array_.load(std::memory_order_relaxed);
+      bottom_.store(b, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      int64_t t = top_.load(std::memory_order_relaxed);
+
+      T *x = NULL;
+      if (t <= b)
+      {
+        x = a->get(b);
+        if (t == b)
+        {
+          //// last item, race against the thieves
+          if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+          {
+            x = NULL;
+          }
+          bottom_.store(b + 1, std::memory_order_relaxed);
+        }
+      }
+      else
+      {
+        bottom_.store(b + 1, std::memory_order_relaxed);
+      }
+      return x;
+    }
+
+    /// NULL when empty, or when another thread won the race
+    T *steal()
+    {
+      int64_t t = top_.load(std::memory_order_acquire);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      const int64_t b = bottom_.load(std::memory_order_acquire);
+
+      T *x = NULL;
+      if (t < b)
+      {
+        ring *a = array_.load(std::memory_order_acquire);
+        x = a->get(t);
+        if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        {
+          x = NULL;
+        }
+      }
+      return x;
+    }
+
+    bool empty() const
+    {
+      const int64_t b = bottom_.load(std::memory_order_relaxed);
+      const int64_t t = top_.load(std::memory_order_relaxed);
+      return b <= t;
+    }
+
+  private:
+    mydeque(const mydeque &);
+    mydeque &operator=(const mydeque &);
+
+    /// capacity is a power of 2
+    struct ring {
+      explicit ring(size_t c) : mask(c - 1), items(new std::atomic<T *>[c])
+      {
+      }
+
+      ~ring()
+      {
+        delete [] items;
+      }
+
+      T *get(int64_t i) const
+      {
+        return items[static_cast<size_t>(i) & mask].load(std::memory_order_relaxed);
+      }
+
+      void put(int64_t i, T *x)
+      {
+        items[static_cast<size_t>(i) & mask].store(x, std::memory_order_relaxed);
+      }
+
+      ring *grow(int64_t t, int64_t b) const
+      {
+        ring *ret = new ring(2 * (mask + 1));
+        for (int64_t i = t; i < b; ++i)
+        {
+          ret->put(i, get(i));
+        }
+        return ret;
+      }
+
+      const size_t      mask;
+      std::atomic<T *> *items;
+    };
+
+    std::atomic<int64_t> top_;
+    std::atomic<int64_t> bottom_;
+    std::atomic<ring *>  array_;
+    /// only touched by the owner
+    std::vector<ring *>  retired_;
+};
+#endif
@@ -0,0 +1,266 @@
+/***
+DEVSIM
+Copyright 2013 Devsim LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+***/
+
+#include "myscheduler.hh"
+#include "myworker.hh"
+#include "dsAssert.hh"
+
+#include <thread>
+
+#if defined(__linux__)
+#include <sched.h>
+#elif defined(_WIN32)
+#include <Windows.h>
+#endif
+
+namespace {
+//// The scheduler and deque of the calling thread, while it runs tasks
+thread_local myscheduler *current_scheduler = NULL;
+thread_local size_t       current_index     = 0;
+
+//// Number of failed attempts to find work before a worker sleeps
+const size_t spin_limit = 64;
+
+void PinThread(size_t index)
+{
+#if defined(__linux__)
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+  {
+    return;
+  }
+
+  const size_t count = CPU_COUNT(&allowed);
+  if (count == 0)
+  {
+    return;
+  }
+
+  //// the index-th processor this process is allowed to run on
+  size_t target = index % count;
+  for (size_t cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+  {
+    if (CPU_ISSET(cpu, &allowed))
+    {
+      if (target == 0)
+      {
+        cpu_set_t one;
+        CPU_ZERO(&one);
+        CPU_SET(cpu, &one);
+        sched_setaffinity(0, sizeof(one), &one);
+        break;
+      }
+      --target;
+    }
+  }
+#elif defined(_WIN32)
+  const size_t bits = 8 * sizeof(DWORD_PTR);
+  SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << (index % bits));
+#else
+  (void) index;
+#endif
+}
+}
+
+myscheduler::myscheduler(size_t num, bool pin) : num_threads_(num), pin_(pin), grain_size_(0), sleeping_(0), epoch_(0), exit_(false)
+{
+  if (num_threads_ == 0)
+  {
+    num_threads_ = 1;
+  }
+
+  for (size_t i = 0; i < num_threads_; ++i)
+  {
+    deques_.push_back(deque_ptr(new deque_t()));
+  }
+
+  for (size_t i = 1; i < num_threads_; ++i)
+  {
+    workers_.push_back(myworker_ptr(new myworker(*this, i, sleep_mutex_, sleep_condition_)));
+    workers_.back()->start();
+  }
+}
+
+myscheduler::~myscheduler()
+{
+  sleep_mutex_.lock();
+  exit_.store(true);
+  sleep_condition_.broadcast();
+  sleep_mutex_.unlock();
+
+  for (size_t i = 0; i < workers_.size(); ++i)
+  {
+    workers_[i]->join();
+  }
+  workers_.clear();
+
+  //// tasks are only left over if a Run was abandoned
+  for (size_t i = 0; i < deques_.size(); ++i)
+  {
+    while (mypacket *t = deques_[i]->pop())
+    {
+      delete t;
+    }
+  }
+}
+
+myscheduler *myscheduler::GetCurrent()
+{
+  return current_scheduler;
+}
+
+namespace {
+//// Makes the calling thread the owner of the first deque, and gives it
+//// back, even if a task throws
+class CallerScope {
+  public:
+    CallerScope(myscheduler &s, mymutex &m) : mutex_(m), previous_scheduler_(current_scheduler), previous_index_(current_index)
+    {
+      mutex_.lock();
+      current_scheduler = &s;
+      current_index     = 0;
+    }
+
+    ~CallerScope()
+    {
+      current_scheduler = previous_scheduler_;
+      current_index     = previous_index_;
+      mutex_.unlock();
+    }
+
+  private:
+    CallerScope();
+    CallerScope(const CallerScope &);
+    CallerScope &operator=(const CallerScope &);
+
+    mymutex           &mutex_;
+    myscheduler *const previous_scheduler_;
+    const size_t       previous_index_;
+};
+}
+
+void myscheduler::Run(mypacket *task, const std::atomic<size_t> &pending)
+{
+  if (current_scheduler == this)
+  {
+    //// nested call from a task
+    Spawn(task);
+    Wait(current_index, pending);
+    return;
+  }
+
+  CallerScope caller(*this, caller_mutex_);
+
+  Spawn(task);
+  Wait(0, pending);
+}
+
+void myscheduler::Spawn(mypacket *task)
+{
+  dsAssert(current_scheduler == this, "UNEXPECTED");
+
+  deques_[current_index]->push(task);
+  epoch_.fetch_add(1);
+
+  if (sleeping_.load() != 0)
+  {
+    sleep_mutex_.lock();
+    sleep_condition_.broadcast();
+    sleep_mutex_.unlock();
+  }
+}
+
+//// Tasks must not throw, since nothing on a worker could catch it.
+//// RangePacket keeps its exceptions for the thread calling parallel_for.
+void myscheduler::Execute(mypacket *task)
+{
+  std::unique_ptr<mypacket> owned(task);
+  owned->run();
+}
+
+//// Our own deque first, in last in first out order, then steal from the others
+mypacket *myscheduler::FindTask(size_t self)
+{
+  mypacket *ret = deques_[self]->pop();
+  for (size_t i = 1; (!ret) && (i < num_threads_); ++i)
+  {
+    ret = deques_[(self + i) % num_threads_]->steal();
+  }
+  return ret;
+}
+
+void myscheduler::Wait(size_t self, const std::atomic<size_t> &pending)
+{
+  while (pending.load(std::memory_order_acquire) != 0)
+  {
+    mypacket *task = FindTask(self);
+    if (task)
+    {
+      Execute(task);
+    }
+    else
+    {
+      std::this_thread::yield();
+    }
+  }
+}
+
+void myscheduler::WorkerLoop(size_t index)
+{
+  current_scheduler = this;
+  current_index     = index;
+
+  if (pin_)
+  {
+    PinThread(index);
+  }
+
+  size_t spins = 0;
+  while (!exit_.load())
+  {
+    const size_t epoch = epoch_.load();
+
+    mypacket *task = FindTask(index);
+    if (task)
+    {
+      Execute(task);
+      spins = 0;
+      continue;
+    }
+
+    if (++spins < spin_limit)
+    {
+      std::this_thread::yield();
+      continue;
+    }
+    spins = 0;
+
+    //// Spawn changes the epoch before checking for sleepers,
+    //// so the wake up cannot be missed
+    sleep_mutex_.lock();
+    sleeping_.fetch_add(1);
+    while ((!exit_.load()) && (epoch_.load() == epoch))
+    {
+      sleep_condition_.wait(sleep_mutex_);
+    }
+    sleeping_.fetch_sub(1);
+    sleep_mutex_.unlock();
+  }
+
+  current_scheduler = NULL;
+}
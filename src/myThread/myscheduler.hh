@@ -0,0 +1,114 @@
+/***
+DEVSIM
+Copyright 2013 Devsim LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+***/
+
+#ifndef MYSCHEDULER_HH
+#define MYSCHEDULER_HH
+#include "mymutex.hh"
+#include "mycondition.hh"
+#include "mypacket.hh"
+#include "mydeque.hh"
+
+#include <atomic>
+#include <vector>
+#include <memory>
+#include <cstddef>
+
+class myworker;
+typedef std::shared_ptr<myworker> myworker_ptr;
+
+/**
+ * Work stealing scheduler.  Every thread has its own deque of tasks.  New
+ * tasks go to the bottom of the deque of the thread creating them, and idle
+ * threads steal from the top of the other deques, so the common case does
+ * not need a lock.  Threads only take the mutex to sleep when no work is
+ * left anywhere.
+ *
+ * The first deque belongs to the thread calling Run, so a scheduler for n
+ * threads starts n - 1 workers.  Only one thread outside of the workers may
+ * call Run at a time.  Tasks may call Run again, e.g. for a nested
+ * parallel_for.
+ */
+class myscheduler
+{
+  public:
+    /// Workers are pinned to processors when pin is true and the platform supports it
+    myscheduler(size_t /*num_threads*/, bool /*pin*/);
+    ~myscheduler();
+
+    size_t GetNumberThreads() const
+    {
+      return num_threads_;
+    }
+
+    bool IsPinned() const
+    {
+      return pin_;
+    }
+
+    /// Default grain size for parallel_for
+    size_t GetGrainSize() const
+    {
+      return grain_size_;
+    }
+
+    void SetGrainSize(size_t g)
+    {
+      grain_size_ = g;
+    }
+
+    /// The scheduler running the task on the calling thread, or NULL
+    static myscheduler *GetCurrent();
+
+    /// Runs the task and anything it spawns, until the count reaches 0.
+    /// Ownership of the task is passed to the scheduler.  Tasks must not
+    /// throw; parallel_for passes its exceptions back to the caller.
+    void Run(mypacket *, const std::atomic<size_t> &);
+
+    /// Only for tasks called from Run.  Ownership of the task is passed to the scheduler.
+    void Spawn(mypacket *);
+
+    /// Called by each worker
+    void WorkerLoop(size_t);
+
+  private:
+    myscheduler();
+    myscheduler(const myscheduler &);
+    myscheduler &operator=(const myscheduler &);
+
+    void Wait(size_t, const std::atomic<size_t> &);
+    mypacket *FindTask(size_t);
+    void Execute(mypacket *);
+
+    typedef mydeque<mypacket> deque_t;
+    typedef std::shared_ptr<deque_t> deque_ptr;
+
+    size_t                     num_threads_;
+    bool                       pin_;
+    size_t                     grain_size_;
+    std::vector<deque_ptr>     deques_;
+    std::vector<myworker_ptr>  workers_;
+    /// external callers take turns at the first deque
+    mymutex                    caller_mutex_;
+    /// for sleeping workers
+    mymutex                    sleep_mutex_;
+    mycondition                sleep_condition_;
+    std::atomic<size_t>        sleeping_;
+    /// changes every time a task is spawned
+    std::atomic<size_t>        epoch_;
+    std::atomic<bool>          exit_;
+};
+#endif
@@ -16,12 +16,10 @@ limitations under the License.
 ***/
 
 #include "myworker.hh"
-#include "mymutex.hh"
-#include "mycondition.hh"
+#include "myscheduler.hh"
 
-/// need to avoid slicing problem by using pointer to packet
-myworker::myworker(mymutex &m, mycondition &c, std::list<mypacket_ptr> &q, size_t &threadexit)
-    : threadBaseClass(m, c), queue(q), threadExit(threadexit)
+myworker::myworker(myscheduler &s, size_t i, mymutex &m, mycondition &c)
+    : threadBaseClass(m, c), scheduler(s), index(i)
 {}
 
 myworker::~myworker()
@@ -29,27 +27,5 @@ myworker::~myworker()
 
 void myworker::run()
 {
-    // This is the reference to my packet
-    mypacket_ptr x;
-    // keep looping forever
-    while (true)
-    {
-	this->lock();
-	while (queue.empty())
-	{
-	    if (threadExit == 1)
-	    {
-		this->unlock();
-		return;
-	    }
-	    this->wait();
-	}
-	x = queue.front();
-	queue.erase(queue.begin());
-	this->unlock();
-	// This will run
-	// Somehow it must signal it is done to the owner
-	x->run();
-//	std::cout << getThreadId() << std::endl;
-    }
+    scheduler.WorkerLoop(index);
 }
@@ -18,25 +18,19 @@ limitations under the License.
 #ifndef MYWORKER_HH
 #define MYWORKER_HH
 #include "threadBaseClass.hh"
-#include "mypacket.hh"
-#include <list>
+class myscheduler;
 /**
- * Class which creates worker threads.  These threads share the same queue
- * of mypacket's to be processed.
- * The size_t &threadExit must be protected by the mutex.
- * When threadExit == 1, it is time to terminate the thread.
- * Calling function would:
- * 1. Lock the mutex
- * 2. Set the threadExit = 1
- * 3. Broadcast the condition variable
+ * Worker thread of a myscheduler.  The mutex and condition variable are
+ * shared by all the workers for sleeping when there is nothing to steal.
  */
 class myworker : public threadBaseClass {
     public:
-	myworker(mymutex &, mycondition &, std::list<mypacket_ptr> &, size_t &);
+	myworker(myscheduler &, size_t, mymutex &, mycondition &);
 	~myworker();
 	void run();
     private:
-	std::list<mypacket_ptr>    &queue;
-	size_t &threadExit;
+	myscheduler &scheduler;
+	/// index of the deque owned by this worker
+	size_t       index;
 };
 #endif
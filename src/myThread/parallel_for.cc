@@ -0,0 +1,154 @@
+/***
+DEVSIM
+Copyright 2013 Devsim LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+***/
+
+#include "parallel_for.hh"
+#include "myThreadPool.hh"
+#include "myscheduler.hh"
+#include "FPECheck.hh"
+
+#include <atomic>
+#include <algorithm>
+#include <exception>
+
+namespace {
+//// Number of pieces per thread, so that stealing can balance the load
+const size_t pieces_per_thread = 4;
+
+struct RangeState {
+  RangeState(const myrangetask &b, myscheduler &s, size_t l) : body(b), scheduler(s), leaf_size(l), pending(1), fpe_flags(FPECheck::getClearedFlag()), failed(false)
+  {
+  }
+
+  const myrangetask                &body;
+  myscheduler                      &scheduler;
+  const size_t                      leaf_size;
+  std::atomic<size_t>               pending;
+  std::atomic<FPECheck::FPEFlag_t>  fpe_flags;
+  //// only the first exception is kept, and the rest of the range is skipped
+  std::atomic<bool>                 failed;
+  std::exception_ptr                error;
+};
+
+//// Collects the floating point exceptions of the body, and restores the
+//// ones of the task this thread was already running, even when the body throws
+class ThreadFPEScope {
+  public:
+    explicit ThreadFPEScope(std::atomic<FPECheck::FPEFlag_t> &f) : fpe_flags_(f), previous_(FPECheck::getThreadFPEFlags())
+    {
+      FPECheck::clearThreadFPE();
+    }
+
+    ~ThreadFPEScope()
+    {
+      fpe_flags_.fetch_or(FPECheck::getThreadFPEFlags());
+      FPECheck::clearThreadFPE();
+      FPECheck::raiseThreadFPE(previous_);
+    }
+
+  private:
+    ThreadFPEScope();
+    ThreadFPEScope(const ThreadFPEScope &);
+    ThreadFPEScope &operator=(const ThreadFPEScope &);
+
+    std::atomic<FPECheck::FPEFlag_t> &fpe_flags_;
+    const FPECheck::FPEFlag_t         previous_;
+};
+
+class RangePacket : public mypacket {
+  public:
+    RangePacket(RangeState &s, size_t b, size_t e) : state_(s), beg_(b), end_(e)
+    {
+    }
+
+    ~RangePacket() {}
+
+    //// Keeps the first half and hands out the second half, until the
+    //// piece is small enough.  Exceptions are kept for the calling thread,
+    //// since they cannot leave a worker, and the count is always decremented,
+    //// so the state is not released while other pieces still use it.
+    void run()
+    {
+      try
+      {
+        size_t e = end_;
+        while ((e - beg_) > state_.leaf_size)
+        {
+          const size_t m = beg_ + (e - beg_) / 2;
+          state_.pending.fetch_add(1);
+          state_.scheduler.Spawn(new RangePacket(state_, m, e));
+          e = m;
+        }
+
+        if (!state_.failed.load())
+        {
+          ThreadFPEScope fpe(state_.fpe_flags);
+          state_.body(beg_, e);
+        }
+      }
+      catch (...)
+      {
+        if (!state_.failed.exchange(true))
+        {
+          state_.error = std::current_exception();
+        }
+      }
+
+      state_.pending.fetch_sub(1, std::memory_order_release);
+    }
+
+  private:
+    RangePacket();
+    RangePacket(const RangePacket &);
+    RangePacket &operator=(const RangePacket &);
+
+    RangeState   &state_;
+    const size_t  beg_;
+    const size_t  end_;
+};
+}
+
+void parallel_for(const myrangetask &body, size_t length, size_t grain)
+{
+  //// Nested calls stay on the scheduler of the enclosing task
+  myscheduler *current = myscheduler::GetCurrent();
+  myscheduler &scheduler = current ? *current : myThreadPool::GetInstance().GetScheduler();
+  const size_t num_threads = scheduler.GetNumberThreads();
+
+  if (grain == 0)
+  {
+    grain = scheduler.GetGrainSize();
+  }
+
+  if ((num_threads < 2) || (length <= grain))
+  {
+    body(0, length);
+    return;
+  }
+
+  const size_t max_pieces = pieces_per_thread * num_threads;
+  const size_t leaf_size = std::max(std::max(grain, size_t(1)), (length + max_pieces - 1) / max_pieces);
+
+  RangeState state(body, scheduler, leaf_size);
+  scheduler.Run(new RangePacket(state, 0, length), state.pending);
+
+  FPECheck::raiseThreadFPE(state.fpe_flags.load());
+
+  if (state.error)
+  {
+    std::rethrow_exception(state.error);
+  }
+}
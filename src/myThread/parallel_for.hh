@@ -0,0 +1,44 @@
+/***
+DEVSIM
+Copyright 2013 Devsim LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+***/
+
+#ifndef PARALLEL_FOR_HH
+#define PARALLEL_FOR_HH
+#include <cstddef>
+
+//// Body of a parallel_for.  It is called on disjoint subranges, possibly at
+//// the same time from several threads.
+class myrangetask {
+  public:
+    virtual ~myrangetask() {}
+    virtual void operator()(const size_t /*begin*/, const size_t /*end*/) const = 0;
+};
+
+//// Calls the body on [0, length) using the thread pool.
+////
+//// The range is split in halves until the pieces are no longer than the
+//// grain size, and idle threads steal the pieces left over by the others.
+//// A grain size of 0 uses the "threads_task_size" parameter, and the range
+//// is never split into more than a few pieces per thread.  Everything runs
+//// in the calling thread when the range is no longer than the grain size,
+//// or "threads_available" is less than 2.
+////
+//// Floating point exceptions from the other threads are raised in the
+//// calling thread.  If a body throws, the pieces which have not started are
+//// skipped, and the first exception is rethrown in the calling thread once
+//// the others have finished.  Calls from inside a body are allowed.
+void parallel_for(const myrangetask &, size_t /*length*/, size_t /*grain*/ = 0);
+#endif
@@ -961,7 +961,7 @@ static const char create_gmsh_mesh_doc[] =
 "    Notes\n"
 "    -----\n"
 "\n"
-"    This file will import a Gmsh format mesh from a file.  Alternatively, the mesh structure may be passed in as as arguments:\n"
+"    This file will import a Gmsh format mesh from a file.  Files in the ascii 2.1 and 2.2 formats, as well as the ascii and binary 4.1 formats, are supported.  In the 4.1 format, the elements of an entity are assigned to each of the physical groups of the entity, and the elements of entities without a physical group are ignored.  Alternatively, the mesh structure may be passed in as as arguments:\n"
 "\n"
 "    ``coordinates`` is a float list of positions in the mesh.  Each coordinate adds an x, y, and z position so that the coordinate list length is 3 times the number of coordinates.\n"
 "\n"
@@ -1000,7 +1000,7 @@ static const char finalize_mesh_doc[] =
 static const char load_devices_doc[] =
 "    ds.load_devices (file)\n"
 "\n"
-"    Load devices from a DEVSIM file\n"
+"    Load devices from a DEVSIM file.  Files written with the 'devsim_binary' type are detected automatically.\n"
 "\n"
 "    Parameters\n"
 "    ----------\n"
@@ -1009,7 +1009,7 @@ static const char load_devices_doc[] =
 ;
 
 static const char write_devices_doc[] =
-"    ds.write_devices (file, device, type)\n"
+"    ds.write_devices (file, device, type, vtk_format, vtk_partitioned, models, asynchronous)\n"
 "\n"
 "    Write a device to a file for visualization or restart\n"
 "\n"
@@ -1019,8 +1019,29 @@ static const char write_devices_doc[] =
 "       name of the file to write the meshes to\n"
 "    device : str, optional\n"
 "       name of the device to write\n"
-"    type : {'devsim', 'devsim_data', 'floops', 'tecplot', 'vtk'}\n"
+"    type : {'devsim', 'devsim_binary', 'devsim_data', 'floops', 'tecplot', 'vtk'}\n"
 "       format to use\n"
+"    vtk_format : {'base64', 'appended'}, optional\n"
+"       compressed data encoded in each element, or appended as raw bytes at the end of each file (default 'base64')\n"
+"    vtk_partitioned : bool, optional\n"
+"       write a '.pvtu' file instead of the '.vtm' and '.visit' files (default False)\n"
+"    models : list, optional\n"
+"       names of the models to write for the 'vtk' type.  All of the models are written when the list is empty\n"
+"    asynchronous : bool, optional\n"
+"       return after copying the data, and write the files in the background.  Only supported for the 'vtk' type (default False)\n"
+"\n"
+"    Notes\n"
+"    -----\n"
+"\n"
+"    For the 'vtk' type, each region is written to its own '.vtu' file.  The data are compressed and the files are written using the available threads.  The '.pvtu' file only lists the models available on every region.\n"
+"\n"
+"    With ``asynchronous``, the data are compressed and written one file at a time by a background thread, so that the simulation may continue.  When two writes are already waiting, the command waits for one of them to start.  Errors in writing the files are reported by :meth:`devsim.wait_for_writes`.  Pending writes are finished before the program exits.  The other types format their data directly from the models, so they are always written before the command returns, and ``asynchronous`` is an error for them.\n"
+;
+
+static const char wait_for_writes_doc[] =
+"    ds.wait_for_writes ()\n"
+"\n"
+"    Wait for the files from ``write_devices`` with the ``asynchronous`` option to be written.  Raises an error if any of them could not be written since the last call.\n"
 ;
 
 static const char contact_edge_model_doc[] =
@@ -1424,7 +1445,7 @@ static const char get_edge_model_list_doc[] =
 ;
 
 static const char get_edge_model_values_doc[] =
-"    ds.get_edge_model_values (device, region, name)\n"
+"    ds.get_edge_model_values (device, region, name, as_array)\n"
 "\n"
 "    Get the edge model values calculated at each edge.\n"
 "\n"
@@ -1436,6 +1457,8 @@ static const char get_edge_model_values_doc[] =
 "       The selected region\n"
 "    name : str\n"
 "       Name of the edge model values being returned as a list\n"
+"    as_array : bool, optional\n"
+"       Return an array.array('d') instead of a tuple, which numpy.frombuffer can use without a copy (default False)\n"
 ;
 
 static const char get_element_model_list_doc[] =
@@ -1452,7 +1475,7 @@ static const char get_element_model_list_doc[] =
 ;
 
 static const char get_element_model_values_doc[] =
-"    ds.get_element_model_values (device, region, name)\n"
+"    ds.get_element_model_values (device, region, name, as_array)\n"
 "\n"
 "    Get element model values at each element edge\n"
 "\n"
@@ -1464,6 +1487,8 @@ static const char get_element_model_values_doc[] =
 "       The selected region\n"
 "    name : str\n"
 "       Name of the element edge model values being returned as a list\n"
+"    as_array : bool, optional\n"
+"       Return an array.array('d') instead of a tuple, which numpy.frombuffer can use without a copy (default False)\n"
 ;
 
 static const char get_interface_model_list_doc[] =
@@ -1508,7 +1533,7 @@ static const char get_node_model_list_doc[] =
 ;
 
 static const char get_node_model_values_doc[] =
-"    ds.get_node_model_values (device, region, name)\n"
+"    ds.get_node_model_values (device, region, name, as_array)\n"
 "\n"
 "    Get node model values evaluated at each node in a region.\n"
 "\n"
@@ -1520,6 +1545,21 @@ static const char get_node_model_values_doc[] =
 "       The selected region\n"
 "    name : str\n"
 "       Name of the node model values being returned as a list\n"
+"    as_array : bool, optional\n"
+"       Return an array.array('d') instead of a tuple, which numpy.frombuffer can use without a copy (default False)\n"
+;
+
+static const char get_recomputed_model_list_doc[] =
+"    ds.get_recomputed_model_list (device, region)\n"
+"\n"
+"    Returns the node, edge and element models recalculated on the device region during the last solver iteration, in the order they were first evaluated.  A model is listed once, even when it is recalculated more than once during the iteration.\n"
+"\n"
+"    Parameters\n"
+"    ----------\n"
+"    device : str\n"
+"       The selected device\n"
+"    region : str\n"
+"       The selected region\n"
 ;
 
 static const char interface_model_doc[] =
@@ -1691,7 +1731,7 @@ static const char set_node_values_doc[] =
 "    init_from : str, optional\n"
 "       Node model we are using to initialize the node solution\n"
 "    values : list, optional\n"
-"       List of values for each node in the region.\n"
+"       List of values for each node in the region.  An array of doubles, such as a numpy float64 array or an array.array('d'), is copied without converting each value.\n"
 ;
 
 static const char symdiff_doc[] =
@@ -1774,6 +1814,17 @@ static const char get_contact_charge_doc[] =
 "       Name of the contact equation from which we are retrieving the charge\n"
 ;
 
+static const char get_phase_timings_doc[] =
+"    ds.get_phase_timings (reset)\n"
+"\n"
+"    Returns the time spent in each phase of the simulation since the last reset, such as model_evaluation, region_assemble, matrix_finalize, lu_factor, lu_solve and region_update.  Each phase has a count, total_time and maximum_time in seconds, and the peak_memory of the process in bytes when it was last left.  Phases may contain other phases, e.g. models are evaluated during assembly.  The peak_memory entry is the current high water mark of the process.\n"
+"\n"
+"    Parameters\n"
+"    ----------\n"
+"    reset : bool, optional\n"
+"       Clear the timings after they are returned\n"
+;
+
 static const char get_contact_current_doc[] =
 "    ds.get_contact_current (device, contact, equation)\n"
 "\n"
@@ -1790,7 +1841,7 @@ static const char get_contact_current_doc[] =
 ;
 
 static const char solve_doc[] =
-"    ds.solve (type, solver_type, absolute_error, relative_error, charge_error, gamma, tdelta, maximum_iterations, frequency, output_node, info)\n"
+"    ds.solve (type, solver_type, absolute_error, relative_error, charge_error, gamma, tdelta, maximum_iterations, frequency, frequencies, output_node, info, preconditioner, fill_level, linear_iterations)\n"
 "\n"
 "    Call the solver.  A small-signal AC source is set with the circuit voltage source.\n"
 "\n"
@@ -1798,8 +1849,10 @@ static const char solve_doc[] =
 "    ----------\n"
 "    type : {'dc', 'ac', 'noise', 'transient_dc', 'transient_bdf1', 'transient_bdf2', 'transient_tr'} required\n"
 "       type of solve being performed\n"
-"    solver_type : {'direct', 'iterative'} required\n"
-"       Linear solver type\n"
+"    solver_type : {'direct', 'mkl_pardiso', 'iterative', 'matrix_free'} required\n"
+"       Linear solver type, 'mkl_pardiso' is a threaded direct solver available when built with MKL\n"
+"       'iterative' with the extended_solver parameter set factors in double precision and refines the solution in extended precision\n"
+"       'matrix_free' solves dc and transient systems with GMRES and a Jacobi preconditioner, reassembling the Jacobian product for each linear iteration instead of storing the matrix\n"
 "    absolute_error : Float, optional\n"
 "       Required update norm in the solve (default 0.0)\n"
 "    relative_error : Float, optional\n"
@@ -1814,8 +1867,51 @@ static const char solve_doc[] =
 "       Maximum number of iterations in the DC solve (default 20)\n"
 "    frequency : Float, optional\n"
 "       Frequency for small-signal AC simulation (default 0.0)\n"
+"    frequencies : list, optional\n"
+"       Frequencies for an 'ac' or 'noise' sweep, which assembles the matrix once and returns a list with the frequency and the real and imag circuit node solution for each frequency.  The device and circuit solutions are left at the last frequency.  For a 'noise' sweep, only the circuit node values are returned for each frequency, and the device noise fields hold the values for the last frequency.\n"
 "    output_node : str, optional\n"
 "       Output circuit node for noise simulation\n"
 "    info : bool, optional\n"
 "       Solve command return convergence information (default False)\n"
+"    preconditioner : {'block', 'ilu'} optional\n"
+"       Preconditioner for the 'iterative' solver type, 'ilu' is a threaded incomplete LU factorization with the equations of each node kept together (default 'block')\n"
+"    fill_level : int, optional\n"
+"       Level of fill for the 'ilu' preconditioner (default 1)\n"
+"    linear_iterations : int, optional\n"
+"       Maximum number of GMRES iterations for the 'iterative' and 'matrix_free' solver types (default 100)\n"
+;
+
+static const char sweep_doc[] =
+"    ds.sweep (device, name, values, contact, absolute_error, relative_error, maximum_iterations, maximum_divisions, predictor, solver_type, preconditioner, fill_level, linear_iterations)\n"
+"\n"
+"    Solve a dc sweep of a device parameter, such as a contact bias.  The parameter is stepped from its present value through each of the values.  When a point does not converge, the solutions are restored and the step to the point is halved.  With a direct solver, each step is started from a first order prediction using the factorization from the last converged point.  Returns a list with a dictionary for each point, containing the value and the currents of the contact equations.\n"
+"\n"
+"    Parameters\n"
+"    ----------\n"
+"    device : str\n"
+"       The selected device\n"
+"    name : str\n"
+"       Name of the device parameter being swept\n"
+"    values : list\n"
+"       Parameter value at each point of the sweep\n"
+"    contact : str, optional\n"
+"       Contact for which the currents are returned\n"
+"    absolute_error : Float, optional\n"
+"       Required update norm in the solve (default 0.0)\n"
+"    relative_error : Float, optional\n"
+"       Required relative update in the solve (default 0.0)\n"
+"    maximum_iterations : int, optional\n"
+"       Maximum number of iterations in each DC solve (default 20)\n"
+"    maximum_divisions : int, optional\n"
+"       Maximum number of times the step to a point is halved, from 0 to 30 (default 10)\n"
+"    predictor : bool, optional\n"
+"       Use the first order prediction (default True)\n"
+"    solver_type : {'direct', 'mkl_pardiso', 'iterative', 'matrix_free'} optional\n"
+"       Linear solver type (default 'direct')\n"
+"    preconditioner : {'block', 'ilu'} optional\n"
+"       Preconditioner for the 'iterative' solver type (default 'block')\n"
+"    fill_level : int, optional\n"
+"       Level of fill for the 'ilu' preconditioner (default 1)\n"
+"    linear_iterations : int, optional\n"
+"       Maximum number of GMRES iterations for the 'iterative' and 'matrix_free' solver types (default 100)\n"
 ;
@@ -20,6 +20,7 @@ limitations under the License.
 #include "ObjectHolder.hh"
 #include "dsAssert.hh"
 #include <limits>
+#include <cstring>
 
 ObjectHolder::ObjectHolder() : object_(NULL)
 {
@@ -130,6 +131,21 @@ ObjectHolder::DoubleEntry_t ObjectHolder::GetDouble() const
         PyErr_Clear();
       }
     }
+    //// other number types, such as the elements of a numpy int64 array
+    else if (PyNumber_Check(obj) && !PyBool_Check(obj))
+    {
+      PyObject *fobj = PyNumber_Float(obj);
+      if (fobj)
+      {
+        ok = true;
+        val = PyFloat_AsDouble(fobj);
+        Py_DECREF(fobj);
+      }
+      else
+      {
+        PyErr_Clear();
+      }
+    }
   }
 
   return std::make_pair(ok, val);
@@ -258,10 +274,77 @@ bool ObjectHolder::GetListOfObjects(ObjectHolderList_t &objs) const
   return ok;
 }
 
+namespace {
+//// Copies the data of a 1 dimensional array of doubles, e.g. a numpy array
+//// of float64 or an array.array('d'), without converting each element.
+//// Returns false if the object does not hold this kind of data.
+bool GetDoubleBuffer(PyObject *obj, std::vector<double> &values)
+{
+  bool ok = false;
+
+  if (PyObject_CheckBuffer(obj))
+  {
+    Py_buffer view;
+    if (PyObject_GetBuffer(obj, &view, PyBUF_FORMAT | PyBUF_C_CONTIGUOUS) == 0)
+    {
+      const std::string format = view.format ? view.format : "B";
+      if ((view.ndim == 1) && (view.itemsize == sizeof(double)) && ((format == "d") || (format == "@d") || (format == "=d")))
+      {
+        const size_t length = view.len / sizeof(double);
+        values.resize(length);
+        if (length)
+        {
+          memcpy(&values[0], view.buf, length * sizeof(double));
+        }
+        ok = true;
+      }
+      PyBuffer_Release(&view);
+    }
+    else
+    {
+      PyErr_Clear();
+    }
+  }
+  //// array.array only has the old buffer interface
+  else if (PyObject_HasAttrString(obj, "typecode"))
+  {
+    PyObject *tcode = PyObject_GetAttrString(obj, "typecode");
+    if (tcode && PyString_Check(tcode) && (std::string(PyString_AsString(tcode)) == "d"))
+    {
+      const void *buf = NULL;
+      Py_ssize_t  len = 0;
+      if (PyObject_AsReadBuffer(obj, &buf, &len) == 0)
+      {
+        const size_t length = len / sizeof(double);
+        values.resize(length);
+        if (length)
+        {
+          memcpy(&values[0], buf, length * sizeof(double));
+        }
+        ok = true;
+      }
+      else
+      {
+        PyErr_Clear();
+      }
+    }
+    Py_XDECREF(tcode);
+  }
+
+  return ok;
+}
+}
+
 bool ObjectHolder::GetDoubleList(std::vector<double> &values) const
 {
   bool ok = false;
   values.clear();
+
+  if (object_ && GetDoubleBuffer(reinterpret_cast<PyObject *>(object_), values))
+  {
+    return true;
+  }
+
   ObjectHolderList_t objs;
   ok = GetListOfObjects(objs);
   if (ok)
@@ -446,6 +529,32 @@ ObjectHolder::ObjectHolder(int v)
 //  Py_INCREF(reinterpret_cast<PyObject *>(object_));
 }
 
+//// An array.array('d') is created from the raw bytes, which is much faster
+//// than creating a float object for each entry.  It supports the buffer
+//// protocol, so numpy.frombuffer can use it without another copy.
+ObjectHolder::ObjectHolder(const std::vector<double> &list) : object_(NULL)
+{
+  PyObject *bytes = PyString_FromStringAndSize(list.empty() ? NULL : reinterpret_cast<const char *>(&list[0]), list.size() * sizeof(double));
+  PyObject *array_module = PyImport_ImportModule("array");
+  if (bytes && array_module)
+  {
+    object_ = PyObject_CallMethod(array_module, const_cast<char *>("array"), const_cast<char *>("sO"), "d", bytes);
+  }
+  Py_XDECREF(array_module);
+  Py_XDECREF(bytes);
+
+  if (!object_)
+  {
+    PyErr_Clear();
+    ObjectHolderList_t objects(list.size());
+    for (size_t i = 0; i < list.size(); ++i)
+    {
+      objects[i] = ObjectHolder(list[i]);
+    }
+    *this = ObjectHolder(objects);
+  }
+}
+
 ObjectHolder::ObjectHolder(ObjectHolderList_t &list)
 {
   const size_t length = list.size();
@@ -301,6 +301,7 @@ MyNewPyPtr(get_interface_model_list,   dsCommand::getInterfaceModelListCmd);
 MyNewPyPtr(get_interface_model_values, dsCommand::getInterfaceValuesCmd);
 MyNewPyPtr(get_node_model_list,        dsCommand::getNodeModelListCmd);
 MyNewPyPtr(get_node_model_values,      dsCommand::printNodeValuesCmd);
+MyNewPyPtr(get_recomputed_model_list,  dsCommand::getNodeModelListCmd);
 MyNewPyPtr(interface_model,            dsCommand::createInterfaceNodeModelCmd);
 MyNewPyPtr(interface_normal_model,     dsCommand::createInterfaceNormalModelCmd);
 MyNewPyPtr(node_model,                 dsCommand::createNodeModelCmd);
@@ -319,7 +320,9 @@ MyNewPyPtr(cylindrical_surface_area,   dsCommand::createCylindricalCmd);
 // Math Commands
 MyNewPyPtr(get_contact_current,        dsCommand::getContactCurrentCmd);
 MyNewPyPtr(get_contact_charge,         dsCommand::getContactCurrentCmd);
+MyNewPyPtr(get_phase_timings,          dsCommand::getPhaseTimingsCmd);
 MyNewPyPtr(solve,                      dsCommand::solveCmd);
+MyNewPyPtr(sweep,                      dsCommand::sweepCmd);
 // Equation Commands
 MyNewPyPtr(equation,                       dsCommand::createEquationCmd);
 MyNewPyPtr(interface_equation,             dsCommand::createInterfaceEquationCmd);
@@ -350,6 +353,7 @@ MyNewPyPtr(add_2d_contact,                dsCommand::add2dContactCmd);
 MyNewPyPtr(create_device,                 dsCommand::createDeviceCmd);
 MyNewPyPtr(load_devices,                  dsCommand::loadDevicesCmd);
 MyNewPyPtr(write_devices,                 dsCommand::writeDevicesCmd);
+MyNewPyPtr(wait_for_writes,               dsCommand::waitForWritesCmd);
 MyNewPyPtr(create_gmsh_mesh,              dsCommand::createGmshMeshCmd);
 MyNewPyPtr(add_gmsh_contact,              dsCommand::addGmshContactCmd);
 MyNewPyPtr(add_gmsh_interface,            dsCommand::addGmshInterfaceCmd);
@@ -415,6 +419,7 @@ MYCOMMAND(get_interface_model_list,   dsCommand::getInterfaceModelListCmd),
 MYCOMMAND(get_interface_model_values, dsCommand::getInterfaceValuesCmd),
 MYCOMMAND(get_node_model_list,        dsCommand::getNodeModelListCmd),
 MYCOMMAND(get_node_model_values,      dsCommand::printNodeValuesCmd),
+MYCOMMAND(get_recomputed_model_list,  dsCommand::getNodeModelListCmd),
 MYCOMMAND(interface_model,            dsCommand::createInterfaceNodeModelCmd),
 MYCOMMAND(interface_normal_model,     dsCommand::createInterfaceNormalModelCmd),
 MYCOMMAND(node_model,                 dsCommand::createNodeModelCmd),
@@ -433,7 +438,9 @@ MYCOMMAND(cylindrical_surface_area,   dsCommand::createCylindricalCmd),
 // Math Commands
 MYCOMMAND(get_contact_current,        dsCommand::getContactCurrentCmd),
 MYCOMMAND(get_contact_charge,         dsCommand::getContactCurrentCmd),
+MYCOMMAND(get_phase_timings,          dsCommand::getPhaseTimingsCmd),
 MYCOMMAND(solve,                      dsCommand::solveCmd),
+MYCOMMAND(sweep,                      dsCommand::sweepCmd),
 // Equation Commands
 MYCOMMAND(equation,                       dsCommand::createEquationCmd),
 MYCOMMAND(interface_equation,             dsCommand::createInterfaceEquationCmd),
@@ -464,6 +471,7 @@ MYCOMMAND(add_2d_contact,                dsCommand::add2dContactCmd),
 MYCOMMAND(create_device,                 dsCommand::createDeviceCmd),
 MYCOMMAND(load_devices,                  dsCommand::loadDevicesCmd),
 MYCOMMAND(write_devices,                 dsCommand::writeDevicesCmd),
+MYCOMMAND(wait_for_writes,               dsCommand::waitForWritesCmd),
 MYCOMMAND(create_gmsh_mesh,              dsCommand::createGmshMeshCmd),
 MYCOMMAND(add_gmsh_contact,              dsCommand::addGmshContactCmd),
 MYCOMMAND(add_gmsh_interface,            dsCommand::addGmshInterfaceCmd),
@@ -313,6 +313,18 @@ ObjectHolder::ObjectHolder(int v)
 }
 
 
+ObjectHolder::ObjectHolder(const std::vector<double> &list)
+{
+  std::vector<Tcl_Obj *> objs(list.size());
+  for (size_t i = 0; i < list.size(); ++i)
+  {
+    objs[i] = Tcl_NewDoubleObj(list[i]);
+  }
+  Tcl_Obj *listPtr = Tcl_NewListObj(objs.size(), objs.empty() ? NULL : &objs[0]);
+  Tcl_IncrRefCount(listPtr);
+  object_ = listPtr;
+}
+
 ObjectHolder::ObjectHolder(ObjectHolderList_t &list)
 {
   Tcl_Obj *listPtr = NULL;
@@ -228,6 +228,38 @@ void FPECheck::raiseFPE(FPECheck::FPEFlag_t x)
   fpe_raised_ |= x;
 }
 
+FPECheck::FPEFlag_t FPECheck::getThreadFPEFlags()
+{
+#ifdef _WIN32
+  return (_statusfp() & getFPEMask());
+#else
+  return fetestexcept(getFPEMask());
+#endif
+}
+
+void FPECheck::clearThreadFPE()
+{
+#ifdef _WIN32
+  _clearfp();
+#else
+  feclearexcept(FE_ALL_EXCEPT);
+#endif
+}
+
+//// There is no way to set the status word directly on Windows
+void FPECheck::raiseThreadFPE(FPECheck::FPEFlag_t x)
+{
+  x &= getFPEMask();
+  if (x)
+  {
+#ifdef _WIN32
+    raiseFPE(x);
+#else
+    feraiseexcept(x);
+#endif
+  }
+}
+
 #ifdef TEST_FPE_CODE
 #include <iostream>
 int main()
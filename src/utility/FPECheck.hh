@@ -44,6 +44,12 @@ class FPECheck
 
     static void raiseFPE(FPECheck::FPEFlag_t);
 
+    //// Only the status of the calling thread, without the flags from raiseFPE.
+    //// Used by the thread pool to move exceptions between threads.
+    static FPECheck::FPEFlag_t getThreadFPEFlags();
+    static void clearThreadFPE();
+    static void raiseThreadFPE(FPECheck::FPEFlag_t);
+
   private:
     void ClearFP();
     FPECheck();
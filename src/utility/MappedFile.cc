@@ -0,0 +1,107 @@
+/***
+DEVSIM
+Copyright 2013 Devsim LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+***/
+#include "MappedFile.hh"
+#include <fstream>
+#include <sstream>
+#include <iterator>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace dsUtility {
+MappedFile::MappedFile() : data_(NULL), size_(0)
+{
+}
+
+MappedFile::~MappedFile()
+{
+  Close();
+}
+
+void MappedFile::Close()
+{
+#ifndef _WIN32
+  if (data_)
+  {
+    munmap(const_cast<char *>(data_), size_);
+  }
+#else
+  buffer_.clear();
+#endif
+  data_ = NULL;
+  size_ = 0;
+}
+
+bool MappedFile::Open(const std::string &filename, std::string &errorString)
+{
+  std::ostringstream os;
+
+  Close();
+
+#ifndef _WIN32
+  int fd = open(filename.c_str(), O_RDONLY);
+  struct stat st;
+  if ((fd < 0) || (fstat(fd, &st) != 0))
+  {
+    os << "Could not open file " << filename << "\n";
+  }
+  else if (st.st_size > 0)
+  {
+    void *p = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (p == MAP_FAILED)
+    {
+      os << "Could not map file " << filename << "\n";
+    }
+    else
+    {
+      data_ = static_cast<const char *>(p);
+      size_ = st.st_size;
+    }
+  }
+  if (fd >= 0)
+  {
+    close(fd);
+  }
+#else
+  std::ifstream myfile(filename.c_str(), std::ios::in | std::ios::binary);
+  if (!myfile)
+  {
+    os << "Could not open file " << filename << "\n";
+  }
+  else
+  {
+    buffer_.assign(std::istreambuf_iterator<char>(myfile), std::istreambuf_iterator<char>());
+    if (!buffer_.empty())
+    {
+      data_ = &buffer_[0];
+      size_ = buffer_.size();
+    }
+  }
+#endif
+
+  if (!os.str().empty())
+  {
+    errorString += os.str();
+    return false;
+  }
+  return true;
+}
+}
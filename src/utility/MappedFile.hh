@@ -0,0 +1,59 @@
+/***
+DEVSIM
+Copyright 2013 Devsim LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+***/
+#ifndef DS_MAPPED_FILE_HH
+#define DS_MAPPED_FILE_HH
+#include <string>
+#include <vector>
+#include <cstddef>
+
+namespace dsUtility {
+//// Read only view of a whole file.  The file is memory mapped, so only the
+//// pages actually used are read from disk.  On Windows the file is read into
+//// a buffer instead.
+////
+//// The data are not null terminated.
+class MappedFile {
+  public:
+    MappedFile();
+    ~MappedFile();
+
+    bool Open(const std::string &/*filename*/, std::string &/*errorString*/);
+    void Close();
+
+    /// NULL for an empty file
+    const char *GetData() const
+    {
+      return data_;
+    }
+
+    size_t GetSize() const
+    {
+      return size_;
+    }
+
+  private:
+    MappedFile(const MappedFile &);
+    MappedFile &operator=(const MappedFile &);
+
+    const char        *data_;
+    size_t             size_;
+#ifdef _WIN32
+    std::vector<char>  buffer_;
+#endif
+};
+}
+#endif
@@ -0,0 +1,104 @@
+/***
+DEVSIM
+Copyright 2013 Devsim LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+***/
+
+#include "PhaseTimer.hh"
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+PhaseTimer *PhaseTimer::instance = 0;
+
+PhaseTimer::PhaseTimer()
+{
+}
+
+PhaseTimer &PhaseTimer::GetInstance()
+{
+  if (!instance)
+  {
+    instance = new PhaseTimer;
+  }
+  return *instance;
+}
+
+void PhaseTimer::DestroyInstance()
+{
+  if (instance)
+  {
+    delete instance;
+  }
+  instance = 0;
+}
+
+void PhaseTimer::StartPhase(const std::string &name)
+{
+  PhaseData &phase = phaseList[name];
+  if (phase.depth == 0)
+  {
+    phase.start = std::chrono::steady_clock::now();
+  }
+  ++phase.depth;
+}
+
+void PhaseTimer::StopPhase(const std::string &name)
+{
+  PhaseList_t::iterator it = phaseList.find(name);
+  //// the list was cleared while the phase was running
+  if ((it == phaseList.end()) || (it->second.depth == 0))
+  {
+    return;
+  }
+
+  PhaseData &phase = it->second;
+  --phase.depth;
+  if (phase.depth == 0)
+  {
+    const double t = std::chrono::duration<double>(std::chrono::steady_clock::now() - phase.start).count();
+    ++phase.count;
+    phase.total_time += t;
+    if (t > phase.maximum_time)
+    {
+      phase.maximum_time = t;
+    }
+    phase.peak_memory = GetPeakMemory();
+  }
+}
+
+void PhaseTimer::Clear()
+{
+  phaseList.clear();
+}
+
+size_t PhaseTimer::GetPeakMemory()
+{
+  size_t ret = 0;
+#ifndef _WIN32
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0)
+  {
+#ifdef __APPLE__
+    ret = usage.ru_maxrss;
+#else
+    //// reported in kilobytes
+    ret = 1024 * static_cast<size_t>(usage.ru_maxrss);
+#endif
+  }
+#endif
+  return ret;
+}
+
@@ -0,0 +1,96 @@
+/***
+DEVSIM
+Copyright 2013 Devsim LLC
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+***/
+
+#ifndef PHASE_TIMER_HH
+#define PHASE_TIMER_HH
+#include <string>
+#include <map>
+#include <chrono>
+#include <cstddef>
+
+//// Accumulates the time spent in the phases of a simulation, such as model
+//// evaluation, assembly and the linear solve, for benchmarking.
+////
+//// Phases may contain other phases, e.g. assembly evaluates models lazily.
+//// When a phase is entered again before it is left, e.g. a model evaluating
+//// the models it depends on, only the outermost interval is counted.
+////
+//// Phases are only timed from the main thread.
+class PhaseTimer {
+  public:
+    struct PhaseData {
+      PhaseData() : count(0), total_time(0.0), maximum_time(0.0), peak_memory(0), depth(0) {}
+
+      size_t count;
+      double total_time;
+      double maximum_time;
+      /// process high water mark in bytes when the phase was last left
+      size_t peak_memory;
+      size_t depth;
+      std::chrono::steady_clock::time_point start;
+    };
+
+    typedef std::map<std::string, PhaseData> PhaseList_t;
+
+    static PhaseTimer &GetInstance();
+    static void DestroyInstance();
+
+    void StartPhase(const std::string &);
+    void StopPhase(const std::string &);
+
+    const PhaseList_t &GetPhaseList() const
+    {
+      return phaseList;
+    }
+
+    void Clear();
+
+    /// Maximum resident set size of the process in bytes, 0 if not available
+    static size_t GetPeakMemory();
+
+  private:
+    PhaseTimer();
+    PhaseTimer(const PhaseTimer &);
+    PhaseTimer &operator=(const PhaseTimer &);
+
+    static PhaseTimer *instance;
+
+    PhaseList_t phaseList;
+};
+
+/// Times the enclosing scope as the named phase
+class PhaseTimerScope {
+  public:
+    PhaseTimerScope(const char *name) : name_(name)
+    {
+      PhaseTimer::GetInstance().StartPhase(name_);
+    }
+
+    ~PhaseTimerScope()
+    {
+      PhaseTimer::GetInstance().StopPhase(name_);
+    }
+
+  private:
+    PhaseTimerScope();
+    PhaseTimerScope(const PhaseTimerScope &);
+    PhaseTimerScope &operator=(const PhaseTimerScope &);
+
+    const std::string name_;
+};
+#endif
+
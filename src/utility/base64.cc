@@ -78,7 +78,11 @@ template <typename T> std::string convertVectorToBase64(const std::vector<T> &x)
   return encodeBase64(y, length);
 }
 
-template <typename T> std::string convertVectorToZlibBase64(const std::vector<T> &x)
+namespace {
+//// Compresses the vector in blocks, as expected by vtkZLibDataCompressor.
+//// The header holds the number of blocks, the block size, the size of the
+//// last partial block, and the compressed size of each block.
+template <typename T> void compressVectorZlib(const std::vector<T> &x, std::vector<unsigned int> &header, std::string &compressedOutput)
 {
   const size_t blockSize = 32768;
 
@@ -97,17 +101,19 @@ template <typename T> std::string convertVectorToZlibBase64(const std::vector<T>
   } 
 
   const int headerLength = numberOfBlocks + 3;
-  std::vector <unsigned int> header(headerLength);
+  header.clear();
+  header.resize(headerLength);
   header[0] = numberOfBlocks;
   header[1] = blockSize;
-  header[2] = numberTInPartialBlock * sizeof(T);
+  //// the last block is a full block when there is no partial block
+  header[2] = numberTInPartialBlock ? (numberTInPartialBlock * sizeof(T)) : (numberOfBlocks ? blockSize : 0);
 
-  std::string        compressedOutput;
-  std::vector<Bytef> outputArray(maxLength);
+  compressedOutput.clear();
+  std::vector<Bytef> outputArray(compressBound(maxLength));
   for (size_t i = 0; i < numberOfBlocks; ++i)
   {
     uLong inputLength = maxLength;
-    if (i == (numberOfBlocks - 1))
+    if ((i == (numberOfBlocks - 1)) && (numberTInPartialBlock != 0))
     {
       inputLength = sizeof(T) * numberTInPartialBlock;
 //      header[3 + i] = inputLength;
@@ -120,7 +126,7 @@ template <typename T> std::string convertVectorToZlibBase64(const std::vector<T>
 
     Bytef *inputArray = reinterpret_cast<Bytef *>(const_cast<T *>(&x[numberOfTPerBlock * i]));
 
-    uLong outputLength = maxLength; 
+    uLong outputLength = outputArray.size(); 
     int zlibRet = compress2(&(outputArray[0]), &outputLength, inputArray, inputLength, Z_DEFAULT_COMPRESSION);
     dsAssert(zlibRet == Z_OK, "UNEXPECTED");
 
@@ -128,14 +134,39 @@ template <typename T> std::string convertVectorToZlibBase64(const std::vector<T>
     header[3 + i] = outputLength;
 
   }
+}
+}
+
+template <typename T> std::string convertVectorToZlibBase64(const std::vector<T> &x)
+{
+  std::vector<unsigned int> header;
+  std::string               compressedOutput;
+  compressVectorZlib(x, header, compressedOutput);
+
   const std::string encodedData = encodeBase64(compressedOutput.c_str(), compressedOutput.size());
 
 
   return convertVectorToBase64(header) + encodedData;
 }
 
+template <typename T> std::string convertVectorToZlibRaw(const std::vector<T> &x)
+{
+  std::vector<unsigned int> header;
+  std::string               compressedOutput;
+  compressVectorZlib(x, header, compressedOutput);
+
+  std::string ret(reinterpret_cast<const char *>(&header[0]), sizeof(unsigned int) * header.size());
+  ret += compressedOutput;
+  return ret;
+}
+
 template std::string convertVectorToBase64(const std::vector<double> &x);
 template std::string convertVectorToZlibBase64(const std::vector<double> &x);
+template std::string convertVectorToZlibBase64(const std::vector<int> &x);
+template std::string convertVectorToZlibBase64(const std::vector<unsigned char> &x);
+template std::string convertVectorToZlibRaw(const std::vector<double> &x);
+template std::string convertVectorToZlibRaw(const std::vector<int> &x);
+template std::string convertVectorToZlibRaw(const std::vector<unsigned char> &x);
 
 static const unsigned char decodeBase64Table[256] =
 {
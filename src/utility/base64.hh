@@ -24,6 +24,8 @@ namespace dsUtility
 std::string encodeBase64(const char * /*input*/, size_t /*length*/);
 template <typename T> std::string convertVectorToBase64(const std::vector<T> &);
 template <typename T> std::string convertVectorToZlibBase64(const std::vector<T> &);
+/// header and compressed blocks without encoding, for appended raw data
+template <typename T> std::string convertVectorToZlibRaw(const std::vector<T> &);
 
 bool decodeBase64(const std::string &/*input*/, std::string &/*output*/);
 }
@@ -0,0 +1,103 @@
+# Copyright 2013 Devsim LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+####
+#### ac_sweep.py
+#### checks solve with the frequencies option against one solve per frequency
+####
+from ds import *
+
+def check_close(name, value, expected, scale=None):
+  if scale is None:
+    scale = abs(expected)
+  if abs(value - expected) > 1e-10 * scale:
+    raise RuntimeError("%s is %g, expected %g" % (name, value, expected))
+
+device = "MyDevice"
+region = "MyRegion"
+
+create_1d_mesh(mesh="cap")
+add_1d_mesh_line(mesh="cap", pos=0, ps=0.1, tag="top")
+add_1d_mesh_line(mesh="cap", pos=1, ps=0.1, tag="bot")
+add_1d_contact  (mesh="cap", name="top", tag="top", material="metal")
+add_1d_contact  (mesh="cap", name="bot", tag="bot", material="metal")
+add_1d_region   (mesh="cap", material="Si", region=region, tag1="top", tag2="bot")
+finalize_mesh(mesh="cap")
+create_device(mesh="cap", device=device)
+
+set_parameter(device=device, region=region, name="Permittivity", value=3.9*8.85e-14)
+set_parameter(device=device, region=region, name="bottombias", value=0.0)
+
+node_solution(device=device, region=region, name="Potential")
+edge_from_node_model(device=device, region=region, node_model="Potential")
+edge_model(device=device, region=region, name="ElectricField", equation="(Potential@n0 - Potential@n1)*EdgeInverseLength")
+edge_model(device=device, region=region, name="ElectricField:Potential@n0", equation="EdgeInverseLength")
+edge_model(device=device, region=region, name="ElectricField:Potential@n1", equation="-EdgeInverseLength")
+edge_model(device=device, region=region, name="PotentialEdgeFlux", equation="Permittivity*ElectricField")
+edge_model(device=device, region=region, name="PotentialEdgeFlux:Potential@n0", equation="diff(Permittivity*ElectricField, Potential@n0)")
+edge_model(device=device, region=region, name="PotentialEdgeFlux:Potential@n1", equation="-PotentialEdgeFlux:Potential@n0")
+equation(device=device, region=region, name="PotentialEquation", variable_name="Potential", edge_model="PotentialEdgeFlux", variable_update="default")
+
+node_model(device=device, region=region, name="topnode_model", equation="Potential - topbias")
+node_model(device=device, region=region, name="topnode_model:Potential", equation="1")
+node_model(device=device, region=region, name="topnode_model:topbias", equation="-1")
+edge_model(device=device, region=region, name="contactcharge_edge", equation="Permittivity*ElectricField")
+edge_model(device=device, region=region, name="contactcharge_edge:Potential@n0", equation="Permittivity*ElectricField:Potential@n0")
+edge_model(device=device, region=region, name="contactcharge_edge:Potential@n1", equation="Permittivity*ElectricField:Potential@n1")
+node_model(device=device, region=region, name="bottomnode_model", equation="Potential - bottombias")
+node_model(device=device, region=region, name="bottomnode_model:Potential", equation="1")
+
+contact_equation(device=device, contact="top", name="PotentialEquation", variable_name="Potential",
+  node_model="topnode_model", edge_charge_model="contactcharge_edge", circuit_node="topbias")
+contact_equation(device=device, contact="bot", name="PotentialEquation", variable_name="Potential",
+  node_model="bottomnode_model", edge_charge_model="contactcharge_edge")
+
+circuit_element(name="V1", n1="1", n2="0", value=1.0, acreal=1.0)
+circuit_element(name="R1", n1="topbias", n2="1", value=1e3)
+
+solve(type="dc", absolute_error=1.0, relative_error=1e-10, maximum_iterations=30)
+
+frequencies = [1e8, 1e10, 1e12, 1e15]
+nodes = ("topbias", "1", "V1.I")
+noise_fields = ("topbias_PotentialEquation_real", "topbias_PotentialEquation_imag")
+
+#### one solve per frequency
+expected = {"ac" : [], "noise" : []}
+for f in frequencies:
+  solve(type="ac", frequency=f)
+  expected["ac"].append(dict([(n, (get_circuit_node_value(solution="ssac_real", node=n), get_circuit_node_value(solution="ssac_imag", node=n))) for n in nodes]))
+  solve(type="noise", frequency=f, output_node="topbias")
+  expected["noise"].append(dict([(n, (get_circuit_node_value(solution="noise_topbias_real", node=n), get_circuit_node_value(solution="noise_topbias_imag", node=n))) for n in nodes]))
+last_noise = dict([(n, get_node_model_values(device=device, region=region, name=n)) for n in noise_fields])
+
+#### the sweep returns the circuit node values for each frequency
+for t in ("ac", "noise"):
+  if t == "ac":
+    results = solve(type="ac", frequencies=frequencies)
+  else:
+    results = solve(type="noise", frequencies=frequencies, output_node="topbias")
+  if len(results) != len(frequencies):
+    raise RuntimeError("%s sweep returned %d results, expected %d" % (t, len(results), len(frequencies)))
+  for f, r, e in zip(frequencies, results, expected[t]):
+    check_close("%s frequency" % t, r["frequency"], f)
+    scale = max([abs(v) for n in nodes for v in e[n]])
+    for n in nodes:
+      check_close("%s %g %s real" % (t, f, n), r["real"][n], e[n][0], scale)
+      check_close("%s %g %s imag" % (t, f, n), r["imag"][n], e[n][1], scale)
+
+#### the device noise fields are only kept for the last frequency
+for n in noise_fields:
+  scale = max([abs(v) for v in last_noise[n]])
+  for v, e in zip(get_node_model_values(device=device, region=region, name=n), last_noise[n]):
+    check_close(n, v, e, scale)
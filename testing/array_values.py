@@ -0,0 +1,79 @@
+# Copyright 2013 Devsim LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+####
+#### array_values.py
+#### round trips node values through arrays of doubles and the per element path
+####
+from ds import *
+from array import array
+
+def check(name, value, expected):
+  if value != expected:
+    raise RuntimeError("%s is %s, expected %s" % (name, str(value), str(expected)))
+
+device = "MyDevice"
+region = "MyRegion"
+
+create_1d_mesh(mesh="dog")
+add_1d_mesh_line(mesh="dog", pos=0, ps=0.1, tag="top")
+add_1d_mesh_line(mesh="dog", pos=1, ps=0.1, tag="bot")
+add_1d_contact  (mesh="dog", name="top", tag="top", material="metal")
+add_1d_contact  (mesh="dog", name="bot", tag="bot", material="metal")
+add_1d_region   (mesh="dog", material="Si", region=region, tag1="top", tag2="bot")
+finalize_mesh(mesh="dog")
+create_device(mesh="dog", device=device)
+node_solution(device=device, region=region, name="Potential")
+
+x = get_node_model_values(device=device, region=region, name="x")
+#### values which do not survive a conversion to float
+expected = [1.0/3.0 - v*v*1e300 for v in x]
+
+def get_values(as_array=False):
+  return get_node_model_values(device=device, region=region, name="Potential", as_array=as_array)
+
+#### a list goes through the per element path, and as_array returns an array.array('d')
+set_node_values(device=device, region=region, name="Potential", values=expected)
+values = get_values(as_array=True)
+check("as_array type", (type(values), values.typecode), (array, "d"))
+check("as_array values", list(values), expected)
+check("tuple values", list(get_values()), expected)
+
+#### the returned array can be passed back in
+set_node_values(device=device, region=region, name="Potential", values=[0.0]*len(x))
+set_node_values(device=device, region=region, name="Potential", values=values)
+check("array('d') values", list(get_values()), expected)
+
+#### an array of a different type is converted element by element
+set_node_values(device=device, region=region, name="Potential", values=array("l", range(len(x))))
+check("array('l') values", list(get_values()), [float(i) for i in range(len(x))])
+
+try:
+  import numpy
+except ImportError:
+  numpy = None
+
+if numpy is not None:
+  set_node_values(device=device, region=region, name="Potential", values=numpy.array(expected, dtype=numpy.float64))
+  check("float64 values", list(get_values()), expected)
+  check("frombuffer values", list(numpy.frombuffer(get_values(as_array=True), dtype=numpy.float64)), expected)
+
+  #### not a double buffer, so each element is converted
+  set_node_values(device=device, region=region, name="Potential", values=numpy.arange(len(x), dtype=numpy.int64))
+  check("int64 values", list(get_values()), [float(i) for i in range(len(x))])
+
+  #### a strided view is not contiguous
+  doubled = numpy.array([v for v in expected for i in (0, 1)], dtype=numpy.float64)
+  set_node_values(device=device, region=region, name="Potential", values=doubled[::2])
+  check("strided float64 values", list(get_values()), expected)
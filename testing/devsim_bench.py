@@ -0,0 +1,177 @@
+# Copyright 2013 Devsim LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+#####
+# devsim_bench
+#
+# Synthetic diode and MOS workloads in 1D, 2D and 3D for tracking the
+# performance of the simulator from release to release.  The time spent in
+# each phase of the simulation, e.g. model_evaluation, region_assemble,
+# matrix_finalize, lu_factor, lu_solve and region_update, is written to a
+# JSON file, together with the memory high water mark of the process.
+#
+# usage: devsim_py devsim_bench.py [output_file]
+#
+import sys
+import json
+import time
+from ds import *
+from python_packages.simple_physics import *
+
+def CreateDiode1D(device, region):
+  create_1d_mesh(mesh=device)
+  add_1d_mesh_line(mesh=device, pos=0,      ps=1e-8, tag="top")
+  add_1d_mesh_line(mesh=device, pos=0.5e-5, ps=1e-10, tag="mid")
+  add_1d_mesh_line(mesh=device, pos=1e-5,   ps=1e-8, tag="bot")
+  add_1d_contact  (mesh=device, name="top", tag="top", material="metal")
+  add_1d_contact  (mesh=device, name="bot", tag="bot", material="metal")
+  add_1d_region   (mesh=device, material="Si", region=region, tag1="top", tag2="bot")
+  finalize_mesh(mesh=device)
+  create_device(mesh=device, device=device)
+  return "x"
+
+def CreateDiode2D(device, region):
+  create_2d_mesh(mesh=device)
+  add_2d_mesh_line(mesh=device, dir="x", pos=0,      ps=1e-7)
+  add_2d_mesh_line(mesh=device, dir="x", pos=0.5e-5, ps=1e-8)
+  add_2d_mesh_line(mesh=device, dir="x", pos=1e-5,   ps=1e-7)
+  add_2d_mesh_line(mesh=device, dir="y", pos=0,      ps=1e-7)
+  add_2d_mesh_line(mesh=device, dir="y", pos=1e-5,   ps=1e-7)
+  add_2d_region(mesh=device, material="Si", region=region)
+  add_2d_contact(mesh=device, name="top", material="metal", region=region, xl=0,    xh=0,    bloat=1e-10)
+  add_2d_contact(mesh=device, name="bot", material="metal", region=region, xl=1e-5, xh=1e-5, bloat=1e-10)
+  finalize_mesh(mesh=device)
+  create_device(mesh=device, device=device)
+  return "x"
+
+def CreateDiode3D(device, region):
+  create_gmsh_mesh (mesh=device, file="gmsh_diode3d.msh")
+  add_gmsh_region  (mesh=device, gmsh_name="Bulk",    region=region, material="Silicon")
+  add_gmsh_contact (mesh=device, gmsh_name="Base",    region=region, material="metal", name="top")
+  add_gmsh_contact (mesh=device, gmsh_name="Emitter", region=region, material="metal", name="bot")
+  finalize_mesh    (mesh=device)
+  create_device    (mesh=device, device=device)
+  return "z"
+
+def RunDiode(device, create):
+  region = "Bulk"
+  direction = create(device, region)
+
+  SetSiliconParameters(device, region, 300)
+  CreateNodeModel(device, region, "Acceptors", "1.0e18*step(0.5e-5-%s)" % direction)
+  CreateNodeModel(device, region, "Donors",    "1.0e18*step(%s-0.5e-5)" % direction)
+  CreateNodeModel(device, region, "NetDoping", "Donors-Acceptors")
+
+  CreateSolution(device, region, "Potential")
+  CreateSiliconPotentialOnly(device, region)
+  for c in get_contact_list(device=device):
+    set_parameter(device=device, name=GetContactBiasName(c), value=0.0)
+    CreateSiliconPotentialOnlyContact(device, region, c)
+  solve(type="dc", absolute_error=1.0, relative_error=1e-12, maximum_iterations=30)
+
+  CreateSolution(device, region, "Electrons")
+  CreateSolution(device, region, "Holes")
+  set_node_values(device=device, region=region, name="Electrons", init_from="IntrinsicElectrons")
+  set_node_values(device=device, region=region, name="Holes",     init_from="IntrinsicHoles")
+  CreateSiliconDriftDiffusion(device, region)
+  for c in get_contact_list(device=device):
+    CreateSiliconDriftDiffusionAtContact(device, region, c)
+  solve(type="dc", absolute_error=1e10, relative_error=1e-10, maximum_iterations=30)
+
+  for v in (0.1, 0.2, 0.3, 0.4, 0.5):
+    set_parameter(device=device, name=GetContactBiasName("top"), value=v)
+    solve(type="dc", absolute_error=1e10, relative_error=1e-10, maximum_iterations=30)
+
+def RunMos2D(device, create=None):
+  create_gmsh_mesh(file="gmsh_mos2d.msh", mesh=device)
+  add_gmsh_region    (mesh=device, gmsh_name="bulk",  region="bulk",  material="Silicon")
+  add_gmsh_region    (mesh=device, gmsh_name="oxide", region="oxide", material="Silicon")
+  add_gmsh_region    (mesh=device, gmsh_name="gate",  region="gate",  material="Silicon")
+  add_gmsh_contact   (mesh=device, gmsh_name="drain_contact",  region="bulk", name="drain",  material="metal")
+  add_gmsh_contact   (mesh=device, gmsh_name="source_contact", region="bulk", name="source", material="metal")
+  add_gmsh_contact   (mesh=device, gmsh_name="body_contact",   region="bulk", name="body",   material="metal")
+  add_gmsh_contact   (mesh=device, gmsh_name="gate_contact",   region="gate", name="gate",   material="metal")
+  add_gmsh_interface (mesh=device, gmsh_name="gate_oxide_interface", region0="gate", region1="oxide", name="gate_oxide")
+  add_gmsh_interface (mesh=device, gmsh_name="bulk_oxide_interface", region0="bulk", region1="oxide", name="bulk_oxide")
+  finalize_mesh(mesh=device)
+  create_device(mesh=device, device=device)
+
+  silicon_regions = ("gate", "bulk")
+
+  node_model(device=device, region="gate", name="NetDoping", equation="1e20")
+  node_model(device=device, region="bulk", name="DrainDoping",  equation="0.25*1e19*erfc((x-4.5e-5)/1e-20)*erfc((y-1e-5)/1e-10)")
+  node_model(device=device, region="bulk", name="SourceDoping", equation="0.25*1e19*erfc(-(x-5.5e-5)/1e-20)*erfc((y-1e-5)/1e-10)")
+  node_model(device=device, region="bulk", name="BodyDoping",   equation="0.5*1e19*erfc(-(y-1e-4)/1e-10)")
+  node_model(device=device, region="bulk", name="NetDoping",    equation="DrainDoping + SourceDoping + 1 - 1e15 - BodyDoping")
+
+  for r in ("gate", "bulk", "oxide"):
+    CreateSolution(device, r, "Potential")
+  for r in silicon_regions:
+    SetSiliconParameters(device, r, 300)
+    CreateSiliconPotentialOnly(device, r)
+  SetOxideParameters(device, "oxide", 300)
+  CreateOxidePotentialOnly(device, "oxide", "log_damp")
+
+  contacts = get_contact_list(device=device)
+  for c in contacts:
+    r = get_region_list(device=device, contact=c)[0]
+    CreateSiliconPotentialOnlyContact(device, r, c)
+    set_parameter(device=device, name=GetContactBiasName(c), value=0.0)
+  for i in ("bulk_oxide", "gate_oxide"):
+    CreateSiliconOxideInterface(device, i)
+  solve(type="dc", absolute_error=1.0e-13, relative_error=1e-12, maximum_iterations=30)
+
+  for r in silicon_regions:
+    CreateSolution(device, r, "Electrons")
+    CreateSolution(device, r, "Holes")
+    set_node_values(device=device, region=r, name="Electrons", init_from="IntrinsicElectrons")
+    set_node_values(device=device, region=r, name="Holes",     init_from="IntrinsicHoles")
+    CreateSiliconDriftDiffusion(device, r, "mu_n", "mu_p")
+  for c in contacts:
+    r = get_region_list(device=device, contact=c)[0]
+    CreateSiliconDriftDiffusionAtContact(device, r, c)
+  solve(type="dc", absolute_error=1.0e30, relative_error=1e-5, maximum_iterations=30)
+
+  for v in (0.1, 0.2, 0.3):
+    set_parameter(device=device, name=GetContactBiasName("gate"), value=v)
+    solve(type="dc", absolute_error=1.0e30, relative_error=1e-5, maximum_iterations=30)
+
+workloads = (
+  ("diode_1d", RunDiode, CreateDiode1D),
+  ("diode_2d", RunDiode, CreateDiode2D),
+  ("diode_3d", RunDiode, CreateDiode3D),
+  ("mos_2d",   RunMos2D, None),
+)
+
+output_file = "devsim_bench.json"
+if len(sys.argv) > 1:
+  output_file = sys.argv[1]
+
+results = {}
+for name, run, create in workloads:
+  get_phase_timings(reset=True)
+  start = time.time()
+  run(name, create)
+  elapsed = time.time() - start
+  timings = get_phase_timings(reset=True)
+  results[name] = {
+    "wall_time"   : elapsed,
+    "peak_memory" : timings.pop("peak_memory"),
+    "phases"      : timings,
+  }
+  print("%s %g" % (name, elapsed))
+
+f = open(output_file, "w")
+json.dump({"workloads" : results}, f, indent=2, sort_keys=True)
+f.close()
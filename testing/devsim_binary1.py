@@ -0,0 +1,47 @@
+# Copyright 2013 Devsim LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+####
+#### devsim_binary1.py
+#### writes the same device in the devsim and devsim_binary formats for devsim_binary2.py
+####
+from ds import *
+
+def make_device(device):
+  mesh = device + "_mesh"
+  create_1d_mesh(mesh=mesh)
+  add_1d_mesh_line(mesh=mesh, pos=0.0, ps=0.1,  tag="top")
+  add_1d_mesh_line(mesh=mesh, pos=0.5, ps=0.01, tag="mid")
+  add_1d_mesh_line(mesh=mesh, pos=1.0, ps=0.1,  tag="bot")
+  add_1d_contact  (mesh=mesh, name="top", tag="top", material="metal")
+  add_1d_contact  (mesh=mesh, name="bot", tag="bot", material="metal")
+  add_1d_interface(mesh=mesh, name="MyInt", tag="mid")
+  add_1d_region   (mesh=mesh, material="Si", region="r0", tag1="top", tag2="mid")
+  add_1d_region   (mesh=mesh, material="Ox", region="r1", tag1="mid", tag2="bot")
+  finalize_mesh(mesh=mesh)
+  create_device(mesh=mesh, device=device)
+
+  for region in ("r0", "r1"):
+    node_solution(device=device, region=region, name="Potential")
+    x = get_node_model_values(device=device, region=region, name="x")
+    set_node_values(device=device, region=region, name="Potential", values=[0.1 + v*v for v in x])
+    node_model(device=device, region=region, name="Doubled", equation="2*Potential")
+    edge_from_node_model(device=device, region=region, node_model="Potential")
+    edge_model(device=device, region=region, name="ElectricField", equation="(Potential@n0-Potential@n1)*EdgeInverseLength")
+
+  interface_model(device=device, interface="MyInt", name="continuousPotential", equation="Potential@r0-Potential@r1")
+
+for device, fmt in (("text", "devsim"), ("binary", "devsim_binary")):
+  make_device(device)
+  write_devices(file="devsim_binary_" + device + ".msh", device=device, type=fmt)
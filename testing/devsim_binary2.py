@@ -0,0 +1,49 @@
+# Copyright 2013 Devsim LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+####
+#### devsim_binary2.py
+#### loads the devices written by devsim_binary1.py and checks the binary file against the text file
+####
+from ds import *
+
+def check(name, value, expected):
+  if value != expected:
+    raise RuntimeError("%s is %s, expected %s" % (name, str(value), str(expected)))
+
+load_devices(file="devsim_binary_text.msh")
+load_devices(file="devsim_binary_binary.msh")
+
+check("regions", list(get_region_list(device="binary")), list(get_region_list(device="text")))
+check("contacts", sorted(get_contact_list(device="binary")), sorted(get_contact_list(device="text")))
+check("interfaces", list(get_interface_list(device="binary")), list(get_interface_list(device="text")))
+
+for region in get_region_list(device="text"):
+  for getlist, getvalues in (
+    (get_node_model_list,    get_node_model_values),
+    (get_edge_model_list,    get_edge_model_values),
+    (get_element_model_list, get_element_model_values),
+  ):
+    names = sorted(getlist(device="text", region=region))
+    check("%s %s" % (region, getlist.__name__), sorted(getlist(device="binary", region=region)), names)
+    for name in names:
+      expected = list(getvalues(device="text", region=region, name=name))
+      check("%s %s" % (region, name), list(getvalues(device="binary", region=region, name=name)), expected)
+
+for interface in get_interface_list(device="text"):
+  names = sorted(get_interface_model_list(device="text", interface=interface))
+  check("%s models" % interface, sorted(get_interface_model_list(device="binary", interface=interface)), names)
+  for name in names:
+    expected = list(get_interface_model_values(device="text", interface=interface, name=name))
+    check("%s %s" % (interface, name), list(get_interface_model_values(device="binary", interface=interface, name=name)), expected)
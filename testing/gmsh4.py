@@ -0,0 +1,45 @@
+# Copyright 2013 Devsim LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+####
+#### gmsh4.py
+#### loads the same square, made of 4 triangles, from MSH 4.1 ascii and binary files
+####
+from ds import *
+
+def check(name, value, expected):
+  if value != expected:
+    raise RuntimeError("%s is %s, expected %s" % (name, str(value), str(expected)))
+
+for fmt in ("ascii", "binary"):
+  mesh = "gmsh4_" + fmt
+  device = mesh
+  create_gmsh_mesh(mesh=mesh, file=mesh + ".msh")
+  add_gmsh_region (mesh=mesh, gmsh_name="bulk", region="bulk", material="Si")
+  add_gmsh_contact(mesh=mesh, gmsh_name="top", name="top", region="bulk", material="metal")
+  add_gmsh_contact(mesh=mesh, gmsh_name="bot", name="bot", region="bulk", material="metal")
+  finalize_mesh(mesh=mesh)
+  create_device(mesh=mesh, device=device)
+
+  check(device + " regions", list(get_region_list(device=device)), ["bulk"])
+  check(device + " contacts", sorted(get_contact_list(device=device)), ["bot", "top"])
+
+  x = get_node_model_values(device=device, region="bulk", name="x")
+  y = get_node_model_values(device=device, region="bulk", name="y")
+  check(device + " nodes", len(x), 5)
+  check(device + " coordinates", sorted(zip(x, y)), [(0.0, 0.0), (0.0, 1.0), (0.5, 0.5), (1.0, 0.0), (1.0, 1.0)])
+  check(device + " edges", len(get_edge_model_values(device=device, region="bulk", name="EdgeLength")), 8)
+  check(device + " triangles", len(get_element_model_values(device=device, region="bulk", name="ElementEdgeCouple")), 3*4)
+  check(device + " contact nodes", sum(get_node_model_values(device=device, region="bulk", name="AtContactNode")), 4.0)
+  print("%s: 5 nodes, 8 edges, 4 triangles" % device)
@@ -0,0 +1,94 @@
+# Copyright 2013 Devsim LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+####
+#### ilu_diode.py
+#### solves a 2D diode with the ilu preconditioner and compares with the direct solver
+####
+from ds import *
+from python_packages.simple_physics import *
+
+device = "diode"
+region = "Bulk"
+bias = GetContactBiasName("top")
+options = {"absolute_error" : 1e10, "relative_error" : 1e-10, "maximum_iterations" : 30}
+
+create_2d_mesh(mesh=device)
+add_2d_mesh_line(mesh=device, dir="x", pos=0,      ps=5e-7)
+add_2d_mesh_line(mesh=device, dir="x", pos=0.5e-5, ps=5e-8)
+add_2d_mesh_line(mesh=device, dir="x", pos=1e-5,   ps=5e-7)
+add_2d_mesh_line(mesh=device, dir="y", pos=0,      ps=1e-6)
+add_2d_mesh_line(mesh=device, dir="y", pos=1e-5,   ps=1e-6)
+add_2d_region(mesh=device, material="Si", region=region)
+add_2d_contact(mesh=device, name="top", material="metal", region=region, xl=0,    xh=0,    bloat=1e-10)
+add_2d_contact(mesh=device, name="bot", material="metal", region=region, xl=1e-5, xh=1e-5, bloat=1e-10)
+finalize_mesh(mesh=device)
+create_device(mesh=device, device=device)
+
+SetSiliconParameters(device, region, 300)
+CreateNodeModel(device, region, "Acceptors", "1.0e18*step(0.5e-5-x)")
+CreateNodeModel(device, region, "Donors",    "1.0e18*step(x-0.5e-5)")
+CreateNodeModel(device, region, "NetDoping", "Donors-Acceptors")
+
+CreateSolution(device, region, "Potential")
+CreateSiliconPotentialOnly(device, region)
+for c in get_contact_list(device=device):
+  set_parameter(device=device, name=GetContactBiasName(c), value=0.0)
+  CreateSiliconPotentialOnlyContact(device, region, c)
+solve(type="dc", absolute_error=1.0, relative_error=1e-12, maximum_iterations=30)
+
+CreateSolution(device, region, "Electrons")
+CreateSolution(device, region, "Holes")
+set_node_values(device=device, region=region, name="Electrons", init_from="IntrinsicElectrons")
+set_node_values(device=device, region=region, name="Holes",     init_from="IntrinsicHoles")
+CreateSiliconDriftDiffusion(device, region)
+for c in get_contact_list(device=device):
+  CreateSiliconDriftDiffusionAtContact(device, region, c)
+solve(type="dc", **options)
+
+solutions = ("Potential", "Electrons", "Holes")
+start = dict([(s, get_node_model_values(device=device, region=region, name=s)) for s in solutions])
+
+def solve_at_bias(**solver):
+  for s in solutions:
+    set_node_values(device=device, region=region, name=s, values=start[s])
+  set_parameter(device=device, name=bias, value=0.0)
+  for v in (0.1, 0.2, 0.3):
+    set_parameter(device=device, name=bias, value=v)
+    solve(type="dc", **dict(options, **solver))
+  current = get_contact_current(device=device, contact="top", equation="ElectronContinuityEquation") + get_contact_current(device=device, contact="top", equation="HoleContinuityEquation")
+  return (current, dict([(s, get_node_model_values(device=device, region=region, name=s)) for s in solutions]))
+
+(expected_current, expected) = solve_at_bias(solver_type="direct")
+
+for fill_level in (0, 1):
+  name = "ILU(%d)" % fill_level
+  (current, values) = solve_at_bias(solver_type="iterative", preconditioner="ilu", fill_level=fill_level)
+  if abs(current - expected_current) > 1e-6 * abs(expected_current):
+    raise RuntimeError("%s current is %g, expected %g" % (name, current, expected_current))
+  for s in solutions:
+    scale = max([abs(v) for v in expected[s]])
+    for v, e in zip(values[s], expected[s]):
+      if abs(v - e) > 1e-6 * scale:
+        raise RuntimeError("%s %s is %g, expected %g" % (name, s, v, e))
+  print("%s matches the direct solve" % name)
+
+#### a linear solve which does not converge fails the solve
+set_parameter(device=device, name=bias, value=0.4)
+try:
+  solve(type="dc", solver_type="iterative", preconditioner="ilu", fill_level=0, linear_iterations=1, **options)
+except Exception:
+  pass
+else:
+  raise RuntimeError("solve with linear_iterations=1 did not fail")
@@ -0,0 +1,97 @@
+# Copyright 2013 Devsim LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+####
+#### matrix_free_diode.py
+#### solves a 1D diode with the matrix_free solver and compares with the direct solver
+####
+from ds import *
+from python_packages.simple_physics import *
+
+device = "diode"
+region = "Bulk"
+bias = GetContactBiasName("top")
+options = {"absolute_error" : 1e10, "relative_error" : 1e-10, "maximum_iterations" : 30}
+
+create_1d_mesh(mesh=device)
+add_1d_mesh_line(mesh=device, pos=0,      ps=1e-7,  tag="top")
+add_1d_mesh_line(mesh=device, pos=0.5e-5, ps=1e-9,  tag="mid")
+add_1d_mesh_line(mesh=device, pos=1e-5,   ps=1e-7,  tag="bot")
+add_1d_contact  (mesh=device, name="top", tag="top", material="metal")
+add_1d_contact  (mesh=device, name="bot", tag="bot", material="metal")
+add_1d_region   (mesh=device, material="Si", region=region, tag1="top", tag2="bot")
+finalize_mesh(mesh=device)
+create_device(mesh=device, device=device)
+
+SetSiliconParameters(device, region, 300)
+CreateNodeModel(device, region, "Acceptors", "1.0e18*step(0.5e-5-x)")
+CreateNodeModel(device, region, "Donors",    "1.0e18*step(x-0.5e-5)")
+CreateNodeModel(device, region, "NetDoping", "Donors-Acceptors")
+
+CreateSolution(device, region, "Potential")
+CreateSiliconPotentialOnly(device, region)
+for c in get_contact_list(device=device):
+  set_parameter(device=device, name=GetContactBiasName(c), value=0.0)
+  CreateSiliconPotentialOnlyContact(device, region, c)
+solve(type="dc", absolute_error=1.0, relative_error=1e-12, maximum_iterations=30)
+
+CreateSolution(device, region, "Electrons")
+CreateSolution(device, region, "Holes")
+set_node_values(device=device, region=region, name="Electrons", init_from="IntrinsicElectrons")
+set_node_values(device=device, region=region, name="Holes",     init_from="IntrinsicHoles")
+CreateSiliconDriftDiffusion(device, region)
+for c in get_contact_list(device=device):
+  CreateSiliconDriftDiffusionAtContact(device, region, c)
+solve(type="dc", **options)
+
+solutions = ("Potential", "Electrons", "Holes")
+start = dict([(s, get_node_model_values(device=device, region=region, name=s)) for s in solutions])
+
+def get_results():
+  currents = {}
+  for c in get_contact_list(device=device):
+    currents[c] = get_contact_current(device=device, contact=c, equation="ElectronContinuityEquation") + get_contact_current(device=device, contact=c, equation="HoleContinuityEquation")
+  return (currents, dict([(s, get_node_model_values(device=device, region=region, name=s)) for s in solutions]))
+
+def solve_at_bias(solver_type):
+  for s in solutions:
+    set_node_values(device=device, region=region, name=s, values=start[s])
+  set_parameter(device=device, name=bias, value=0.0)
+  for v in (0.1, 0.2, 0.3):
+    set_parameter(device=device, name=bias, value=v)
+    solve(type="dc", solver_type=solver_type, **options)
+  return get_results()
+
+def compare(name, results, expected):
+  for c in expected[0]:
+    if abs(results[0][c] - expected[0][c]) > 1e-6 * abs(expected[0][c]):
+      raise RuntimeError("%s %s current is %g, expected %g" % (name, c, results[0][c], expected[0][c]))
+  for s in solutions:
+    scale = max([abs(v) for v in expected[1][s]])
+    for v, e in zip(results[1][s], expected[1][s]):
+      if abs(v - e) > 1e-6 * scale:
+        raise RuntimeError("%s %s is %g, expected %g" % (name, s, v, e))
+
+expected = solve_at_bias("direct")
+results = solve_at_bias("matrix_free")
+compare("matrix_free", results, expected)
+
+#### small signal solves are not available, and leave the dc solution alone
+try:
+  solve(type="ac", frequency=1e6, solver_type="matrix_free")
+except Exception:
+  pass
+else:
+  raise RuntimeError("ac solve with matrix_free did not fail")
+compare("matrix_free after ac", get_results(), expected)
@@ -0,0 +1,76 @@
+# Copyright 2013 Devsim LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+####
+#### recomputed_models.py
+#### checks that get_recomputed_model_list lists each model recalculated
+#### during the last solver iteration once, and only after a parameter
+#### change its dependents
+####
+from ds import *
+
+device = "MyDevice"
+region = "MyRegion"
+
+create_1d_mesh(mesh="dog")
+add_1d_mesh_line(mesh="dog", pos=0, ps=0.1, tag="top")
+add_1d_mesh_line(mesh="dog", pos=1, ps=0.1, tag="bot")
+add_1d_contact  (mesh="dog", name="top", tag="top", material="metal")
+add_1d_contact  (mesh="dog", name="bot", tag="bot", material="metal")
+add_1d_region   (mesh="dog", material="Si", region=region, tag1="top", tag2="bot")
+finalize_mesh(mesh="dog")
+create_device(mesh="dog", device=device)
+
+for name, value in (("alpha", 1.0), ("beta", 1.0), ("gamma", 1.0)):
+  set_parameter(device=device, region=region, name=name, value=value)
+
+#### alpha changes the solution by much less than the convergence criteria,
+#### so that a solve after changing it takes a single iteration
+node_solution(device=device, region=region, name="Potential")
+node_model(device=device, region=region, name="a_model", equation="alpha * x")
+node_model(device=device, region=region, name="b_model", equation="2 * a_model")
+node_model(device=device, region=region, name="c_model", equation="beta * x")
+node_model(device=device, region=region, name="d_model", equation="gamma * x")
+node_model(device=device, region=region, name="Residual", equation="Potential - c_model - 1e-30 * b_model")
+node_model(device=device, region=region, name="Residual:Potential", equation="1")
+equation(device=device, region=region, name="PotentialEquation", variable_name="Potential", node_model="Residual", variable_update="default")
+
+def check(expected):
+  models = get_recomputed_model_list(device=device, region=region)
+  if len(models) != len(set(models)):
+    raise RuntimeError("models listed more than once: %s" % str(models))
+  if sorted(models) != sorted(expected):
+    raise RuntimeError("expected %s, got %s" % (str(sorted(expected)), str(sorted(models))))
+
+options = {"type" : "dc", "absolute_error" : 1e-10, "relative_error" : 1e-10, "maximum_iterations" : 10}
+
+#### the first iteration evaluates everything in the equation, the last one
+#### only what depends on the updated Potential
+solve(**options)
+check(["Residual"])
+
+#### models read outside of a solve are not reported by the next one
+for i in range(100):
+  set_parameter(device=device, region=region, name="gamma", value=1.0 + i)
+  get_node_model_values(device=device, region=region, name="d_model")
+  get_node_model_values(device=device, region=region, name="Residual")
+check(["Residual"])
+
+set_parameter(device=device, region=region, name="alpha", value=2.0)
+solve(**options)
+check(["a_model", "b_model", "Residual"])
+
+#### nothing changed, but the update of Potential from the last solve
+solve(**options)
+check(["Residual"])
@@ -0,0 +1,85 @@
+# Copyright 2013 Devsim LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+####
+#### sweep_halving.py
+#### a forward bias step which only converges when the sweep halves the step
+####
+from ds import *
+from python_packages.simple_physics import *
+
+def expect_error(name, function, **kwargs):
+  try:
+    function(**kwargs)
+  except Exception:
+    return
+  raise RuntimeError("%s did not fail" % name)
+
+device = "diode"
+region = "Bulk"
+bias = GetContactBiasName("top")
+target = 0.7
+
+create_1d_mesh(mesh=device)
+add_1d_mesh_line(mesh=device, pos=0,      ps=1e-7,  tag="top")
+add_1d_mesh_line(mesh=device, pos=0.5e-5, ps=1e-9,  tag="mid")
+add_1d_mesh_line(mesh=device, pos=1e-5,   ps=1e-7,  tag="bot")
+add_1d_contact  (mesh=device, name="top", tag="top", material="metal")
+add_1d_contact  (mesh=device, name="bot", tag="bot", material="metal")
+add_1d_region   (mesh=device, material="Si", region=region, tag1="top", tag2="bot")
+finalize_mesh(mesh=device)
+create_device(mesh=device, device=device)
+
+SetSiliconParameters(device, region, 300)
+CreateNodeModel(device, region, "Acceptors", "1.0e18*step(0.5e-5-x)")
+CreateNodeModel(device, region, "Donors",    "1.0e18*step(x-0.5e-5)")
+CreateNodeModel(device, region, "NetDoping", "Donors-Acceptors")
+
+CreateSolution(device, region, "Potential")
+CreateSiliconPotentialOnly(device, region)
+for c in get_contact_list(device=device):
+  set_parameter(device=device, name=GetContactBiasName(c), value=0.0)
+  CreateSiliconPotentialOnlyContact(device, region, c)
+solve(type="dc", absolute_error=1.0, relative_error=1e-12, maximum_iterations=30)
+
+CreateSolution(device, region, "Electrons")
+CreateSolution(device, region, "Holes")
+set_node_values(device=device, region=region, name="Electrons", init_from="IntrinsicElectrons")
+set_node_values(device=device, region=region, name="Holes",     init_from="IntrinsicHoles")
+CreateSiliconDriftDiffusion(device, region)
+for c in get_contact_list(device=device):
+  CreateSiliconDriftDiffusionAtContact(device, region, c)
+solve(type="dc", absolute_error=1e10, relative_error=1e-10, maximum_iterations=30)
+
+#### 1 << 31 does not fit in an int
+expect_error("maximum_divisions=31", sweep, device=device, name=bias, values=[target], maximum_divisions=31)
+expect_error("maximum_divisions=-1", sweep, device=device, name=bias, values=[target], maximum_divisions=-1)
+
+#### the full step does not converge in 4 iterations, so the sweep has to halve it
+options = {"absolute_error" : 1e10, "relative_error" : 1e-10, "maximum_iterations" : 4}
+set_parameter(device=device, name=bias, value=target)
+expect_error("solve to %g" % target, solve, type="dc", **options)
+set_parameter(device=device, name=bias, value=0.0)
+expect_error("sweep without divisions", sweep, device=device, name=bias, values=[target], maximum_divisions=0, **options)
+
+points = sweep(device=device, name=bias, values=[target], contact="top", **options)
+if (len(points) != 1) or (points[0]["value"] != target):
+  raise RuntimeError("sweep ended at %s, expected %g" % (str(points), target))
+current = points[0]["currents"]["ElectronContinuityEquation"] + points[0]["currents"]["HoleContinuityEquation"]
+
+#### the same point from the converged solution
+solve(type="dc", absolute_error=1e10, relative_error=1e-10, maximum_iterations=30)
+expected = get_contact_current(device=device, contact="top", equation="ElectronContinuityEquation") + get_contact_current(device=device, contact="top", equation="HoleContinuityEquation")
+if abs(current - expected) > 1e-6 * abs(expected):
+  raise RuntimeError("sweep current is %g, expected %g" % (current, expected))
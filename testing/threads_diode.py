@@ -0,0 +1,115 @@
+# Copyright 2013 Devsim LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+####
+#### threads_diode.py
+#### finalizes, solves and writes a 2D diode with 1 and with 4 threads, and
+#### checks the results are bit for bit the same
+####
+from ds import *
+from python_packages.simple_physics import *
+
+def check(name, value, expected):
+  if value != expected:
+    raise RuntimeError("%s differs between 1 and 4 threads" % name)
+
+def read_file(name, device):
+  with open(name, "rb") as fh:
+    return fh.read().replace(device.encode("ascii"), b"DEVICE")
+
+def run(threads):
+  set_parameter(name="threads_available", value=threads)
+  set_parameter(name="threads_task_size", value=16)
+
+  device = "threads%d" % threads
+  region = "Bulk"
+  options = {"absolute_error" : 1e10, "relative_error" : 1e-10, "maximum_iterations" : 30}
+
+  create_2d_mesh(mesh=device)
+  add_2d_mesh_line(mesh=device, dir="x", pos=0,      ps=5e-7)
+  add_2d_mesh_line(mesh=device, dir="x", pos=0.5e-5, ps=5e-8)
+  add_2d_mesh_line(mesh=device, dir="x", pos=1e-5,   ps=5e-7)
+  add_2d_mesh_line(mesh=device, dir="y", pos=0,      ps=1e-6)
+  add_2d_mesh_line(mesh=device, dir="y", pos=1e-5,   ps=1e-6)
+  add_2d_region(mesh=device, material="Si", region=region)
+  add_2d_contact(mesh=device, name="top", material="metal", region=region, xl=0,    xh=0,    bloat=1e-10)
+  add_2d_contact(mesh=device, name="bot", material="metal", region=region, xl=1e-5, xh=1e-5, bloat=1e-10)
+  finalize_mesh(mesh=device)
+  create_device(mesh=device, device=device)
+
+  #### connectivity of the finalized mesh
+  results = []
+  edge_from_node_model(device=device, region=region, node_model="node_index")
+  for n in ("node_index@n0", "node_index@n1"):
+    element_model(device=device, region=region, name="Element_" + n.replace("@", "_"), equation=n)
+  element_model(device=device, region=region, name="ElementEdgeIndex", equation="edge_index")
+  for n in ("node_index@n0", "node_index@n1", "EdgeCouple", "EdgeLength"):
+    results.append((n, get_edge_model_values(device=device, region=region, name=n)))
+  for n in ("Element_node_index_n0", "Element_node_index_n1", "ElementEdgeIndex", "ElementEdgeCouple"):
+    results.append((n, get_element_model_values(device=device, region=region, name=n)))
+  for n in ("NodeVolume", "AtContactNode"):
+    results.append((n, get_node_model_values(device=device, region=region, name=n)))
+
+  #### dc solve
+  SetSiliconParameters(device, region, 300)
+  CreateNodeModel(device, region, "Acceptors", "1.0e18*step(0.5e-5-x)")
+  CreateNodeModel(device, region, "Donors",    "1.0e18*step(x-0.5e-5)")
+  CreateNodeModel(device, region, "NetDoping", "Donors-Acceptors")
+
+  CreateSolution(device, region, "Potential")
+  CreateSiliconPotentialOnly(device, region)
+  for c in get_contact_list(device=device):
+    set_parameter(device=device, name=GetContactBiasName(c), value=0.0)
+    CreateSiliconPotentialOnlyContact(device, region, c)
+  solve(type="dc", absolute_error=1.0, relative_error=1e-12, maximum_iterations=30)
+
+  CreateSolution(device, region, "Electrons")
+  CreateSolution(device, region, "Holes")
+  set_node_values(device=device, region=region, name="Electrons", init_from="IntrinsicElectrons")
+  set_node_values(device=device, region=region, name="Holes",     init_from="IntrinsicHoles")
+  CreateSiliconDriftDiffusion(device, region)
+  for c in get_contact_list(device=device):
+    CreateSiliconDriftDiffusionAtContact(device, region, c)
+  solve(type="dc", **options)
+  for v in (0.1, 0.2, 0.3):
+    set_parameter(device=device, name=GetContactBiasName("top"), value=v)
+    solve(type="dc", **options)
+
+  for n in ("Potential", "Electrons", "Holes"):
+    results.append((n, get_node_model_values(device=device, region=region, name=n)))
+  for c in get_contact_list(device=device):
+    for e in ("ElectronContinuityEquation", "HoleContinuityEquation"):
+      results.append(("%s %s current" % (c, e), get_contact_current(device=device, contact=c, equation=e)))
+
+  #### files
+  write_devices(file=device + ".msh", device=device, type="devsim")
+  results.append(("devsim file", read_file(device + ".msh", device)))
+  try:
+    write_devices(file=device, device=device, type="vtk")
+  except Exception:
+    #### vtk support is optional
+    pass
+  else:
+    for f in (device + ".vtm", device + "_0.vtu"):
+      results.append((f.replace(device, "vtk"), read_file(f, device)))
+
+  return results
+
+serial = run(1)
+threaded = run(4)
+set_parameter(name="threads_available", value=0)
+
+check("number of results", len(threaded), len(serial))
+for (name, value), (ename, expected) in zip(threaded, serial):
+  check(name, (name, value), (ename, expected))
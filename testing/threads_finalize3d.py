@@ -0,0 +1,67 @@
+# Copyright 2013 Devsim LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+####
+#### threads_finalize3d.py
+#### finalizes a 3D mesh with 1 and with 4 threads, and checks the element
+#### edge and triangle data are bit for bit the same
+####
+from ds import *
+
+def check(name, value, expected):
+  if value != expected:
+    raise RuntimeError("%s differs between 1 and 4 threads" % name)
+
+def read_file(name, device):
+  with open(name, "rb") as fh:
+    return fh.read().replace(device.encode("ascii"), b"DEVICE")
+
+def run(threads):
+  set_parameter(name="threads_available", value=threads)
+  set_parameter(name="threads_task_size", value=64)
+
+  device = "finalize%d" % threads
+  region = "Bulk"
+  create_gmsh_mesh (mesh=device, file="gmsh_diode3d.msh")
+  add_gmsh_region  (mesh=device, gmsh_name="Bulk",    region=region, material="Silicon")
+  add_gmsh_contact (mesh=device, gmsh_name="Base",    region=region, material="metal", name="top")
+  add_gmsh_contact (mesh=device, gmsh_name="Emitter", region=region, material="metal", name="bot")
+  finalize_mesh    (mesh=device)
+  create_device    (mesh=device, device=device)
+
+  results = []
+  #### the nodes and the edge of each tetrahedron edge
+  edge_from_node_model(device=device, region=region, node_model="node_index")
+  for n in ("node_index@n0", "node_index@n1"):
+    element_model(device=device, region=region, name="Element_" + n.replace("@", "_"), equation=n)
+  element_model(device=device, region=region, name="ElementEdgeIndex", equation="edge_index")
+  for n in ("Element_node_index_n0", "Element_node_index_n1", "ElementEdgeIndex", "ElementEdgeCouple"):
+    results.append((n, get_element_model_values(device=device, region=region, name=n)))
+  #### summed from the edge data of each tetrahedron
+  for n in ("node_index@n0", "node_index@n1", "EdgeCouple", "EdgeLength"):
+    results.append((n, get_edge_model_values(device=device, region=region, name=n)))
+  for n in ("NodeVolume", "AtContactNode"):
+    results.append((n, get_node_model_values(device=device, region=region, name=n)))
+
+  write_devices(file=device + ".msh", device=device, type="devsim")
+  results.append(("devsim file", read_file(device + ".msh", device)))
+  return results
+
+serial = run(1)
+threaded = run(4)
+set_parameter(name="threads_available", value=0)
+
+check("number of results", len(threaded), len(serial))
+for (name, value), (ename, expected) in zip(threaded, serial):
+  check(name, (name, value), (ename, expected))
@@ -0,0 +1,195 @@
+# Copyright 2013 Devsim LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+####
+#### vector_math.py
+#### compares the array versions of the special functions with the scalar
+#### versions and with python math, including the fallback to the scalar
+#### versions for arguments outside of the range of each array version
+####
+from ds import *
+import math
+
+device = "MyDevice"
+region = "MyRegion"
+
+create_1d_mesh(mesh="dog")
+add_1d_mesh_line(mesh="dog", pos=0, ps=4e-4, tag="top")
+add_1d_mesh_line(mesh="dog", pos=1, ps=4e-4, tag="bot")
+add_1d_contact  (mesh="dog", name="top", tag="top", material="metal")
+add_1d_contact  (mesh="dog", name="bot", tag="bot", material="metal")
+add_1d_region   (mesh="dog", material="Si", region=region, tag1="top", tag2="bot")
+finalize_mesh(mesh="dog")
+create_device(mesh="dog", device=device)
+
+#### more nodes than in a block of the array versions
+number_nodes = len(get_node_model_values(device=device, region=region, name="x"))
+if number_nodes < 2048:
+  raise RuntimeError("expected at least 2048 nodes")
+
+#### v is evaluated with the array versions, while the parameter a is uniform
+#### and is evaluated with the scalar versions
+node_solution(device=device, region=region, name="v")
+set_node_values(device=device, region=region, name="v", init_from="x")
+set_parameter(device=device, region=region, name="a", value=0.5)
+
+#### relative tolerance between the array and scalar versions
+#### B and dBdx cancel for arguments just above 1e-4, and Fermi only
+#### converges to ~1e-9
+tolerances = {
+  "B"           : 1e-11,
+  "dBdx"        : 1e-7,
+  "erfc"        : 1e-14,
+  "derfdx"      : 1e-14,
+  "derfcdx"     : 1e-14,
+  "Fermi"       : 1e-8,
+  "dFermidx"    : 1e-8,
+  "InvFermi"    : 1e-13,
+  "dInvFermidx" : 1e-13,
+}
+
+for name in tolerances:
+  node_model(device=device, region=region, name="vector_" + name, equation="%s(v)" % name)
+  node_model(device=device, region=region, name="scalar_" + name, equation="%s(a)" % name)
+
+def same(x, y, tol):
+  if math.isnan(x) or math.isnan(y):
+    return math.isnan(x) and math.isnan(y)
+  if x == y:
+    return True
+  return abs(x - y) <= tol * max(abs(x), abs(y)) + 1e-300
+
+def tile(values):
+  return [values[i % len(values)] for i in range(number_nodes)]
+
+#### None when the evaluation fails, e.g. for a floating point exception
+def vector_values(name, values):
+  set_node_values(device=device, region=region, name="v", values=values)
+  try:
+    return get_node_model_values(device=device, region=region, name="vector_" + name)
+  except Exception:
+    return None
+
+def scalar_value(name, value):
+  set_parameter(device=device, region=region, name="a", value=value)
+  try:
+    return get_node_model_values(device=device, region=region, name="scalar_" + name)[0]
+  except Exception:
+    return None
+
+def check_values(name, values):
+  tol = tolerances[name]
+  scalars = {}
+  for x in values:
+    scalars[x] = scalar_value(name, x)
+    if scalars[x] is None:
+      raise RuntimeError("%s(%g) failed" % (name, x))
+  args = tile(values)
+  results = vector_values(name, args)
+  if results is None:
+    raise RuntimeError("%s failed" % name)
+  for x, y in zip(args, results):
+    if not same(y, scalars[x], tol):
+      raise RuntimeError("%s(%.17g) is %.17g and %.17g for the scalar version" % (name, x, y, scalars[x]))
+  return results
+
+#### a failure for a bad argument must be the same as for the scalar version
+def check_outcome(name, bad):
+  args = tile([0.5, 1.5, bad])
+  results = vector_values(name, args)
+  expected = scalar_value(name, bad)
+  if expected is None:
+    if results is not None:
+      raise RuntimeError("%s(%g) failed only for the scalar version" % (name, bad))
+    return
+  if results is None:
+    raise RuntimeError("%s(%g) failed only for the array version" % (name, bad))
+  good = (scalar_value(name, 0.5), scalar_value(name, 1.5), expected)
+  for i, y in enumerate(results):
+    if not same(y, good[i % 3], tolerances[name]):
+      raise RuntimeError("%s(%.17g) is %.17g and %.17g for the scalar version" % (name, args[i], y, good[i % 3]))
+
+def sweep(start, stop, step):
+  return [start + i * step for i in range(int((stop - start) / step) + 1)]
+
+def signed(values):
+  return values + [-x for x in values]
+
+inf = float("inf")
+nan = float("nan")
+
+#### small arguments use the series, large ones are clamped
+bernoulli_values = signed([0.0, 1e-300, 1e-10, 1e-5, 9.99e-5, 1e-4, 1.0001e-4, 1.1e-4, 5e-4, 1e-3, 0.1, 0.5, 1.0, 5.0, 20.0, 36.0, 37.0, 100.0, 700.0, 709.7, 709.8, 1e3, 1e300]) + sweep(-50.0, 50.0, 0.37)
+#### every range of the rational approximation, and the tail of erfc
+erfc_values = signed([0.0, 1e-300, 0.46875, 0.5, 4.0, 4.0001, 5.9, 6.0, 26.5, 27.3, 1e3, 1e150]) + sweep(-30.0, 30.0, 0.07)
+#### both sides of the breakpoint of InvFermi
+fermi_values = [-700.0, -30.0, -1.0, 0.0, 1.0, 8.0, 8.46, 10.0, 50.0, 199.99, 200.0] + sweep(-700.0, 200.0, 1.37)
+inv_fermi_values = [2.2250738585072014e-308, 8.4629603662170, 8.46296036621705, 8.462960366217051, 1e200] + [10.0**(-300.0 + 0.25 * i) for i in range(2000)]
+
+kernels = (
+  ("B", bernoulli_values, [inf, -inf]),
+  ("dBdx", bernoulli_values, [inf, -inf]),
+  ("erfc", erfc_values, [inf, -inf]),
+  ("derfdx", erfc_values, [1e151, -1e151, inf, -inf]),
+  ("derfcdx", erfc_values, [1e151, -1e151, inf, -inf]),
+  ("Fermi", fermi_values, [-701.0, -705.0, 201.0, 300.0, 500.0]),
+  ("dFermidx", fermi_values, [-701.0, -705.0, 201.0, 300.0, 500.0]),
+  ("InvFermi", inv_fermi_values, [1e-310, 1e201, 1e220]),
+  ("dInvFermidx", inv_fermi_values, [1e201, 1e220]),
+)
+
+for name, values, outside in kernels:
+  #### evaluated with the array version
+  check_values(name, values)
+  #### blocks with arguments outside of the range use the scalar version
+  check_values(name, values + outside)
+
+#### NaN and arguments giving a floating point exception
+bad_values = {
+  "derfdx"      : [1e200],
+  "derfcdx"     : [1e200],
+  "Fermi"       : [-720.0, -800.0, 800.0],
+  "dFermidx"    : [-720.0, -800.0, 800.0],
+  "InvFermi"    : [0.0, -1.0, 1e250],
+  "dInvFermidx" : [0.0, -1.0, 1e-310],
+}
+for name in tolerances:
+  for bad in [nan] + bad_values.get(name, []):
+    check_outcome(name, bad)
+
+#### the functions available in python math
+def bernoulli(x):
+  if x == 0.0:
+    return 1.0
+  elif x > 700.0:
+    return x * math.exp(-x)
+  return x / math.expm1(x)
+
+def erfc_derivative(x):
+  return 2.0 / math.sqrt(math.pi) * math.exp(-x * x)
+
+def erfc_negative_derivative(x):
+  return -erfc_derivative(x)
+
+references = (
+  ("B", bernoulli_values, bernoulli, 1e-10),
+  ("erfc", erfc_values, math.erfc, 1e-12),
+  ("derfdx", erfc_values, erfc_derivative, 1e-12),
+  ("derfcdx", erfc_values, erfc_negative_derivative, 1e-12),
+)
+for name, values, function, tol in references:
+  results = vector_values(name, tile(values))
+  for x, y in zip(tile(values), results):
+    if not same(y, function(x), tol):
+      raise RuntimeError("%s(%.17g) is %.17g and %.17g from python math" % (name, x, y, function(x)))
@@ -0,0 +1,76 @@
+# Copyright 2013 Devsim LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+####
+#### vtk_async.py
+#### checks asynchronous vtk writes against synchronous ones
+####
+from ds import *
+import os
+
+def expect_error(name, function, **kwargs):
+  try:
+    function(**kwargs)
+  except Exception:
+    return
+  raise RuntimeError("%s did not fail" % name)
+
+def read_files(name):
+  ret = []
+  for f in (name + ".vtm", name + ".visit", name + "_0.vtu"):
+    with open(f, "rb") as fh:
+      ret.append(fh.read().replace(name.encode("ascii"), b"NAME"))
+  return ret
+
+device = "MyDevice"
+region = "MyRegion"
+
+create_1d_mesh(mesh="dog")
+add_1d_mesh_line(mesh="dog", pos=0, ps=0.01, tag="top")
+add_1d_mesh_line(mesh="dog", pos=1, ps=0.01, tag="bot")
+add_1d_contact  (mesh="dog", name="top", tag="top", material="metal")
+add_1d_contact  (mesh="dog", name="bot", tag="bot", material="metal")
+add_1d_region   (mesh="dog", material="Si", region=region, tag1="top", tag2="bot")
+finalize_mesh(mesh="dog")
+create_device(mesh="dog", device=device)
+node_solution(device=device, region=region, name="Potential")
+x = get_node_model_values(device=device, region=region, name="x")
+
+#### more writes than can wait in the queue, with different values in each
+count = 5
+for i in range(count):
+  set_node_values(device=device, region=region, name="Potential", values=[i + v for v in x])
+  write_devices(file="vtk_async_sync%d" % i, device=device, type="vtk")
+  write_devices(file="vtk_async_async%d" % i, device=device, type="vtk", asynchronous=True)
+wait_for_writes()
+
+for i in range(count):
+  if read_files("vtk_async_sync%d" % i) != read_files("vtk_async_async%d" % i):
+    raise RuntimeError("asynchronous write %d does not match the synchronous write" % i)
+
+#### the error from the background thread is reported by wait_for_writes, and only once
+expect_error("synchronous write to a missing directory", write_devices, file="vtk_async_missing/out", device=device, type="vtk")
+write_devices(file="vtk_async_missing/out", device=device, type="vtk", asynchronous=True)
+expect_error("wait_for_writes after a write to a missing directory", wait_for_writes)
+wait_for_writes()
+
+#### only the vtk type may be written asynchronously, and nothing is written for the others
+for t in ("devsim", "devsim_binary", "devsim_data", "floops", "tecplot"):
+  f = "vtk_async_%s.out" % t
+  if os.path.exists(f):
+    os.remove(f)
+  expect_error("asynchronous %s write" % t, write_devices, file=f, device=device, type=t, asynchronous=True)
+  if os.path.exists(f):
+    raise RuntimeError("asynchronous %s write created %s" % (t, f))
+wait_for_writes()
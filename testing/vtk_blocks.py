@@ -0,0 +1,101 @@
+# Copyright 2013 Devsim LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+####
+#### vtk_blocks.py
+#### reads back compressed vtk arrays whose sizes are a multiple of the 32768 byte block size
+####
+import base64
+import re
+import struct
+import zlib
+from ds import *
+
+# 32768 edges gives exactly 8 blocks of connectivity, 4 blocks of offsets, and 1 block of types
+ncells = 32768
+
+device = "MyDevice"
+region = "MyRegion"
+create_1d_mesh(mesh="blocks")
+add_1d_mesh_line(mesh="blocks", pos=0,      ps=1, tag="top")
+add_1d_mesh_line(mesh="blocks", pos=ncells, ps=1, tag="bot")
+add_1d_contact  (mesh="blocks", name="top", tag="top", material="metal")
+add_1d_contact  (mesh="blocks", name="bot", tag="bot", material="metal")
+add_1d_region   (mesh="blocks", material="Si", region=region, tag1="top", tag2="bot")
+finalize_mesh(mesh="blocks")
+create_device(mesh="blocks", device=device)
+
+def decompress(header, data):
+  '''returns the uncompressed bytes, checking the sizes in the header'''
+  nblocks, block_size, last_size = header[0:3]
+  ret = b''
+  pos = 0
+  for i in range(nblocks):
+    block = zlib.decompress(data[pos:pos+header[3+i]])
+    pos += header[3+i]
+    expected = last_size if i == (nblocks - 1) else block_size
+    if len(block) != expected:
+      raise RuntimeError("block %d has %d bytes, expected %d" % (i, len(block), expected))
+    ret += block
+  return ret
+
+def read_header(raw):
+  nblocks = struct.unpack('<I', raw[0:4])[0]
+  return struct.unpack('<%dI' % (nblocks + 3), raw[0:4*(nblocks + 3)])
+
+def read_base64(text):
+  '''the header and the data are encoded separately'''
+  first = base64.b64decode(text[0:16])
+  nblocks = struct.unpack('<I', first[0:4])[0]
+  hlen = 4 * ((4*(nblocks + 3) + 2) // 3)
+  header = read_header(base64.b64decode(text[0:hlen]))
+  return decompress(header, base64.b64decode(text[hlen:]))
+
+def read_appended(appended, offset):
+  header = read_header(appended[offset:])
+  start = offset + 4*len(header)
+  return decompress(header, appended[start:start + sum(header[3:])])
+
+def read_arrays(filename):
+  '''returns the uncompressed bytes of each array by name'''
+  with open(filename, 'rb') as f:
+    contents = f.read()
+  ret = {}
+  marker = b'<AppendedData encoding="raw">\n_'
+  if marker in contents:
+    xml, appended = contents.split(marker, 1)
+    for m in re.finditer(b'<DataArray type="[^"]*" Name="([^"]*)"[^>]* format="appended" offset="([0-9]*)"/>', xml):
+      ret[m.group(1).decode()] = read_appended(appended, int(m.group(2)))
+  else:
+    for m in re.finditer(b'<DataArray type="[^"]*" Name="([^"]*)"[^>]* format="binary">\n([^<]*)\n</DataArray>', contents):
+      ret[m.group(1).decode()] = read_base64(m.group(2).strip())
+  return ret
+
+def check(filename):
+  arrays = read_arrays(filename)
+  connectivity = struct.unpack('<%di' % (2*ncells), arrays["connectivity"])
+  offsets = struct.unpack('<%di' % ncells, arrays["offsets"])
+  types = struct.unpack('<%dB' % ncells, arrays["types"])
+  if list(offsets) != list(range(2, 2*ncells + 1, 2)):
+    raise RuntimeError("%s: offsets do not match" % filename)
+  if set(types) != set([3]):
+    raise RuntimeError("%s: types do not match" % filename)
+  if sorted(set(connectivity)) != list(range(0, ncells + 1)):
+    raise RuntimeError("%s: connectivity does not match" % filename)
+  print("%s: %d cells" % (filename, ncells))
+
+for fmt in ("base64", "appended"):
+  name = "vtk_blocks_" + fmt
+  write_devices(file=name, device=device, type="vtk", vtk_format=fmt)
+  check(name + "_0.vtu")